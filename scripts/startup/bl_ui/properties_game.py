@@ -600,6 +600,18 @@ class SCENE_PT_game_physics(SceneButtonsPanel, Panel):
             row.label(text="Object Activity:")
             row.prop(gs, "use_activity_culling")
 
+            row = layout.row()
+            row.label(text="Culling:")
+            row.prop(gs, "use_occlusion_culling")
+            sub = row.row()
+            sub.active = gs.use_occlusion_culling
+            sub.prop(gs, "occlusion_culling_resolution", text="Resolution")
+
+            row = layout.row()
+            row.label(text="Physics:")
+            row.prop(gs, "use_parallel_physics", text="Parallel")
+            row.prop(gs, "use_shape_cache")
+
         else:
             split = layout.split()
 
@@ -611,6 +623,14 @@ class SCENE_PT_game_physics(SceneButtonsPanel, Panel):
             col.label(text="Logic Steps:")
             col.prop(gs, "logic_step_max", text="Max")
 
+        row = layout.row()
+        row.label(text="Scene Graph:")
+        row.prop(gs, "use_parallel_scenegraph", text="Parallel")
+
+        row = layout.row()
+        row.label(text="Animation:")
+        row.prop(gs, "use_parallel_animation", text="Parallel")
+
 class SCENE_PT_game_blender_physics(SceneButtonsPanel, Panel):
     bl_label = "Game Blender Physics"
     COMPAT_ENGINES = {
@@ -720,6 +740,10 @@ class SCENE_PT_game_navmesh(SceneButtonsPanel, Panel):
         row.prop(rd, "sample_dist")
         row.prop(rd, "sample_max_error")
 
+        col = layout.column()
+        col.label(text="Game Engine:")
+        col.prop(rd, "tile_size")
+
 
 class SCENE_PT_game_hysteresis(SceneButtonsPanel, Panel):
     bl_label = "Level of Detail"
@@ -742,6 +766,9 @@ class SCENE_PT_game_hysteresis(SceneButtonsPanel, Panel):
         row = layout.row()
         row.active = gs.use_scene_hysteresis
         row.prop(gs, "scene_hysteresis_percentage", text="")
+        row = layout.row()
+        row.prop(gs, "use_lod_screen_size")
+        row.prop(gs, "lod_max_swaps")
 
 class SCENE_PT_game_console(SceneButtonsPanel, Panel):
     bl_label = "Game Python Console"
@@ -433,4 +433,10 @@ void blo_do_versions_upbge(FileData *fd, Library */*lib*/, Main *bmain)
       }
     }
   }
+  if (!MAIN_VERSION_UPBGE_ATLEAST(bmain, 50, 2)) {
+    LISTBASE_FOREACH (Scene *, sce, &bmain->scenes) {
+      /* WO_DBVT_CULLING is used again and opt-in, the old defaults set it. */
+      sce->gm.mode &= ~WO_DBVT_CULLING;
+    }
+  }
 }
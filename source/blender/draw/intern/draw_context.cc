@@ -2362,6 +2362,10 @@ void DRW_game_render_loop(bContext *C,
         }
         Object *orig_ob = DEG_get_original(ob);
 
+        /* Don't render objects waiting in a replica pool or culled by the game engine */
+        if (orig_ob->gameflag & (OB_POOLED_REPLICA | OB_CULLED)) {
+          continue;
+        }
         if (orig_ob->gameflag & OB_OVERLAY_COLLECTION) {
           blender::draw::ObjectRef ob_ref(data_, ob);
           drw_engines_cache_populate(ob_ref, duplis, extraction);
@@ -2382,8 +2386,9 @@ void DRW_game_render_loop(bContext *C,
         }
 
         Object *orig_ob = DEG_get_original(ob);
-        /* Don't render objects in overlay collections in main pass */
-        if (orig_ob->gameflag & OB_OVERLAY_COLLECTION) {
+        /* Don't render objects in overlay collections in main pass,
+         * objects waiting in a replica pool and objects culled by the game engine */
+        if (orig_ob->gameflag & (OB_OVERLAY_COLLECTION | OB_POOLED_REPLICA | OB_CULLED)) {
           continue;
         }
         blender::draw::ObjectRef ob_ref(data_, ob);
@@ -1585,7 +1585,9 @@ static void draw_controller_python(uiLayout *layout, PointerRNA *ptr)
   split = &layout->split(0.3, true);
   split->prop(ptr, "mode", UI_ITEM_NONE, "", ICON_NONE);
   if (RNA_enum_get(ptr, "mode") == CONT_PY_SCRIPT) {
-    split->prop(ptr, "text", UI_ITEM_NONE, "", ICON_NONE);
+    sub = &split->split(0.8f, false);
+    sub->prop(ptr, "text", UI_ITEM_NONE, "", ICON_NONE);
+    sub->prop(ptr, "use_persistent_namespace", UI_ITEM_R_TOGGLE, std::nullopt, ICON_NONE);
   }
   else {
     sub = &split->split(0.8f, false);
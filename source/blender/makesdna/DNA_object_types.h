@@ -847,6 +847,11 @@ enum {
   OB_OVERLAY_COLLECTION = 1 << 24,
 
   OB_LOD_UPDATE_PHYSICS = 1 << 25,
+
+  /* Runtime only: hidden object waiting in a game scene replica pool. */
+  OB_POOLED_REPLICA = 1 << 26,
+  /* Runtime only: object culled for the camera currently rendered by the game engine. */
+  OB_CULLED = 1 << 27,
 };
 
 /* ob->gameflag2 */
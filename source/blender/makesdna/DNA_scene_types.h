@@ -1023,7 +1023,9 @@ typedef struct RecastData {
   float detailsamplemaxerror;
   char partitioning;
   char _pad1;
-  short _pad2[5];
+  /** Size of the tiles in cells for the game engine, 0 for a single mesh. */
+  short tilesize;
+  short _pad2[4];
 } RecastData;
 
 /* RecastData.partitioning */
@@ -1077,7 +1079,7 @@ typedef struct GameData {
   float erp, erp2, cfm, _pad1;
 
   /* Scene LoD */
-  short lodflag, _pad3;
+  short lodflag, lodmaxswaps;
   int scehysteresis;
   void *_pad10;
 } GameData;
@@ -1142,6 +1144,10 @@ enum {
 #define GAME_PYTHON_CONSOLE (1 << 22)
 #define GAME_USE_INTERACTIVE_DYNAPAINT (1 << 23)
 #define GAME_USE_INTERACTIVE_RIGIDBODY (1 << 24)
+#define GAME_USE_PARALLEL_SCENEGRAPH (1 << 25)
+#define GAME_USE_PARALLEL_ANIMATION (1 << 26)
+#define GAME_USE_PARALLEL_PHYSICS (1 << 27)
+#define GAME_USE_SHAPE_CACHE (1 << 28)
 /* Note: GameData.flag is now an int (max 32 flags). A short could only take 16 flags */
 
 /* GameData.playerflag */
@@ -1150,6 +1156,7 @@ enum {
 
 /* GameData.lodflag */
 #define SCE_LOD_USE_HYST (1 << 0)
+#define SCE_LOD_USE_SCREEN_SIZE (1 << 1)
 
 /* GameData.profileSize */
 #define GAME_PROFILE_SIZE_NORMAL 0
@@ -112,6 +112,8 @@ enum {
   WO_MODE_UNUSED_5 = 1 << 5, /* cleared */
   WO_MODE_UNUSED_6 = 1 << 6, /* cleared */
   WO_MODE_UNUSED_7 = 1 << 7, /* cleared */
+  /* Bit cleared from #World::mode, only used by #GameData::mode. */
+  WO_DBVT_CULLING = WO_MODE_UNUSED_5,
 };
 
 /** #World::mistype */
@@ -277,6 +277,14 @@ void RNA_def_controller(BlenderRNA *brna)
                            "without restarting");
   RNA_def_property_update(prop, NC_LOGIC, nullptr);
 
+  prop = RNA_def_property(srna, "use_persistent_namespace", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", CONT_PY_PERSISTENT);
+  RNA_def_property_ui_text(prop,
+                           "P",
+                           "Keep the global variables of the script between its executions "
+                           "instead of starting from a copy of the namespace each time");
+  RNA_def_property_update(prop, NC_LOGIC, nullptr);
+
   /* Other Controllers */
   srna = RNA_def_struct(brna, "AndController", "Controller");
   RNA_def_struct_ui_text(
@@ -6039,6 +6039,16 @@ static void rna_def_scene_game_recast_data(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Max Sample Error", "Detail mesh simplification max sample error");
   RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "tile_size", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "tilesize");
+  RNA_def_property_range(prop, 0, 1024);
+  RNA_def_property_ui_range(prop, 0, 256, 8, -1);
+  RNA_def_property_ui_text(prop,
+                           "Tile Size",
+                           "Size of the tiles in cells, the tiles under the blockers of a navigation "
+                           "mesh are rebuilt while the game runs (0 to disable)");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
 }
 
 static void rna_def_bake_data(BlenderRNA *brna)
@@ -6604,6 +6614,13 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Activity Culling", "Enable object activity culling in this scene");
 
+  prop = RNA_def_property(srna, "use_occlusion_culling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "mode", WO_DBVT_CULLING);
+  RNA_def_property_ui_text(prop,
+                           "Occlusion Culling",
+                           "Skip the render of the objects outside of the camera view or hidden "
+                           "by occluder objects, culled objects don't cast shadows");
+
   prop = RNA_def_property(srna, "show_debug_properties", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_SHOW_DEBUG_PROPS);
   RNA_def_property_ui_text(
@@ -6698,6 +6715,32 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Use Interactive Rigidbody Sim", "Blender Rigidbody sim at bge runtime (experimental)");
 
+  prop = RNA_def_property(srna, "use_parallel_scenegraph", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_PARALLEL_SCENEGRAPH);
+  RNA_def_property_ui_text(prop,
+                           "Parallel Scene Graph",
+                           "Update the transforms of independent object hierarchies in parallel");
+
+  prop = RNA_def_property(srna, "use_parallel_animation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_PARALLEL_ANIMATION);
+  RNA_def_property_ui_text(
+      prop, "Parallel Animation", "Evaluate the actions of the armatures in parallel");
+
+  prop = RNA_def_property(srna, "use_parallel_physics", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_PARALLEL_PHYSICS);
+  RNA_def_property_ui_text(prop,
+                           "Parallel Physics",
+                           "Compute the collisions, solve the simulation islands and synchronize "
+                           "the objects with multiple threads, the results are reproducible for a "
+                           "same number of threads");
+
+  prop = RNA_def_property(srna, "use_shape_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_USE_SHAPE_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "Shape Cache",
+                           "Store the BVH of the static triangle mesh shapes in a file next to "
+                           "the .blend file to not rebuild them at the next launches");
+
   /* obstacle simulation */
   prop = RNA_def_property(srna, "obstacle_simulation", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_sdna(prop, NULL, "obstacleSimulation");
@@ -6743,6 +6786,23 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
       "Hysteresis %",
       "Minimum distance change required to transition to the previous level of detail");
   RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "use_lod_screen_size", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "lodflag", SCE_LOD_USE_SCREEN_SIZE);
+  RNA_def_property_ui_text(prop,
+                           "Screen Size",
+                           "Scale the level of detail distances by the camera zoom and the object "
+                           "scale, to change level at the same size on screen");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
+
+  prop = RNA_def_property(srna, "lod_max_swaps", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "lodmaxswaps");
+  RNA_def_property_range(prop, 0, 10000);
+  RNA_def_property_ui_text(prop,
+                           "Max Swaps",
+                           "Maximum number of objects changing of level of detail per render, "
+                           "the nearest first (0 for no limit)");
+  RNA_def_property_update(prop, NC_SCENE, NULL);
 }
 
 static void rna_def_view_layers(BlenderRNA *brna, PropertyRNA *cprop)
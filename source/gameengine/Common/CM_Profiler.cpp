@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Common/CM_Profiler.cpp
+ *  \ingroup common
+ */
+
+#include "CM_Profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "CM_Thread.h"
+
+namespace {
+
+/// Zones of a thread, written by its thread and read by the export.
+struct ThreadBuffer {
+  int id;
+  std::string name;
+  CM_ThreadSpinLock lock;
+  /// Allocated at the first zone.
+  std::vector<CM_Profiler::Zone> zones;
+  /// Index of the next zone to write.
+  unsigned int next = 0;
+  /// True when the zones wrapped around the ring.
+  bool full = false;
+};
+
+std::mutex buffers_mutex;
+/// Buffers of all the threads which recorded a zone, kept after the thread ends.
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer *current_buffer = nullptr;
+
+/// Maximum depth of the zones opened with BeginZone.
+const int zone_stack_size = 64;
+struct OpenZone {
+  const char *name;
+  /// -1 if the profiler was disabled when the zone began.
+  long long start;
+};
+thread_local OpenZone zone_stack[zone_stack_size];
+thread_local int zone_depth = 0;
+
+const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+ThreadBuffer *get_thread_buffer()
+{
+  if (!current_buffer) {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    buffers.emplace_back(new ThreadBuffer());
+    current_buffer = buffers.back().get();
+    current_buffer->id = buffers.size();
+    current_buffer->name = "Thread " + std::to_string(current_buffer->id);
+  }
+  return current_buffer;
+}
+
+void write_json_string(FILE *file, const char *str)
+{
+  fputc('"', file);
+  for (const char *c = str; *c; ++c) {
+    if (*c == '"' || *c == '\\') {
+      fputc('\\', file);
+      fputc(*c, file);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      fprintf(file, "\\u%04x", (unsigned char)*c);
+    }
+    else {
+      fputc(*c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+}  // namespace
+
+std::atomic<bool> CM_Profiler::m_enabled(false);
+
+void CM_Profiler::Start()
+{
+  m_enabled.store(true);
+}
+
+void CM_Profiler::Stop()
+{
+  m_enabled.store(false);
+}
+
+void CM_Profiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+  for (std::unique_ptr<ThreadBuffer> &buffer : buffers) {
+    buffer->lock.Lock();
+    buffer->next = 0;
+    buffer->full = false;
+    buffer->lock.Unlock();
+  }
+}
+
+void CM_Profiler::SetThreadName(const std::string &name)
+{
+  ThreadBuffer *buffer = get_thread_buffer();
+  buffer->lock.Lock();
+  buffer->name = name;
+  buffer->lock.Unlock();
+}
+
+long long CM_Profiler::GetTime()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              start_time)
+      .count();
+}
+
+void CM_Profiler::CopyDetail(char *buffer, const char *detail)
+{
+  if (detail) {
+    strncpy(buffer, detail, DETAIL_SIZE - 1);
+    buffer[DETAIL_SIZE - 1] = '\0';
+  }
+  else {
+    buffer[0] = '\0';
+  }
+}
+
+void CM_Profiler::AddZone(const char *name, const char *detail, long long start, long long end)
+{
+  ThreadBuffer *buffer = get_thread_buffer();
+
+  buffer->lock.Lock();
+  if (buffer->zones.empty()) {
+    buffer->zones.resize(RING_SIZE);
+  }
+
+  Zone &zone = buffer->zones[buffer->next];
+  zone.name = name;
+  CopyDetail(zone.detail, detail);
+  zone.start = start;
+  zone.duration = end - start;
+
+  if (++buffer->next == RING_SIZE) {
+    buffer->next = 0;
+    buffer->full = true;
+  }
+  buffer->lock.Unlock();
+}
+
+void CM_Profiler::BeginZone(const char *name)
+{
+  if (zone_depth < zone_stack_size) {
+    OpenZone &zone = zone_stack[zone_depth];
+    zone.name = name;
+    zone.start = IsEnabled() ? GetTime() : -1;
+  }
+  ++zone_depth;
+}
+
+void CM_Profiler::EndZone()
+{
+  if (zone_depth == 0) {
+    return;
+  }
+
+  --zone_depth;
+  if (zone_depth < zone_stack_size) {
+    const OpenZone &zone = zone_stack[zone_depth];
+    if (zone.start != -1) {
+      AddZone(zone.name, nullptr, zone.start, GetTime());
+    }
+  }
+}
+
+bool CM_Profiler::WriteChromeTrace(const std::string &path)
+{
+  FILE *file = fopen(path.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+  bool first = true;
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+  for (std::unique_ptr<ThreadBuffer> &buffer : buffers) {
+    buffer->lock.Lock();
+
+    fprintf(file,
+            "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+            first ? "" : ",\n",
+            buffer->id);
+    write_json_string(file, buffer->name.c_str());
+    fprintf(file, "}}");
+    first = false;
+
+    // Write the zones from the oldest.
+    const unsigned int count = buffer->full ? RING_SIZE : buffer->next;
+    const unsigned int begin = buffer->full ? buffer->next : 0;
+    for (unsigned int i = 0; i < count; ++i) {
+      const Zone &zone = buffer->zones[(begin + i) % RING_SIZE];
+      fprintf(file, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"name\":", buffer->id);
+      write_json_string(file, zone.name);
+      fprintf(file, ",\"ts\":%.3f,\"dur\":%.3f", zone.start * 1e-3, zone.duration * 1e-3);
+      if (zone.detail[0] != '\0') {
+        fprintf(file, ",\"args\":{\"detail\":");
+        write_json_string(file, zone.detail);
+        fprintf(file, "}");
+      }
+      fprintf(file, "}");
+    }
+
+    buffer->lock.Unlock();
+  }
+
+  fprintf(file, "\n]}\n");
+
+  return (fclose(file) == 0);
+}
@@ -0,0 +1,106 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file CM_Profiler.h
+ *  \ingroup common
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+/**
+ * Scoped zones profiler exported as a Chrome trace (chrome://tracing or Perfetto).
+ *
+ * Each thread records its zones in its own ring buffer, the oldest zones are overwritten
+ * once the buffer is full. When the profiler is stopped a zone only costs a test of an
+ * atomic flag.
+ */
+class CM_Profiler {
+ public:
+  /// Number of zones kept per thread.
+  static const unsigned int RING_SIZE = 1 << 16;
+  /// Maximum length of the detail of a zone, longer details are truncated.
+  static const unsigned int DETAIL_SIZE = 48;
+
+  struct Zone {
+    /// Static name of the zone.
+    const char *name;
+    char detail[DETAIL_SIZE];
+    long long start;
+    long long duration;
+  };
+
+ private:
+  static std::atomic<bool> m_enabled;
+
+ public:
+  static inline bool IsEnabled()
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /// Start recording, the zones previously recorded are kept.
+  static void Start();
+  static void Stop();
+  /// Remove the recorded zones of all threads.
+  static void Clear();
+
+  /// Name the current thread in the trace.
+  static void SetThreadName(const std::string &name);
+
+  /// Current time of the profiler clock in nanoseconds.
+  static long long GetTime();
+  /// Copy a zone detail in a buffer of DETAIL_SIZE, detail can be nullptr.
+  static void CopyDetail(char *buffer, const char *detail);
+  /// Record a zone of the current thread.
+  static void AddZone(const char *name, const char *detail, long long start, long long end);
+
+  /** Begin a zone of the current thread ended by the next call to EndZone, used by the
+   * libraries reporting their zones with enter and leave callbacks.
+   */
+  static void BeginZone(const char *name);
+  static void EndZone();
+
+  /** Write the recorded zones in the Chrome trace event JSON format.
+   * \return False if the file can't be written.
+   */
+  static bool WriteChromeTrace(const std::string &path);
+};
+
+/// Record the time spent in the scope of this object.
+class CM_ProfileZone {
+ private:
+  const char *m_name;
+  long long m_start;
+  char m_detail[CM_Profiler::DETAIL_SIZE];
+
+ public:
+  /** \param name Static name of the zone.
+   * \param detail Optional string describing the zone (e.g the object name), copied.
+   */
+  inline CM_ProfileZone(const char *name, const char *detail = nullptr)
+      : m_name(name), m_start(-1)
+  {
+    if (CM_Profiler::IsEnabled()) {
+      CM_Profiler::CopyDetail(m_detail, detail);
+      m_start = CM_Profiler::GetTime();
+    }
+  }
+
+  inline ~CM_ProfileZone()
+  {
+    if (m_start != -1) {
+      CM_Profiler::AddZone(m_name, m_detail, m_start, CM_Profiler::GetTime());
+    }
+  }
+};
+
+#define _CM_PROFILE_CONCAT(a, b) a##b
+#define _CM_PROFILE_NAME(line) _CM_PROFILE_CONCAT(_cm_profile_zone_, line)
+
+/// Profile the current scope.
+#define CM_PROFILE_ZONE(name) CM_ProfileZone _CM_PROFILE_NAME(__LINE__)(name)
+/// Profile the current scope with a detail string (const char *), only evaluated when enabled.
+#define CM_PROFILE_ZONE_DETAIL(name, detail) \
+  CM_ProfileZone _CM_PROFILE_NAME(__LINE__)(name, CM_Profiler::IsEnabled() ? (detail) : nullptr)
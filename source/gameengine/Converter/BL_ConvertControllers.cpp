@@ -138,6 +138,7 @@ void BL_ConvertControllers(struct Object *blenderobject,
               MEM_freeN(buf);
             }
           }
+          pyctrl->SetPersistentNamespace(pycont->flag & CONT_PY_PERSISTENT);
         }
         else {
           /* let the controller print any warnings here when importing */
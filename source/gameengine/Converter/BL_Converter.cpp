@@ -35,6 +35,9 @@
 
 #include "BL_Converter.h"
 
+#include <algorithm>
+#include <cfloat>
+
 #include "BKE_context.hh"
 #include "BKE_idtype.hh"
 #include "BKE_lib_id.hh"
@@ -45,6 +48,7 @@
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
 #include "BLI_task.h"
+#include "BLI_time.h"
 #include "BLO_readfile.hh"
 #include "DNA_material_types.h"
 #include "DNA_mesh_types.h"
@@ -52,10 +56,12 @@
 
 #include "BL_DataConversion.h"
 #include "BL_SceneConverter.h"
+#include "CM_Profiler.h"
 #include "DummyPhysicsEnvironment.h"
 #include "EXP_StringValue.h"
 #include "KX_GameObject.h"
 #include "KX_LibLoadStatus.h"
+#include "KX_ObjectPool.h"
 #include "KX_PythonInit.h"  // So we can handle adding new text datablocks for Python to import
 #include "LA_SystemCommandLine.h"
 #include "RAS_BucketManager.h"
@@ -103,7 +109,7 @@ void BL_Converter::SceneSlot::Merge(const BL_SceneConverter *converter)
 }
 
 BL_Converter::BL_Converter(Main *maggie, KX_KetsjiEngine *engine)
-    : m_maggie(maggie), m_ketsjiEngine(engine), m_alwaysUseExpandFraming(false)
+    : m_mergeBudget(0.0), m_maggie(maggie), m_ketsjiEngine(engine), m_alwaysUseExpandFraming(false)
 {
   BKE_main_id_tag_all(maggie, ID_TAG_DOIT, false);  // avoid re-tagging later on
   m_threadinfo.m_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
@@ -241,6 +247,19 @@ void BL_Converter::RemoveScene(KX_Scene *scene)
    * e.g the display array bucket owned by the meshes and needed to be unregistered
    * from the bucket manager in the scene.
    */
+  /* The merge jobs keep the scene they merge into across frames, finish them before the scene
+   * is freed. The converted scenes are freed by the merge. */
+  QueueMergeJobs();
+  for (std::vector<MergeJob>::iterator it = m_mergejobs.begin(); it != m_mergejobs.end();) {
+    if (it->m_status->GetMergeScene() == scene) {
+      MergeJobStep(*it, DBL_MAX);
+      it = m_mergejobs.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
   SceneSlot &sceneSlot = m_sceneSlots[scene];
   sceneSlot.m_meshobjects.clear();
 
@@ -294,32 +313,91 @@ Main *BL_Converter::GetMainDynamicPath(const std::string &path) const
   return nullptr;
 }
 
+/// Name of the stages of KX_Scene::MergeState reported by the load status.
+static const char *merge_stage_names[] = {"merging",
+                                          "merging objects",
+                                          "merging inactive objects",
+                                          "merging physics",
+                                          "merging lists",
+                                          "merging logic",
+                                          "merged",
+                                          "merge failed"};
+
 void BL_Converter::MergeAsyncLoads()
 {
-  std::vector<KX_Scene *> *merge_scenes;
-
-  std::vector<KX_LibLoadStatus *>::iterator mit;
-  std::vector<KX_Scene *>::iterator sit;
+  MergeAsyncLoadsUntil((m_mergeBudget > 0.0) ? BLI_time_now_seconds() + m_mergeBudget : DBL_MAX);
+}
 
+void BL_Converter::QueueMergeJobs()
+{
   m_threadinfo.m_mutex.Lock();
+  for (KX_LibLoadStatus *status : m_mergequeue) {
+    m_mergejobs.push_back({status, 0, KX_Scene::MergeState()});
+  }
+  m_mergequeue.clear();
+  m_threadinfo.m_mutex.Unlock();
+}
 
-  for (mit = m_mergequeue.begin(); mit != m_mergequeue.end(); ++mit) {
-    merge_scenes = (std::vector<KX_Scene *> *)(*mit)->GetData();
-
-    for (sit = merge_scenes->begin(); sit != merge_scenes->end(); ++sit) {
-      (*mit)->GetMergeScene()->MergeScene(*sit);
-      delete (*sit);
+bool BL_Converter::MergeJobStep(MergeJob &job, double endtime)
+{
+  KX_LibLoadStatus *status = job.m_status;
+  std::vector<KX_Scene *> *merge_scenes = (std::vector<KX_Scene *> *)status->GetData();
+
+  while (job.m_sceneIndex < merge_scenes->size()) {
+    KX_Scene *scene = (*merge_scenes)[job.m_sceneIndex];
+    const bool merged = status->GetMergeScene()->MergeSceneStep(scene, job.m_state, endtime);
+
+    // We'll call conversion 90% and merging 10% for now.
+    const float sceneProgress = (float)job.m_state.stage / KX_Scene::MergeState::MERGE_FINISHED;
+    status->SetStage(merge_stage_names[job.m_state.stage]);
+    status->SetProgress(0.9f +
+                        0.1f * (job.m_sceneIndex + std::min(sceneProgress, 1.0f)) /
+                            merge_scenes->size());
+
+    if (!merged) {
+      // Out of time, continue at the next call.
+      return false;
     }
 
-    delete merge_scenes;
-    (*mit)->SetData(nullptr);
+    delete scene;
+    ++job.m_sceneIndex;
+    job.m_state = KX_Scene::MergeState();
 
-    (*mit)->Finish();
+    if (BLI_time_now_seconds() >= endtime) {
+      return false;
+    }
   }
 
-  m_mergequeue.clear();
+  delete merge_scenes;
+  status->SetData(nullptr);
+  status->Finish();
 
-  m_threadinfo.m_mutex.Unlock();
+  return true;
+}
+
+void BL_Converter::MergeAsyncLoadsUntil(double endtime)
+{
+  CM_PROFILE_ZONE("MergeAsyncLoads");
+
+  QueueMergeJobs();
+
+  // Higher priorities first, the loading order is kept for equal priorities.
+  std::stable_sort(m_mergejobs.begin(),
+                   m_mergejobs.end(),
+                   [](const MergeJob &job1, const MergeJob &job2) {
+                     return job1.m_status->GetPriority() > job2.m_status->GetPriority();
+                   });
+
+  while (!m_mergejobs.empty()) {
+    if (!MergeJobStep(m_mergejobs.front(), endtime)) {
+      return;
+    }
+    m_mergejobs.erase(m_mergejobs.begin());
+
+    if (BLI_time_now_seconds() >= endtime) {
+      return;
+    }
+  }
 }
 
 void BL_Converter::FinalizeAsyncLoads()
@@ -327,7 +405,7 @@ void BL_Converter::FinalizeAsyncLoads()
   // Finish all loading libraries.
   BLI_task_pool_work_and_wait(m_threadinfo.m_pool);
   // Merge all libraries data in the current scene, to avoid memory leak of unmerged scenes.
-  MergeAsyncLoads();
+  MergeAsyncLoadsUntil(DBL_MAX);
 }
 
 void BL_Converter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
@@ -337,6 +415,16 @@ void BL_Converter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
   m_threadinfo.m_mutex.Unlock();
 }
 
+void BL_Converter::SetMergeBudget(double budget)
+{
+  m_mergeBudget = std::max(budget, 0.0);
+}
+
+double BL_Converter::GetMergeBudget() const
+{
+  return m_mergeBudget;
+}
+
 static void async_convert(TaskPool *pool, void *ptr, int /*threadid*/)
 {
   KX_Scene *new_scene = nullptr;
@@ -612,6 +700,9 @@ bool BL_Converter::FreeBlendFile(Main *maggie)
       numScenes--;
     }
     else {
+      // The pooled copies of the freed objects must not be used by the next replicas.
+      scene->GetObjectPool()->ClearTagged();
+
       // in case the mesh might be refered to later
       std::map<std::string, void *> &mapStringToMeshes = scene->GetLogicManager()->GetMeshMap();
       for (std::map<std::string, void *>::iterator it = mapStringToMeshes.begin(),
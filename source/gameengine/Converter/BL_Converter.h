@@ -38,6 +38,7 @@
 #include "CM_Thread.h"
 #include "EXP_ListValue.h"
 #include "KX_BlenderMaterial.h"
+#include "KX_Scene.h"
 #include "RAS_MeshObject.h"
 
 class EXP_StringValue;
@@ -85,9 +86,28 @@ class BL_Converter {
   std::map<std::string, KX_LibLoadStatus *> m_status_map;
   std::vector<KX_LibLoadStatus *> m_mergequeue;
 
+  /// An async load merged over several calls of MergeAsyncLoads.
+  struct MergeJob {
+    KX_LibLoadStatus *m_status;
+    /// Index of the converted scene being merged.
+    unsigned int m_sceneIndex;
+    KX_Scene::MergeState m_state;
+  };
+  /// The async loads being merged, only used by the main thread.
+  std::vector<MergeJob> m_mergejobs;
+  /// Time in seconds spent at most merging async loads per call to MergeAsyncLoads, 0 for no limit.
+  double m_mergeBudget;
+
   Main *m_maggie;
   std::vector<Main *> m_DynamicMaggie;
 
+  /// Move the async loads converted by the threads to the merge jobs.
+  void QueueMergeJobs();
+  /// Merge a job until the time endtime is reached, return true when the job is finished.
+  bool MergeJobStep(MergeJob &job, double endtime);
+  /// Merge the async loads until the time endtime (BLI_time_now_seconds) is reached.
+  void MergeAsyncLoadsUntil(double endtime);
+
   KX_KetsjiEngine *m_ketsjiEngine;
   bool m_alwaysUseExpandFraming;
 
@@ -143,10 +163,14 @@ class BL_Converter {
 
   void MergeScene(KX_Scene *to, KX_Scene *from);
 
+  /// Merge the converted async loads by priority, within the merge time budget.
   void MergeAsyncLoads();
   void FinalizeAsyncLoads();
   void AddScenesToMergeQueue(KX_LibLoadStatus *status);
 
+  void SetMergeBudget(double budget);
+  double GetMergeBudget() const;
+
   void PrintStats();
 
   // LibLoad Options.
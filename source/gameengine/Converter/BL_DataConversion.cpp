@@ -80,6 +80,7 @@
 
 #include "BL_ArmatureObject.h"
 #include "BL_SceneConverter.h"
+#include "CM_Profiler.h"
 #include "BL_ConvertActuators.h"
 #include "BL_ConvertControllers.h"
 #include "BL_ConvertProperties.h"
@@ -97,6 +98,7 @@
 #include "KX_NodeRelationships.h"
 #include "KX_ObstacleSimulation.h"
 #include "KX_PythonComponent.h"
+#include "PHY_IGraphicController.h"
 #include "RAS_ICanvas.h"
 #include "RAS_Vertex.h"
 #ifdef WITH_BULLET
@@ -356,6 +358,8 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
                                bool libloading,
                                bool converting_during_runtime)
 {
+  CM_PROFILE_ZONE_DETAIL("ConvertMesh", mesh->id.name + 2);
+
   RAS_MeshObject *meshobj;
   int lightlayer = blenderobj ? blenderobj->lay : (1 << 20) - 1;  // all layers if no object.
 
@@ -1141,7 +1145,8 @@ static void bl_ConvertBlenderObject_Single(BL_SceneConverter *converter,
                           nullptr,
                           nullptr,
                           KX_Scene::KX_ScenegraphUpdateFunc,
-                          KX_Scene::KX_ScenegraphRescheduleFunc);
+                          KX_Scene::KX_ScenegraphRescheduleFunc,
+                          nullptr);
     SG_Node *parentinversenode = new SG_Node(nullptr, kxscene, callback);
 
     // Define a normal parent relationship for this node.
@@ -1199,6 +1204,7 @@ static void bl_ConvertBlenderObject_Single(BL_SceneConverter *converter,
 
   if (isInActiveLayer) {
     objectlist->Add(CM_AddRef(gameobj));
+    kxscene->ActivateDirtyObject(gameobj);
     // tf.Add(gameobj->GetSGNode());
 
     gameobj->NodeUpdateGS(0);
@@ -1223,6 +1229,7 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
                               bool alwaysUseExpandFraming,
                               bool libloading)
 {
+  CM_PROFILE_ZONE_DETAIL("ConvertBlenderObjects", kxscene->GetName().c_str());
 
 #define BL_CONVERTBLENDEROBJECT_SINGLE \
   bl_ConvertBlenderObject_Single(converter, \
@@ -1289,15 +1296,17 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
 
     /* set activity culling parameters */
     kxscene->SetActivityCulling((blenderscene->gm.mode & WO_ACTIVITY_CULLING) != 0);
-    kxscene->SetDbvtCulling(false);
+    kxscene->SetDbvtCulling((blenderscene->gm.mode & WO_DBVT_CULLING) != 0);
 
-    // no occlusion culling by default
+    // no occlusion culling until an occluder is converted
     kxscene->SetDbvtOcclusionRes(0);
 
     if (blenderscene->gm.lodflag & SCE_LOD_USE_HYST) {
       kxscene->SetLodHysteresis(true);
       kxscene->SetLodHysteresisValue(blenderscene->gm.scehysteresis);
     }
+    kxscene->SetLodScreenSize((blenderscene->gm.lodflag & SCE_LOD_USE_SCREEN_SIZE) != 0);
+    kxscene->SetLodMaxSwaps(blenderscene->gm.lodmaxswaps);
   }
 
   int activeLayerBitInfo = blenderscene->lay;
@@ -1611,6 +1620,49 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
           gameobj, blenderobject, meshobj, kxscene, layerMask, converter, processCompoundChildren);
     }
   }
+  // Build in parallel the collision shapes work deferred by the physics conversion.
+  kxscene->GetPhysicsEnvironment()->EndConversion();
+
+  // Register the bounding box of the rendered objects in the culling tree.
+  if (kxscene->GetDbvtCulling()) {
+    PHY_IPhysicsEnvironment *physEnv = kxscene->GetPhysicsEnvironment();
+    for (KX_GameObject *gameobj : sumolist) {
+      Object *blenderobject = gameobj->GetBlenderObject();
+      if (single_object && !converting_instance_col_at_runtime) {
+        if (blenderobject != single_object) {
+          continue;
+        }
+      }
+
+      if (gameobj->GetOccluder()) {
+        kxscene->SetDbvtOcclusionRes(blenderscene->gm.occlusionRes);
+      }
+
+      if (!gameobj->UseCulling() || gameobj->GetGraphicController()) {
+        continue;
+      }
+
+      gameobj->UpdateBounds();
+
+      PHY_IMotionState *motionstate = new KX_MotionState(gameobj->GetSGNode());
+      PHY_IGraphicController *ctrl = physEnv->CreateGraphicController(motionstate);
+      if (!ctrl) {
+        delete motionstate;
+        continue;
+      }
+
+      ctrl->SetNewClientInfo(gameobj->getClientInfo());
+      const SG_BBox &aabb = gameobj->GetCullingNode().GetAabb();
+      ctrl->SetLocalAabb(aabb.GetMin(), aabb.GetMax());
+      gameobj->SetGraphicController(ctrl);
+
+      const int layerMask = (groupobj.find(blenderobject) == groupobj.end()) ? activeLayerBitInfo :
+                                                                                0;
+      if ((blenderobject->lay & layerMask) != 0) {
+        ctrl->Activate(true);
+      }
+    }
+  }
 
   // create physics joints
   for (KX_GameObject *gameobj : sumolist) {
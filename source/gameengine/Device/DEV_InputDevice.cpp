@@ -193,6 +193,9 @@ void DEV_InputDevice::ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type,
 
   if (event.m_values[event.m_values.size() - 1] != val) {
     // The key event value changed, we considerate it as the real event.
+    if (event.m_queue.empty()) {
+      m_changedInputs.push_back(type);
+    }
     event.m_status.push_back((val > 0) ? SCA_InputEvent::ACTIVE : SCA_InputEvent::NONE);
     event.m_queue.push_back((val > 0) ? SCA_InputEvent::JUSTACTIVATED :
                                         SCA_InputEvent::JUSTRELEASED);
@@ -211,6 +214,9 @@ void DEV_InputDevice::ConvertMoveEvent(int x, int y)
   SCA_InputEvent &xevent = m_inputsTable[MOUSEX];
   xevent.m_values.push_back(x);
   if (xevent.m_status[xevent.m_status.size() - 1] != SCA_InputEvent::ACTIVE) {
+    if (xevent.m_queue.empty()) {
+      m_changedInputs.push_back(MOUSEX);
+    }
     xevent.m_status.push_back(SCA_InputEvent::ACTIVE);
     xevent.m_queue.push_back(SCA_InputEvent::JUSTACTIVATED);
   }
@@ -218,6 +224,9 @@ void DEV_InputDevice::ConvertMoveEvent(int x, int y)
   SCA_InputEvent &yevent = m_inputsTable[MOUSEY];
   yevent.m_values.push_back(y);
   if (yevent.m_status[yevent.m_status.size() - 1] != SCA_InputEvent::ACTIVE) {
+    if (yevent.m_queue.empty()) {
+      m_changedInputs.push_back(MOUSEY);
+    }
     yevent.m_status.push_back(SCA_InputEvent::ACTIVE);
     yevent.m_queue.push_back(SCA_InputEvent::JUSTACTIVATED);
   }
@@ -225,9 +234,13 @@ void DEV_InputDevice::ConvertMoveEvent(int x, int y)
 
 void DEV_InputDevice::ConvertWheelEvent(int z)
 {
-  SCA_InputEvent &event = m_inputsTable[(z > 0) ? WHEELUPMOUSE : WHEELDOWNMOUSE];
+  const SCA_EnumInputs type = (z > 0) ? WHEELUPMOUSE : WHEELDOWNMOUSE;
+  SCA_InputEvent &event = m_inputsTable[type];
   event.m_values.push_back(z);
   if (event.m_status[event.m_status.size() - 1] != SCA_InputEvent::ACTIVE) {
+    if (event.m_queue.empty()) {
+      m_changedInputs.push_back(type);
+    }
     event.m_status.push_back(SCA_InputEvent::ACTIVE);
     event.m_queue.push_back(SCA_InputEvent::JUSTACTIVATED);
   }
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file EXP_PropertyName.h
+ *  \ingroup expressions
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * Interned property name, the names are registered once in a global table and
+ * compared as integers. A name created from a string is resolved at conversion or
+ * construction time so that the property accesses don't compare strings.
+ */
+class EXP_PropertyName {
+ private:
+  /// Index of the name in the global table, -1 for an invalid name.
+  int m_index;
+
+  explicit EXP_PropertyName(int index);
+
+ public:
+  /// Create an invalid name matching no property.
+  EXP_PropertyName();
+  /// Return the name registered for this string, registering it if needed.
+  explicit EXP_PropertyName(const std::string &name);
+
+  /** Return the name registered for this string or an invalid name if the
+   * string was never registered, in which case no property can use it.
+   */
+  static EXP_PropertyName Find(const std::string &name);
+
+  bool IsValid() const
+  {
+    return m_index != -1;
+  }
+
+  /// Return the string of the name, an empty string for an invalid name.
+  const std::string &GetString() const;
+
+  bool operator==(const EXP_PropertyName &other) const
+  {
+    return m_index == other.m_index;
+  }
+
+  bool operator!=(const EXP_PropertyName &other) const
+  {
+    return m_index != other.m_index;
+  }
+
+  /// Order of registration, used to sort the properties.
+  bool operator<(const EXP_PropertyName &other) const
+  {
+    return m_index < other.m_index;
+  }
+};
@@ -22,11 +22,12 @@
 #  pragma warning(disable : 4786)
 #endif
 
-#include <map>     // Array functionality for the property list.
+#include <map>
 #include <string>  // std::string class.
 #include <vector>
 
 #include "CM_RefCount.h"
+#include "EXP_PropertyName.h"
 
 #ifndef GEN_NO_TRACE
 #  undef trace
@@ -125,6 +126,9 @@ class EXP_Value : public EXP_PyObjectPlus, public CM_RefCount<EXP_Value> {
   /// needed.
   virtual void SetProperty(const std::string &name, EXP_Value *ioProperty);
   virtual EXP_Value *GetProperty(const std::string &inName);
+  /// Set and get a property from a name resolved in advance, without string comparison.
+  void SetProperty(const EXP_PropertyName &name, EXP_Value *ioProperty);
+  EXP_Value *GetProperty(const EXP_PropertyName &name) const;
   /// Get text description of property with name <inName>, returns an empty string if there is no
   /// property named <inName>.
   const std::string GetPropertyText(const std::string &inName);
@@ -132,6 +136,8 @@ class EXP_Value : public EXP_PyObjectPlus, public CM_RefCount<EXP_Value> {
   /// Remove the property named <inName>, returns true if the property was succesfully removed,
   /// false if property was not found or could not be removed.
   virtual bool RemoveProperty(const std::string &inName);
+  bool RemoveProperty(const EXP_PropertyName &name);
+  /// Return the property names sorted alphabetically.
   virtual std::vector<std::string> GetPropertyNames();
   /// Clear all properties.
   virtual void ClearProperties();
@@ -163,12 +169,33 @@ class EXP_Value : public EXP_PyObjectPlus, public CM_RefCount<EXP_Value> {
 
   virtual bool IsError() const;
 
+  /** Return a counter incremented at each write of the value or of its properties list,
+   * used to skip the checks of unchanged values (e.g by the property sensors).
+   */
+  unsigned int GetRevision() const
+  {
+    return m_revision;
+  }
+
  protected:
   virtual void DestructFromPython();
 
+  /// Notify a write of the value, called by the setters of the derived classes.
+  void IncreaseRevision()
+  {
+    ++m_revision;
+  }
+
  private:
-  /// Properties for user/game etc.
-  std::map<std::string, EXP_Value *> m_properties;
+  using PropertyItem = std::pair<EXP_PropertyName, EXP_Value *>;
+
+  /// Return the first property with a name not ordered before name.
+  std::vector<PropertyItem>::iterator LowerBoundProperty(const EXP_PropertyName &name);
+
+  /// Properties for user/game etc, sorted by name registration order.
+  std::vector<PropertyItem> m_properties;
+  /// Number of writes of the value and of its properties list.
+  unsigned int m_revision;
 };
 
 /** EXP_PropValue is a EXP_Value derived class, that implements the identification (String name)
@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Expressions/PropertyName.cpp
+ *  \ingroup expressions
+ */
+
+#include "EXP_PropertyName.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+/// Names registered by all the objects, the names are never removed.
+struct PropertyNameTable {
+  /// Protect the table as the conversion can run in several threads.
+  std::mutex mutex;
+  std::unordered_map<std::string, int> indices;
+  /// The strings in order of registration, a deque to not move them.
+  std::deque<std::string> strings;
+};
+
+}  // namespace
+
+static PropertyNameTable &property_name_table()
+{
+  // Constructed at first use to be usable from static initializations.
+  static PropertyNameTable table;
+  return table;
+}
+
+EXP_PropertyName::EXP_PropertyName(int index) : m_index(index)
+{
+}
+
+EXP_PropertyName::EXP_PropertyName() : m_index(-1)
+{
+}
+
+EXP_PropertyName::EXP_PropertyName(const std::string &name)
+{
+  PropertyNameTable &table = property_name_table();
+  std::lock_guard<std::mutex> lock(table.mutex);
+
+  const auto it = table.indices.find(name);
+  if (it != table.indices.end()) {
+    m_index = it->second;
+    return;
+  }
+
+  m_index = table.strings.size();
+  table.strings.push_back(name);
+  table.indices.emplace(name, m_index);
+}
+
+EXP_PropertyName EXP_PropertyName::Find(const std::string &name)
+{
+  PropertyNameTable &table = property_name_table();
+  std::lock_guard<std::mutex> lock(table.mutex);
+
+  const auto it = table.indices.find(name);
+  if (it == table.indices.end()) {
+    return EXP_PropertyName();
+  }
+
+  return EXP_PropertyName(it->second);
+}
+
+const std::string &EXP_PropertyName::GetString() const
+{
+  static const std::string empty;
+  if (m_index == -1) {
+    return empty;
+  }
+
+  PropertyNameTable &table = property_name_table();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  return table.strings[m_index];
+}
@@ -18,6 +18,7 @@
  *
  */
 
+#include <algorithm>
 
 #include "EXP_BoolValue.h"
 #include "EXP_ErrorValue.h"
@@ -70,7 +71,7 @@ PyMethodDef EXP_Value::Methods[] = {
 };
 #endif  // WITH_PYTHON
 
-EXP_Value::EXP_Value()
+EXP_Value::EXP_Value() : m_revision(0)
 {
 }
 
@@ -146,6 +147,22 @@ std::string EXP_Value::op2str(VALUE_OPERATOR op)
 /// Set property <ioProperty>, overwrites and releases a previous property with the same name if
 /// needed.
 void EXP_Value::SetProperty(const std::string &name, EXP_Value *ioProperty)
+{
+  SetProperty(EXP_PropertyName(name), ioProperty);
+}
+
+std::vector<EXP_Value::PropertyItem>::iterator EXP_Value::LowerBoundProperty(
+    const EXP_PropertyName &name)
+{
+  return std::lower_bound(m_properties.begin(),
+                          m_properties.end(),
+                          name,
+                          [](const PropertyItem &item, const EXP_PropertyName &name) {
+                            return item.first < name;
+                          });
+}
+
+void EXP_Value::SetProperty(const EXP_PropertyName &name, EXP_Value *ioProperty)
 {
   // Check if somebody is setting an empty property.
   if (ioProperty == nullptr) {
@@ -154,21 +171,38 @@ void EXP_Value::SetProperty(const std::string &name, EXP_Value *ioProperty)
   }
 
   // Try to replace property (if so -> exit as soon as we replaced it).
-  EXP_Value *oldval = m_properties[name];
-  if (oldval) {
-    oldval->Release();
+  std::vector<PropertyItem>::iterator it = LowerBoundProperty(name);
+  IncreaseRevision();
+  if (it != m_properties.end() && it->first == name) {
+    it->second->Release();
+    it->second = ioProperty->AddRef();
+    return;
   }
 
-  // Add property at end of array.
-  m_properties[name] = ioProperty->AddRef();
+  // Insert the property at its sorted position.
+  m_properties.emplace(it, name, ioProperty->AddRef());
 }
 
 /// Get pointer to a property with name <inName>, returns nullptr if there is no property named
 /// <inName>.
 EXP_Value *EXP_Value::GetProperty(const std::string &inName)
 {
-  std::map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
-  if (it != m_properties.end()) {
+  // A name never registered is not used by any property.
+  return GetProperty(EXP_PropertyName::Find(inName));
+}
+
+EXP_Value *EXP_Value::GetProperty(const EXP_PropertyName &name) const
+{
+  if (!name.IsValid()) {
+    return nullptr;
+  }
+
+  const std::vector<PropertyItem>::const_iterator it = std::lower_bound(
+      m_properties.begin(),
+      m_properties.end(),
+      name,
+      [](const PropertyItem &item, const EXP_PropertyName &name) { return item.first < name; });
+  if (it != m_properties.end() && it->first == name) {
     return it->second;
   }
   return nullptr;
@@ -202,10 +236,20 @@ float EXP_Value::GetPropertyNumber(const std::string &inName, float defnumber)
 /// if property was not found or could not be removed.
 bool EXP_Value::RemoveProperty(const std::string &inName)
 {
-  std::map<std::string, EXP_Value *>::iterator it = m_properties.find(inName);
-  if (it != m_properties.end()) {
-    (*it).second->Release();
+  return RemoveProperty(EXP_PropertyName::Find(inName));
+}
+
+bool EXP_Value::RemoveProperty(const EXP_PropertyName &name)
+{
+  if (!name.IsValid()) {
+    return false;
+  }
+
+  std::vector<PropertyItem>::iterator it = LowerBoundProperty(name);
+  if (it != m_properties.end() && it->first == name) {
+    it->second->Release();
     m_properties.erase(it);
+    IncreaseRevision();
     return true;
   }
 
@@ -215,13 +259,13 @@ bool EXP_Value::RemoveProperty(const std::string &inName)
 /// Get Property Names.
 std::vector<std::string> EXP_Value::GetPropertyNames()
 {
-  const unsigned short size = m_properties.size();
-  std::vector<std::string> result(size);
-
-  unsigned short i = 0;
-  for (const auto &pair : m_properties) {
-    result[i++] = pair.first;
+  std::vector<std::string> result;
+  result.reserve(m_properties.size());
+  for (const PropertyItem &item : m_properties) {
+    result.push_back(item.first.GetString());
   }
+
+  std::sort(result.begin(), result.end());
   return result;
 }
 
@@ -229,25 +273,22 @@ std::vector<std::string> EXP_Value::GetPropertyNames()
 void EXP_Value::ClearProperties()
 {
   // Remove all properties.
-  for (const auto &pair : m_properties) {
-    pair.second->Release();
+  for (const PropertyItem &item : m_properties) {
+    item.second->Release();
   }
 
   // Delete property array.
   m_properties.clear();
+  IncreaseRevision();
 }
 
 /// Get property number <inIndex>.
 EXP_Value *EXP_Value::GetProperty(int inIndex)
 {
-  int count = 0;
-
-  for (const auto &pair : m_properties) {
-    if (count++ == inIndex) {
-      return pair.second;
-    }
+  if (inIndex < 0 || inIndex >= (int)m_properties.size()) {
+    return nullptr;
   }
-  return nullptr;
+  return m_properties[inIndex].second;
 }
 
 /// Get the amount of properties assiocated with this value.
@@ -270,9 +311,10 @@ void EXP_Value::ProcessReplica()
   EXP_PyObjectPlus::ProcessReplica();
 
   // Copy all props.
-  for (auto &pair : m_properties) {
-    pair.second = pair.second->GetReplica();
+  for (PropertyItem &item : m_properties) {
+    item.second = item.second->GetReplica();
   }
+  IncreaseRevision();
 }
 
 int EXP_Value::GetValueType()
@@ -371,11 +413,12 @@ EXP_Value *EXP_Value::ConvertPythonToValue(PyObject *pyobj,
 
 PyObject *EXP_Value::ConvertKeysToPython(void)
 {
-  PyObject *pylist = PyList_New(m_properties.size());
+  const std::vector<std::string> names = GetPropertyNames();
+  PyObject *pylist = PyList_New(names.size());
 
   Py_ssize_t i = 0;
-  for (const auto &pair : m_properties) {
-    PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString(pair.first));
+  for (const std::string &name : names) {
+    PyList_SET_ITEM(pylist, i++, PyUnicode_FromStdString(name));
   }
 
   return pylist;
@@ -75,6 +75,12 @@ bool SCA_AlwaysSensor::IsPositiveTrigger()
   return (m_invert ? false : true);
 }
 
+bool SCA_AlwaysSensor::InputsChanged()
+{
+  // Only the first evaluation can trigger the controllers.
+  return m_alwaysresult;
+}
+
 bool SCA_AlwaysSensor::Evaluate()
 {
   /* Nice! :) */
@@ -45,5 +45,6 @@ class SCA_AlwaysSensor : public SCA_ISensor {
   virtual EXP_Value *GetReplica();
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
+  virtual bool InputsChanged();
   virtual void Init();
 };
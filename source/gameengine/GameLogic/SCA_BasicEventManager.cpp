@@ -48,7 +48,17 @@ SCA_BasicEventManager::~SCA_BasicEventManager()
 
 void SCA_BasicEventManager::NextFrame()
 {
+  // Skip the sensors for which nothing changed since their last activation.
   for (SCA_ISensor *sensor : m_sensors) {
-    sensor->Activate(m_logicmgr);
+    if (sensor->NeedActivation() || sensor->InputsChanged()) {
+      sensor->Activate(m_logicmgr);
+    }
+  }
+}
+
+void SCA_BasicEventManager::EndFrame()
+{
+  for (SCA_ISensor *sensor : m_sensors) {
+    sensor->EndFrame();
   }
 }
@@ -42,4 +42,5 @@ class SCA_BasicEventManager : public SCA_EventManager {
   ~SCA_BasicEventManager();
 
   virtual void NextFrame();
+  virtual void EndFrame();
 };
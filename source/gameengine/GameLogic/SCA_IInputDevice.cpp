@@ -141,6 +141,7 @@ void SCA_IInputDevice::ClearInputs()
     m_inputsTable[i].Clear();
   }
   m_text.clear();
+  m_changedInputs.clear();
 }
 
 void SCA_IInputDevice::ReleaseMoveEvent()
@@ -159,6 +160,9 @@ void SCA_IInputDevice::ReleaseMoveEvent()
         (event.m_status[event.m_status.size() - 1] == SCA_InputEvent::ACTIVE)) {
       event.m_status.pop_back();
       event.m_status.push_back(SCA_InputEvent::NONE);
+      if (event.m_queue.empty()) {
+        m_changedInputs.push_back(eventTypes[i]);
+      }
       event.m_queue.push_back(SCA_InputEvent::JUSTRELEASED);
     }
   }
@@ -169,6 +173,11 @@ const std::wstring &SCA_IInputDevice::GetText() const
   return m_text;
 }
 
+const std::vector<SCA_IInputDevice::SCA_EnumInputs> &SCA_IInputDevice::GetChangedInputs() const
+{
+  return m_changedInputs;
+}
+
 const char SCA_IInputDevice::ConvertKeyToChar(SCA_IInputDevice::SCA_EnumInputs input, bool shifted)
 {
   std::map<SCA_EnumInputs, std::pair<char, char>>::iterator it = m_keyToChar.find(input);
@@ -32,6 +32,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 
 #include "SCA_InputEvent.h"
 
@@ -209,6 +210,8 @@ class SCA_IInputDevice {
   SCA_InputEvent m_inputsTable[SCA_IInputDevice::MAX_KEYS];
   /// Typed text in unicode during a frame.
   std::wstring m_text;
+  /// Inputs which received an event since the last call to ClearInputs(), without duplicates.
+  std::vector<SCA_EnumInputs> m_changedInputs;
 
   /// True when a sensor handle the same key as the exit key.
   bool m_hookExitKey;
@@ -239,5 +242,8 @@ class SCA_IInputDevice {
   /// Return typed unicode text during a frame.
   const std::wstring &GetText() const;
 
+  /// Return the inputs which received an event during a frame.
+  const std::vector<SCA_EnumInputs> &GetChangedInputs() const;
+
   static const char ConvertKeyToChar(SCA_EnumInputs input, bool shifted);
 };
@@ -41,6 +41,8 @@
 void SCA_ISensor::ReParent(SCA_IObject *parent)
 {
   SCA_ILogicBrick::ReParent(parent);
+  // The inputs can depend on the parent (e.g properties).
+  m_wakeup = true;
 }
 
 SCA_ISensor::SCA_ISensor(SCA_IObject *gameobj, SCA_EventManager *eventmgr)
@@ -58,7 +60,8 @@ SCA_ISensor::SCA_ISensor(SCA_IObject *gameobj, SCA_EventManager *eventmgr)
       m_suspended(false),
       m_links(0),
       m_state(false),
-      m_prev_state(false)
+      m_prev_state(false),
+      m_wakeup(true)
 {
 }
 
@@ -96,6 +99,7 @@ void SCA_ISensor::SetPulseMode(bool posmode, bool negmode, int skippedticks)
 void SCA_ISensor::SetInvert(bool inv)
 {
   m_invert = inv;
+  m_wakeup = true;
 }
 
 void SCA_ISensor::SetLevel(bool lvl)
@@ -108,6 +112,11 @@ void SCA_ISensor::SetTap(bool tap)
   m_tap = tap;
 }
 
+bool SCA_ISensor::InputsChanged()
+{
+  return true;
+}
+
 double SCA_ISensor::GetNumber()
 {
   return GetState();
@@ -131,6 +140,8 @@ bool SCA_ISensor::IsSuspended()
 void SCA_ISensor::Resume()
 {
   m_suspended = false;
+  // The inputs may have changed while the sensor was suspended.
+  m_wakeup = true;
 }
 
 bool SCA_ISensor::GetState()
@@ -176,6 +187,10 @@ void SCA_ISensor::Init()
       this, "sensor " << m_name << " has no init function, please report this bug to Blender.org");
 }
 
+void SCA_ISensor::EndFrame()
+{
+}
+
 void SCA_ISensor::DecLink()
 {
   --m_links;
@@ -194,6 +209,7 @@ void SCA_ISensor::RegisterToManager()
   // sensor is just activated, initialize it
   Init();
   m_state = false;
+  m_wakeup = true;
   m_eventmgr->RegisterSensor(this);
 }
 
@@ -254,6 +270,7 @@ void SCA_ISensor::Activate(class SCA_LogicManager *logicmgr)
   /* Calculate if a __triggering__ is wanted
    * don't evaluate a sensor that is not connected to any controller
    */
+  m_wakeup = false;
   if (m_links && !m_suspended) {
     bool result = this->Evaluate();
     // store the state for the rest of the logic system
@@ -337,6 +354,7 @@ EXP_PYMETHODDEF_DOC_NOARGS(
 {
   Init();
   m_prev_state = false;
+  m_wakeup = true;
   Py_RETURN_NONE;
 }
 
@@ -390,7 +408,7 @@ PyAttributeDef SCA_ISensor::Attributes[] = {
     EXP_PYATTRIBUTE_BOOL_RW("usePosPulseMode", SCA_ISensor, m_pos_pulsemode),
     EXP_PYATTRIBUTE_BOOL_RW("useNegPulseMode", SCA_ISensor, m_neg_pulsemode),
     EXP_PYATTRIBUTE_INT_RW("skippedTicks", 0, 100000, true, SCA_ISensor, m_skipped_ticks),
-    EXP_PYATTRIBUTE_BOOL_RW("invert", SCA_ISensor, m_invert),
+    EXP_PYATTRIBUTE_BOOL_RW_CHECK("invert", SCA_ISensor, m_invert, pyattr_check_wakeup),
     EXP_PYATTRIBUTE_BOOL_RW_CHECK("level", SCA_ISensor, m_level, pyattr_check_level),
     EXP_PYATTRIBUTE_BOOL_RW_CHECK("tap", SCA_ISensor, m_tap, pyattr_check_tap),
     EXP_PYATTRIBUTE_RO_FUNCTION("triggered", SCA_ISensor, pyattr_get_triggered),
@@ -472,6 +490,14 @@ int SCA_ISensor::pyattr_check_tap(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUT
   return 0;
 }
 
+int SCA_ISensor::pyattr_check_wakeup(EXP_PyObjectPlus *self_v,
+                                     const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  SCA_ISensor *self = static_cast<SCA_ISensor *>(self_v);
+  self->WakeUp();
+  return 0;
+}
+
 PyObject *SCA_ISensor::pyattr_get_frequency(EXP_PyObjectPlus *self_v,
                                             const EXP_PYATTRIBUTE_DEF *attrdef)
 {
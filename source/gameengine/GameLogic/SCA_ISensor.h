@@ -87,6 +87,9 @@ class SCA_ISensor : public SCA_ILogicBrick {
   /// Previous state (for tap option).
   bool m_prev_state;
 
+  /// An input of the sensor or its settings changed since the last activation.
+  bool m_wakeup;
+
   std::vector<SCA_IController *> m_linkedcontrollers;
 
  public:
@@ -111,6 +114,31 @@ class SCA_ISensor : public SCA_ILogicBrick {
   virtual bool Evaluate() = 0;
   virtual bool IsPositiveTrigger();
   virtual void Init();
+  /// Release the data only valid during the logic frame, called by the event managers.
+  virtual void EndFrame();
+
+  /** Request an evaluation at the next activation, used by the event managers
+   * when an input the sensor registered interest in received an event.
+   */
+  void WakeUp()
+  {
+    m_wakeup = true;
+  }
+
+  /** Return true if the next activation can't be skipped whatever the inputs: the sensor
+   * was woken up or reset, its pulse, tap or level modes can trigger the controllers or its
+   * state changed at the last activation.
+   */
+  bool NeedActivation() const
+  {
+    return m_wakeup || m_reset || m_pos_pulsemode || m_neg_pulsemode || m_level ||
+           m_state != m_prev_state || (m_tap && m_state);
+  }
+
+  /** Return true if the inputs read by Evaluate() may have changed since the last
+   * evaluation, the sensors not tracking their inputs are evaluated at each frame.
+   */
+  virtual bool InputsChanged();
 
   virtual EXP_Value *GetReplica() = 0;
 
@@ -187,6 +215,8 @@ class SCA_ISensor : public SCA_ILogicBrick {
 
   static int pyattr_check_level(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
   static int pyattr_check_tap(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+  /// Wake up the sensor after a change of a setting used by Evaluate() or IsPositiveTrigger().
+  static int pyattr_check_wakeup(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 
   enum SensorStatus {
     KX_SENSOR_INACTIVE = 0,
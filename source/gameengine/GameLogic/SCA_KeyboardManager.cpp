@@ -37,7 +37,9 @@
 #include "SCA_KeyboardSensor.h"
 
 SCA_KeyboardManager::SCA_KeyboardManager(SCA_LogicManager *logicmgr, SCA_IInputDevice *inputdev)
-    : SCA_EventManager(logicmgr, KEYBOARD_EVENTMGR), m_inputDevice(inputdev)
+    : SCA_EventManager(logicmgr, KEYBOARD_EVENTMGR),
+      m_inputDevice(inputdev),
+      m_invalidInputSensors(false)
 {
 }
 
@@ -50,9 +52,73 @@ SCA_IInputDevice *SCA_KeyboardManager::GetInputDevice()
   return m_inputDevice;
 }
 
+bool SCA_KeyboardManager::RegisterSensor(SCA_ISensor *sensor)
+{
+  const bool registered = SCA_EventManager::RegisterSensor(sensor);
+  m_invalidInputSensors |= registered;
+  return registered;
+}
+
+bool SCA_KeyboardManager::RemoveSensor(SCA_ISensor *sensor)
+{
+  const bool removed = SCA_EventManager::RemoveSensor(sensor);
+  m_invalidInputSensors |= removed;
+  return removed;
+}
+
+void SCA_KeyboardManager::InvalidateInputSensors()
+{
+  m_invalidInputSensors = true;
+}
+
+void SCA_KeyboardManager::UpdateInputSensors()
+{
+  for (std::vector<SCA_ISensor *> &sensors : m_inputSensors) {
+    sensors.clear();
+  }
+  m_anyInputSensors.clear();
+
+  std::vector<SCA_IInputDevice::SCA_EnumInputs> inputs;
+  for (SCA_ISensor *sensor : m_sensors) {
+    SCA_KeyboardSensor *keyboardSensor = static_cast<SCA_KeyboardSensor *>(sensor);
+    if (keyboardSensor->IsWokenUpByAnyInput()) {
+      m_anyInputSensors.push_back(sensor);
+      continue;
+    }
+
+    inputs.clear();
+    keyboardSensor->GetWakeUpInputs(inputs);
+    for (const SCA_IInputDevice::SCA_EnumInputs input : inputs) {
+      m_inputSensors[input].push_back(sensor);
+    }
+  }
+
+  m_invalidInputSensors = false;
+}
+
 void SCA_KeyboardManager::NextFrame()
 {
+  if (m_invalidInputSensors) {
+    UpdateInputSensors();
+  }
+
+  // Wake up the sensors interested in the inputs which received an event.
+  const std::vector<SCA_IInputDevice::SCA_EnumInputs> &inputs = m_inputDevice->GetChangedInputs();
+  if (!inputs.empty()) {
+    for (SCA_ISensor *sensor : m_anyInputSensors) {
+      sensor->WakeUp();
+    }
+    for (const SCA_IInputDevice::SCA_EnumInputs input : inputs) {
+      for (SCA_ISensor *sensor : m_inputSensors[input]) {
+        sensor->WakeUp();
+      }
+    }
+  }
+
+  // The other sensors are not evaluated as nothing changed for them.
   for (SCA_ISensor *sensor : m_sensors) {
-    sensor->Activate(m_logicmgr);
+    if (sensor->NeedActivation()) {
+      sensor->Activate(m_logicmgr);
+    }
   }
 }
@@ -39,10 +39,25 @@
 class SCA_KeyboardManager : public SCA_EventManager {
   class SCA_IInputDevice *m_inputDevice;
 
+  /// Sensors woken up by the events of each input.
+  std::vector<SCA_ISensor *> m_inputSensors[SCA_IInputDevice::MAX_KEYS];
+  /// Sensors woken up by the events of any input.
+  std::vector<SCA_ISensor *> m_anyInputSensors;
+  /// The sensors or their inputs changed since the inputs sensors lists were built.
+  bool m_invalidInputSensors;
+
+  /// Build the lists of sensors woken up by each input.
+  void UpdateInputSensors();
+
  public:
   SCA_KeyboardManager(class SCA_LogicManager *logicmgr, class SCA_IInputDevice *inputdev);
   virtual ~SCA_KeyboardManager();
 
   virtual void NextFrame();
+  virtual bool RegisterSensor(SCA_ISensor *sensor);
+  virtual bool RemoveSensor(SCA_ISensor *sensor);
   SCA_IInputDevice *GetInputDevice();
+
+  /// Notify that the inputs of a sensor changed.
+  void InvalidateInputSensors();
 };
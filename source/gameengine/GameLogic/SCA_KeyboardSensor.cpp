@@ -205,6 +205,30 @@ bool SCA_KeyboardSensor::Evaluate()
   return result;
 }
 
+bool SCA_KeyboardSensor::InputsChanged()
+{
+  // The keyboard manager wakes up the sensor when one of its inputs received an event.
+  return false;
+}
+
+bool SCA_KeyboardSensor::IsWokenUpByAnyInput() const
+{
+  // The typed text is only logged when a key is pressed.
+  return m_bAllKeys || !m_toggleprop.empty();
+}
+
+void SCA_KeyboardSensor::GetWakeUpInputs(
+    std::vector<SCA_IInputDevice::SCA_EnumInputs> &inputs) const
+{
+  inputs.push_back((SCA_IInputDevice::SCA_EnumInputs)m_hotkey);
+  if (m_qual > 0) {
+    inputs.push_back((SCA_IInputDevice::SCA_EnumInputs)m_qual);
+  }
+  if (m_qual2 > 0) {
+    inputs.push_back((SCA_IInputDevice::SCA_EnumInputs)m_qual2);
+  }
+}
+
 void SCA_KeyboardSensor::LogKeystrokes()
 {
   EXP_Value *tprop = GetParent()->GetProperty(m_targetprop);
@@ -325,14 +349,36 @@ PyMethodDef SCA_KeyboardSensor::Methods[] = {
 PyAttributeDef SCA_KeyboardSensor::Attributes[] = {
     EXP_PYATTRIBUTE_RO_FUNCTION("events", SCA_KeyboardSensor, pyattr_get_events),
     EXP_PYATTRIBUTE_RO_FUNCTION("inputs", SCA_KeyboardSensor, pyattr_get_inputs),
-    EXP_PYATTRIBUTE_BOOL_RW("useAllKeys", SCA_KeyboardSensor, m_bAllKeys),
-    EXP_PYATTRIBUTE_INT_RW("key", 0, SCA_IInputDevice::ENDKEY, true, SCA_KeyboardSensor, m_hotkey),
-    EXP_PYATTRIBUTE_SHORT_RW(
-        "hold1", 0, SCA_IInputDevice::ENDKEY, true, SCA_KeyboardSensor, m_qual),
-    EXP_PYATTRIBUTE_SHORT_RW(
-        "hold2", 0, SCA_IInputDevice::ENDKEY, true, SCA_KeyboardSensor, m_qual2),
-    EXP_PYATTRIBUTE_STRING_RW(
-        "toggleProperty", 0, MAX_PROP_NAME, false, SCA_KeyboardSensor, m_toggleprop),
+    EXP_PYATTRIBUTE_BOOL_RW_CHECK(
+        "useAllKeys", SCA_KeyboardSensor, m_bAllKeys, pyattr_check_inputs),
+    EXP_PYATTRIBUTE_INT_RW_CHECK("key",
+                                 0,
+                                 SCA_IInputDevice::ENDKEY,
+                                 true,
+                                 SCA_KeyboardSensor,
+                                 m_hotkey,
+                                 pyattr_check_inputs),
+    EXP_PYATTRIBUTE_SHORT_RW_CHECK("hold1",
+                                   0,
+                                   SCA_IInputDevice::ENDKEY,
+                                   true,
+                                   SCA_KeyboardSensor,
+                                   m_qual,
+                                   pyattr_check_inputs),
+    EXP_PYATTRIBUTE_SHORT_RW_CHECK("hold2",
+                                   0,
+                                   SCA_IInputDevice::ENDKEY,
+                                   true,
+                                   SCA_KeyboardSensor,
+                                   m_qual2,
+                                   pyattr_check_inputs),
+    EXP_PYATTRIBUTE_STRING_RW_CHECK("toggleProperty",
+                                    0,
+                                    MAX_PROP_NAME,
+                                    false,
+                                    SCA_KeyboardSensor,
+                                    m_toggleprop,
+                                    pyattr_check_inputs),
     EXP_PYATTRIBUTE_STRING_RW(
         "targetProperty", 0, MAX_PROP_NAME, false, SCA_KeyboardSensor, m_targetprop),
     EXP_PYATTRIBUTE_NULL  // Sentinel
@@ -390,4 +436,13 @@ PyObject *SCA_KeyboardSensor::pyattr_get_events(EXP_PyObjectPlus *self_v,
   return resultlist;
 }
 
+int SCA_KeyboardSensor::pyattr_check_inputs(EXP_PyObjectPlus *self_v,
+                                            const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  SCA_KeyboardSensor *self = static_cast<SCA_KeyboardSensor *>(self_v);
+  ((SCA_KeyboardManager *)self->m_eventmgr)->InvalidateInputSensors();
+  self->WakeUp();
+  return 0;
+}
+
 #endif  // WITH_PYTHON
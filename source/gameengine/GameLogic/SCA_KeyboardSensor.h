@@ -35,6 +35,7 @@
 #include <list>
 
 #include "EXP_BoolValue.h"
+#include "SCA_IInputDevice.h"
 #include "SCA_ISensor.h"
 
 /**
@@ -92,6 +93,12 @@ class SCA_KeyboardSensor : public SCA_ISensor {
 
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
+  virtual bool InputsChanged();
+
+  /// Return true if the sensor must be evaluated after an event of any input (all keys or logging).
+  bool IsWokenUpByAnyInput() const;
+  /// Get the inputs the sensor must be evaluated for when they receive an event.
+  void GetWakeUpInputs(std::vector<SCA_IInputDevice::SCA_EnumInputs> &inputs) const;
 
 #ifdef WITH_PYTHON
   /* --------------------------------------------------------------------- */
@@ -105,5 +112,8 @@ class SCA_KeyboardSensor : public SCA_ISensor {
 
   static PyObject *pyattr_get_events(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
   static PyObject *pyattr_get_inputs(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+
+  /// Update the inputs waking up the sensor after a change of keys or logging properties.
+  static int pyattr_check_inputs(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 #endif
 };
@@ -32,6 +32,8 @@
 
 #include "SCA_LogicManager.h"
 
+#include "CM_Profiler.h"
+
 #include "SCA_ISensor.h"
 #include "SCA_PythonController.h"
 
@@ -135,6 +137,8 @@ void SCA_LogicManager::RegisterToActuator(SCA_IController *controller, SCA_IActu
 
 void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 {
+  CM_PROFILE_ZONE("Sensors and controllers");
+
   for (std::vector<SCA_EventManager *>::const_iterator ie = m_eventmanagers.begin();
        !(ie == m_eventmanagers.end());
        ie++)
@@ -152,6 +156,8 @@ void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 
 void SCA_LogicManager::UpdateFrame(double curtime)
 {
+  CM_PROFILE_ZONE("Actuators");
+
   for (std::vector<SCA_EventManager *>::const_iterator ie = m_eventmanagers.begin();
        !(ie == m_eventmanagers.end());
        ie++)
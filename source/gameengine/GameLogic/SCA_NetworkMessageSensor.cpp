@@ -68,12 +68,15 @@ EXP_Value *SCA_NetworkMessageSensor::GetReplica()
 {
   // This is the standard sensor implementation of GetReplica
   // There may be more network message sensor specific stuff to do here.
-  EXP_Value *replica = new SCA_NetworkMessageSensor(*this);
+  SCA_NetworkMessageSensor *replica = new SCA_NetworkMessageSensor(*this);
 
   if (replica == nullptr) {
     return nullptr;
   }
   replica->ProcessReplica();
+  // The lists are owned by the original sensor.
+  replica->m_BodyList = nullptr;
+  replica->m_SubjectList = nullptr;
 
   return replica;
 }
@@ -96,37 +99,14 @@ bool SCA_NetworkMessageSensor::Evaluate()
     m_SubjectList = nullptr;
   }
 
-  std::string toname = GetParent()->GetName();
-  std::string &subject = this->m_subject;
+  m_messages = m_NetworkScene->FindMessages(GetParent()->GetName(), m_subject);
+  m_frame_message_count = m_messages.GetSize();
 
-  const std::vector<KX_NetworkMessageManager::Message> messages = m_NetworkScene->FindMessages(
-      toname, subject);
-
-  m_frame_message_count = messages.size();
-
-  if (!messages.empty()) {
+  if (m_frame_message_count > 0) {
 #ifdef NAN_NET_DEBUG
     std::cout << "SCA_NetworkMessageSensor found one or more messages" << std::endl;
 #endif
     m_IsUp = true;
-    m_BodyList = new EXP_ListValue<EXP_StringValue>();
-    m_SubjectList = new EXP_ListValue<EXP_StringValue>();
-  }
-
-  std::vector<KX_NetworkMessageManager::Message>::const_iterator mesit;
-  for (mesit = messages.begin(); mesit != messages.end(); mesit++) {
-    // save the body
-    const std::string &body = (*mesit).body;
-    // save the subject
-    const std::string &messub = (*mesit).subject;
-#ifdef NAN_NET_DEBUG
-    if (body) {
-      cout << "body [" << body << "]\n";
-    }
-#endif
-    m_BodyList->Add(new EXP_StringValue(body, "body"));
-    // Store Subject
-    m_SubjectList->Add(new EXP_StringValue(messub, "subject"));
   }
 
   result = (WasUp != m_IsUp);
@@ -139,6 +119,12 @@ bool SCA_NetworkMessageSensor::Evaluate()
   return result;
 }
 
+void SCA_NetworkMessageSensor::EndFrame()
+{
+  // The lists already requested are kept, the others can't be created anymore.
+  m_messages = KX_NetworkMessageManager::MessageList();
+}
+
 /// return true for being up (no flank needed)
 bool SCA_NetworkMessageSensor::IsPositiveTrigger()
 {
@@ -210,6 +196,13 @@ PyObject *SCA_NetworkMessageSensor::pyattr_get_bodies(EXP_PyObjectPlus *self_v,
                                                       const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   SCA_NetworkMessageSensor *self = static_cast<SCA_NetworkMessageSensor *>(self_v);
+  if (!self->m_BodyList && self->m_IsUp) {
+    self->m_BodyList = new EXP_ListValue<EXP_StringValue>();
+    for (unsigned int i = 0, size = self->m_messages.GetSize(); i < size; ++i) {
+      self->m_BodyList->Add(new EXP_StringValue(std::string(self->m_messages.GetBody(i)), "body"));
+    }
+  }
+
   if (self->m_BodyList) {
     return self->m_BodyList->GetProxy();
   }
@@ -222,6 +215,13 @@ PyObject *SCA_NetworkMessageSensor::pyattr_get_subjects(EXP_PyObjectPlus *self_v
                                                         const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   SCA_NetworkMessageSensor *self = static_cast<SCA_NetworkMessageSensor *>(self_v);
+  if (!self->m_SubjectList && self->m_IsUp) {
+    self->m_SubjectList = new EXP_ListValue<EXP_StringValue>();
+    for (unsigned int i = 0, size = self->m_messages.GetSize(); i < size; ++i) {
+      self->m_SubjectList->Add(new EXP_StringValue(self->m_messages.GetSubject(i), "subject"));
+    }
+  }
+
   if (self->m_SubjectList) {
     return self->m_SubjectList->GetProxy();
   }
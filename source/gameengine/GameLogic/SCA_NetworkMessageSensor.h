@@ -31,6 +31,7 @@
  */
 #pragma once
 
+#include "KX_NetworkMessageManager.h"
 #include "SCA_ISensor.h"
 
 class KX_NetworkMessageScene;
@@ -49,6 +50,12 @@ class SCA_NetworkMessageSensor : public SCA_ISensor {
 
   bool m_IsUp;
 
+  /** Messages caught since the last frame, referenced without copy until the end of the logic
+   * frame to let the message manager reuse the frame.
+   */
+  KX_NetworkMessageManager::MessageList m_messages;
+
+  /// Lists of bodies and subjects, created from the messages only when requested.
   EXP_ListValue<EXP_StringValue> *m_BodyList;
   EXP_ListValue<EXP_StringValue> *m_SubjectList;
 
@@ -63,7 +70,7 @@ class SCA_NetworkMessageSensor : public SCA_ISensor {
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
   virtual void Init();
-  void EndFrame();
+  virtual void EndFrame();
 
   virtual void Replace_NetworkScene(KX_NetworkMessageScene *val)
   {
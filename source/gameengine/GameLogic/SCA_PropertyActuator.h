@@ -48,6 +48,8 @@ class SCA_PropertyActuator : public SCA_IActuator {
 
   int m_type;
   std::string m_propname;
+  /// Name of the property resolved in advance.
+  EXP_PropertyName m_prop;
   std::string m_exprtxt;
   SCA_IObject *m_sourceObj;  // for copy property actuator
 
@@ -68,6 +70,11 @@ class SCA_PropertyActuator : public SCA_IActuator {
 
   virtual bool Update();
 
+#ifdef WITH_PYTHON
+  /// Check the property name and resolve it.
+  static int CheckPropertyName(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef);
+#endif
+
   /* --------------------------------------------------------------------- */
   /* Python interface ---------------------------------------------------- */
   /* --------------------------------------------------------------------- */
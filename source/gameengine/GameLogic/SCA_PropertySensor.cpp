@@ -48,26 +48,56 @@ SCA_PropertySensor::SCA_PropertySensor(SCA_EventManager *eventmgr,
       m_checktype(checktype),
       m_checkpropval(propval),
       m_checkpropmaxval(propmaxval),
-      m_checkpropname(propname)
+      m_checkpropname(propname),
+      m_lastprop(nullptr),
+      m_lastparentrevision(0),
+      m_lastproprevision(0)
 {
   // EXP_Parser pars;
   // pars.SetContext(this->AddRef());
   // EXP_Value* resultval = m_rightexpr->Calculate();
 
-  EXP_Value *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-  if (!orgprop->IsError()) {
+  UpdateCheckedPropertyName();
+
+  EXP_Value *orgprop = FindCheckedProperty();
+  if (orgprop) {
     m_previoustext = orgprop->GetText();
   }
-  orgprop->Release();
 
   Init();
 }
 
+void SCA_PropertySensor::UpdateCheckedPropertyName()
+{
+  // The sub properties ("prop.sub") are looked up by FindIdentifier.
+  if (m_checkpropname.find('.') == std::string::npos) {
+    m_checkprop = EXP_PropertyName(m_checkpropname);
+  }
+  else {
+    m_checkprop = EXP_PropertyName();
+  }
+}
+
+EXP_Value *SCA_PropertySensor::FindCheckedProperty()
+{
+  if (m_checkprop.IsValid()) {
+    return GetParent()->GetProperty(m_checkprop);
+  }
+
+  // The sub property is still owned by its parent property once released.
+  EXP_Value *orgprop = GetParent()->FindIdentifier(m_checkpropname);
+  const bool error = orgprop->IsError();
+  orgprop->Release();
+  return error ? nullptr : orgprop;
+}
+
 void SCA_PropertySensor::Init()
 {
   m_recentresult = false;
   m_lastresult = m_invert ? true : false;
   m_reset = true;
+  // The parent can be a different object, e.g for a replica.
+  m_lastprop = nullptr;
 }
 
 EXP_Value *SCA_PropertySensor::GetReplica()
@@ -93,9 +123,45 @@ SCA_PropertySensor::~SCA_PropertySensor()
 {
 }
 
+bool SCA_PropertySensor::InputsChanged()
+{
+  // The sub properties are not tracked.
+  if (!m_checkprop.IsValid()) {
+    return true;
+  }
+
+  // A property was added, replaced or removed, m_lastprop may be freed.
+  if (GetParent()->GetRevision() != m_lastparentrevision) {
+    return true;
+  }
+
+  if (!m_lastprop) {
+    return false;
+  }
+
+  switch (m_lastprop->GetValueType()) {
+    case VALUE_INT_TYPE:
+    case VALUE_FLOAT_TYPE:
+    case VALUE_BOOL_TYPE:
+    case VALUE_STRING_TYPE: {
+      return m_lastprop->GetRevision() != m_lastproprevision;
+    }
+    default: {
+      // The other values don't increase their revision when modified.
+      return true;
+    }
+  }
+}
+
 bool SCA_PropertySensor::Evaluate()
 {
   bool result = CheckPropertyCondition();
+
+  // Remember the checked values to skip the evaluations while they are unchanged.
+  EXP_Value *parent = GetParent();
+  m_lastparentrevision = parent->GetRevision();
+  m_lastprop = parent->GetProperty(m_checkprop);
+  m_lastproprevision = m_lastprop ? m_lastprop->GetRevision() : 0;
   bool reset = m_reset && m_level;
 
   m_reset = false;
@@ -116,8 +182,8 @@ bool SCA_PropertySensor::CheckPropertyCondition()
       reverse = true;
       ATTR_FALLTHROUGH;
     case KX_PROPSENSOR_EQUAL: {
-      EXP_Value *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-      if (!orgprop->IsError()) {
+      EXP_Value *orgprop = FindCheckedProperty();
+      if (orgprop) {
         const std::string &testprop = orgprop->GetText();
         // Force strings to upper case, to avoid confusion in
         // bool tests. It's stupid the prop's identity is lost
@@ -141,7 +207,6 @@ bool SCA_PropertySensor::CheckPropertyCondition()
         }
         /* end patch */
       }
-      orgprop->Release();
 
       if (reverse)
         result = !result;
@@ -152,8 +217,8 @@ bool SCA_PropertySensor::CheckPropertyCondition()
       break;
     }
     case KX_PROPSENSOR_INTERVAL: {
-      EXP_Value *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-      if (!orgprop->IsError()) {
+      EXP_Value *orgprop = FindCheckedProperty();
+      if (orgprop) {
         float min;
         float max;
         float val;
@@ -169,20 +234,18 @@ bool SCA_PropertySensor::CheckPropertyCondition()
 
         result = (min <= val) && (val <= max);
       }
-      orgprop->Release();
 
       break;
     }
     case KX_PROPSENSOR_CHANGED: {
-      EXP_Value *orgprop = GetParent()->FindIdentifier(m_checkpropname);
+      EXP_Value *orgprop = FindCheckedProperty();
 
-      if (!orgprop->IsError()) {
+      if (orgprop) {
         if (m_previoustext != orgprop->GetText()) {
           m_previoustext = orgprop->GetText();
           result = true;
         }
       }
-      orgprop->Release();
 
       break;
     }
@@ -190,8 +253,8 @@ bool SCA_PropertySensor::CheckPropertyCondition()
       reverse = true;
       ATTR_FALLTHROUGH;
     case KX_PROPSENSOR_GREATERTHAN: {
-      EXP_Value *orgprop = GetParent()->FindIdentifier(m_checkpropname);
-      if (!orgprop->IsError()) {
+      EXP_Value *orgprop = FindCheckedProperty();
+      if (orgprop) {
         float ref;
         CM_StringTo(m_checkpropval, ref);
         float val;
@@ -210,7 +273,6 @@ bool SCA_PropertySensor::CheckPropertyCondition()
           result = val > ref;
         }
       }
-      orgprop->Release();
 
       break;
     }
@@ -235,6 +297,24 @@ EXP_Value *SCA_PropertySensor::FindIdentifier(const std::string &identifiername)
 /* Python functions                                                          */
 /* ------------------------------------------------------------------------- */
 
+int SCA_PropertySensor::CheckPropertyName(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef)
+{
+  if (CheckProperty(self, attrdef)) {
+    return 1;
+  }
+
+  SCA_PropertySensor *sensor = static_cast<SCA_PropertySensor *>(self);
+  sensor->UpdateCheckedPropertyName();
+  sensor->WakeUp();
+  return 0;
+}
+
+int SCA_PropertySensor::CheckMode(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef)
+{
+  static_cast<SCA_PropertySensor *>(self)->WakeUp();
+  return 0;
+}
+
 int SCA_PropertySensor::validValueForProperty(EXP_PyObjectPlus *self, const PyAttributeDef *)
 {
   /* If someone actually do type checking please make sure the 'max' and 'min'
@@ -242,6 +322,7 @@ int SCA_PropertySensor::validValueForProperty(EXP_PyObjectPlus *self, const PyAt
    * function directly */
 
   /*  There is no type checking at this moment, unfortunately...           */
+  static_cast<SCA_PropertySensor *>(self)->WakeUp();
   return 0;
 }
 
@@ -289,14 +370,15 @@ PyMethodDef SCA_PropertySensor::Methods[] = {
 };
 
 PyAttributeDef SCA_PropertySensor::Attributes[] = {
-    EXP_PYATTRIBUTE_INT_RW("mode",
-                           KX_PROPSENSOR_NODEF,
-                           KX_PROPSENSOR_MAX - 1,
-                           false,
-                           SCA_PropertySensor,
-                           m_checktype),
+    EXP_PYATTRIBUTE_INT_RW_CHECK("mode",
+                                 KX_PROPSENSOR_NODEF,
+                                 KX_PROPSENSOR_MAX - 1,
+                                 false,
+                                 SCA_PropertySensor,
+                                 m_checktype,
+                                 CheckMode),
     EXP_PYATTRIBUTE_STRING_RW_CHECK(
-        "propName", 0, MAX_PROP_NAME, false, SCA_PropertySensor, m_checkpropname, CheckProperty),
+        "propName", 0, MAX_PROP_NAME, false, SCA_PropertySensor, m_checkpropname, CheckPropertyName),
     EXP_PYATTRIBUTE_STRING_RW_CHECK(
         "value", 0, 100, false, SCA_PropertySensor, m_checkpropval, validValueForProperty),
     EXP_PYATTRIBUTE_STRING_RW_CHECK(
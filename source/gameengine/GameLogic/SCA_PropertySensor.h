@@ -41,9 +41,16 @@ class SCA_PropertySensor : public SCA_ISensor {
   std::string m_checkpropval;
   std::string m_checkpropmaxval;
   std::string m_checkpropname;
+  /// Name of the checked property resolved in advance, invalid for a sub property.
+  EXP_PropertyName m_checkprop;
   std::string m_previoustext;
   bool m_lastresult;
   bool m_recentresult;
+  /// Property checked at the last evaluation, only valid while the parent revision is unchanged.
+  EXP_Value *m_lastprop;
+  /// Revisions of the parent and of the checked property at the last evaluation.
+  unsigned int m_lastparentrevision;
+  unsigned int m_lastproprevision;
 
  protected:
  public:
@@ -72,9 +79,14 @@ class SCA_PropertySensor : public SCA_ISensor {
   virtual EXP_Value *GetReplica();
   virtual void Init();
   bool CheckPropertyCondition();
+  /// Resolve the name of the checked property after it changed.
+  void UpdateCheckedPropertyName();
+  /// Return the checked property or nullptr if it doesn't exist.
+  EXP_Value *FindCheckedProperty();
 
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
+  virtual bool InputsChanged();
   virtual EXP_Value *FindIdentifier(const std::string &identifiername);
 
 #ifdef WITH_PYTHON
@@ -87,6 +99,10 @@ class SCA_PropertySensor : public SCA_ISensor {
    * Test whether this is a sensible value (type check)
    */
   static int validValueForProperty(EXP_PyObjectPlus *self, const PyAttributeDef *);
+  /// Check the property name and resolve it.
+  static int CheckPropertyName(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef);
+  /// Wake up the sensor after a change of the mode.
+  static int CheckMode(EXP_PyObjectPlus *self, const PyAttributeDef *attrdef);
 
 #endif
 };
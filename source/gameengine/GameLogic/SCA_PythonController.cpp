@@ -40,6 +40,7 @@
 #endif  // WITH_PYTHON
 
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 
 // initialize static member variables
 SCA_PythonController *SCA_PythonController::m_sCurrentController = nullptr;
@@ -53,10 +54,13 @@ SCA_PythonController::SCA_PythonController(SCA_IObject *gameobj, int mode)
       m_function_argc(0),
       m_bModified(true),
       m_debug(false),
-      m_mode(mode)
+      m_mode(mode),
+      m_persistentNamespace(false),
+      m_resetNamespace(false)
 #ifdef WITH_PYTHON
       ,
-      m_pythondictionary(nullptr)
+      m_pythondictionary(nullptr),
+      m_persistentDictionary(nullptr)
 #endif
 
 {
@@ -74,6 +78,8 @@ SCA_PythonController::~SCA_PythonController()
     PyDict_Clear(m_pythondictionary);
     Py_DECREF(m_pythondictionary);
   }
+
+  FreePersistentNamespace();
 #endif
 }
 
@@ -93,6 +99,9 @@ EXP_Value *SCA_PythonController::GetReplica()
   if (m_pythondictionary)
     replica->m_pythondictionary = PyDict_Copy(m_pythondictionary);
 
+  // The variables of the persistent namespace can reference the original object.
+  replica->m_persistentDictionary = nullptr;
+
 #  if 0
 	// The other option is to incref the replica->m_pythondictionary -
 	// the replica objects can then share data.
@@ -214,6 +223,7 @@ PyTypeObject SCA_PythonController::Type = {
 PyMethodDef SCA_PythonController::Methods[] = {
     {"activate", (PyCFunction)SCA_PythonController::sPyActivate, METH_O},
     {"deactivate", (PyCFunction)SCA_PythonController::sPyDeActivate, METH_O},
+    EXP_PYMETHODTABLE_NOARGS(SCA_PythonController, resetNamespace),
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -221,6 +231,7 @@ PyAttributeDef SCA_PythonController::Attributes[] = {
     EXP_PYATTRIBUTE_RW_FUNCTION(
         "script", SCA_PythonController, pyattr_get_script, pyattr_set_script),
     EXP_PYATTRIBUTE_INT_RO("mode", SCA_PythonController, m_mode),
+    EXP_PYATTRIBUTE_BOOL_RW("persistentNamespace", SCA_PythonController, m_persistentNamespace),
     EXP_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -241,6 +252,16 @@ void SCA_PythonController::ErrorPrint(const char *error_msg)
   PyErr_Clear(); /* just to be sure */
 }
 
+void SCA_PythonController::FreePersistentNamespace()
+{
+  if (m_persistentDictionary) {
+    // break any circular references in the dictionary
+    PyDict_Clear(m_persistentDictionary);
+    Py_DECREF(m_persistentDictionary);
+    m_persistentDictionary = nullptr;
+  }
+}
+
 bool SCA_PythonController::Compile()
 {
   m_bModified = false;
@@ -251,6 +272,9 @@ bool SCA_PythonController::Compile()
     m_bytecode = nullptr;
   }
 
+  // the global variables of the previous script are not valid for the new one
+  FreePersistentNamespace();
+
   // recompile the scripttext into bytecode
   m_bytecode = Py_CompileString(m_scriptText.c_str(), m_scriptName.c_str(), Py_file_input);
 
@@ -346,6 +370,8 @@ bool SCA_PythonController::Import()
 
 void SCA_PythonController::Trigger(SCA_LogicManager *logicmgr)
 {
+  CM_PROFILE_ZONE_DETAIL("PythonController", m_scriptName.c_str());
+
   m_sCurrentController = this;
 
   PyObject *excdict = nullptr;
@@ -387,9 +413,24 @@ void SCA_PythonController::Trigger(SCA_LogicManager *logicmgr)
         Py_DECREF(value);
       }
 
-      excdict = PyDict_Copy(m_pythondictionary);
+      /* The persistent namespace is reused until reset, the global variables of the
+       * script are kept between the runs and no dictionary is copied. */
+      if (m_resetNamespace || !m_persistentNamespace) {
+        FreePersistentNamespace();
+        m_resetNamespace = false;
+      }
 
-      resultobj = PyEval_EvalCode((PyObject *)m_bytecode, excdict, excdict);
+      if (m_persistentNamespace) {
+        if (!m_persistentDictionary) {
+          m_persistentDictionary = PyDict_Copy(m_pythondictionary);
+        }
+        resultobj = PyEval_EvalCode(
+            (PyObject *)m_bytecode, m_persistentDictionary, m_persistentDictionary);
+      }
+      else {
+        excdict = PyDict_Copy(m_pythondictionary);
+        resultobj = PyEval_EvalCode((PyObject *)m_bytecode, excdict, excdict);
+      }
 
       /* PyRun_SimpleString(m_scriptText.Ptr()); */
       break;
@@ -401,15 +442,16 @@ void SCA_PythonController::Trigger(SCA_LogicManager *logicmgr)
       if (!m_function)
         return;
 
-      PyObject *args = nullptr;
-
+      /* Call without argument tuple, the controller proxy is created once
+       * and kept by the controller. */
       if (m_function_argc == 1) {
-        args = PyTuple_New(1);
-        PyTuple_SET_ITEM(args, 0, GetProxy());
+        PyObject *proxy = GetProxy();
+        resultobj = PyObject_Vectorcall(m_function, &proxy, 1, nullptr);
+        Py_DECREF(proxy);
+      }
+      else {
+        resultobj = PyObject_Vectorcall(m_function, nullptr, 0, nullptr);
       }
-
-      resultobj = PyObject_CallObject(m_function, args);
-      Py_XDECREF(args);
       break;
     }
 
@@ -465,6 +507,17 @@ PyObject *SCA_PythonController::PyDeActivate(PyObject *value)
   Py_RETURN_NONE;
 }
 
+EXP_PYMETHODDEF_DOC_NOARGS(SCA_PythonController,
+                           resetNamespace,
+                           "resetNamespace()\n"
+                           "Discard the global variables kept by the persistent namespace, "
+                           "the script starts from a fresh namespace at its next run.\n")
+{
+  // Deferred as the script can be running with this namespace.
+  m_resetNamespace = true;
+  Py_RETURN_NONE;
+}
+
 PyObject *SCA_PythonController::pyattr_get_script(EXP_PyObjectPlus *self_v,
                                                   const EXP_PYATTRIBUTE_DEF *attrdef)
 {
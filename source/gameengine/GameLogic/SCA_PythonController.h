@@ -49,6 +49,9 @@ class SCA_PythonController : public SCA_IController {
   bool m_bModified;
   bool m_debug; /* use with SCA_PYEXEC_MODULE for reloading every logic run */
   int m_mode;
+  /* use with SCA_PYEXEC_SCRIPT to keep the namespace between the logic runs */
+  bool m_persistentNamespace;
+  bool m_resetNamespace;
 
  protected:
   std::string m_scriptText;
@@ -56,6 +59,10 @@ class SCA_PythonController : public SCA_IController {
 #ifdef WITH_PYTHON
   PyObject *m_pythondictionary; /* for SCA_PYEXEC_SCRIPT only */
   PyObject *m_pythonfunction;   /* for SCA_PYEXEC_MODULE only */
+  /* namespace kept between the logic runs, for SCA_PYEXEC_SCRIPT only */
+  PyObject *m_persistentDictionary;
+
+  void FreePersistentNamespace();
 #endif
   std::vector<class SCA_ISensor *> m_triggeredSensors;
 
@@ -81,6 +88,10 @@ class SCA_PythonController : public SCA_IController {
   {
     m_debug = debug;
   }
+  void SetPersistentNamespace(bool persistent)
+  {
+    m_persistentNamespace = persistent;
+  }
   void AddTriggeredSensor(class SCA_ISensor *sensor)
   {
     m_triggeredSensors.push_back(sensor);
@@ -101,6 +112,7 @@ class SCA_PythonController : public SCA_IController {
   EXP_PYMETHOD_O(SCA_PythonController, DeActivate);
   EXP_PYMETHOD_O(SCA_PythonController, SetScript);
   EXP_PYMETHOD_NOARGS(SCA_PythonController, GetScript);
+  EXP_PYMETHOD_DOC_NOARGS(SCA_PythonController, resetNamespace);
 
   static PyObject *pyattr_get_script(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
   static int pyattr_set_script(EXP_PyObjectPlus *self_v,
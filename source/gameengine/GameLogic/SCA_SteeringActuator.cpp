@@ -37,7 +37,6 @@
 #include "KX_NavMeshObject.h"
 #include "KX_ObstacleSimulation.h"
 #include "KX_PyMath.h"
-#include "Recast.h"
 
 /* ------------------------------------------------------------------------- */
 /* Native functions                                                          */
@@ -67,6 +66,7 @@ SCA_SteeringActuator::SCA_SteeringActuator(SCA_IObject *gameobj,
       m_turnspeed(turnspeed),
       m_simulation(simulation),
       m_updateTime(0),
+      m_delta(0),
       m_obstacle(nullptr),
       m_isActive(false),
       m_isSelfTerminated(isSelfTerminated),
@@ -75,6 +75,7 @@ SCA_SteeringActuator::SCA_SteeringActuator(SCA_IObject *gameobj,
       m_normalUp(normalup),
       m_pathLen(0),
       m_pathUpdatePeriod(pathUpdatePeriod),
+      m_pathRequested(false),
       m_lockzvel(lockzvel),
       m_wayPointIdx(-1),
       m_steerVec(MT_Vector3(0, 0, 0))
@@ -113,6 +114,8 @@ EXP_Value *SCA_SteeringActuator::GetReplica()
 
 void SCA_SteeringActuator::ProcessReplica()
 {
+  // The path requests are not copied in the obstacle simulation.
+  m_pathRequested = false;
   if (m_target)
     m_target->RegisterActuator(this);
   if (m_navmesh)
@@ -219,8 +222,15 @@ bool SCA_SteeringActuator::Update(double curtime)
             (m_pathUpdatePeriod >= 0 &&
              curtime - m_pathUpdateTime > ((double)m_pathUpdatePeriod / 1000.0))) {
           m_pathUpdateTime = curtime;
-          m_pathLen = m_navmesh->FindPath(mypos, targpos, m_path, MAX_PATH_LENGTH);
-          m_wayPointIdx = m_pathLen > 1 ? 1 : -1;
+          // Searched with the paths of the other agents within the budget of the frame.
+          if (m_simulation && m_obstacle) {
+            if (!m_pathRequested) {
+              m_pathRequested = true;
+              m_simulation->RequestPath(this);
+            }
+          }
+          else
+            UpdatePath();
         }
 
         if (m_wayPointIdx > 0) {
@@ -255,37 +265,21 @@ bool SCA_SteeringActuator::Update(double curtime)
     if (!m_steerVec.fuzzyZero())
       m_steerVec.normalize();
     MT_Vector3 newvel = m_velocity * m_steerVec;
+    m_delta = delta;
 
-    // adjust velocity to avoid obstacles
+    // adjust velocity to avoid obstacles with the other agents at the end of the frame
     if (m_simulation && m_obstacle /*&& !newvel.fuzzyZero()*/) {
       if (m_enableVisualization)
         KX_RasterizerDrawDebugLine(mypos, mypos + newvel, MT_Vector4(1.0f, 0.0f, 0.0f, 1.0f));
-      m_simulation->AdjustObstacleVelocity(m_obstacle,
-                                           m_mode != KX_STEERING_PATHFOLLOWING ? m_navmesh :
-                                                                                 nullptr,
-                                           newvel,
-                                           m_acceleration * (float)delta,
-                                           m_turnspeed / (180.0f * (float)(M_PI * delta)));
-      if (m_enableVisualization)
-        KX_RasterizerDrawDebugLine(mypos, mypos + newvel, MT_Vector4(0.0f, 1.0f, 0.0f, 1.0f));
-    }
-
-    HandleActorFace(newvel);
-    if (isdyna) {
-      // temporary solution: set 2D steering velocity directly to obj
-      // correct way is to apply physical force
-      MT_Vector3 curvel = obj->GetLinearVelocity();
-
-      if (m_lockzvel)
-        newvel.z() = 0.0f;
-      else
-        newvel.z() = curvel.z();
-
-      obj->setLinearVelocity(newvel, false);
+      m_simulation->RequestVelocity(m_obstacle,
+                                    m_mode != KX_STEERING_PATHFOLLOWING ? m_navmesh : nullptr,
+                                    this,
+                                    newvel,
+                                    m_acceleration * (float)delta,
+                                    m_turnspeed / (180.0f * (float)(M_PI * delta)));
     }
     else {
-      MT_Vector3 movement = delta * newvel;
-      obj->ApplyMovement(movement, false);
+      ApplyVelocity(newvel);
     }
   }
   else {
@@ -310,88 +304,46 @@ const MT_Vector3 &SCA_SteeringActuator::GetSteeringVec()
     return ZERO_VECTOR;
 }
 
-inline float vdot2(const float *a, const float *b)
+void SCA_SteeringActuator::UpdatePath()
 {
-  return a[0] * b[0] + a[2] * b[2];
-}
-static bool barDistSqPointToTri(const float *p, const float *a, const float *b, const float *c)
-{
-  float v0[3], v1[3], v2[3];
-  rcVsub(v0, c, a);
-  rcVsub(v1, b, a);
-  rcVsub(v2, p, a);
-
-  const float dot00 = vdot2(v0, v0);
-  const float dot01 = vdot2(v0, v1);
-  const float dot02 = vdot2(v0, v2);
-  const float dot11 = vdot2(v1, v1);
-  const float dot12 = vdot2(v1, v2);
-
-  // Compute barycentric coordinates
-  float invDenom = 1.0f / (dot00 * dot11 - dot01 * dot01);
-  float u = (dot11 * dot02 - dot01 * dot12) * invDenom;
-  float v = (dot00 * dot12 - dot01 * dot02) * invDenom;
-
-  float ud = u < 0.f ? -u : (u > 1.f ? u - 1.f : 0.f);
-  float vd = v < 0.f ? -v : (v > 1.f ? v - 1.f : 0.f);
-  return ud * ud + vd * vd;
-}
+  m_pathRequested = false;
+  if (!m_navmesh || !m_target) {
+    return;
+  }
 
-inline void flipAxes(float *vec)
-{
-  std::swap(vec[1], vec[2]);
+  KX_GameObject *obj = (KX_GameObject *)GetParent();
+  m_pathLen = m_navmesh->FindPath(
+      obj->NodeGetWorldPosition(), m_target->NodeGetWorldPosition(), m_path, MAX_PATH_LENGTH);
+  m_wayPointIdx = m_pathLen > 1 ? 1 : -1;
 }
 
-static bool getNavmeshNormal(dtStatNavMesh *navmesh, const MT_Vector3 &pos, MT_Vector3 &normal)
+void SCA_SteeringActuator::ApplyVelocity(const MT_Vector3 &velocity)
 {
-  static const float polyPickExt[3] = {2, 4, 2};
-  float spos[3];
-  pos.getValue(spos);
-  flipAxes(spos);
-  dtStatPolyRef sPolyRef = navmesh->findNearestPoly(spos, polyPickExt);
-  if (sPolyRef == 0)
-    return false;
-  const dtStatPoly *p = navmesh->getPoly(sPolyRef - 1);
-  const dtStatPolyDetail *pd = navmesh->getPolyDetail(sPolyRef - 1);
-
-  float distMin = FLT_MAX;
-  int idxMin = -1;
-  for (int i = 0; i < pd->ntris; ++i) {
-    const unsigned char *t = navmesh->getDetailTri(pd->tbase + i);
-    const float *v[3];
-    for (int j = 0; j < 3; ++j) {
-      if (t[j] < p->nv)
-        v[j] = navmesh->getVertex(p->v[t[j]]);
-      else
-        v[j] = navmesh->getDetailVertex(pd->vbase + (t[j] - p->nv));
-    }
-    float dist = barDistSqPointToTri(spos, v[0], v[1], v[2]);
-    if (dist < distMin) {
-      distMin = dist;
-      idxMin = i;
-    }
-  }
+  KX_GameObject *obj = (KX_GameObject *)GetParent();
+  MT_Vector3 newvel = velocity;
 
-  if (idxMin >= 0) {
-    const unsigned char *t = navmesh->getDetailTri(pd->tbase + idxMin);
-    const float *v[3];
-    for (int j = 0; j < 3; ++j) {
-      if (t[j] < p->nv)
-        v[j] = navmesh->getVertex(p->v[t[j]]);
-      else
-        v[j] = navmesh->getDetailVertex(pd->vbase + (t[j] - p->nv));
-    }
-    MT_Vector3 tri[3];
-    for (size_t j = 0; j < 3; j++)
-      tri[j].setValue(v[j][0], v[j][2], v[j][1]);
-    MT_Vector3 a, b;
-    a = tri[1] - tri[0];
-    b = tri[2] - tri[0];
-    normal = b.cross(a).safe_normalized();
-    return true;
+  if (m_simulation && m_obstacle && m_enableVisualization) {
+    const MT_Vector3 &mypos = obj->NodeGetWorldPosition();
+    KX_RasterizerDrawDebugLine(mypos, mypos + newvel, MT_Vector4(0.0f, 1.0f, 0.0f, 1.0f));
   }
 
-  return false;
+  HandleActorFace(newvel);
+  if (obj->IsDynamic()) {
+    // temporary solution: set 2D steering velocity directly to obj
+    // correct way is to apply physical force
+    MT_Vector3 curvel = obj->GetLinearVelocity();
+
+    if (m_lockzvel)
+      newvel.z() = 0.0f;
+    else
+      newvel.z() = curvel.z();
+
+    obj->setLinearVelocity(newvel, false);
+  }
+  else {
+    MT_Vector3 movement = m_delta * newvel;
+    obj->ApplyMovement(movement, false);
+  }
 }
 
 void SCA_SteeringActuator::HandleActorFace(MT_Vector3 &velocity)
@@ -408,10 +360,9 @@ void SCA_SteeringActuator::HandleActorFace(MT_Vector3 &velocity)
   MT_Matrix3x3 mat;
 
   if (m_navmesh && m_normalUp) {
-    dtStatNavMesh *navmesh = m_navmesh->GetNavMesh();
     MT_Vector3 normal;
     MT_Vector3 trpos = m_navmesh->TransformToLocalCoords(curobj->NodeGetWorldPosition());
-    if (getNavmeshNormal(navmesh, trpos, normal)) {
+    if (m_navmesh->GetNormal(trpos, normal)) {
 
       left = (dir.cross(up)).safe_normalized();
       dir = (-left.cross(normal)).safe_normalized();
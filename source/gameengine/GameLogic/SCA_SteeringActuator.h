@@ -50,6 +50,8 @@ class SCA_SteeringActuator : public SCA_IActuator {
   KX_ObstacleSimulation *m_simulation;
 
   double m_updateTime;
+  /// Time step of the last velocity.
+  double m_delta;
   KX_Obstacle *m_obstacle;
   bool m_isActive;
   bool m_isSelfTerminated;
@@ -60,6 +62,8 @@ class SCA_SteeringActuator : public SCA_IActuator {
   int m_pathLen;
   int m_pathUpdatePeriod;
   double m_pathUpdateTime;
+  /// The path is queued in the obstacle simulation.
+  bool m_pathRequested;
   bool m_lockzvel;
   int m_wayPointIdx;
   MT_Matrix3x3 m_parentlocalmat;
@@ -100,6 +104,11 @@ class SCA_SteeringActuator : public SCA_IActuator {
   virtual bool UnlinkObject(SCA_IObject *clientobj);
   const MT_Vector3 &GetSteeringVec();
 
+  /// Search the path to the target, called by the obstacle simulation for a requested path.
+  void UpdatePath();
+  /// Move the object at a velocity, called by the obstacle simulation for a requested velocity.
+  void ApplyVelocity(const MT_Vector3 &velocity);
+
 #ifdef WITH_PYTHON
 
   /* --------------------------------------------------------------------- */
@@ -404,7 +404,8 @@ static GHOST_IWindow *startWindow(GHOST_ISystem *system,
                                   int windowWidth,
                                   int windowHeight,
                                   const bool stereoVisual,
-                                  const int alphaBackground)
+                                  const int alphaBackground,
+                                  const GHOST_TWindowState state)
 {
   GHOST_GPUSettings glSettings = {0};
   // Create the main window
@@ -420,7 +421,7 @@ static GHOST_IWindow *startWindow(GHOST_ISystem *system,
                                                windowTop,
                                                windowWidth,
                                                windowHeight,
-                                               GHOST_kWindowStateNormal,
+                                               state,
                                                glSettings);
   if (!window) {
     CM_Error("could not create main window");
@@ -546,8 +547,13 @@ static void usage(const std::string &program, bool isBlenderPlayer)
   CM_Message("       show_camera_frustum            0         Show debug camera frustum volume");
   CM_Message(
       "       show_shadow_frustum            0         Show debug light shadow frustum volume");
-  CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings"
-             << std::endl);
+  CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings");
+  CM_Message(
+      "       profile_trace                            Write a Chrome trace of the game to a file");
+  CM_Message(
+      "       benchmark_frames               0         Run N logic frames at fixed timestep without"
+      " rendering and print the timings"
+      << std::endl);
   CM_Message("  -p: override python main loop script");
   CM_Message(std::endl);
   CM_Message(
@@ -1352,6 +1358,11 @@ int main(int argc,
     usage(argv[0], isBlenderPlayer);
     return 0;
   }
+
+  /* The benchmark doesn't render, the window is only needed for the GPU context used by the
+   * conversion and is kept minimized. */
+  const bool benchmark = (SYS_GetCommandLineInt(syshandle, "benchmark_frames", 0) > 0);
+
   GHOST_ISystem *system = nullptr;
 #ifdef WIN32
   if (scr_saver_mode != SCREEN_SAVER_MODE_CONFIGURATION)
@@ -1586,7 +1597,7 @@ int main(int argc,
             if (firstTimeRunning) {
               firstTimeRunning = false;
 
-              if (fullScreen) {
+              if (fullScreen && !benchmark) {
 #ifdef WIN32
                 if (scr_saver_mode == SCREEN_SAVER_MODE_SAVER) {
                   window = startScreenSaverFullScreen(system,
@@ -1662,7 +1673,9 @@ int main(int argc,
                                          windowWidth,
                                          windowHeight,
                                          stereoWindow,
-                                         alphaBackground);
+                                         alphaBackground,
+                                         benchmark ? GHOST_kWindowStateMinimized :
+                                                     GHOST_kWindowStateNormal);
                 }
               }
               /* wm context */
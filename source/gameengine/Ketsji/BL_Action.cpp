@@ -408,10 +408,8 @@ void BL_Action::Update(float curtime, bool applyToObject)
     return;
   }
 
-  // Update controllers time. The controllers list is cleared when action is done
-  for (SG_Controller *cont : m_sg_contr_list) {
-    cont->SetSimulatedTime(m_localframe);  // update spatial controllers
-    cont->Update(m_localframe);
+  // The controllers modify the scene graph, they are updated later in UpdateIPOs.
+  if (!m_sg_contr_list.empty()) {
     m_requestIpo = true;
   }
 
@@ -607,10 +605,6 @@ void BL_Action::Update(float curtime, bool applyToObject)
       }
     }
   }
-  // If the action is done we can remove its scene graph IPO controller.
-  if (m_done) {
-    ClearControllerList();
-  }
 }
 
 /* To sync m_obj and children in SceneGraph after potential m_obj transform update in SG_Controller actions */
@@ -619,7 +613,18 @@ void BL_Action::Update(float curtime, bool applyToObject)
 void BL_Action::UpdateIPOs()
 {
   if (m_requestIpo) {
+    // Update controllers time.
+    for (SG_Controller *cont : m_sg_contr_list) {
+      cont->SetSimulatedTime(m_localframe);  // update spatial controllers
+      cont->Update(m_localframe);
+    }
     m_obj->GetSGNode()->UpdateWorldData(0.0);
     m_requestIpo = false;
   }
+
+  // If the action is done its last frame was applied just above, we can remove its scene graph
+  // IPO controllers.
+  if (m_done) {
+    ClearControllerList();
+  }
 }
@@ -168,10 +168,20 @@ bool BL_ActionManager::IsSuspended() const
 }
 
 void BL_ActionManager::Update(float curtime, bool applyToObject)
+{
+  UpdateActions(curtime, applyToObject);
+  UpdateIPOs();
+}
+
+void BL_ActionManager::UpdateActions(float curtime, bool applyToObject)
 {
   for (const auto &pair : m_layers) {
     pair.second->Update(curtime, applyToObject);
   }
+}
+
+void BL_ActionManager::UpdateIPOs()
+{
   /* It's to sync children with parent SGNode after fcurve update */
   for (const auto &pair : m_layers) {
     pair.second->UpdateIPOs();
@@ -120,4 +120,16 @@ class BL_ActionManager {
    * manages actions' frames.
    */
   void Update(float curtime, bool applyToObject);
+  /**
+   * Update the running actions without modifying the scene graph, it can be called from the
+   * scene animation pool.
+   * \param curtime The current time used to compute the actions' frame.
+   * \param applyToObject Set to true if the actions must transform the object, else it only
+   * manages actions' frames.
+   */
+  void UpdateActions(float curtime, bool applyToObject);
+  /**
+   * Apply the transform actions to the object and sync its children in the scene graph.
+   */
+  void UpdateIPOs();
 };
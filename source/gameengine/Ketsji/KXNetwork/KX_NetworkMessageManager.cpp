@@ -32,58 +32,277 @@
 
 #include "KX_NetworkMessageManager.h"
 
-KX_NetworkMessageManager::KX_NetworkMessageManager() : m_currentList(0)
+#include <algorithm>
+#include <numeric>
+
+static const unsigned int INVALID_NAME = (unsigned int)-1;
+/// Minimum number of names kept before removing the unused names.
+static const unsigned int NAMES_MIN_MAX_COUNT = 1024;
+
+std::string_view KX_NetworkMessageManager::MessageFrame::GetBody(const Message &message) const
+{
+  return std::string_view(m_bodies.data() + message.bodyOffset, message.bodySize);
+}
+
+KX_NetworkMessageManager::MessageList::MessageList()
+    : m_manager(nullptr), m_ranges({{{0, 0}, {0, 0}}})
+{
+}
+
+unsigned int KX_NetworkMessageManager::MessageList::GetSize() const
+{
+  return (m_ranges[0].second - m_ranges[0].first) + (m_ranges[1].second - m_ranges[1].first);
+}
+
+const KX_NetworkMessageManager::Message &KX_NetworkMessageManager::MessageList::GetMessage(
+    unsigned int index) const
+{
+  const unsigned int firstSize = m_ranges[0].second - m_ranges[0].first;
+  if (index < firstSize) {
+    return m_frame->m_messages[m_ranges[0].first + index];
+  }
+  return m_frame->m_messages[m_ranges[1].first + index - firstSize];
+}
+
+std::string_view KX_NetworkMessageManager::MessageList::GetBody(unsigned int index) const
+{
+  return m_frame->GetBody(GetMessage(index));
+}
+
+const std::string &KX_NetworkMessageManager::MessageList::GetSubject(unsigned int index) const
+{
+  return m_manager->GetName(GetMessage(index).subject);
+}
+
+KX_NetworkMessageManager::KX_NetworkMessageManager()
+    : m_currentFrame(std::make_shared<MessageFrame>()),
+      m_lastFrame(std::make_shared<MessageFrame>()),
+      m_namesMaxCount(NAMES_MIN_MAX_COUNT),
+      m_listener(nullptr)
 {
+  // The messages sent to all objects use the empty name.
+  RegisterName("");
 }
 
 KX_NetworkMessageManager::~KX_NetworkMessageManager()
 {
-  ClearMessages();
 }
 
-void KX_NetworkMessageManager::AddMessage(KX_NetworkMessageManager::Message message)
+unsigned int KX_NetworkMessageManager::RegisterName(const std::string &name)
 {
-  // Put the new message in map for the given receiver and subject.
-  m_messages[m_currentList][message.to][message.subject].push_back(message);
+  const auto it = m_nameIds.find(name);
+  if (it != m_nameIds.end()) {
+    return it->second;
+  }
+
+  const unsigned int id = m_names.size();
+  m_names.push_back(name);
+  m_nameIds.emplace(name, id);
+
+  // Insert the name in the alphabetical order, shifting the orders of the following names.
+  const auto pos = std::lower_bound(m_sortedIds.begin(),
+                                    m_sortedIds.end(),
+                                    name,
+                                    [this](unsigned int other, const std::string &name) {
+                                      return m_names[other] < name;
+                                    });
+  const unsigned int order = pos - m_sortedIds.begin();
+  for (auto next = pos, end = m_sortedIds.end(); next != end; ++next) {
+    ++m_nameOrders[*next];
+  }
+  m_sortedIds.insert(pos, id);
+  m_nameOrders.push_back(order);
+
+  return id;
 }
 
-const std::vector<KX_NetworkMessageManager::Message> KX_NetworkMessageManager::GetMessages(
-    std::string to, std::string subject)
+unsigned int KX_NetworkMessageManager::FindName(const std::string &name) const
 {
-  std::vector<KX_NetworkMessageManager::Message> messages;
+  const auto it = m_nameIds.find(name);
+  if (it == m_nameIds.end()) {
+    return INVALID_NAME;
+  }
+  return it->second;
+}
 
-  // look at messages without receiver.
-  std::map<std::string, std::vector<Message>> &messagesNoReceiver =
-      m_messages[1 - m_currentList][""];
-  std::map<std::string, std::vector<Message>> &messagesReceiver =
-      m_messages[1 - m_currentList][to];
-  if (subject.empty()) {
-    // Add all message without receiver and subject.
-    for (const auto &pair : messagesNoReceiver) {
-      messages.insert(messages.end(), pair.second.begin(), pair.second.end());
+const std::string &KX_NetworkMessageManager::GetName(unsigned int id) const
+{
+  return m_names[id];
+}
+
+void KX_NetworkMessageManager::AddMessage(const std::string &to,
+                                          SCA_IObject *from,
+                                          const std::string &subject,
+                                          const std::string &body)
+{
+  if (m_listener) {
+    m_listener->MessageAdded(to, subject, body);
+  }
+
+  AddRemoteMessage(to, from, subject, body);
+}
+
+void KX_NetworkMessageManager::AddRemoteMessage(const std::string &to,
+                                                SCA_IObject *from,
+                                                const std::string &subject,
+                                                const std::string &body)
+{
+  MessageFrame &frame = *m_currentFrame;
+  const Message message = {RegisterName(to),
+                           RegisterName(subject),
+                           from,
+                           (unsigned int)frame.m_bodies.size(),
+                           (unsigned int)body.size()};
+  frame.m_bodies.append(body);
+  frame.m_messages.push_back(message);
+}
+
+void KX_NetworkMessageManager::CompactNames(MessageFrame &frame)
+{
+  if (m_names.size() <= m_namesMaxCount) {
+    return;
+  }
+
+  // Keep the empty name and the names used by the frame, renumbered in order of use.
+  std::vector<unsigned int> newIds(m_names.size(), INVALID_NAME);
+  std::deque<std::string> names;
+  newIds[0] = 0;
+  names.push_back(std::move(m_names[0]));
+  for (Message &message : frame.m_messages) {
+    for (unsigned int *id : {&message.to, &message.subject}) {
+      if (newIds[*id] == INVALID_NAME) {
+        newIds[*id] = names.size();
+        names.push_back(std::move(m_names[*id]));
+      }
+      *id = newIds[*id];
     }
-    // Add all message with the given receiver and no subject.
-    for (const auto &pair : messagesReceiver) {
-      messages.insert(messages.end(), pair.second.begin(), pair.second.end());
+  }
+
+  m_names = std::move(names);
+  m_nameIds.clear();
+  for (unsigned int i = 0, size = m_names.size(); i < size; ++i) {
+    m_nameIds.emplace(m_names[i], i);
+  }
+
+  m_sortedIds.resize(m_names.size());
+  std::iota(m_sortedIds.begin(), m_sortedIds.end(), 0);
+  std::sort(m_sortedIds.begin(), m_sortedIds.end(), [this](unsigned int id1, unsigned int id2) {
+    return m_names[id1] < m_names[id2];
+  });
+  m_nameOrders.resize(m_names.size());
+  for (unsigned int i = 0, size = m_sortedIds.size(); i < size; ++i) {
+    m_nameOrders[m_sortedIds[i]] = i;
+  }
+
+  // Avoid compacting at each frame when the frames use many names.
+  m_namesMaxCount = std::max(NAMES_MIN_MAX_COUNT, (unsigned int)m_names.size() * 2);
+}
+
+void KX_NetworkMessageManager::FinishFrame(MessageFrame &frame)
+{
+  if (frame.m_messages.empty()) {
+    return;
+  }
+
+  /* Group the messages by receiver and then by subject in alphabetical order,
+   * keeping the order of sending for the same receiver and subject. */
+  std::stable_sort(frame.m_messages.begin(),
+                   frame.m_messages.end(),
+                   [this](const Message &message1, const Message &message2) {
+                     if (message1.to != message2.to) {
+                       return message1.to < message2.to;
+                     }
+                     return m_nameOrders[message1.subject] < m_nameOrders[message2.subject];
+                   });
+}
+
+std::pair<unsigned int, unsigned int> KX_NetworkMessageManager::FindRange(
+    unsigned int to, unsigned int subject) const
+{
+  const std::vector<Message> &messages = m_lastFrame->m_messages;
+  const unsigned int order = m_nameOrders[subject];
+  const auto lower = std::lower_bound(
+      messages.begin(), messages.end(), to, [this, order](const Message &message, unsigned int to) {
+        return message.to < to || (message.to == to && m_nameOrders[message.subject] < order);
+      });
+  const auto upper = std::upper_bound(
+      lower, messages.end(), to, [this, order](unsigned int to, const Message &message) {
+        return to < message.to || (to == message.to && order < m_nameOrders[message.subject]);
+      });
+
+  return {lower - messages.begin(), upper - messages.begin()};
+}
+
+std::pair<unsigned int, unsigned int> KX_NetworkMessageManager::FindRange(unsigned int to) const
+{
+  const std::vector<Message> &messages = m_lastFrame->m_messages;
+  const auto lower = std::lower_bound(
+      messages.begin(), messages.end(), to, [](const Message &message, unsigned int to) {
+        return message.to < to;
+      });
+  const auto upper = std::upper_bound(
+      lower, messages.end(), to, [](unsigned int to, const Message &message) {
+        return to < message.to;
+      });
+
+  return {lower - messages.begin(), upper - messages.begin()};
+}
+
+KX_NetworkMessageManager::MessageList KX_NetworkMessageManager::GetMessages(
+    const std::string &to, const std::string &subject) const
+{
+  MessageList list;
+  list.m_manager = this;
+  list.m_frame = m_lastFrame;
+
+  if (m_lastFrame->m_messages.empty()) {
+    return list;
+  }
+
+  // The names never used are not used by any message.
+  const unsigned int toId = FindName(to);
+  if (subject.empty()) {
+    // All the messages without receiver and then the messages with the given receiver.
+    list.m_ranges[0] = FindRange(0);
+    if (toId != INVALID_NAME && toId != 0) {
+      list.m_ranges[1] = FindRange(toId);
     }
   }
   else {
-    std::vector<KX_NetworkMessageManager::Message> &messagesNoReceiverSubject =
-        messagesNoReceiver[subject];
-    messages.insert(
-        messages.end(), messagesNoReceiverSubject.begin(), messagesNoReceiverSubject.end());
-    std::vector<KX_NetworkMessageManager::Message> &messagesReceiverSubject =
-        messagesReceiver[subject];
-    messages.insert(
-        messages.end(), messagesReceiverSubject.begin(), messagesReceiverSubject.end());
+    const unsigned int subjectId = FindName(subject);
+    if (subjectId == INVALID_NAME) {
+      return list;
+    }
+
+    list.m_ranges[0] = FindRange(0, subjectId);
+    if (toId != INVALID_NAME && toId != 0) {
+      list.m_ranges[1] = FindRange(toId, subjectId);
+    }
   }
 
-  return messages;
+  return list;
 }
 
 void KX_NetworkMessageManager::ClearMessages()
 {
-  // Clear previous list.
-  m_messages[1 - m_currentList].clear();
-  m_currentList = 1 - m_currentList;
+  // Reuse the previous frame buffers if no message list is using them.
+  std::shared_ptr<MessageFrame> frame = std::move(m_lastFrame);
+  if (frame.use_count() == 1) {
+    frame->m_messages.clear();
+    frame->m_bodies.clear();
+  }
+  else {
+    frame = std::make_shared<MessageFrame>();
+  }
+
+  m_lastFrame = std::move(m_currentFrame);
+  m_currentFrame = std::move(frame);
+  // The names are only used by the last frame, the current frame is empty.
+  CompactNames(*m_lastFrame);
+  FinishFrame(*m_lastFrame);
+}
+
+void KX_NetworkMessageManager::SetListener(KX_NetworkMessageListener *listener)
+{
+  m_listener = listener;
 }
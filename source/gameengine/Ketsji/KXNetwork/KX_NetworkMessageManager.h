@@ -34,51 +34,143 @@ conflicts with KX_NetworkMessageManager::SendMessage */
 #  undef SendMessage
 #endif
 
-#include <map>
+#include <array>
+#include <deque>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 class SCA_IObject;
 
+/// Interface receiving the messages added by the logic, used to send them to other engines.
+class KX_NetworkMessageListener {
+ public:
+  virtual ~KX_NetworkMessageListener() = default;
+
+  virtual void MessageAdded(const std::string &to,
+                            const std::string &subject,
+                            const std::string &body) = 0;
+};
+
 class KX_NetworkMessageManager {
  public:
   struct Message {
-    /// Receiver object(s) name.
-    std::string to;
+    /// Receiver object(s) name identifier.
+    unsigned int to;
+    /// Message subject identifier, used as filter.
+    unsigned int subject;
     /// Sender game object.
     SCA_IObject *from;
-    /// Message subject, used as filter.
-    std::string subject;
-    /// Message body.
-    std::string body;
+    /// Position of the body in the bodies of the frame.
+    unsigned int bodyOffset;
+    unsigned int bodySize;
   };
 
- private:
-  /** List of all messages, filtered by receiver object(s) name and subject name.
-   * We use two lists, one handle sended message in the current frame and the other
-   * is used for handle message sended in the last frame for sensors.
+  /** All the messages sent during a frame, the bodies are stored contiguously.
+   * Once the frame is finished the messages are sorted by receiver and subject.
+   */
+  class MessageFrame {
+    friend class KX_NetworkMessageManager;
+
+   private:
+    std::vector<Message> m_messages;
+    std::string m_bodies;
+
+   public:
+    std::string_view GetBody(const Message &message) const;
+  };
+
+  /** Messages of the last frame for a receiver and a subject, without copy of the messages:
+   * a range of messages sent to all objects followed by a range of messages sent to the
+   * receiver. The list keeps the frame alive but must be released before the frame changes,
+   * the frame is reused and the subject identifiers can be renumbered.
    */
-  std::map<std::string, std::map<std::string, std::vector<Message>>> m_messages[2];
+  class MessageList {
+    friend class KX_NetworkMessageManager;
 
-  /** Since we use two list for the current and last frame we have to switch of
-   * current message list each frame. This value is only 0 or 1.
+   private:
+    const KX_NetworkMessageManager *m_manager;
+    std::shared_ptr<const MessageFrame> m_frame;
+    /// Begin and end indices of the ranges in the frame messages.
+    std::array<std::pair<unsigned int, unsigned int>, 2> m_ranges;
+
+   public:
+    MessageList();
+
+    unsigned int GetSize() const;
+    const Message &GetMessage(unsigned int index) const;
+    std::string_view GetBody(unsigned int index) const;
+    const std::string &GetSubject(unsigned int index) const;
+  };
+
+ private:
+  /// Receiver names and subjects identifiers, the empty name is always 0.
+  std::unordered_map<std::string, unsigned int> m_nameIds;
+  /// Names per identifier, a deque to not move the strings.
+  std::deque<std::string> m_names;
+  /** Alphabetical order of the names per identifier, used to sort the messages of a receiver
+   * by subject. The new names are inserted in place, keeping the relative order of the others.
    */
-  unsigned short m_currentList;
+  std::vector<unsigned int> m_nameOrders;
+  /// Identifiers in alphabetical order of the names.
+  std::vector<unsigned int> m_sortedIds;
+  /// Number of names over which the names unused by the last frame are removed.
+  unsigned int m_namesMaxCount;
+
+  /// Messages sent in the current frame, read by the sensors the next frame.
+  std::shared_ptr<MessageFrame> m_currentFrame;
+  /// Messages sent in the last frame, read by the sensors.
+  std::shared_ptr<MessageFrame> m_lastFrame;
+
+  /// Listener of the added messages, null when the messages are not sent to other engines.
+  KX_NetworkMessageListener *m_listener;
+
+  /// Return the identifier of a name, registering it if needed.
+  unsigned int RegisterName(const std::string &name);
+  /// Return the identifier of a name or -1 if it was never used.
+  unsigned int FindName(const std::string &name) const;
+  /// Remove the names unused by a frame if there are too many names, renumbering its messages.
+  void CompactNames(MessageFrame &frame);
+  /// Sort the messages of a finished frame.
+  void FinishFrame(MessageFrame &frame);
+  /// Return the range of messages of the last frame for a receiver and a subject.
+  std::pair<unsigned int, unsigned int> FindRange(unsigned int to, unsigned int subject) const;
+  /// Return the range of messages of the last frame for a receiver and any subject.
+  std::pair<unsigned int, unsigned int> FindRange(unsigned int to) const;
 
  public:
   KX_NetworkMessageManager();
   virtual ~KX_NetworkMessageManager();
 
-  /** Add a message in the next message list.
-   * \param message The given message to add.
+  /** Add a message in the next message list, the message is also given to the listener.
+   * \param to The receiver object(s) name, empty for all objects.
+   * \param from The sender game object.
+   * \param subject The message subject.
+   * \param body The message body, copied once in the frame bodies.
    */
-  void AddMessage(Message message);
+  void AddMessage(const std::string &to,
+                  SCA_IObject *from,
+                  const std::string &subject,
+                  const std::string &body);
+  /// Add a message received from another engine in the next message list.
+  void AddRemoteMessage(const std::string &to,
+                        SCA_IObject *from,
+                        const std::string &subject,
+                        const std::string &body);
   /** Get all messages for a given receiver object name and message subject.
    * \param to The object(s) name.
-   * \param subject The message subject/filter.
+   * \param subject The message subject/filter, empty for all subjects.
    */
-  const std::vector<Message> GetMessages(std::string to, std::string subject);
+  MessageList GetMessages(const std::string &to, const std::string &subject) const;
+
+  /// Return the receiver name or subject of an identifier.
+  const std::string &GetName(unsigned int id) const;
 
   /// Clear all messages
   void ClearMessages();
+
+  /// Set the listener of the messages added by the logic, null to remove it.
+  void SetListener(KX_NetworkMessageListener *listener);
 };
@@ -32,7 +32,14 @@
 KX_CollisionContactPoint::KX_CollisionContactPoint(const PHY_ICollData *collData,
                                                    unsigned int index,
                                                    bool firstObject)
-    : m_collData(collData), m_index(index), m_firstObject(firstObject)
+    : m_localPointA(collData->GetLocalPointA(index, firstObject)),
+      m_localPointB(collData->GetLocalPointB(index, firstObject)),
+      m_worldPoint(collData->GetWorldPoint(index, firstObject)),
+      m_normal(collData->GetNormal(index, firstObject)),
+      m_combinedFriction(collData->GetCombinedFriction(index, firstObject)),
+      m_combinedRollingFriction(collData->GetCombinedRollingFriction(index, firstObject)),
+      m_combinedRestitution(collData->GetCombinedRestitution(index, firstObject)),
+      m_appliedImpulse(collData->GetAppliedImpulse(index, firstObject))
 {
 }
 
@@ -110,60 +117,56 @@ PyObject *KX_CollisionContactPoint::pyattr_get_local_point_a(EXP_PyObjectPlus *s
                                                              const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_CollisionContactPoint *self = static_cast<KX_CollisionContactPoint *>(self_v);
-  return PyObjectFrom(self->m_collData->GetLocalPointA(self->m_index, self->m_firstObject));
+  return PyObjectFrom(self->m_localPointA);
 }
 
 PyObject *KX_CollisionContactPoint::pyattr_get_local_point_b(EXP_PyObjectPlus *self_v,
                                                              const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_CollisionContactPoint *self = static_cast<KX_CollisionContactPoint *>(self_v);
-  return PyObjectFrom(self->m_collData->GetLocalPointB(self->m_index, self->m_firstObject));
+  return PyObjectFrom(self->m_localPointB);
 }
 
 PyObject *KX_CollisionContactPoint::pyattr_get_world_point(EXP_PyObjectPlus *self_v,
                                                            const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_CollisionContactPoint *self = static_cast<KX_CollisionContactPoint *>(self_v);
-  return PyObjectFrom(self->m_collData->GetWorldPoint(self->m_index, self->m_firstObject));
+  return PyObjectFrom(self->m_worldPoint);
 }
 
 PyObject *KX_CollisionContactPoint::pyattr_get_normal(EXP_PyObjectPlus *self_v,
                                                       const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_CollisionContactPoint *self = static_cast<KX_CollisionContactPoint *>(self_v);
-  return PyObjectFrom(self->m_collData->GetNormal(self->m_index, self->m_firstObject));
+  return PyObjectFrom(self->m_normal);
 }
 
 PyObject *KX_CollisionContactPoint::pyattr_get_combined_friction(
     EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_CollisionContactPoint *self = static_cast<KX_CollisionContactPoint *>(self_v);
-  return PyFloat_FromDouble(
-      self->m_collData->GetCombinedFriction(self->m_index, self->m_firstObject));
+  return PyFloat_FromDouble(self->m_combinedFriction);
 }
 
 PyObject *KX_CollisionContactPoint::pyattr_get_combined_rolling_friction(
     EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_CollisionContactPoint *self = static_cast<KX_CollisionContactPoint *>(self_v);
-  return PyFloat_FromDouble(
-      self->m_collData->GetCombinedRollingFriction(self->m_index, self->m_firstObject));
+  return PyFloat_FromDouble(self->m_combinedRollingFriction);
 }
 
 PyObject *KX_CollisionContactPoint::pyattr_get_combined_restitution(
     EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_CollisionContactPoint *self = static_cast<KX_CollisionContactPoint *>(self_v);
-  return PyFloat_FromDouble(
-      self->m_collData->GetCombinedRestitution(self->m_index, self->m_firstObject));
+  return PyFloat_FromDouble(self->m_combinedRestitution);
 }
 
 PyObject *KX_CollisionContactPoint::pyattr_get_applied_impulse(EXP_PyObjectPlus *self_v,
                                                                const EXP_PYATTRIBUTE_DEF *attrdef)
 {
   KX_CollisionContactPoint *self = static_cast<KX_CollisionContactPoint *>(self_v);
-  return PyFloat_FromDouble(
-      self->m_collData->GetAppliedImpulse(self->m_index, self->m_firstObject));
+  return PyFloat_FromDouble(self->m_appliedImpulse);
 }
 
 static int kx_collision_contact_point_list_get_sensors_size_cb(void *self_v)
@@ -28,15 +28,22 @@
 
 #include "EXP_ListWrapper.h"
 #include "EXP_Value.h"
+#include "MT_Vector3.h"
 
 class PHY_ICollData;
 
 class KX_CollisionContactPoint : public EXP_Value {
   Py_Header protected :
-      /// All infos about contact position, normal, friction ect…
-      const PHY_ICollData *m_collData;
-  const unsigned int m_index;
-  const bool m_firstObject;
+      /// All infos about contact position, normal, friction ect…, copied as the collision data
+      /// are reused by the physics at the next step while the point can be kept by Python.
+      MT_Vector3 m_localPointA;
+  MT_Vector3 m_localPointB;
+  MT_Vector3 m_worldPoint;
+  MT_Vector3 m_normal;
+  float m_combinedFriction;
+  float m_combinedRollingFriction;
+  float m_combinedRestitution;
+  float m_appliedImpulse;
 
  public:
   KX_CollisionContactPoint(const PHY_ICollData *collData, unsigned int index, bool firstObject);
@@ -62,7 +62,7 @@ bool KX_CollisionEventManager::NewHandleCollision(PHY_IPhysicsController *ctrl1,
                                                   const PHY_ICollData *coll_data,
                                                   bool first)
 {
-  m_newCollisions.insert(NewCollision(ctrl1, ctrl2, coll_data, first));
+  m_newCollisions.emplace_back(ctrl1, ctrl2, coll_data, first);
 
   return false;
 }
@@ -239,23 +239,3 @@ KX_CollisionEventManager::NewCollision::NewCollision(PHY_IPhysicsController *_fi
     : first(_first), second(_second), colldata(_colldata), isFirst(_isfirst)
 {
 }
-
-KX_CollisionEventManager::NewCollision::NewCollision(const NewCollision &to_copy)
-    : first(to_copy.first), second(to_copy.second), colldata(to_copy.colldata), isFirst(to_copy.isFirst)
-{
-}
-
-bool KX_CollisionEventManager::NewCollision::operator<(const NewCollision &other) const
-{
-  // see strict weak ordering: https://support.microsoft.com/en-us/kb/949171
-  if (first == other.first) {
-    if (second == other.second) {
-      if (colldata == other.colldata) {
-        return isFirst < other.isFirst;
-      }
-      return colldata < other.colldata;
-    }
-    return second < other.second;
-  }
-  return first < other.first;
-}
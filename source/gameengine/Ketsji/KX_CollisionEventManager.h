@@ -31,7 +31,6 @@
 
 #pragma once
 
-#include <set>
 #include <vector>
 
 #include "KX_GameObject.h"
@@ -52,24 +51,20 @@ class KX_CollisionEventManager : public SCA_EventManager {
     const PHY_ICollData *colldata;
     bool isFirst;
 
-    /**
-     * Creates a copy of the given PHY_ICollData; freeing that copy should be done by the owner of
-     * the NewCollision object.
-     *
-     * This allows us to efficiently store NewCollision objects in a std::set without creating more
-     * copies of colldata, as the NewCollision copy constructor reuses the pointer and doesn't
-     * clone it again. */
+    /** The collision data is owned by the physics environment and stays valid until the next
+     * physics step. */
     NewCollision(PHY_IPhysicsController *first,
                  PHY_IPhysicsController *second,
                  const PHY_ICollData *colldata,
                  bool isFirst);
-    NewCollision(const NewCollision &to_copy);
-    bool operator<(const NewCollision &other) const;
   };
 
   PHY_IPhysicsEnvironment *m_physEnv;
 
-  std::set<NewCollision> m_newCollisions;
+  /** The collisions reported during the last physics step in the order of the physics
+   * environment, each manifold being reported once. The capacity is kept between the frames to
+   * not allocate per collision. */
+  std::vector<NewCollision> m_newCollisions;
 
   static bool newCollisionResponse(void *client_data,
                                    PHY_IPhysicsController *ctrl1,
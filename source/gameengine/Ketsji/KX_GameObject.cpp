@@ -43,16 +43,17 @@
 #include "BKE_lib_id.hh"
 #include "BKE_mball.hh"
 #include "BKE_object.hh"
+#include "BLI_bounds_types.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "DEG_depsgraph_query.hh"
 #include "DNA_mesh_types.h"
 #include "DNA_scene_types.h"
-#include "WM_api.hh"
 
 #include "BL_Action.h"
 #include "BL_ActionManager.h"
 #include "BL_SceneConverter.h"
+#include "CM_Profiler.h"
 #include "KX_ClientObjectInfo.h"
 #include "KX_CollisionContactPoints.h"
 #include "KX_Globals.h"
@@ -61,10 +62,12 @@
 #include "KX_MeshProxy.h"
 #include "KX_NetworkMessageScene.h"  //Needed for sendMessage()
 #include "KX_NodeRelationships.h"
+#include "KX_ObjectPool.h"
 #include "KX_PolyProxy.h"
 #include "KX_PyMath.h"
 #include "KX_PythonComponent.h"
 #include "KX_RayCast.h"
+#include "PHY_IGraphicController.h"
 #include "SCA_ISensor.h"
 #include "SG_Controller.h"
 
@@ -80,15 +83,50 @@ static MT_Matrix3x3 dummy_orientation = MT_Matrix3x3(
     1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
 
 KX_GameObject::ActivityCullingInfo::ActivityCullingInfo()
-    : m_flags(ACTIVITY_NONE), m_physicsRadius(0.0f), m_logicRadius(0.0f)
+    : m_flags(ACTIVITY_NONE),
+      m_physicsRadius(0.0f),
+      m_logicRadius(0.0f),
+      m_checkMargin(0.0f),
+      m_checkTravel(0.0),
+      m_checkGeneration(0),
+      m_checkPosition(0.0f, 0.0f, 0.0f)
 {
 }
 
+void KX_GameObject::ActivityCullingInfo::InvalidateCheck()
+{
+  m_checkMargin = 0.0f;
+}
+
+void KX_GameObject::ActivityCullingInfo::SetChecked(float distance,
+                                                    const MT_Vector3 &position,
+                                                    double travel,
+                                                    unsigned int generation)
+{
+  /* The distance to the nearest camera can't change more than the distance traveled by the
+   * object and the cameras, until then the object stays on the same side of each radius. */
+  const float dist = std::sqrt(distance);
+  float margin = FLT_MAX;
+  if (m_flags & ACTIVITY_PHYSICS) {
+    margin = min_ff(margin, std::fabs(dist - std::sqrt(m_physicsRadius)));
+  }
+  if (m_flags & ACTIVITY_LOGIC) {
+    margin = min_ff(margin, std::fabs(dist - std::sqrt(m_logicRadius)));
+  }
+
+  m_checkMargin = margin;
+  m_checkTravel = travel;
+  m_checkGeneration = generation;
+  m_checkPosition = position;
+}
+
 KX_GameObject::KX_GameObject()
     : SCA_IObject(),
-      m_isReplica(false),            // eevee
-      m_forceIgnoreParentTx(false),  // eevee
-      m_previousLodLevel(-1),        // eevee
+      m_isReplica(false),                     // eevee
+      m_poolTemplate(nullptr),                // eevee
+      m_forceIgnoreParentTx(false),           // eevee
+      m_dirtyListState(DIRTY_LIST_DISABLED),  // eevee
+      m_previousLodLevel(-1),                 // eevee
       m_layer(0),
       m_lodManager(nullptr),
       m_currentLodLevel(0),
@@ -99,6 +137,7 @@ KX_GameObject::KX_GameObject()
       m_bVisible(true),
       m_bOccluder(false),
       m_pPhysicsController(nullptr),
+      m_pGraphicController(nullptr),
       m_pSGNode(nullptr),
       m_pInstanceObjects(nullptr),
       m_pDupliGroupObject(nullptr),
@@ -112,6 +151,8 @@ KX_GameObject::KX_GameObject()
 #endif
 {
   m_pClient_info = new KX_ClientObjectInfo(this, KX_ClientObjectInfo::ACTOR);
+  // The object is visible until a culling pass tells otherwise.
+  m_cullingNode.SetCulled(false);
 
   unit_m4(m_prevobject_to_world);  // eevee
 };
@@ -149,6 +190,7 @@ KX_GameObject::~KX_GameObject()
     if (ob->gameflag & OB_OVERLAY_COLLECTION) {
       ob->gameflag &= ~OB_OVERLAY_COLLECTION;
     }
+    ob->gameflag &= ~OB_CULLED;
   }
 
   if (m_pSGNode) {
@@ -194,6 +236,10 @@ KX_GameObject::~KX_GameObject()
     delete m_pPhysicsController;
   }
 
+  if (m_pGraphicController) {
+    delete m_pGraphicController;
+  }
+
   if (m_actionManager) {
     delete m_actionManager;
   }
@@ -236,6 +282,8 @@ void KX_GameObject::SyncTransformWithDepsgraph()
 void KX_GameObject::ForceIgnoreParentTx()
 {
   m_forceIgnoreParentTx = true;
+  // The children must be processed in the next render pass even if the object didn't move.
+  GetScene()->AddDirtyObject(this);
 }
 
 void KX_GameObject::TagForTransformUpdate(bool is_overlay_pass, bool is_last_render_pass)
@@ -346,27 +394,38 @@ void KX_GameObject::ReplicateBlenderObject()
   if (ob) {
     bContext *C = KX_GetActiveEngine()->GetContext();
     Main *bmain = CTX_data_main(C);
-    Object *newob;
-    BKE_id_copy_ex(bmain, &ob->id, (ID **)&newob, 0);
-    id_us_min(&newob->id);
     Scene *scene = GetScene()->GetBlenderScene();
-    ViewLayer *view_layer = BKE_view_layer_default_view(scene);
-    BKE_collection_object_add_from(bmain,
-                                   scene,
-                                   BKE_view_layer_camera_find(scene, view_layer),
-                                   newob);  // add replica where is the active camera
-
-    /* Avoid to make instance_collections "containers" visibled
-     * when replicating as we want only the instances created in DupliGroupRecuse
-     * to be visibled */
-    if (!ob->instance_collection) {
-      newob->base_flag |= (BASE_ENABLED_AND_MAYBE_VISIBLE_IN_VIEWPORT |
-                           BASE_ENABLED_AND_VISIBLE_IN_DEFAULT_VIEWPORT);
-      newob->visibility_flag &= ~OB_HIDE_VIEWPORT;
+    Object *newob;
+
+    /* Replicas of original objects reuse the hidden objects of the scene pool,
+     * avoiding an ID copy and a depsgraph relations update per replica. */
+    m_poolTemplate = (!m_isReplica && KX_ObjectPool::IsPoolable(ob)) ? ob : nullptr;
+
+    if (m_poolTemplate) {
+      newob = GetScene()->GetObjectPool()->Acquire(ob);
     }
+    else {
+      BKE_id_copy_ex(bmain, &ob->id, (ID **)&newob, 0);
+      id_us_min(&newob->id);
+      ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+      BKE_collection_object_add_from(bmain,
+                                     scene,
+                                     BKE_view_layer_camera_find(scene, view_layer),
+                                     newob);  // add replica where is the active camera
+
+      /* Avoid to make instance_collections "containers" visibled
+       * when replicating as we want only the instances created in DupliGroupRecuse
+       * to be visibled */
+      if (!ob->instance_collection) {
+        newob->base_flag |= (BASE_ENABLED_AND_MAYBE_VISIBLE_IN_VIEWPORT |
+                             BASE_ENABLED_AND_VISIBLE_IN_DEFAULT_VIEWPORT);
+        newob->visibility_flag &= ~OB_HIDE_VIEWPORT;
+      }
 
-    /* This will call BKE_main_collection_sync_remap at frame end. */
-    GetScene()->TagForCollectionRemap();
+      /* This will call BKE_main_collection_sync_remap at frame end. */
+      GetScene()->TagForCollectionRemap();
+      DEG_relations_tag_update(bmain);
+    }
 
     /* Attempt to fix missing notifier in special cases (realtime compositor when overlay pass)
      * See: https://github.com/UPBGE/upbge/issues/1818 - Would maybe need more investigations
@@ -382,8 +441,6 @@ void KX_GameObject::ReplicateBlenderObject()
       }
     }
 
-    DEG_relations_tag_update(bmain);
-
     m_pBlenderObject = newob;
     m_isReplica = true;
   }
@@ -396,7 +453,14 @@ void KX_GameObject::RemoveOrHideBlenderObject()
     if (ctrl) {
       ctrl->RemoveSoftBodyModifier(ob);
     }
-    if (m_isReplica) {
+    if (m_poolTemplate) {
+      /* Keep the object hidden in the pool for the next replica of the same template. */
+      GetScene()->GetBlenderSceneConverter()->UnregisterGameObject(this);
+      GetScene()->GetObjectPool()->Release(m_poolTemplate, ob);
+      SetBlenderObject(nullptr);
+      m_poolTemplate = nullptr;
+    }
+    else if (m_isReplica) {
       bContext *C = KX_GetActiveEngine()->GetContext();
       Main *bmain = CTX_data_main(C);
       BKE_id_delete(bmain, ob);
@@ -548,10 +612,12 @@ KX_GameObject::ActivityCullingInfo &KX_GameObject::GetActivityCullingInfo()
 void KX_GameObject::SetActivityCullingInfo(const ActivityCullingInfo &cullingInfo)
 {
   m_activityCullingInfo = cullingInfo;
+  m_activityCullingInfo.InvalidateCheck();
 }
 
 void KX_GameObject::SetActivityCulling(ActivityCullingInfo::Flag flag, bool enable)
 {
+  m_activityCullingInfo.InvalidateCheck();
   if (enable) {
     m_activityCullingInfo.m_flags = (ActivityCullingInfo::Flag)(m_activityCullingInfo.m_flags |
                                                                 flag);
@@ -592,6 +658,16 @@ float *KX_GameObject::GetPrevObjectMatToWorld()
   return (float *)m_prevobject_to_world;
 }
 
+KX_GameObject::DirtyListState KX_GameObject::GetDirtyListState() const
+{
+  return m_dirtyListState;
+}
+
+void KX_GameObject::SetDirtyListState(DirtyListState state)
+{
+  m_dirtyListState = state;
+}
+
 /********************End of EEVEE INTEGRATION*********************/
 
 KX_GameObject *KX_GameObject::GetClientObject(KX_ClientObjectInfo *info)
@@ -859,6 +935,16 @@ void KX_GameObject::UpdateActionManager(float curtime, bool applyToObject)
   GetActionManager()->Update(curtime, applyToObject);
 }
 
+void KX_GameObject::UpdateActions(float curtime, bool applyToObject)
+{
+  GetActionManager()->UpdateActions(curtime, applyToObject);
+}
+
+void KX_GameObject::UpdateActionIPOs()
+{
+  GetActionManager()->UpdateIPOs();
+}
+
 float KX_GameObject::GetActionFrame(short layer)
 {
   return GetActionManager()->GetActionFrame(layer);
@@ -897,6 +983,7 @@ void KX_GameObject::ProcessReplica()
   }
 
   m_pPhysicsController = nullptr;
+  m_pGraphicController = nullptr;
   m_pSGNode = nullptr;
 
   /* Dupli group and instance list are set later in replication.
@@ -907,6 +994,10 @@ void KX_GameObject::ProcessReplica()
   m_pClient_info->m_gameobject = this;
   m_actionManager = nullptr;
   m_state = 0;
+  // The replica is activated when added in the scene object list.
+  m_dirtyListState = DIRTY_LIST_DISABLED;
+  // The replica can be added in another scene.
+  m_activityCullingInfo.InvalidateCheck();
 
 #ifdef WITH_PYTHON
 
@@ -1071,7 +1162,59 @@ void KX_GameObject::RemoveMeshes()
 
 bool KX_GameObject::UseCulling() const
 {
-  return false;
+  return !m_meshes.empty();
+}
+
+void KX_GameObject::UpdateBounds()
+{
+  Object *ob = GetBlenderObject();
+  if (!ob) {
+    return;
+  }
+
+  using namespace blender;
+  const std::optional<Bounds<float3>> bounds = BKE_object_boundbox_eval_cached_get(ob);
+  if (!bounds) {
+    return;
+  }
+
+  const MT_Vector3 min(bounds->min.x, bounds->min.y, bounds->min.z);
+  const MT_Vector3 max(bounds->max.x, bounds->max.y, bounds->max.z);
+  m_cullingNode.GetAabb().Set(min, max);
+  if (m_pGraphicController) {
+    m_pGraphicController->SetLocalAabb(min, max);
+  }
+}
+
+static void activate_graphic_controller_recursive(SG_Node *node, bool active)
+{
+  const NodeList &children = node->GetSGChildren();
+
+  for (SG_Node *childnode : children) {
+    KX_GameObject *clientgameobj = static_cast<KX_GameObject *>(childnode->GetSGClientObject());
+    if (clientgameobj != nullptr && clientgameobj->GetGraphicController()) {
+      clientgameobj->GetGraphicController()->Activate(active);
+    }
+
+    // if the childobj is nullptr then this may be an inverse parent link
+    // so a non recursive search should still look down this node.
+    activate_graphic_controller_recursive(childnode, active);
+  }
+}
+
+void KX_GameObject::ActivateGraphicController(bool active, bool recurse)
+{
+  if (m_pGraphicController) {
+    m_pGraphicController->Activate(active);
+  }
+  if (recurse) {
+    activate_graphic_controller_recursive(GetSGNode(), active);
+  }
+}
+
+SG_CullingNode &KX_GameObject::GetCullingNode()
+{
+  return m_cullingNode;
 }
 
 void KX_GameObject::SetLodManager(KX_LodManager *lodManager)
@@ -1102,15 +1245,18 @@ KX_LodManager *KX_GameObject::GetLodManager() const
   return m_lodManager;
 }
 
-void KX_GameObject::UpdateLod(const MT_Vector3 &cam_pos, float lodfactor)
+short KX_GameObject::GetCurrentLodLevel() const
+{
+  return m_currentLodLevel;
+}
+
+void KX_GameObject::UpdateLod(KX_LodLevel *lodLevel)
 {
   if (!m_lodManager) {
     return;
   }
 
   KX_Scene *scene = GetScene();
-  const float distance2 = NodeGetWorldPosition().distance2(cam_pos) * (lodfactor * lodfactor);
-  KX_LodLevel *lodLevel = m_lodManager->GetLevel(scene, m_currentLodLevel, distance2);
 
   bool updatePhysicsShape = false;
   if (GetBlenderObject()->gameflag & OB_LOD_UPDATE_PHYSICS) {
@@ -1184,6 +1330,8 @@ void KX_GameObject::UpdateTransform()
   // HACK: saves function call for dynamic object, they are handled differently
   if (m_pPhysicsController && !m_pPhysicsController->IsDynamic())
     m_pPhysicsController->SetTransform();
+  if (m_pGraphicController)
+    m_pGraphicController->SetGraphicTransform();
 }
 
 void KX_GameObject::UpdateTransformFunc(SG_Node *node, void *gameobj, void *scene)
@@ -1362,8 +1510,10 @@ void KX_GameObject::SetObjectColor(const MT_Vector4 &rgbavec)
   if (ob_orig && GetScene()->OrigObCanBeTransformedInRealtime(ob_orig) &&
       ELEM(ob_orig->type, OB_MESH, OB_CURVES_LEGACY, OB_SURF, OB_FONT, OB_MBALL)) {
     copy_v4_v4(ob_orig->color, m_objectColor.getValue());
-    DEG_id_tag_update(&ob_orig->id, ID_RECALC_SHADING | ID_RECALC_TRANSFORM);
-    WM_main_add_notifier(NC_OBJECT | ND_DRAW, &ob_orig->id);
+    // Also called by the color controllers, which can be updated in parallel.
+    GetScene()->AppendToIdsToUpdate(&ob_orig->id,
+                                    (IDRecalcFlag)(ID_RECALC_SHADING | ID_RECALC_TRANSFORM),
+                                    ob_orig->gameflag & OB_OVERLAY_COLLECTION);
   }
 }
 
@@ -1855,16 +2005,24 @@ void KX_GameObject::SetComponents(EXP_ListValue<KX_PythonComponent> *components)
 #endif
 }
 
-void KX_GameObject::Update()
+void KX_GameObject::UpdateComponents(unsigned int tick, double time)
 {
 #ifdef WITH_PYTHON
-  if (!m_logicSuspended) {
-    if (m_components) {
-      for (KX_PythonComponent *comp : m_components) {
+  // Suspended by the logic or the activity culling.
+  if (m_logicSuspended) {
+    return;
+  }
+
+  if (m_components) {
+    for (KX_PythonComponent *comp : m_components) {
+      if (comp->NeedUpdate(tick, time)) {
+        CM_PROFILE_ZONE_DETAIL("Component", comp->GetName().c_str());
         comp->Update();
       }
     }
+  }
 
+  if (NeedUpdate(tick, time)) {
     KX_PythonProxy::Update();
   }
 #endif  // WITH_PYTHON
@@ -2183,6 +2341,7 @@ PyMethodDef KX_GameObject::Methods[] = {
 
     EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, rayCastTo),
     EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, rayCast),
+    EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, rayCastBatch),
     EXP_PYMETHODTABLE_O(KX_GameObject, getDistanceTo),
     EXP_PYMETHODTABLE_O(KX_GameObject, getVectTo),
     EXP_PYMETHODTABLE_KEYWORDS(KX_GameObject, sendMessage),
@@ -3209,6 +3368,7 @@ int KX_GameObject::pyattr_set_physicsCullingRadius(EXP_PyObjectPlus *self_v,
   }
 
   self->GetActivityCullingInfo().m_physicsRadius = val * val;
+  self->GetActivityCullingInfo().InvalidateCheck();
 
   return PY_SET_ATTR_SUCCESS;
 }
@@ -3234,6 +3394,7 @@ int KX_GameObject::pyattr_set_logicCullingRadius(EXP_PyObjectPlus *self_v,
   }
 
   self->GetActivityCullingInfo().m_logicRadius = val * val;
+  self->GetActivityCullingInfo().InvalidateCheck();
 
   return PY_SET_ATTR_SUCCESS;
 }
@@ -4836,6 +4997,23 @@ EXP_PYMETHODDEF_DOC(
     return none_tuple_3();
 }
 
+EXP_PYMETHODDEF_DOC(KX_GameObject,
+                    rayCastBatch,
+                    "rayCastBatch(origins, targets, mask)\n"
+                    "Cast a ray from each origin to each target in parallel and return a 4-tuple "
+                    "(objects, hits, positions, normals), see KX_Scene.rayCastBatch.\n"
+                    "Note: The object on which you call this method matters: the rays will ignore "
+                    "it.\n")
+{
+  PHY_IPhysicsController *spc = GetPhysicsController();
+  KX_GameObject *parent = GetParent();
+  if (!spc && parent) {
+    spc = parent->GetPhysicsController();
+  }
+
+  return KX_RayCast::PyRayTestBatch(GetScene()->GetPhysicsEnvironment(), spc, args, kwds);
+}
+
 EXP_PYMETHODDEF_DOC(KX_GameObject,
                     sendMessage,
                     "sendMessage(subject, [body, to])\n"
@@ -49,15 +49,18 @@
 #include "MT_Transform.h"
 #include "SCA_IObject.h"
 #include "SCA_LogicManager.h" /* for ConvertPythonToGameObject to search object names */
+#include "SG_CullingNode.h"
 #include "SG_Node.h"
 
 // Forward declarations.
 struct KX_ClientObjectInfo;
 class KX_RayCast;
 class KX_LodManager;
+class KX_LodLevel;
 class KX_PythonComponent;
 class RAS_MeshObject;
 class PHY_IPhysicsController;
+class PHY_IGraphicController;
 class BL_ActionManager;
 struct Object;
 class KX_CollisionContactPointList;
@@ -100,13 +103,43 @@ class KX_GameObject : public SCA_IObject {
     float m_physicsRadius;
     /// Squared logic culling radius.
     float m_logicRadius;
+
+    /// Distance the object and the cameras can travel before the culling state can change.
+    float m_checkMargin;
+    /// Scene camera travel at the last distance computation.
+    double m_checkTravel;
+    /// Scene activity culling generation at the last distance computation.
+    unsigned int m_checkGeneration;
+    /// Object position at the last distance computation.
+    MT_Vector3 m_checkPosition;
+
+    /// Force the distance computation in the next activity culling pass.
+    void InvalidateCheck();
+    /// Compute the margin before the next distance computation from the squared distance.
+    void SetChecked(float distance,
+                    const MT_Vector3 &position,
+                    double travel,
+                    unsigned int generation);
+  };
+
+  /// State of the object in the scene list of objects to synchronize with the depsgraph.
+  enum DirtyListState {
+    /// The object is active but not in the dirty list.
+    DIRTY_LIST_NONE = 0,
+    /// The object is in the dirty list.
+    DIRTY_LIST_ADDED,
+    /// The object is not active (inactive layer), it is never synchronized.
+    DIRTY_LIST_DISABLED
   };
 
  protected:
   /* EEVEE INTEGRATION */
   float m_prevobject_to_world[4][4];
   bool m_isReplica;
+  /// Template object of the replica Blender object when it comes from the scene object pool.
+  struct Object *m_poolTemplate;
   bool m_forceIgnoreParentTx;
+  DirtyListState m_dirtyListState;
   short m_previousLodLevel;
   /* END OF EEVEE INTEGRATION */
 
@@ -127,10 +160,15 @@ class KX_GameObject : public SCA_IObject {
   bool m_bVisible;
   bool m_bOccluder;
 
+  /// Culling state of the object from the last camera culling pass.
+  SG_CullingNode m_cullingNode;
+
   // Object activity culling settings converted from blender objects.
   ActivityCullingInfo m_activityCullingInfo;
 
   PHY_IPhysicsController *m_pPhysicsController;
+  /// Bounding box of the object in the culling tree of the physics environment.
+  PHY_IGraphicController *m_pGraphicController;
   SG_Node *m_pSGNode;
 
   EXP_ListValue<KX_GameObject> *m_pInstanceObjects;
@@ -164,6 +202,8 @@ class KX_GameObject : public SCA_IObject {
   void SyncTransformWithDepsgraph();
   void SetIsReplicaObject();
   float *GetPrevObjectMatToWorld();
+  DirtyListState GetDirtyListState() const;
+  void SetDirtyListState(DirtyListState state);
   BL_ActionManager *GetActionManagerNoCreate();
   /* END OF EEVEE INTEGRATION */
 
@@ -332,6 +372,13 @@ class KX_GameObject : public SCA_IObject {
    * actions' frames.
    */
   void UpdateActionManager(float curtime, bool applyObject);
+  /**
+   * Update the object's actions without modifying the scene graph, safe to call from the scene
+   * animation pool. UpdateActionIPOs must be called afterward.
+   */
+  void UpdateActions(float curtime, bool applyObject);
+  /// Apply the transform actions updated by UpdateActions to the scene graph.
+  void UpdateActionIPOs();
 
   /*********************************
    * End Animation API
@@ -435,6 +482,25 @@ class KX_GameObject : public SCA_IObject {
   {
     m_pPhysicsController = physicscontroller;
   }
+
+  /**
+   * \return a pointer to the graphic controller owned by this class.
+   */
+  PHY_IGraphicController *GetGraphicController()
+  {
+    return m_pGraphicController;
+  }
+
+  void SetGraphicController(PHY_IGraphicController *graphiccontroller)
+  {
+    m_pGraphicController = graphiccontroller;
+  }
+
+  /// Add or remove the graphic controller of this object and its children from the culling tree.
+  void ActivateGraphicController(bool active, bool recurse);
+
+  /// Update the culling node and graphic controller bounding box from the blender object.
+  void UpdateBounds();
   /// Return true when the game object is a .
   virtual bool IsDeformable() const
   {
@@ -590,7 +656,7 @@ class KX_GameObject : public SCA_IObject {
   virtual void setCcdSweptSphereRadius(float swept_sphere_radius);
 
   /**
-   * Update the physics object transform based upon the current SG_Node
+   * Update the physics and graphic object transform based upon the current SG_Node
    * position.
    */
   void UpdateTransform();
@@ -649,11 +715,13 @@ class KX_GameObject : public SCA_IObject {
   void SetLodManager(KX_LodManager *lodManager);
   /// Get current lod manager.
   KX_LodManager *GetLodManager() const;
+  /// Get the index of the current lod level.
+  short GetCurrentLodLevel() const;
 
-  /**
-   * Updates the current lod level based on distance from camera.
+  /** Update the mesh rendered for the current lod level.
+   * \param lodLevel The new lod level to switch to, nullptr to keep the current level.
    */
-  void UpdateLod(const MT_Vector3 &cam_pos, float lodfactor);
+  void UpdateLod(KX_LodLevel *lodLevel);
 
   /** Update the activity culling of the object.
    * \param distance Squared nearest distance to the cameras of this object.
@@ -680,6 +748,8 @@ class KX_GameObject : public SCA_IObject {
   /// Return true when the object can be culled.
   bool UseCulling() const;
 
+  SG_CullingNode &GetCullingNode();
+
   /**
    * Was this object marked visible? (only for the explicit
    * visibility system).
@@ -772,7 +842,8 @@ class KX_GameObject : public SCA_IObject {
 
   virtual void SetScene(KX_Scene *scene);
 
-  virtual void Update();
+  /// Update the python proxy and components scheduled for this logic tick.
+  void UpdateComponents(unsigned int tick, double time);
 
 #ifdef WITH_PYTHON
   /**
@@ -826,6 +897,7 @@ class KX_GameObject : public SCA_IObject {
   EXP_PYMETHOD_NOARGS(KX_GameObject, EndObject);
   EXP_PYMETHOD_DOC(KX_GameObject, rayCastTo);
   EXP_PYMETHOD_DOC(KX_GameObject, rayCast);
+  EXP_PYMETHOD_DOC(KX_GameObject, rayCastBatch);
   EXP_PYMETHOD_DOC_O(KX_GameObject, getDistanceTo);
   EXP_PYMETHOD_DOC_O(KX_GameObject, getVectTo);
   EXP_PYMETHOD_DOC(KX_GameObject, sendMessage);
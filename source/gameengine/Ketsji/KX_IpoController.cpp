@@ -48,6 +48,7 @@ typedef unsigned long uint_ptr;
 
 #include "KX_GameObject.h"
 #include "KX_ScalarInterpolator.h"
+#include "KX_Scene.h"
 #include "PHY_IPhysicsController.h"
 
 // All objects should start on frame 1! Will we ever need an object to
@@ -135,7 +136,8 @@ bool KX_IpoController::Update(double currentTime)
         if (m_game_object && ob && m_game_object->GetPhysicsController()) {
           MT_Vector3 vec = m_ipo_local ? ob->GetWorldOrientation() * m_ipo_xform.GetPosition() :
                                          m_ipo_xform.GetPosition();
-          m_game_object->GetPhysicsController()->ApplyForce(vec, false);
+          // Can be updated in parallel, the scene applies the force to the physics.
+          m_game_object->GetScene()->AppendToForces(m_game_object, vec, false);
         }
       }
       else {
@@ -194,10 +196,11 @@ bool KX_IpoController::Update(double currentTime)
         m_ipo_channels_active[OB_DROT_Y] || m_ipo_channels_active[OB_DROT_Z]) {
       if (m_ipo_as_force) {
         if (m_game_object && ob) {
-          m_game_object->ApplyTorque(m_ipo_local ?
-                                         ob->GetWorldOrientation() * m_ipo_xform.GetEulerAngles() :
-                                         m_ipo_xform.GetEulerAngles(),
-                                     false);
+          m_game_object->GetScene()->AppendToForces(
+              m_game_object,
+              m_ipo_local ? ob->GetWorldOrientation() * m_ipo_xform.GetEulerAngles() :
+                            m_ipo_xform.GetEulerAngles(),
+              true);
         }
       }
       else if (m_ipo_add) {
@@ -47,6 +47,7 @@
 
 #include "BL_Converter.h"
 #include "BL_SceneConverter.h"
+#include "CM_Profiler.h"
 #include "DEV_Joystick.h"  // for DEV_Joystick::HandleEvents
 #include "KX_Camera.h"
 #include "KX_Globals.h"
@@ -174,6 +175,8 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system,
  */
 KX_KetsjiEngine::~KX_KetsjiEngine()
 {
+  StopReplication();
+
 #ifdef WITH_PYTHON
   Py_CLEAR(m_pyprofiledict);
 #endif
@@ -240,6 +243,29 @@ void KX_KetsjiEngine::SetNetworkMessageManager(KX_NetworkMessageManager *manager
   m_networkMessageManager = manager;
 }
 
+bool KX_KetsjiEngine::StartReplication(const KX_NetworkReplication::Settings &settings)
+{
+  // Release the previous socket first, the new replication can use the same port.
+  StopReplication();
+
+  std::unique_ptr<KX_NetworkReplication> replication(new KX_NetworkReplication(settings));
+  if (!replication->Start()) {
+    return false;
+  }
+
+  m_networkReplication = std::move(replication);
+  m_networkMessageManager->SetListener(m_networkReplication.get());
+  return true;
+}
+
+void KX_KetsjiEngine::StopReplication()
+{
+  if (m_networkReplication) {
+    m_networkMessageManager->SetListener(nullptr);
+    m_networkReplication.reset();
+  }
+}
+
 #ifdef WITH_PYTHON
 PyObject *KX_KetsjiEngine::GetPyProfileDict()
 {
@@ -256,6 +282,8 @@ void KX_KetsjiEngine::SetConverter(BL_Converter *converter)
 
 void KX_KetsjiEngine::StartEngine()
 {
+  CM_Profiler::SetThreadName("Main");
+
   // Reset the clock to start at 0.0.
   m_clock.Reset();
 
@@ -269,16 +297,8 @@ void KX_KetsjiEngine::BeginFrame()
   m_canvas->BeginDraw();
 }
 
-void KX_KetsjiEngine::EndFrame()
+void KX_KetsjiEngine::NextProfileMeasurement()
 {
-  // Show profiling info
-  m_logger.StartLog(tc_overhead);
-  if (m_flags & (SHOW_PROFILE | SHOW_FRAMERATE | SHOW_DEBUG_PROPERTIES)) {
-    RenderDebugProperties();
-  }
-
-  m_rasterizer->FlushDebugDraw(m_canvas);
-
   double tottime = m_logger.GetAverage();
   if (tottime < 1e-6)
     tottime = 1e-6;
@@ -299,6 +319,19 @@ void KX_KetsjiEngine::EndFrame()
 
   // Go to next profiling measurement, time spent after this call is shown in the next frame.
   m_logger.NextMeasurement();
+}
+
+void KX_KetsjiEngine::EndFrame()
+{
+  // Show profiling info
+  m_logger.StartLog(tc_overhead);
+  if (m_flags & (SHOW_PROFILE | SHOW_FRAMERATE | SHOW_DEBUG_PROPERTIES)) {
+    RenderDebugProperties();
+  }
+
+  m_rasterizer->FlushDebugDraw(m_canvas);
+
+  NextProfileMeasurement();
 
   m_logger.StartLog(tc_rasterizer);
   m_rasterizer->EndFrame();
@@ -324,26 +357,7 @@ void KX_KetsjiEngine::EndFrameViewportRender()
 
   m_rasterizer->FlushDebugDraw(m_canvas);
 
-  double tottime = m_logger.GetAverage();
-  if (tottime < 1e-6)
-    tottime = 1e-6;
-
-#ifdef WITH_PYTHON
-  for (int i = tc_first; i < tc_numCategories; ++i) {
-    double time = m_logger.GetAverage((KX_TimeCategory)i);
-    PyObject *val = PyTuple_New(2);
-    PyTuple_SetItem(val, 0, PyFloat_FromDouble(time * 1000.0));
-    PyTuple_SetItem(val, 1, PyFloat_FromDouble(time / tottime * 100.0));
-
-    PyDict_SetItemString(m_pyprofiledict, m_profileLabels[i].c_str(), val);
-    Py_DECREF(val);
-  }
-#endif
-
-  m_average_framerate = 1.0 / tottime;
-
-  // Go to next profiling measurement, time spent after this call is shown in the next frame.
-  m_logger.NextMeasurement();
+  NextProfileMeasurement();
 
   m_logger.StartLog(tc_rasterizer);
   // m_rasterizer->EndFrame();
@@ -468,6 +482,8 @@ KX_KetsjiEngine::FrameTimes KX_KetsjiEngine::GetFrameTimes()
 
 bool KX_KetsjiEngine::NextFrame()
 {
+  CM_PROFILE_ZONE("NextFrame");
+
   m_logger.StartLog(tc_services);
 
   const FrameTimes times = GetFrameTimes();
@@ -481,6 +497,8 @@ bool KX_KetsjiEngine::NextFrame()
   }
 
   for (unsigned short i = 0; i < times.frames; ++i) {
+    CM_PROFILE_ZONE("LogicFrame");
+
     m_frameTime += times.framestep;
 
     m_converter->MergeAsyncLoads();
@@ -507,6 +525,8 @@ bool KX_KetsjiEngine::NextFrame()
 
     // for each scene, call the proceed functions
     for (KX_Scene *scene : m_scenes) {
+      CM_PROFILE_ZONE_DETAIL("Scene", scene->GetName().c_str());
+
       /* Suspension holds the physics and logic processing for an
        * entire scene. Objects can be suspended individually, and
        * the settings for that precede the logic and physics
@@ -562,6 +582,10 @@ bool KX_KetsjiEngine::NextFrame()
     }
 
     m_logger.StartLog(tc_network);
+    // The received messages are added before the clear to be read the next frame.
+    if (m_networkReplication) {
+      m_networkReplication->Update(m_scenes, m_frameTime, m_networkMessageManager);
+    }
     m_networkMessageManager->ClearMessages();
 
     // update system devices
@@ -572,6 +596,12 @@ bool KX_KetsjiEngine::NextFrame()
     ProcessScheduledScenes();
   }
 
+  // The measurements are otherwise advanced by the render in EndFrame.
+  if (!m_doRender) {
+    m_logger.StartLog(tc_overhead);
+    NextProfileMeasurement();
+  }
+
   // Start logging time spent outside main loop
   m_logger.StartLog(tc_outside);
 
@@ -758,6 +788,8 @@ bool KX_KetsjiEngine::GetFrameRenderData(std::vector<FrameRenderData> &frameData
 
 void KX_KetsjiEngine::Render()
 {
+  CM_PROFILE_ZONE("Render");
+
   m_logger.StartLog(tc_rasterizer);
 
   BeginFrame();
@@ -1061,7 +1093,7 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene,
                                    unsigned short pass)
 {
   KX_Camera *rendercam = cameraFrameData.m_renderCamera;
-  // KX_Camera *cullingcam = cameraFrameData.m_cullingCamera;
+  KX_Camera *cullingcam = cameraFrameData.m_cullingCamera;
   // const RAS_Rect &area = cameraFrameData.m_area;
   const RAS_Rect &viewport = cameraFrameData.m_viewport;
 
@@ -1092,6 +1124,12 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene,
 
   bool is_last_render_pass = rendercam == m_renderingCameras.back();
 
+  /* Cull after the pre draw callbacks which can render the scene from other cameras (e.g
+   * ImageRender), the culling state is then also used by the next animations update. */
+  m_logger.StartLog(tc_scenegraph);
+  scene->CalculateVisibleMeshes(cullingcam, viewport);
+  m_logger.StartLog(tc_rasterizer);
+
   scene->RenderAfterCameraSetup(rendercam, background_fb, viewport, is_overlay_pass, is_last_render_pass);
 
   if (scene->GetPhysicsEnvironment()) {
@@ -1134,6 +1172,9 @@ RAS_FrameBuffer *KX_KetsjiEngine::PostRenderScene(KX_Scene *scene,
 
 void KX_KetsjiEngine::StopEngine()
 {
+  // The replication refers to the objects of the scenes.
+  StopReplication();
+
   if (m_bInitialized) {
     m_converter->FinalizeAsyncLoads();
 
@@ -1199,6 +1240,7 @@ void KX_KetsjiEngine::PostProcessScene(KX_Scene *scene)
     scene->GetCameraList()->Add(CM_AddRef(activecam));
     scene->SetActiveCamera(activecam);
     scene->GetObjectList()->Add(CM_AddRef(activecam));
+    scene->ActivateDirtyObject(activecam);
     scene->GetRootParentList()->Add(CM_AddRef(activecam));
     // done with activecam
     activecam->Release();
@@ -1565,6 +1607,21 @@ double KX_KetsjiEngine::GetAverageFrameRate()
   return m_average_framerate;
 }
 
+void KX_KetsjiEngine::SetProfileMeasurementCount(unsigned int count)
+{
+  // The current measurement is not part of the averages.
+  m_logger.SetMaxNumMeasurements(count + 1);
+}
+
+void KX_KetsjiEngine::GetProfileAverages(std::vector<std::string> &labels,
+                                         std::vector<double> &times)
+{
+  for (int i = tc_first; i < tc_numCategories; ++i) {
+    labels.push_back(m_profileLabels[i]);
+    times.push_back(m_logger.GetAverage((KX_TimeCategory)i));
+  }
+}
+
 void KX_KetsjiEngine::SetExitKey(short key)
 {
   m_exitkey = key;
@@ -32,12 +32,14 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "CM_Clock.h"
 #include "EXP_Python.h"
 #include "KX_ISystem.h"
+#include "KX_NetworkReplication.h"
 #include "KX_Scene.h"
 #include "KX_TimeCategoryLogger.h"
 #include "MT_Matrix4x4.h"
@@ -140,6 +142,8 @@ class KX_KetsjiEngine {
   KX_ISystem *m_kxsystem;
   BL_Converter *m_converter;
   KX_NetworkMessageManager *m_networkMessageManager;
+  /// Replication of the objects and messages with other engines, null when not started.
+  std::unique_ptr<KX_NetworkReplication> m_networkReplication;
 #ifdef WITH_PYTHON
   PyObject *m_pyprofiledict;
 #endif
@@ -289,6 +293,9 @@ class KX_KetsjiEngine {
   void BeginFrame();
   FrameTimes GetFrameTimes();
 
+  /// Update the profiling averages and start a new measurement.
+  void NextProfileMeasurement();
+
  public:
   KX_KetsjiEngine(KX_ISystem *system,
                   struct bContext *C,
@@ -344,6 +351,10 @@ class KX_KetsjiEngine {
     return m_networkMessageManager;
   }
 
+  /// Start the replication, replacing the current one, return false if it can't be started.
+  bool StartReplication(const KX_NetworkReplication::Settings &settings);
+  void StopReplication();
+
   /// returns true if an update happened to indicate -> Render
   bool NextFrame();
   void Render();
@@ -448,6 +459,17 @@ class KX_KetsjiEngine {
    */
   double GetAverageFrameRate();
 
+  /**
+   * Sets the number of frames the profiling averages are computed over.
+   */
+  void SetProfileMeasurementCount(unsigned int count);
+  /**
+   * Gets the average time in seconds spent per frame in each profiling category.
+   * \param labels Filled with the labels of the categories.
+   * \param times Filled with the average times, in the same order.
+   */
+  void GetProfileAverages(std::vector<std::string> &labels, std::vector<double> &times);
+
   /**
    * Gets the time scale multiplier
    */
@@ -26,6 +26,8 @@
 
 #include "KX_LibLoadStatus.h"
 
+#include <climits>
+
 #include "BLI_time.h"
 
 KX_LibLoadStatus::KX_LibLoadStatus(class BL_Converter *kx_converter,
@@ -38,6 +40,8 @@ KX_LibLoadStatus::KX_LibLoadStatus(class BL_Converter *kx_converter,
       m_data(nullptr),
       m_libname(path),
       m_progress(0.0f),
+      m_stage("converting"),
+      m_priority(0),
       m_finished(false)
 #ifdef WITH_PYTHON
       ,
@@ -52,6 +56,7 @@ void KX_LibLoadStatus::Finish()
 {
   m_finished = true;
   m_progress = 1.f;
+  m_stage = "finished";
   m_endtime = BLI_time_now_seconds();
 
   RunFinishCallback();
@@ -137,6 +142,21 @@ void KX_LibLoadStatus::AddProgress(float progress)
   RunProgressCallback();
 }
 
+void KX_LibLoadStatus::SetStage(const std::string &stage)
+{
+  m_stage = stage;
+}
+
+const std::string &KX_LibLoadStatus::GetStage() const
+{
+  return m_stage;
+}
+
+int KX_LibLoadStatus::GetPriority() const
+{
+  return m_priority;
+}
+
 #ifdef WITH_PYTHON
 
 PyMethodDef KX_LibLoadStatus::Methods[] = {
@@ -150,6 +170,8 @@ PyAttributeDef KX_LibLoadStatus::Attributes[] = {
     // pyattr_set_onprogress),
     EXP_PYATTRIBUTE_FLOAT_RO("progress", KX_LibLoadStatus, m_progress),
     EXP_PYATTRIBUTE_STRING_RO("libraryName", KX_LibLoadStatus, m_libname),
+    EXP_PYATTRIBUTE_STRING_RO("stage", KX_LibLoadStatus, m_stage),
+    EXP_PYATTRIBUTE_INT_RW("priority", INT_MIN, INT_MAX, true, KX_LibLoadStatus, m_priority),
     EXP_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_LibLoadStatus, pyattr_get_timetaken),
     EXP_PYATTRIBUTE_BOOL_RO("finished", KX_LibLoadStatus, m_finished),
     EXP_PYATTRIBUTE_NULL  // Sentinel
@@ -36,6 +36,10 @@ class KX_LibLoadStatus : public EXP_PyObjectPlus {
   std::string m_libname;
 
   float m_progress;
+  /// Name of the current loading stage, reported to the user.
+  std::string m_stage;
+  /// Pending merges of higher priority are done first.
+  int m_priority;
   double m_starttime;
   double m_endtime;
 
@@ -73,6 +77,11 @@ class KX_LibLoadStatus : public EXP_PyObjectPlus {
   float GetProgress();
   void AddProgress(float progress);
 
+  void SetStage(const std::string &stage);
+  const std::string &GetStage() const;
+
+  int GetPriority() const;
+
 #ifdef WITH_PYTHON
   static PyObject *pyattr_get_onfinish(EXP_PyObjectPlus *self_v,
                                        const EXP_PYATTRIBUTE_DEF *attrdef);
@@ -31,12 +31,11 @@
 
 #include "KX_LightIpoSGController.h"
 
-#include "DEG_depsgraph_query.hh"
 #include "DNA_light_types.h"
-#include "WM_api.hh"
 
 #include "KX_Light.h"
 #include "KX_ScalarInterpolator.h"
+#include "KX_Scene.h"
 
 #if defined(_WIN64)
 typedef unsigned __int64 uint_ptr;
@@ -58,16 +57,17 @@ bool KX_LightIpoSGController::Update(double currentTime)
 
     if (m_modify_energy) {
       la->energy = m_energy;
-      DEG_id_tag_update(&la->id, 0);
-      WM_main_add_notifier(NC_LAMP | ND_LIGHTING_DRAW, la);
     }
 
     if (m_modify_color) {
       la->r = m_col_rgb[0];
       la->g = m_col_rgb[1];
       la->b = m_col_rgb[2];
-      DEG_id_tag_update(&la->id, 0);
-      WM_main_add_notifier(NC_LAMP | ND_LIGHTING_DRAW, la);
+    }
+
+    // Tagged through the scene as the node trees can be updated in parallel.
+    if (m_modify_energy || m_modify_color) {
+      kxlight->GetScene()->AppendToIdsToUpdate(&la->id, (IDRecalcFlag)0, false);
     }
 
     /*if (m_modify_dist) {
@@ -35,72 +35,13 @@
 #include "KX_LodLevel.h"
 #include "KX_Scene.h"
 
-KX_LodManager::LodLevelIterator::LodLevelIterator(const std::vector<KX_LodLevel *> &levels,
-                                                  unsigned short index,
-                                                  KX_Scene *scene)
-    : m_levels(levels), m_index(index), m_scene(scene)
-{
-}
-
-inline float KX_LodManager::LodLevelIterator::GetHysteresis(unsigned short level) const
-{
-  if (level < 1 || !m_scene->IsActivedLodHysteresis()) {
-    return 0.0f;
-  }
-
-  KX_LodLevel *lod = m_levels[level];
-  KX_LodLevel *prelod = m_levels[level - 1];
-
-  float hysteresis = 0.0f;
-  // if exists, LoD level hysteresis will override scene hysteresis
-  if (lod->GetFlag() & KX_LodLevel::USE_HYSTERESIS) {
-    hysteresis = lod->GetHysteresis() / 100.0f;
-  }
-  else {
-    hysteresis = m_scene->GetLodHysteresisValue() / 100.0f;
-  }
-
-  return MT_abs(prelod->GetDistance() - lod->GetDistance()) * hysteresis;
-}
-
-inline int KX_LodManager::LodLevelIterator::operator++()
-{
-  return m_index++;
-}
-
-inline int KX_LodManager::LodLevelIterator::operator--()
-{
-  return m_index--;
-}
-
-inline short KX_LodManager::LodLevelIterator::operator*() const
-{
-  return m_index;
-}
-
-inline bool KX_LodManager::LodLevelIterator::operator<=(float distance2) const
-{
-  // The last level doesn't have a next level, then the maximum distance is infinite and should
-  // always return false.
-  if (m_index == (m_levels.size() - 1)) {
-    return false;
-  }
-
-  return square_f(m_levels[m_index + 1]->GetDistance() + GetHysteresis(m_index + 1)) <= distance2;
-}
-
-inline bool KX_LodManager::LodLevelIterator::operator>(float distance2) const
-{
-  return square_f(m_levels[m_index]->GetDistance() - GetHysteresis(m_index)) > distance2;
-}
-
 KX_LodManager::KX_LodManager(Object *ob,
                              KX_Scene *scene,
                              RAS_Rasterizer *rasty,
                              BL_SceneConverter *converter,
                              bool libloading,
                              bool converting_during_runtime)
-    : m_refcount(1), m_distanceFactor(ob->lodfactor)
+    : m_thresholdsHysteresis(-2), m_refcount(1), m_distanceFactor(ob->lodfactor)
 {
   if (BLI_listbase_count_at_most(&ob->lodlevels, 2) > 1) {
     Mesh *lodmesh = (Mesh *)ob->data;
@@ -140,7 +81,7 @@ KX_LodManager::KX_LodManager(Object *ob,
 }
 
 KX_LodManager::KX_LodManager(RAS_MeshObject *meshObj, Object *lodsource)
-    : m_refcount(1), m_distanceFactor(1.0f)
+    : m_thresholdsHysteresis(-2), m_refcount(1), m_distanceFactor(1.0f)
 {
   KX_LodLevel *lodLevel = new KX_LodLevel(
       0.0f, 0.0f, 0, meshObj, lodsource, OB_LOD_USE_MESH | OB_LOD_USE_MAT);
@@ -169,6 +110,46 @@ KX_LodLevel *KX_LodManager::GetLevel(unsigned int index) const
   return m_levels[index];
 }
 
+float KX_LodManager::GetHysteresis(KX_Scene *scene, unsigned short level) const
+{
+  if (level < 1 || !scene->IsActivedLodHysteresis()) {
+    return 0.0f;
+  }
+
+  KX_LodLevel *lod = m_levels[level];
+  KX_LodLevel *prelod = m_levels[level - 1];
+
+  float hysteresis = 0.0f;
+  // if exists, LoD level hysteresis will override scene hysteresis
+  if (lod->GetFlag() & KX_LodLevel::USE_HYSTERESIS) {
+    hysteresis = lod->GetHysteresis() / 100.0f;
+  }
+  else {
+    hysteresis = scene->GetLodHysteresisValue() / 100.0f;
+  }
+
+  return MT_abs(prelod->GetDistance() - lod->GetDistance()) * hysteresis;
+}
+
+void KX_LodManager::UpdateThresholds(KX_Scene *scene)
+{
+  const int hysteresis = scene->IsActivedLodHysteresis() ? scene->GetLodHysteresisValue() : -1;
+  if (hysteresis == m_thresholdsHysteresis) {
+    return;
+  }
+  m_thresholdsHysteresis = hysteresis;
+
+  const unsigned short size = m_levels.size();
+  m_upDistances2.resize(size);
+  m_downDistances2.resize(size);
+  for (unsigned short level = 0; level < size; ++level) {
+    const float distance = m_levels[level]->GetDistance();
+    const float levelHysteresis = GetHysteresis(scene, level);
+    m_upDistances2[level] = square_f(distance + levelHysteresis);
+    m_downDistances2[level] = square_f(distance - levelHysteresis);
+  }
+}
+
 KX_LodLevel *KX_LodManager::GetLevel(KX_Scene *scene, short previouslod, float distance2)
 {
   if (m_levels.size() == 1) {
@@ -176,21 +157,19 @@ KX_LodLevel *KX_LodManager::GetLevel(KX_Scene *scene, short previouslod, float d
   }
   distance2 *= (m_distanceFactor * m_distanceFactor);
 
-  LodLevelIterator it(m_levels, previouslod, scene);
+  UpdateThresholds(scene);
 
-  while (true) {
-    if (it <= distance2) {
-      ++it;
-    }
-    else if (it > distance2) {
-      --it;
-    }
-    else {
-      break;
-    }
+  const unsigned short last = m_levels.size() - 1;
+  unsigned short level = previouslod;
+  // Go to the next levels while the distance is above their distance more hysteresis.
+  while (level < last && m_upDistances2[level + 1] <= distance2) {
+    ++level;
+  }
+  // Go back to the previous levels while the distance is below their distance less hysteresis.
+  while (level > 0 && m_downDistances2[level] > distance2) {
+    --level;
   }
 
-  const unsigned short level = *it;
   return (level == previouslod) ? nullptr : m_levels[level];
 }
 
@@ -40,38 +40,25 @@ class KX_LodManager : public EXP_Value {
   Py_Header
 
       private :
-      /** This class helps to compare the object distance to camera with the list of lod levels.
-       * It represent the gap between two levels, when you compare it with a distance it compare
-       * with the a N level distance and a N+1 level distance including hysteresis.
-       */
-      class LodLevelIterator {
-   private:
-    const std::vector<KX_LodLevel *> &m_levels;
-    short m_index;
-    KX_Scene *m_scene;
-    float GetHysteresis(unsigned short level) const;
-
-   public:
-    LodLevelIterator(const std::vector<KX_LodLevel *> &levels,
-                     unsigned short index,
-                     KX_Scene *scene);
-
-    int operator++();
-    int operator--();
-    short operator*() const;
-    /// Compare next level distance more hysteresis with current distance.
-    bool operator<=(float distance2) const;
-    /// Compare the current lod level distance less hysteresis with current distance.
-    bool operator>(float distance2) const;
-  };
-
   std::vector<KX_LodLevel *> m_levels;
 
+  /** Squared distances to reach each level from the previous one and to go back to the
+   * previous level, including the hysteresis. The factor of the manager is not applied.
+   */
+  std::vector<float> m_upDistances2;
+  std::vector<float> m_downDistances2;
+  /** Scene hysteresis used to compute the distances, -1 when the hysteresis is disabled and -2
+   * before the first computation.
+   */
+  int m_thresholdsHysteresis;
+
   /** Get the hysteresis from the level or the scene.
    * \param scene Scene used to get default hysteresis.
    * \param level Level index used to get hysteresis.
    */
-  float GetHysteresis(KX_Scene *scene, unsigned short level);
+  float GetHysteresis(KX_Scene *scene, unsigned short level) const;
+  /// Compute the level distances if the scene hysteresis changed.
+  void UpdateThresholds(KX_Scene *scene);
 
   int m_refcount;
 
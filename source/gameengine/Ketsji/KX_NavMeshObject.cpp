@@ -27,19 +27,26 @@
 
 #include "KX_NavMeshObject.h"
 
+#include <algorithm>
+#include <cfloat>
+
 #include "BKE_context.hh"
 #include "BKE_mesh.hh"
 #include "BKE_mesh_legacy_convert.hh"
 #include "BLI_sort.h"
 #include "DEG_depsgraph_query.hh"
 #include "DNA_meshdata_types.h"
+#include "DNA_scene_types.h"
 
 #include "BL_Converter.h"
+#include "CM_List.h"
 #include "CM_Message.h"
 #include "DetourStatNavMeshBuilder.h"
 #include "KX_Globals.h"
+#include "KX_NavMeshTiles.h"
 #include "KX_ObstacleSimulation.h"
 #include "KX_PyMath.h"
+#include "KX_Scene.h"
 #include "RAS_IVertex.h"
 #include "RAS_Polygon.h"
 #include "Recast.h"
@@ -574,7 +581,192 @@ static int polyFindVertex(const unsigned short *p,
   return res;
 }
 
-KX_NavMeshObject::KX_NavMeshObject() : KX_GameObject(), m_navMesh(nullptr)
+/// Polygon of a static or tiled navigation mesh.
+struct NavMeshPoly {
+  int nv;
+  const float *verts[DT_TILE_VERTS_PER_POLYGON];
+  /// True when the edge from the vertex i - 1 to i has no neighbor polygon.
+  bool walls[DT_TILE_VERTS_PER_POLYGON];
+  int ntris;
+  /// Detail triangles, the indices below nv are the polygon vertices.
+  const unsigned char *tris;
+  const float *dverts;
+
+  const float *GetTriVertex(int tri, int k) const
+  {
+    const unsigned char index = tris[tri * 4 + k];
+    return (index < nv) ? verts[index] : &dverts[(index - nv) * 3];
+  }
+};
+
+static void getStatPoly(const dtStatNavMesh *navmesh, int index, NavMeshPoly &r_poly)
+{
+  const dtStatPoly *poly = navmesh->getPoly(index);
+  const dtStatPolyDetail *detail = navmesh->getPolyDetail(index);
+  r_poly.nv = poly->nv;
+  for (int i = 0, j = poly->nv - 1; i < poly->nv; j = i++) {
+    r_poly.verts[i] = navmesh->getVertex(poly->v[i]);
+    r_poly.walls[i] = (poly->n[j] == 0);
+  }
+  r_poly.ntris = detail->ntris;
+  r_poly.tris = navmesh->getDetailTri(detail->tbase);
+  r_poly.dverts = (detail->nverts > 0) ? navmesh->getDetailVertex(detail->vbase) : nullptr;
+}
+
+static void getTilePoly(const dtTileHeader *header, int index, NavMeshPoly &r_poly)
+{
+  const dtTilePoly &poly = header->polys[index];
+  const dtTilePolyDetail &detail = header->dmeshes[index];
+  r_poly.nv = poly.nv;
+  for (int i = 0; i < poly.nv; ++i) {
+    r_poly.verts[i] = &header->verts[poly.v[i] * 3];
+    r_poly.walls[i] = true;
+  }
+  // The links connect the polygons inside the tile and with the neighbor tiles.
+  for (int i = poly.links; i < poly.links + poly.nlinks; ++i) {
+    const int edge = header->links[i].e;
+    r_poly.walls[(edge + 1) % poly.nv] = false;
+  }
+  r_poly.ntris = detail.ntris;
+  r_poly.tris = &header->dtris[detail.tbase * 4];
+  r_poly.dverts = (detail.nverts > 0) ? &header->dverts[detail.vbase * 3] : nullptr;
+}
+
+/// Call a function for each polygon of the static or tiled navigation mesh.
+template<class Function>
+static void foreachPoly(const dtStatNavMesh *statmesh,
+                        const dtTiledNavMesh *tilemesh,
+                        Function function)
+{
+  NavMeshPoly poly;
+  if (tilemesh) {
+    for (int i = 0; i < DT_MAX_TILES; ++i) {
+      const dtTileHeader *header = tilemesh->getTile(i)->header;
+      if (!header) {
+        continue;
+      }
+      for (int j = 0; j < header->npolys; ++j) {
+        getTilePoly(header, j, poly);
+        function(poly);
+      }
+    }
+  }
+  else if (statmesh) {
+    for (int i = 0; i < statmesh->getPolyCount(); ++i) {
+      getStatPoly(statmesh, i, poly);
+      function(poly);
+    }
+  }
+}
+
+static bool findNearestPoly(dtStatNavMesh *statmesh,
+                            dtTiledNavMesh *tilemesh,
+                            const float pos[3],
+                            NavMeshPoly &r_poly)
+{
+  if (tilemesh) {
+    const dtTilePolyRef ref = tilemesh->findNearestPoly(pos, polyPickExt);
+    if (ref == 0) {
+      return false;
+    }
+    unsigned int salt, tile, index;
+    dtDecodeTileId(ref, salt, tile, index);
+    getTilePoly(tilemesh->getTile(tile)->header, index, r_poly);
+    return true;
+  }
+  if (statmesh) {
+    const dtStatPolyRef ref = statmesh->findNearestPoly(pos, polyPickExt);
+    if (ref == 0) {
+      return false;
+    }
+    getStatPoly(statmesh, ref - 1, r_poly);
+    return true;
+  }
+  return false;
+}
+
+/// Maximum number of polygon corridors kept between path queries.
+static const unsigned int MAX_CORRIDORS = 1024;
+
+/** Find a path in a static or tiled navigation mesh, both have the same query functions.
+ * The polygons crossed between two polygons are searched once and reused by the next paths
+ * between the same polygons, only the straight path is computed again from the positions.
+ */
+template<class NavMesh, class PolyRef>
+static int findStraightPath(NavMesh *navmesh,
+                            std::unordered_map<uint64_t, std::vector<unsigned int>> &corridors,
+                            const float spos[3],
+                            const float epos[3],
+                            float *path,
+                            int maxPathLen)
+{
+  const PolyRef sPolyRef = navmesh->findNearestPoly(spos, polyPickExt);
+  const PolyRef ePolyRef = navmesh->findNearestPoly(epos, polyPickExt);
+  if (!sPolyRef || !ePolyRef) {
+    return 0;
+  }
+
+  std::vector<PolyRef> polys(maxPathLen);
+  int npolys;
+  const uint64_t key = ((uint64_t)sPolyRef << 32) | (uint64_t)ePolyRef;
+  const auto it = corridors.find(key);
+  if (it != corridors.end() && it->second.size() <= (unsigned int)maxPathLen) {
+    npolys = it->second.size();
+    std::copy(it->second.begin(), it->second.end(), polys.begin());
+  }
+  else {
+    npolys = navmesh->findPath(sPolyRef, ePolyRef, spos, epos, polys.data(), maxPathLen);
+    /* Failed and truncated searches are not cached, a tile swap or a longer path can find the
+     * corridor later. */
+    if (npolys > 0 && polys[npolys - 1] == ePolyRef) {
+      if (corridors.size() >= MAX_CORRIDORS) {
+        corridors.clear();
+      }
+      corridors[key].assign(polys.begin(), polys.begin() + npolys);
+    }
+  }
+
+  if (npolys == 0) {
+    return 0;
+  }
+
+  return navmesh->findStraightPath(spos, epos, polys.data(), npolys, path, maxPathLen);
+}
+
+template<class NavMesh, class PolyRef>
+static float raycast(NavMesh *navmesh, const float spos[3], const float epos[3])
+{
+  const PolyRef sPolyRef = navmesh->findNearestPoly(spos, polyPickExt);
+  float t = 0;
+  PolyRef polys[MAX_PATH_LEN];
+  navmesh->raycast(sPolyRef, spos, epos, t, polys, MAX_PATH_LEN);
+  return t;
+}
+
+static float barDistSqPointToTri(const float *p, const float *a, const float *b, const float *c)
+{
+  float v0[3], v1[3], v2[3];
+  rcVsub(v0, c, a);
+  rcVsub(v1, b, a);
+  rcVsub(v2, p, a);
+
+  const float dot00 = v0[0] * v0[0] + v0[2] * v0[2];
+  const float dot01 = v0[0] * v1[0] + v0[2] * v1[2];
+  const float dot02 = v0[0] * v2[0] + v0[2] * v2[2];
+  const float dot11 = v1[0] * v1[0] + v1[2] * v1[2];
+  const float dot12 = v1[0] * v2[0] + v1[2] * v2[2];
+
+  // Compute barycentric coordinates
+  float invDenom = 1.0f / (dot00 * dot11 - dot01 * dot01);
+  float u = (dot11 * dot02 - dot01 * dot12) * invDenom;
+  float v = (dot00 * dot12 - dot01 * dot02) * invDenom;
+
+  float ud = u < 0.f ? -u : (u > 1.f ? u - 1.f : 0.f);
+  float vd = v < 0.f ? -v : (v > 1.f ? v - 1.f : 0.f);
+  return ud * ud + vd * vd;
+}
+
+KX_NavMeshObject::KX_NavMeshObject() : KX_GameObject(), m_navMesh(nullptr), m_tiles(nullptr)
 {
 }
 
@@ -582,6 +774,8 @@ KX_NavMeshObject::~KX_NavMeshObject()
 {
   if (m_navMesh)
     delete m_navMesh;
+  if (m_tiles)
+    delete m_tiles;
 }
 
 KX_PythonProxy *KX_NavMeshObject::NewInstance()
@@ -593,6 +787,8 @@ void KX_NavMeshObject::ProcessReplica()
 {
   KX_GameObject::ProcessReplica();
   m_navMesh = nullptr; /* without this, building frees the navmesh we copied from */
+  m_tiles = nullptr;
+  m_blockers.clear();
   if (!BuildNavMesh()) {
     CM_FunctionError("unable to build navigation mesh");
     return;
@@ -781,10 +977,18 @@ bool KX_NavMeshObject::BuildVertIndArrays(float *&vertices,
 
 bool KX_NavMeshObject::BuildNavMesh()
 {
+  m_corridors.clear();
   if (m_navMesh) {
     delete m_navMesh;
     m_navMesh = nullptr;
   }
+  if (m_tiles) {
+    delete m_tiles;
+    m_tiles = nullptr;
+    GetScene()->RemoveTiledNavMesh(this);
+    // The scene only removes the ended blockers from the tiled navigation meshes.
+    m_blockers.clear();
+  }
 
   if (GetMeshCount() == 0) {
     CM_Error("can't find mesh for navmesh object: " << m_name);
@@ -835,6 +1039,26 @@ bool KX_NavMeshObject::BuildNavMesh()
     }
   }
 
+  const RecastData &recastData = GetScene()->GetBlenderScene()->gm.recastData;
+  if (recastData.tilesize > 0) {
+    const bool built = BuildTiles(recastData, vertices, nverts, polys, npolys, vertsPerPoly);
+    if (!built) {
+      CM_Error("can't build navigation mesh tiles for object: " << m_name);
+    }
+    delete[] vertices;
+    if (dvertices) {
+      delete[] dvertices;
+    }
+    MEM_freeN(polys);
+    if (dmeshes) {
+      MEM_freeN(dmeshes);
+    }
+    if (dtris) {
+      MEM_freeN(dtris);
+    }
+    return built;
+  }
+
   if (!buildMeshAdjacency(polys, npolys, nverts, vertsPerPoly)) {
     CM_FunctionError("unable to build mesh adjacency information.");
     if (vertices) {
@@ -1018,52 +1242,200 @@ bool KX_NavMeshObject::BuildNavMesh()
   return true;
 }
 
+bool KX_NavMeshObject::BuildTiles(const RecastData &params,
+                                  const float *vertices,
+                                  int nverts,
+                                  const unsigned short *polys,
+                                  int npolys,
+                                  int vertsPerPoly)
+{
+  const std::vector<float> verts(vertices, vertices + nverts * 3);
+  std::vector<int> tris;
+  for (int i = 0; i < npolys; ++i) {
+    const unsigned short *poly = &polys[i * vertsPerPoly * 2];
+    const int nv = polyNumVerts(poly, vertsPerPoly);
+    // The navigation polygons are convex.
+    for (int j = 2; j < nv; ++j) {
+      tris.push_back(poly[0]);
+      tris.push_back(poly[j - 1]);
+      tris.push_back(poly[j]);
+    }
+  }
+
+  m_tiles = new KX_NavMeshTiles();
+  if (!m_tiles->Build(params, verts, tris)) {
+    delete m_tiles;
+    m_tiles = nullptr;
+    return false;
+  }
+
+  GetScene()->AddTiledNavMesh(this);
+
+  return true;
+}
+
 dtStatNavMesh *KX_NavMeshObject::GetNavMesh()
 {
   return m_navMesh;
 }
 
-void KX_NavMeshObject::DrawNavMesh(NavMeshRenderMode renderMode)
+dtTiledNavMesh *KX_NavMeshObject::GetTiledNavMesh()
+{
+  return m_tiles ? m_tiles->GetNavMesh() : nullptr;
+}
+
+bool KX_NavMeshObject::GetNormal(const MT_Vector3 &pos, MT_Vector3 &normal)
+{
+  float spos[3];
+  pos.getValue(spos);
+  flipAxes(spos);
+
+  NavMeshPoly poly;
+  if (!findNearestPoly(m_navMesh, GetTiledNavMesh(), spos, poly)) {
+    return false;
+  }
+
+  float distMin = FLT_MAX;
+  int idxMin = -1;
+  for (int i = 0; i < poly.ntris; ++i) {
+    float dist = barDistSqPointToTri(
+        spos, poly.GetTriVertex(i, 0), poly.GetTriVertex(i, 1), poly.GetTriVertex(i, 2));
+    if (dist < distMin) {
+      distMin = dist;
+      idxMin = i;
+    }
+  }
+
+  if (idxMin < 0) {
+    return false;
+  }
+
+  MT_Vector3 tri[3];
+  for (int j = 0; j < 3; j++) {
+    const float *v = poly.GetTriVertex(idxMin, j);
+    tri[j].setValue(v[0], v[2], v[1]);
+  }
+  const MT_Vector3 a = tri[1] - tri[0];
+  const MT_Vector3 b = tri[2] - tri[0];
+  normal = b.cross(a).safe_normalized();
+  return true;
+}
+
+void KX_NavMeshObject::GetWalls(std::vector<MT_Vector3> &walls)
 {
-  if (!m_navMesh)
+  foreachPoly(m_navMesh, GetTiledNavMesh(), [&walls](const NavMeshPoly &poly) {
+    for (int i = 0, j = poly.nv - 1; i < poly.nv; j = i++) {
+      if (!poly.walls[i]) {
+        continue;
+      }
+      const float *vj = poly.verts[j];
+      const float *vi = poly.verts[i];
+      walls.emplace_back(vj[0], vj[2], vj[1]);
+      walls.emplace_back(vi[0], vi[2], vi[1]);
+    }
+  });
+}
+
+bool KX_NavMeshObject::AddBlocker(KX_GameObject *gameobj)
+{
+  /* The blockers are removed when they end by the scene of the navigation mesh, objects of
+   * other scenes would be left dangling. */
+  if (!m_tiles || gameobj == this || gameobj->GetScene() != GetScene()) {
+    return false;
+  }
+
+  CM_ListAddIfNotFound(m_blockers, gameobj);
+  return true;
+}
+
+void KX_NavMeshObject::RemoveBlocker(KX_GameObject *gameobj)
+{
+  CM_ListRemoveIfFound(m_blockers, gameobj);
+}
+
+void KX_NavMeshObject::UpdateTiles()
+{
+  if (!m_tiles) {
     return;
-  MT_Vector4 color(0.0f, 0.0f, 0.0f, 1.0f);
+  }
+
+  MT_Matrix3x3 orientation = NodeGetWorldOrientation();
+  const MT_Vector3 &scaling = NodeGetWorldScaling();
+  orientation.scale(scaling[0], scaling[1], scaling[2]);
+  MT_Transform invworldtr;
+  invworldtr.invert(MT_Transform(NodeGetWorldPosition(), orientation));
+
+  std::vector<KX_NavMeshTiles::Box> boxes(m_blockers.size());
+  for (unsigned int i = 0, size = m_blockers.size(); i < size; ++i) {
+    KX_GameObject *gameobj = m_blockers[i];
+    // The culling bounds are only updated by the DBVT culling, deformed objects change them.
+    gameobj->UpdateBounds();
+    const SG_BBox &aabb = gameobj->GetCullingNode().GetAabb();
+    const MT_Vector3 &min = aabb.GetMin();
+    const MT_Vector3 &max = aabb.GetMax();
+    // Blocker local space to navigation mesh local space.
+    const MT_Transform trans = invworldtr * gameobj->NodeGetWorldTransform();
+
+    KX_NavMeshTiles::Box &box = boxes[i];
+    for (unsigned short j = 0; j < 8; ++j) {
+      const MT_Vector3 corner(
+          (j & 1) ? max.x() : min.x(), (j & 2) ? max.y() : min.y(), (j & 4) ? max.z() : min.z());
+      float pos[3];
+      trans(corner).getValue(pos);
+      flipAxes(pos);
+      if (j == 0) {
+        rcVcopy(box.m_min, pos);
+        rcVcopy(box.m_max, pos);
+      }
+      else {
+        rcVmin(box.m_min, pos);
+        rcVmax(box.m_max, pos);
+      }
+    }
+  }
+
+  m_tiles->SetBlockers(boxes);
+
+  if (m_tiles->Update()) {
+    // The walls and the paths changed with the tiles.
+    m_corridors.clear();
+    KX_ObstacleSimulation *obssimulation = GetScene()->GetObstacleSimulation();
+    if (obssimulation) {
+      obssimulation->DestroyObstacleForObj(this);
+      obssimulation->AddObstaclesForNavMesh(this);
+    }
+  }
+}
+
+void KX_NavMeshObject::DrawNavMesh(NavMeshRenderMode renderMode)
+{
+  dtTiledNavMesh *tilemesh = GetTiledNavMesh();
+  const MT_Vector4 color(0.0f, 0.0f, 0.0f, 1.0f);
 
   switch (renderMode) {
     case RM_POLYS:
     case RM_WALLS:
-      for (int pi = 0; pi < m_navMesh->getPolyCount(); pi++) {
-        const dtStatPoly *poly = m_navMesh->getPoly(pi);
-
-        for (int i = 0, j = (int)poly->nv - 1; i < (int)poly->nv; j = i++) {
-          if (poly->n[j] && renderMode == RM_WALLS)
+      foreachPoly(m_navMesh, tilemesh, [&](const NavMeshPoly &poly) {
+        for (int i = 0, j = poly.nv - 1; i < poly.nv; j = i++) {
+          if (!poly.walls[i] && renderMode == RM_WALLS)
             continue;
-          const float *vif = m_navMesh->getVertex(poly->v[i]);
-          const float *vjf = m_navMesh->getVertex(poly->v[j]);
+          const float *vif = poly.verts[i];
+          const float *vjf = poly.verts[j];
           MT_Vector3 vi(vif[0], vif[2], vif[1]);
           MT_Vector3 vj(vjf[0], vjf[2], vjf[1]);
           vi = TransformToWorldCoords(vi);
           vj = TransformToWorldCoords(vj);
           KX_RasterizerDrawDebugLine(vi, vj, color);
         }
-      }
+      });
       break;
     case RM_TRIS:
-      for (int i = 0; i < m_navMesh->getPolyDetailCount(); ++i) {
-        const dtStatPoly *p = m_navMesh->getPoly(i);
-        const dtStatPolyDetail *pd = m_navMesh->getPolyDetail(i);
-
-        for (int j = 0; j < pd->ntris; ++j) {
-          const unsigned char *t = m_navMesh->getDetailTri(pd->tbase + j);
+      foreachPoly(m_navMesh, tilemesh, [&](const NavMeshPoly &poly) {
+        for (int j = 0; j < poly.ntris; ++j) {
           MT_Vector3 tri[3];
           for (int k = 0; k < 3; ++k) {
-            const float *v;
-            if (t[k] < p->nv)
-              v = m_navMesh->getVertex(p->v[t[k]]);
-            else
-              v = m_navMesh->getDetailVertex(pd->vbase + (t[k] - p->nv));
             float pos[3];
-            rcVcopy(pos, v);
+            rcVcopy(pos, poly.GetTriVertex(j, k));
             flipAxes(pos);
             tri[k].setValue(pos);
           }
@@ -1074,7 +1446,7 @@ void KX_NavMeshObject::DrawNavMesh(NavMeshRenderMode renderMode)
           for (int k = 0; k < 3; k++)
             KX_RasterizerDrawDebugLine(tri[k], tri[(k + 1) % 3], color);
         }
-      }
+      });
       break;
     default:
       /* pass */
@@ -1109,7 +1481,8 @@ int KX_NavMeshObject::FindPath(const MT_Vector3 &from,
                                float *path,
                                int maxPathLen)
 {
-  if (!m_navMesh)
+  dtTiledNavMesh *tilemesh = GetTiledNavMesh();
+  if (!m_navMesh && !tilemesh)
     return 0;
   MT_Vector3 localfrom = TransformToLocalCoords(from);
   MT_Vector3 localto = TransformToLocalCoords(to);
@@ -1118,25 +1491,16 @@ int KX_NavMeshObject::FindPath(const MT_Vector3 &from,
   flipAxes(spos);
   localto.getValue(epos);
   flipAxes(epos);
-  dtStatPolyRef sPolyRef = m_navMesh->findNearestPoly(spos, polyPickExt);
-  dtStatPolyRef ePolyRef = m_navMesh->findNearestPoly(epos, polyPickExt);
-
-  int pathLen = 0;
-  if (sPolyRef && ePolyRef) {
-    dtStatPolyRef *polys = new dtStatPolyRef[maxPathLen];
-    int npolys;
-    npolys = m_navMesh->findPath(sPolyRef, ePolyRef, spos, epos, polys, maxPathLen);
-    if (npolys) {
-      pathLen = m_navMesh->findStraightPath(spos, epos, polys, npolys, path, maxPathLen);
-      for (int i = 0; i < pathLen; i++) {
-        flipAxes(&path[i * 3]);
-        MT_Vector3 waypoint(&path[i * 3]);
-        waypoint = TransformToWorldCoords(waypoint);
-        waypoint.getValue(&path[i * 3]);
-      }
-    }
 
-    delete[] polys;
+  const int pathLen = tilemesh ? findStraightPath<dtTiledNavMesh, dtTilePolyRef>(
+                                     tilemesh, m_corridors, spos, epos, path, maxPathLen) :
+                                 findStraightPath<dtStatNavMesh, dtStatPolyRef>(
+                                     m_navMesh, m_corridors, spos, epos, path, maxPathLen);
+  for (int i = 0; i < pathLen; i++) {
+    flipAxes(&path[i * 3]);
+    MT_Vector3 waypoint(&path[i * 3]);
+    waypoint = TransformToWorldCoords(waypoint);
+    waypoint.getValue(&path[i * 3]);
   }
 
   return pathLen;
@@ -1144,7 +1508,8 @@ int KX_NavMeshObject::FindPath(const MT_Vector3 &from,
 
 float KX_NavMeshObject::Raycast(const MT_Vector3 &from, const MT_Vector3 &to)
 {
-  if (!m_navMesh)
+  dtTiledNavMesh *tilemesh = GetTiledNavMesh();
+  if (!m_navMesh && !tilemesh)
     return 0.f;
   MT_Vector3 localfrom = TransformToLocalCoords(from);
   MT_Vector3 localto = TransformToLocalCoords(to);
@@ -1153,11 +1518,10 @@ float KX_NavMeshObject::Raycast(const MT_Vector3 &from, const MT_Vector3 &to)
   flipAxes(spos);
   localto.getValue(epos);
   flipAxes(epos);
-  dtStatPolyRef sPolyRef = m_navMesh->findNearestPoly(spos, polyPickExt);
-  float t = 0;
-  static dtStatPolyRef polys[MAX_PATH_LEN];
-  m_navMesh->raycast(sPolyRef, spos, epos, t, polys, MAX_PATH_LEN);
-  return t;
+  if (tilemesh) {
+    return raycast<dtTiledNavMesh, dtTilePolyRef>(tilemesh, spos, epos);
+  }
+  return raycast<dtStatNavMesh, dtStatPolyRef>(m_navMesh, spos, epos);
 }
 
 void KX_NavMeshObject::DrawPath(const float *path, int pathLen, const MT_Vector4 &color)
@@ -1234,6 +1598,8 @@ PyMethodDef KX_NavMeshObject::Methods[] = {
     EXP_PYMETHODTABLE(KX_NavMeshObject, raycast),
     EXP_PYMETHODTABLE(KX_NavMeshObject, draw),
     EXP_PYMETHODTABLE(KX_NavMeshObject, rebuild),
+    EXP_PYMETHODTABLE_O(KX_NavMeshObject, addBlocker),
+    EXP_PYMETHODTABLE_O(KX_NavMeshObject, removeBlocker),
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -1294,4 +1660,45 @@ EXP_PYMETHODDEF_DOC_NOARGS(KX_NavMeshObject, rebuild, "rebuild(): rebuild naviga
   Py_RETURN_NONE;
 }
 
+EXP_PYMETHODDEF_DOC_O(KX_NavMeshObject,
+                      addBlocker,
+                      "addBlocker(object): carve the bounding box of an object in the tiled "
+                      "navigation mesh\n")
+{
+  KX_GameObject *gameobj;
+  if (!ConvertPythonToGameObject(GetScene()->GetLogicManager(),
+                                 value,
+                                 &gameobj,
+                                 false,
+                                 "navmesh.addBlocker(object): KX_NavMeshObject")) {
+    return nullptr;
+  }
+
+  if (!AddBlocker(gameobj)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "navmesh.addBlocker(object): KX_NavMeshObject, the navigation mesh is not "
+                    "tiled or the object is not in its scene");
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC_O(KX_NavMeshObject,
+                      removeBlocker,
+                      "removeBlocker(object): stop carving an object in the tiled navigation "
+                      "mesh\n")
+{
+  KX_GameObject *gameobj;
+  if (!ConvertPythonToGameObject(GetScene()->GetLogicManager(),
+                                 value,
+                                 &gameobj,
+                                 false,
+                                 "navmesh.removeBlocker(object): KX_NavMeshObject")) {
+    return nullptr;
+  }
+
+  RemoveBlocker(gameobj);
+  Py_RETURN_NONE;
+}
+
 #endif  // WITH_PYTHON
@@ -26,17 +26,28 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "DetourStatNavMesh.h"
+#include "DetourTileNavMesh.h"
 #include "EXP_PyObjectPlus.h"
 #include "KX_GameObject.h"
 
+class KX_NavMeshTiles;
+struct RecastData;
 
 class KX_NavMeshObject : public KX_GameObject {
   Py_Header
 
       protected : dtStatNavMesh *m_navMesh;
+  /// Tiled navigation mesh used instead of m_navMesh when the scene has a tile size.
+  KX_NavMeshTiles *m_tiles;
+  /// Objects carved in the tiled navigation mesh.
+  std::vector<KX_GameObject *> m_blockers;
+  /// Polygons of the paths found, keyed by their start and end polygons.
+  std::unordered_map<uint64_t, std::vector<unsigned int>> m_corridors;
 
   bool BuildVertIndArrays(float *&vertices,
                           int &nverts,
@@ -48,6 +59,12 @@ class KX_NavMeshObject : public KX_GameObject {
                           unsigned short *&dtris,
                           int &ndtris,
                           int &vertsPerPoly);
+  bool BuildTiles(const RecastData &params,
+                  const float *vertices,
+                  int nverts,
+                  const unsigned short *polys,
+                  int npolys,
+                  int vertsPerPoly);
 
  public:
   KX_NavMeshObject();
@@ -58,6 +75,18 @@ class KX_NavMeshObject : public KX_GameObject {
 
   bool BuildNavMesh();
   dtStatNavMesh *GetNavMesh();
+  dtTiledNavMesh *GetTiledNavMesh();
+  /// Get the normal of the navigation mesh at a position in local coordinates.
+  bool GetNormal(const MT_Vector3 &pos, MT_Vector3 &normal);
+  /// Get the walls of the navigation mesh as pairs of points in local coordinates.
+  void GetWalls(std::vector<MT_Vector3> &walls);
+
+  /// Carve the bounding box of an object of the same scene in the tiled navigation mesh.
+  bool AddBlocker(KX_GameObject *gameobj);
+  void RemoveBlocker(KX_GameObject *gameobj);
+  /// Rebuild the tiles under the moved blockers and swap the tiles rebuilt.
+  void UpdateTiles();
+
   int FindPath(const MT_Vector3 &from, const MT_Vector3 &to, float *path, int maxPathLen);
   float Raycast(const MT_Vector3 &from, const MT_Vector3 &to);
 
@@ -78,5 +107,7 @@ class KX_NavMeshObject : public KX_GameObject {
   EXP_PYMETHOD_DOC(KX_NavMeshObject, raycast);
   EXP_PYMETHOD_DOC(KX_NavMeshObject, draw);
   EXP_PYMETHOD_DOC_NOARGS(KX_NavMeshObject, rebuild);
+  EXP_PYMETHOD_DOC_O(KX_NavMeshObject, addBlocker);
+  EXP_PYMETHOD_DOC_O(KX_NavMeshObject, removeBlocker);
 #endif /* WITH_PYTHON */
 };
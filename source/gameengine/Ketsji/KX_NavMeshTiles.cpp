@@ -0,0 +1,433 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Ketsji/KX_NavMeshTiles.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_NavMeshTiles.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "BLI_assert.h"
+#include "BLI_math_rotation.h"
+#include "BLI_task.h"
+#include "DNA_scene_types.h"
+
+#include "CM_Message.h"
+#include "CM_Profiler.h"
+#include "DetourTileNavMeshBuilder.h"
+
+static bool build_regions(rcContext &context,
+                          rcCompactHeightfield &chf,
+                          const rcConfig &config,
+                          char partitioning)
+{
+  switch (partitioning) {
+    case RC_PARTITION_MONOTONE: {
+      return rcBuildRegionsMonotone(
+          &context, chf, config.borderSize, config.minRegionArea, config.mergeRegionArea);
+    }
+    case RC_PARTITION_LAYERS: {
+      return rcBuildLayerRegions(&context, chf, config.borderSize, config.minRegionArea);
+    }
+    default: {
+      return rcBuildDistanceField(&context, chf) &&
+             rcBuildRegions(
+                 &context, chf, config.borderSize, config.minRegionArea, config.mergeRegionArea);
+    }
+  }
+}
+
+static bool box_overlap_xz(const KX_NavMeshTiles::Box &box, const float min[3], const float max[3])
+{
+  return box.m_min[0] <= max[0] && box.m_max[0] >= min[0] && box.m_min[2] <= max[2] &&
+         box.m_max[2] >= min[2];
+}
+
+KX_NavMeshTiles::KX_NavMeshTiles() : m_navMesh(nullptr), m_partitioning(0), m_pool(nullptr)
+{
+  memset(&m_config, 0, sizeof(rcConfig));
+  m_tiles[0] = m_tiles[1] = 0;
+}
+
+KX_NavMeshTiles::~KX_NavMeshTiles()
+{
+  if (m_pool) {
+    BLI_task_pool_work_and_wait(m_pool);
+    BLI_task_pool_free(m_pool);
+  }
+
+  for (TileJob *job : m_jobs) {
+    delete[] job->m_data;
+    delete job;
+  }
+
+  if (m_navMesh) {
+    // The navigation mesh doesn't free the tiles it owns.
+    for (int i = 0; i < DT_MAX_TILES; ++i) {
+      const dtTile *tile = m_navMesh->getTile(i);
+      if (tile->header) {
+        m_navMesh->removeTileAt(tile->x, tile->y, nullptr, nullptr);
+      }
+    }
+    delete m_navMesh;
+  }
+}
+
+void KX_NavMeshTiles::BuildTileTask(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  TileJob *job = static_cast<TileJob *>(taskdata);
+  job->m_tiles->BuildTile(job);
+  job->m_done = true;
+}
+
+void KX_NavMeshTiles::BuildTile(TileJob *job) const
+{
+  CM_PROFILE_ZONE("NavMeshTile");
+
+  const std::vector<int> &tileTris = m_tileTris[job->m_y * m_tiles[0] + job->m_x];
+  if (tileTris.empty()) {
+    return;
+  }
+
+  rcConfig config = m_config;
+  const float tileWorld = config.tileSize * config.cs;
+  const float border = config.borderSize * config.cs;
+  config.bmin[0] = m_config.bmin[0] + job->m_x * tileWorld - border;
+  config.bmin[2] = m_config.bmin[2] + job->m_y * tileWorld - border;
+  config.bmax[0] = m_config.bmin[0] + (job->m_x + 1) * tileWorld + border;
+  config.bmax[2] = m_config.bmin[2] + (job->m_y + 1) * tileWorld + border;
+
+  const int ntris = tileTris.size();
+  std::vector<int> tris(ntris * 3);
+  for (int i = 0; i < ntris; ++i) {
+    memcpy(&tris[i * 3], &m_tris[tileTris[i] * 3], sizeof(int) * 3);
+  }
+  // The source triangles are the walkable surface, no need to check their slope.
+  const std::vector<unsigned char> areas(ntris, RC_WALKABLE_AREA);
+
+  rcContext context(false);
+  rcHeightfield *solid = rcAllocHeightfield();
+  rcCompactHeightfield *chf = rcAllocCompactHeightfield();
+  rcContourSet *cset = rcAllocContourSet();
+  rcPolyMesh *pmesh = rcAllocPolyMesh();
+  rcPolyMeshDetail *dmesh = rcAllocPolyMeshDetail();
+
+  bool built = rcCreateHeightfield(&context,
+                                   *solid,
+                                   config.width,
+                                   config.height,
+                                   config.bmin,
+                                   config.bmax,
+                                   config.cs,
+                                   config.ch) &&
+               rcRasterizeTriangles(&context,
+                                    m_verts.data(),
+                                    m_verts.size() / 3,
+                                    tris.data(),
+                                    areas.data(),
+                                    ntris,
+                                    *solid,
+                                    config.walkableClimb) &&
+               rcBuildCompactHeightfield(
+                   &context, config.walkableHeight, config.walkableClimb, *solid, *chf);
+
+  if (built) {
+    for (const Box &box : job->m_blockers) {
+      rcMarkBoxArea(&context, box.m_min, box.m_max, RC_NULL_AREA, *chf);
+    }
+
+    built = build_regions(context, *chf, config, m_partitioning) &&
+            rcBuildContours(&context,
+                            *chf,
+                            config.maxSimplificationError,
+                            config.maxEdgeLen,
+                            *cset,
+                            RC_CONTOUR_TESS_WALL_EDGES) &&
+            rcBuildPolyMesh(&context, *cset, config.maxVertsPerPoly, *pmesh) &&
+            rcBuildPolyMeshDetail(&context,
+                                  *pmesh,
+                                  *chf,
+                                  config.detailSampleDist,
+                                  config.detailSampleMaxError,
+                                  *dmesh);
+  }
+
+  // An empty tile has no data, like a tile with too many polygons for the references.
+  if (built && pmesh->npolys > 0) {
+    if (pmesh->npolys > DT_MAX_POLYGONS || dmesh->nverts >= 0xffff) {
+      job->m_overflow = true;
+    }
+    else {
+      // Detour uses 16 bits detail meshes.
+      std::vector<unsigned short> dmeshes(dmesh->nmeshes * 4);
+      for (int i = 0; i < dmesh->nmeshes * 4; ++i) {
+        dmeshes[i] = dmesh->meshes[i];
+      }
+
+      if (!dtCreateNavMeshTileData(pmesh->verts,
+                                   pmesh->nverts,
+                                   pmesh->polys,
+                                   pmesh->npolys,
+                                   pmesh->nvp,
+                                   dmeshes.data(),
+                                   dmesh->verts,
+                                   dmesh->nverts,
+                                   dmesh->tris,
+                                   dmesh->ntris,
+                                   pmesh->bmin,
+                                   pmesh->bmax,
+                                   config.cs,
+                                   config.ch,
+                                   config.tileSize,
+                                   config.walkableClimb,
+                                   &job->m_data,
+                                   &job->m_dataSize))
+      {
+        job->m_data = nullptr;
+        job->m_dataSize = 0;
+      }
+    }
+  }
+
+  rcFreeHeightField(solid);
+  rcFreeCompactHeightfield(chf);
+  rcFreeContourSet(cset);
+  rcFreePolyMesh(pmesh);
+  rcFreePolyMeshDetail(dmesh);
+}
+
+void KX_NavMeshTiles::SwapTile(TileJob *job)
+{
+  if (job->m_overflow) {
+    CM_Warning("navigation mesh tile (" << job->m_x << ", " << job->m_y << ") has more than "
+                                        << DT_MAX_POLYGONS << " polygons, decrease the tile size");
+  }
+
+  m_navMesh->removeTileAt(job->m_x, job->m_y, nullptr, nullptr);
+  if (job->m_data &&
+      !m_navMesh->addTileAt(job->m_x, job->m_y, job->m_data, job->m_dataSize, true))
+  {
+    delete[] job->m_data;
+  }
+  job->m_data = nullptr;
+}
+
+bool KX_NavMeshTiles::GetTileRange(const float min[3],
+                                   const float max[3],
+                                   int r_min[2],
+                                   int r_max[2]) const
+{
+  const float tileWorld = m_config.tileSize * m_config.cs;
+  const float border = m_config.borderSize * m_config.cs;
+  for (unsigned short i = 0; i < 2; ++i) {
+    // Tiles are along X and Z.
+    const unsigned short axis = i * 2;
+    r_min[i] = std::max(0, int(floorf((min[axis] - border - m_config.bmin[axis]) / tileWorld)));
+    r_max[i] = std::min(m_tiles[i] - 1,
+                        int(floorf((max[axis] + border - m_config.bmin[axis]) / tileWorld)));
+  }
+
+  return (r_min[0] <= r_max[0] && r_min[1] <= r_max[1]);
+}
+
+void KX_NavMeshTiles::TagBox(const Box &box)
+{
+  int min[2], max[2];
+  if (!GetTileRange(box.m_min, box.m_max, min, max)) {
+    return;
+  }
+
+  for (int y = min[1]; y <= max[1]; ++y) {
+    for (int x = min[0]; x <= max[0]; ++x) {
+      m_dirtyTiles[y * m_tiles[0] + x] = true;
+    }
+  }
+}
+
+bool KX_NavMeshTiles::Build(const RecastData &params,
+                            const std::vector<float> &verts,
+                            const std::vector<int> &tris)
+{
+  BLI_assert(!m_navMesh);
+
+  m_verts = verts;
+  m_tris = tris;
+  const int nverts = m_verts.size() / 3;
+  const int ntris = m_tris.size() / 3;
+  if (nverts == 0 || ntris == 0) {
+    return false;
+  }
+
+  // Same conversion as the navigation mesh operator of the editor.
+  m_config.cs = params.cellsize;
+  m_config.ch = params.cellheight;
+  m_config.walkableSlopeAngle = RAD2DEGF(params.agentmaxslope);
+  m_config.walkableHeight = int(ceilf(params.agentheight / params.cellheight));
+  m_config.walkableClimb = int(floorf(params.agentmaxclimb / params.cellheight));
+  m_config.walkableRadius = int(ceilf(params.agentradius / params.cellsize));
+  m_config.maxEdgeLen = int(params.edgemaxlen / params.cellsize);
+  m_config.maxSimplificationError = params.edgemaxerror;
+  m_config.minRegionArea = int(params.regionminsize * params.regionminsize);
+  m_config.mergeRegionArea = int(params.regionmergesize * params.regionmergesize);
+  m_config.maxVertsPerPoly = DT_TILE_VERTS_PER_POLYGON;
+  m_config.detailSampleDist = (params.detailsampledist < 0.9f) ?
+                                  0.0f :
+                                  params.cellsize * params.detailsampledist;
+  m_config.detailSampleMaxError = params.cellheight * params.detailsamplemaxerror;
+  m_config.tileSize = params.tilesize;
+  m_config.borderSize = m_config.walkableRadius + 3;
+  m_config.width = m_config.height = m_config.tileSize + m_config.borderSize * 2;
+  m_partitioning = params.partitioning;
+
+  rcCalcBounds(m_verts.data(), nverts, m_config.bmin, m_config.bmax);
+
+  const float tileWorld = m_config.tileSize * m_config.cs;
+  m_tiles[0] = std::max(1, int(ceilf((m_config.bmax[0] - m_config.bmin[0]) / tileWorld)));
+  m_tiles[1] = std::max(1, int(ceilf((m_config.bmax[2] - m_config.bmin[2]) / tileWorld)));
+  const int numTiles = m_tiles[0] * m_tiles[1];
+  if (numTiles > DT_MAX_TILES) {
+    CM_Error("navigation mesh has " << numTiles << " tiles, more than " << DT_MAX_TILES
+                                    << ", increase the tile size");
+    return false;
+  }
+
+  m_navMesh = new dtTiledNavMesh();
+  if (!m_navMesh->init(m_config.bmin, tileWorld, params.agentmaxclimb)) {
+    return false;
+  }
+
+  m_tileTris.resize(numTiles);
+  for (int i = 0; i < ntris; ++i) {
+    float min[3], max[3];
+    rcVcopy(min, &m_verts[m_tris[i * 3] * 3]);
+    rcVcopy(max, min);
+    for (unsigned short j = 1; j < 3; ++j) {
+      const float *vert = &m_verts[m_tris[i * 3 + j] * 3];
+      rcVmin(min, vert);
+      rcVmax(max, vert);
+    }
+
+    int tmin[2], tmax[2];
+    if (!GetTileRange(min, max, tmin, tmax)) {
+      continue;
+    }
+    for (int y = tmin[1]; y <= tmax[1]; ++y) {
+      for (int x = tmin[0]; x <= tmax[0]; ++x) {
+        m_tileTris[y * m_tiles[0] + x].push_back(i);
+      }
+    }
+  }
+
+  m_dirtyTiles.assign(numTiles, true);
+  m_busyTiles.assign(numTiles, false);
+
+  m_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
+
+  // Build all the tiles now, the queries must not wait for them.
+  Update();
+  BLI_task_pool_work_and_wait(m_pool);
+  Update();
+
+  return true;
+}
+
+void KX_NavMeshTiles::SetBlockers(const std::vector<Box> &blockers)
+{
+  /* The source surface is already eroded by the agent radius, only the blockers are expanded so
+   * the agents keep their distance from them, and lowered to carve the surface they stand on. */
+  const float radius = m_config.walkableRadius * m_config.cs;
+  const float climb = m_config.walkableClimb * m_config.ch;
+
+  std::vector<Box> boxes(blockers);
+  for (Box &box : boxes) {
+    box.m_min[0] -= radius;
+    box.m_min[1] -= climb;
+    box.m_min[2] -= radius;
+    box.m_max[0] += radius;
+    box.m_max[2] += radius;
+  }
+
+  const unsigned int size = std::max(boxes.size(), m_blockers.size());
+  for (unsigned int i = 0; i < size; ++i) {
+    if (i < boxes.size() && i < m_blockers.size() &&
+        memcmp(&boxes[i], &m_blockers[i], sizeof(Box)) == 0)
+    {
+      continue;
+    }
+
+    if (i < m_blockers.size()) {
+      TagBox(m_blockers[i]);
+    }
+    if (i < boxes.size()) {
+      TagBox(boxes[i]);
+    }
+  }
+
+  m_blockers = boxes;
+}
+
+bool KX_NavMeshTiles::Update()
+{
+  bool swapped = false;
+  for (std::vector<TileJob *>::iterator it = m_jobs.begin(); it != m_jobs.end();) {
+    TileJob *job = *it;
+    if (!job->m_done) {
+      ++it;
+      continue;
+    }
+
+    SwapTile(job);
+    m_busyTiles[job->m_y * m_tiles[0] + job->m_x] = false;
+    delete job;
+    it = m_jobs.erase(it);
+    swapped = true;
+  }
+
+  const float tileWorld = m_config.tileSize * m_config.cs;
+  const float border = m_config.borderSize * m_config.cs;
+  for (int y = 0; y < m_tiles[1]; ++y) {
+    for (int x = 0; x < m_tiles[0]; ++x) {
+      const int index = y * m_tiles[0] + x;
+      // A tile dirtied while being rebuilt is rebuilt again once swapped.
+      if (!m_dirtyTiles[index] || m_busyTiles[index]) {
+        continue;
+      }
+
+      TileJob *job = new TileJob();
+      job->m_tiles = this;
+      job->m_x = x;
+      job->m_y = y;
+      job->m_data = nullptr;
+      job->m_dataSize = 0;
+      job->m_overflow = false;
+      job->m_done = false;
+
+      const float min[3] = {m_config.bmin[0] + x * tileWorld - border,
+                            m_config.bmin[1],
+                            m_config.bmin[2] + y * tileWorld - border};
+      const float max[3] = {m_config.bmin[0] + (x + 1) * tileWorld + border,
+                            m_config.bmax[1],
+                            m_config.bmin[2] + (y + 1) * tileWorld + border};
+      for (const Box &box : m_blockers) {
+        if (box_overlap_xz(box, min, max)) {
+          job->m_blockers.push_back(box);
+        }
+      }
+
+      m_dirtyTiles[index] = false;
+      m_busyTiles[index] = true;
+      m_jobs.push_back(job);
+      BLI_task_pool_push(m_pool, BuildTileTask, job, false, nullptr);
+    }
+  }
+
+  return swapped;
+}
+
+dtTiledNavMesh *KX_NavMeshTiles::GetNavMesh() const
+{
+  return m_navMesh;
+}
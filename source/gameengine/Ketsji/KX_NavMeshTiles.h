@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file KX_NavMeshTiles.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "DetourTileNavMesh.h"
+#include "Recast.h"
+
+struct RecastData;
+struct TaskPool;
+
+/**
+ * Navigation mesh split in tiles which are rebuilt at runtime.
+ *
+ * The tiles are built by Recast from the triangles of the navigation mesh object, which are
+ * already the walkable surface of the agents, less the boxes of the blockers. When a box
+ * changes the tiles it overlaps are rebuilt in background tasks and swapped in the Detour mesh
+ * by Update, on the main thread, so the queries always run on a complete mesh.
+ *
+ * All the coordinates are in the local space of the navigation mesh object with Y up, like
+ * Recast and Detour.
+ */
+class KX_NavMeshTiles {
+ public:
+  struct Box {
+    float m_min[3];
+    float m_max[3];
+  };
+
+ private:
+  /// Tile built by a background task.
+  struct TileJob {
+    KX_NavMeshTiles *m_tiles;
+    int m_x;
+    int m_y;
+    /// Blockers overlapping the tile when the build started.
+    std::vector<Box> m_blockers;
+    /// Tile data for Detour, nullptr for an empty tile or a failed build.
+    unsigned char *m_data;
+    int m_dataSize;
+    /// True when the tile has too many polygons for Detour.
+    bool m_overflow;
+    std::atomic<bool> m_done;
+  };
+
+  dtTiledNavMesh *m_navMesh;
+
+  /// Recast settings of the tiles, the bounds are the ones of the whole mesh.
+  rcConfig m_config;
+  char m_partitioning;
+  /// Number of tiles in X and Z.
+  int m_tiles[2];
+
+  /// Source triangles.
+  std::vector<float> m_verts;
+  std::vector<int> m_tris;
+  /// Index of the triangles overlapping each tile and its border.
+  std::vector<std::vector<int>> m_tileTris;
+
+  std::vector<Box> m_blockers;
+  /// Tiles to rebuild at the next update.
+  std::vector<bool> m_dirtyTiles;
+  /// Tiles being rebuilt.
+  std::vector<TileJob *> m_jobs;
+  std::vector<bool> m_busyTiles;
+  TaskPool *m_pool;
+
+  static void BuildTileTask(TaskPool *__restrict pool, void *taskdata);
+  void BuildTile(TileJob *job) const;
+  /// Replace the tile of a finished job in the navigation mesh.
+  void SwapTile(TileJob *job);
+  /// Get the range of tiles overlapping a box expanded by the tile border.
+  bool GetTileRange(const float min[3], const float max[3], int r_min[2], int r_max[2]) const;
+  /// Mark the tiles overlapping a box to rebuild.
+  void TagBox(const Box &box);
+
+ public:
+  KX_NavMeshTiles();
+  ~KX_NavMeshTiles();
+
+  /** Build all the tiles and wait for them.
+   * \param params The Recast settings of the scene, params.tilesize must not be zero.
+   * \param verts The source vertices, 3 floats per vertex.
+   * \param tris The source triangles, 3 vertex indices per triangle.
+   */
+  bool Build(const RecastData &params,
+             const std::vector<float> &verts,
+             const std::vector<int> &tris);
+
+  /// Set the boxes carved in the navigation mesh, the tiles under changed boxes are rebuilt.
+  void SetBlockers(const std::vector<Box> &blockers);
+
+  /** Start the rebuild of the dirty tiles and swap the finished ones.
+   * \return True when tiles were swapped.
+   */
+  bool Update();
+
+  dtTiledNavMesh *GetNavMesh() const;
+};
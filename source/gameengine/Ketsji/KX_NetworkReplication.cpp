@@ -0,0 +1,1224 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Ketsji/KX_NetworkReplication.cpp
+ *  \ingroup ketsji
+ */
+
+#ifdef WIN32
+#  include <winsock2.h>
+#  include <ws2tcpip.h>
+#else
+#  include <arpa/inet.h>
+#  include <fcntl.h>
+#  include <netinet/in.h>
+#  include <sys/socket.h>
+#  include <unistd.h>
+#endif
+
+#include "KX_NetworkReplication.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include "BLI_hash_md5.hh"
+
+#include "EXP_BoolValue.h"
+#include "EXP_FloatValue.h"
+#include "EXP_IntValue.h"
+#include "EXP_ListValue.h"
+#include "EXP_StringValue.h"
+#include "KX_GameObject.h"
+#include "KX_Scene.h"
+#include "PHY_IPhysicsController.h"
+
+#include "CM_Message.h"
+
+/// First bytes of all the packets.
+static const unsigned int PACKET_MAGIC = 0x52504755;  // "UGPR"
+/// Maximum size of a packet, the snapshots bigger than this are not sent.
+static const unsigned int PACKET_MAX_SIZE = 60000;
+/// Number of snapshots kept as baselines and for the interpolation.
+static const unsigned int HISTORY_SIZE = 64;
+/// Time without packet after which a client is forgotten by the server, or reconnects.
+static const double CLIENT_TIMEOUT = 5.0;
+/// Size of the connection requests, bigger than the challenge answered by the server.
+static const unsigned int CONNECT_PACKET_SIZE = 64;
+/** Maximum size of the messages in a packet, the remaining messages are sent in the next
+ * packets. The messages bigger than this are never sent. */
+static const unsigned int MESSAGES_MAX_SIZE = PACKET_MAX_SIZE / 4;
+
+enum PacketType { PACKET_SNAPSHOT = 0, PACKET_ACKNOWLEDGEMENT, PACKET_CONNECT, PACKET_CHALLENGE };
+
+enum PropertyType { PROP_REMOVED = 0, PROP_INT, PROP_FLOAT, PROP_BOOL, PROP_STRING };
+
+enum ObjectField {
+  FIELD_POSITION = (1 << 0),
+  FIELD_ROTATION = (1 << 1),
+  FIELD_SCALE = (1 << 2),
+  FIELD_PROPERTIES = (1 << 3),
+  FIELD_REMOVED = (1 << 4)
+};
+
+namespace {
+
+/// Write values in little endian at the end of a packet.
+class PacketWriter {
+ private:
+  std::vector<unsigned char> &m_data;
+
+ public:
+  PacketWriter(std::vector<unsigned char> &data) : m_data(data)
+  {
+  }
+
+  void WriteU8(unsigned char value)
+  {
+    m_data.push_back(value);
+  }
+
+  void WriteU16(unsigned short value)
+  {
+    m_data.push_back(value & 0xFF);
+    m_data.push_back(value >> 8);
+  }
+
+  void WriteU32(unsigned int value)
+  {
+    for (unsigned short i = 0; i < 4; ++i) {
+      m_data.push_back((value >> (i * 8)) & 0xFF);
+    }
+  }
+
+  void WriteU64(unsigned long long value)
+  {
+    for (unsigned short i = 0; i < 8; ++i) {
+      m_data.push_back((value >> (i * 8)) & 0xFF);
+    }
+  }
+
+  void WriteFloat(float value)
+  {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteU32(bits);
+  }
+
+  void WriteDouble(double value)
+  {
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteU64(bits);
+  }
+
+  void WriteString(const std::string &value)
+  {
+    WriteU32(value.size());
+    m_data.insert(m_data.end(), value.begin(), value.end());
+  }
+};
+
+/// Read values in little endian from a packet, a read past the end invalidates the reader.
+class PacketReader {
+ private:
+  const std::vector<unsigned char> &m_data;
+  unsigned int m_position;
+  bool m_valid;
+
+  bool Check(unsigned int size)
+  {
+    if (m_data.size() - m_position < size) {
+      m_valid = false;
+    }
+    return m_valid;
+  }
+
+ public:
+  PacketReader(const std::vector<unsigned char> &data) : m_data(data), m_position(0), m_valid(true)
+  {
+  }
+
+  bool IsValid() const
+  {
+    return m_valid;
+  }
+
+  /// Reject the packet after reading an unexpected value.
+  void Invalidate()
+  {
+    m_valid = false;
+  }
+
+  unsigned char ReadU8()
+  {
+    if (!Check(1)) {
+      return 0;
+    }
+    return m_data[m_position++];
+  }
+
+  unsigned short ReadU16()
+  {
+    if (!Check(2)) {
+      return 0;
+    }
+    const unsigned short value = m_data[m_position] | (m_data[m_position + 1] << 8);
+    m_position += 2;
+    return value;
+  }
+
+  unsigned int ReadU32()
+  {
+    if (!Check(4)) {
+      return 0;
+    }
+    unsigned int value = 0;
+    for (unsigned short i = 0; i < 4; ++i) {
+      value |= (unsigned int)m_data[m_position++] << (i * 8);
+    }
+    return value;
+  }
+
+  unsigned long long ReadU64()
+  {
+    if (!Check(8)) {
+      return 0;
+    }
+    unsigned long long value = 0;
+    for (unsigned short i = 0; i < 8; ++i) {
+      value |= (unsigned long long)m_data[m_position++] << (i * 8);
+    }
+    return value;
+  }
+
+  float ReadFloat()
+  {
+    const unsigned int bits = ReadU32();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  double ReadDouble()
+  {
+    const unsigned long long bits = ReadU64();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  std::string ReadString()
+  {
+    const unsigned int size = ReadU32();
+    if (!Check(size)) {
+      return std::string();
+    }
+    const std::string value((const char *)&m_data[m_position], size);
+    m_position += size;
+    return value;
+  }
+};
+
+}  // namespace
+
+/// Size of a message written in a packet, its sequence and its three strings.
+template<class Message> static unsigned int message_size(const Message &message)
+{
+  return sizeof(unsigned int) * 4 + message.to.size() + message.subject.size() +
+         message.body.size();
+}
+
+/// FNV-1a hash of the scene and object names, identical on all the engines.
+static unsigned int object_identifier(const std::string &sceneName, const std::string &objectName)
+{
+  unsigned int hash = 2166136261u;
+  const auto add = [&hash](const std::string &str) {
+    for (const char c : str) {
+      hash = (hash ^ (unsigned char)c) * 16777619u;
+    }
+  };
+
+  add(sceneName);
+  add("/");
+  add(objectName);
+  return hash;
+}
+
+static bool floats_equal(const float *values1, const float *values2, unsigned int size)
+{
+  return memcmp(values1, values2, sizeof(float) * size) == 0;
+}
+
+bool KX_NetworkReplication::PropertyState::operator==(const PropertyState &other) const
+{
+  return type == other.type && number == other.number && text == other.text;
+}
+
+bool KX_NetworkReplication::Endpoint::operator<(const Endpoint &other) const
+{
+  return (address != other.address) ? address < other.address : port < other.port;
+}
+
+KX_NetworkReplication::KX_NetworkReplication(const Settings &settings)
+    : m_settings(settings),
+      m_socket(-1),
+      m_serverEndpoint({0, 0}),
+      m_lastTickTime(0.0),
+      m_lastSendTime(0.0),
+      m_nextTick(1),
+      m_nextSequence(1),
+      m_token(0),
+      m_connected(false),
+      m_lastReceiveTime(0.0),
+      m_receivedSequence(0),
+      m_clockOffset(0.0),
+      m_clockInitialized(false),
+      m_appliedTick(0)
+{
+  m_settings.tickRate = std::max(m_settings.tickRate, 1.0f);
+  m_settings.sendRate = std::max(m_settings.sendRate, 1.0f);
+  m_settings.interpolationDelay = std::max(m_settings.interpolationDelay, 0.0f);
+
+  std::random_device random;
+  for (unsigned char &value : m_secret) {
+    value = random() & 0xFF;
+  }
+}
+
+KX_NetworkReplication::~KX_NetworkReplication()
+{
+  if (m_socket == -1) {
+    return;
+  }
+
+#ifdef WIN32
+  closesocket((SOCKET)m_socket);
+  WSACleanup();
+#else
+  close((int)m_socket);
+#endif
+}
+
+bool KX_NetworkReplication::Start()
+{
+#ifdef WIN32
+  WSADATA wsaData;
+  if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+    CM_Error("replication: can't initialize the sockets");
+    return false;
+  }
+#endif
+
+  in_addr address;
+  if (inet_pton(AF_INET, m_settings.address.c_str(), &address) != 1) {
+    CM_Error("replication: invalid IPv4 address \"" << m_settings.address << "\"");
+#ifdef WIN32
+    WSACleanup();
+#endif
+    return false;
+  }
+  m_serverEndpoint = {(unsigned int)address.s_addr, htons(m_settings.port)};
+
+#ifdef WIN32
+  const SOCKET sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (sock == INVALID_SOCKET) {
+    CM_Error("replication: can't create the socket");
+    WSACleanup();
+    return false;
+  }
+  m_socket = (long long)sock;
+  u_long nonBlocking = 1;
+  ioctlsocket(sock, FIONBIO, &nonBlocking);
+#else
+  const int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (sock == -1) {
+    CM_Error("replication: can't create the socket");
+    return false;
+  }
+  m_socket = sock;
+  fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+  // The server listens on the given address, the clients use any free port.
+  sockaddr_in local = {};
+  local.sin_family = AF_INET;
+  if (m_settings.mode == MODE_SERVER) {
+    local.sin_addr = address;
+    local.sin_port = htons(m_settings.port);
+  }
+  else {
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = 0;
+  }
+
+  if (bind(sock, (const sockaddr *)&local, sizeof(local)) != 0) {
+    CM_Error("replication: can't bind the socket to " << m_settings.address << ":"
+                                                      << m_settings.port);
+    return false;
+  }
+
+  return true;
+}
+
+bool KX_NetworkReplication::SendPacket(const std::vector<unsigned char> &data, const Endpoint &to)
+{
+  if (data.size() > PACKET_MAX_SIZE) {
+    CM_Warning("replication: packet of " << data.size() << " bytes is too big, not sent");
+    return false;
+  }
+
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = to.address;
+  address.sin_port = to.port;
+
+#ifdef WIN32
+  const int sent = sendto((SOCKET)m_socket,
+                          (const char *)data.data(),
+                          data.size(),
+                          0,
+                          (const sockaddr *)&address,
+                          sizeof(address));
+#else
+  const int sent = sendto(
+      (int)m_socket, data.data(), data.size(), 0, (const sockaddr *)&address, sizeof(address));
+#endif
+
+  // A full send buffer is handled as a loss.
+  return sent == (int)data.size();
+}
+
+void KX_NetworkReplication::MessageAdded(const std::string &to,
+                                         const std::string &subject,
+                                         const std::string &body)
+{
+  const Message message = {m_nextSequence, to, subject, body};
+  if (message_size(message) > MESSAGES_MAX_SIZE) {
+    CM_Warning("replication: message \"" << subject << "\" is bigger than "
+                                         << MESSAGES_MAX_SIZE << " bytes, not sent");
+    return;
+  }
+  ++m_nextSequence;
+
+  if (m_settings.mode == MODE_SERVER) {
+    for (auto &pair : m_clients) {
+      pair.second.messages.push_back(message);
+    }
+  }
+  else {
+    m_pendingMessages.push_back(message);
+  }
+}
+
+void KX_NetworkReplication::CollectObjects(EXP_ListValue<KX_Scene> *scenes)
+{
+  static const EXP_PropertyName replicateName("replicate");
+
+  m_objects.clear();
+  for (KX_Scene *scene : scenes) {
+    const std::string &sceneName = scene->GetName();
+    for (KX_GameObject *gameobj : scene->GetObjectList()) {
+      EXP_Value *replicate = gameobj->GetProperty(replicateName);
+      if (!replicate || replicate->GetNumber() == 0.0) {
+        continue;
+      }
+
+      const unsigned int id = object_identifier(sceneName, gameobj->GetName());
+      // Only the first object of a name is replicated, the others are not identifiable.
+      m_objects.emplace(id, gameobj);
+    }
+  }
+}
+
+
+bool KX_NetworkReplication::ReadProperty(EXP_Value *prop, PropertyState &state)
+{
+  switch (prop->GetValueType()) {
+    case VALUE_INT_TYPE: {
+      state.type = PROP_INT;
+      state.number = prop->GetNumber();
+      return true;
+    }
+    case VALUE_FLOAT_TYPE: {
+      state.type = PROP_FLOAT;
+      state.number = prop->GetNumber();
+      return true;
+    }
+    case VALUE_BOOL_TYPE: {
+      state.type = PROP_BOOL;
+      state.number = prop->GetNumber();
+      return true;
+    }
+    case VALUE_STRING_TYPE: {
+      state.type = PROP_STRING;
+      state.text = prop->GetText();
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+EXP_Value *KX_NetworkReplication::CreateProperty(const PropertyState &state)
+{
+  switch (state.type) {
+    case PROP_INT: {
+      return new EXP_IntValue((cInt)state.number);
+    }
+    case PROP_FLOAT: {
+      return new EXP_FloatValue((float)state.number);
+    }
+    case PROP_BOOL: {
+      return new EXP_BoolValue(state.number != 0.0);
+    }
+    case PROP_STRING: {
+      return new EXP_StringValue(state.text, state.name);
+    }
+  }
+
+  return nullptr;
+}
+
+const KX_NetworkReplication::Snapshot *KX_NetworkReplication::FindSnapshot(
+    const std::deque<Snapshot> &snapshots, unsigned int tick) const
+{
+  for (const Snapshot &snapshot : snapshots) {
+    if (snapshot.tick == tick) {
+      return &snapshot;
+    }
+  }
+  return nullptr;
+}
+
+void KX_NetworkReplication::CaptureSnapshot(double time)
+{
+  Snapshot snapshot;
+  snapshot.tick = m_nextTick++;
+  snapshot.time = time;
+  snapshot.objects.reserve(m_objects.size());
+
+  // The objects map is sorted by identifier.
+  for (const auto &pair : m_objects) {
+    KX_GameObject *gameobj = pair.second;
+
+    ObjectState state;
+    state.id = pair.first;
+    gameobj->NodeGetWorldPosition().getValue(state.position);
+    gameobj->NodeGetWorldOrientation().getRotation().getValue(state.rotation);
+    gameobj->NodeGetWorldScaling().getValue(state.scale);
+
+    // The names are sorted alphabetically to be in the same order on all the engines.
+    for (const std::string &name : gameobj->GetPropertyNames()) {
+      PropertyState prop = {name, PROP_REMOVED, 0.0, std::string()};
+      if (ReadProperty(gameobj->GetProperty(name), prop)) {
+        state.properties.push_back(std::move(prop));
+      }
+    }
+
+    snapshot.objects.push_back(std::move(state));
+  }
+
+  m_history.push_back(std::move(snapshot));
+  if (m_history.size() > HISTORY_SIZE) {
+    m_history.pop_front();
+  }
+}
+
+/** Write the oldest messages fitting in MESSAGES_MAX_SIZE, the others are sent once the
+ * written ones are acknowledged. */
+template<class MessageQueue>
+static void write_messages(std::vector<unsigned char> &data,
+                           PacketWriter &writer,
+                           const MessageQueue &messages)
+{
+  const unsigned int countOffset = data.size();
+  writer.WriteU32(0);
+  unsigned int count = 0;
+  unsigned int size = 0;
+  for (const auto &message : messages) {
+    size += message_size(message);
+    if (size > MESSAGES_MAX_SIZE) {
+      break;
+    }
+    writer.WriteU32(message.sequence);
+    writer.WriteString(message.to);
+    writer.WriteString(message.subject);
+    writer.WriteString(message.body);
+    ++count;
+  }
+
+  for (unsigned short i = 0; i < 4; ++i) {
+    data[countOffset + i] = (count >> (i * 8)) & 0xFF;
+  }
+}
+
+template<class Property> static void write_property(PacketWriter &writer, const Property &prop)
+{
+  writer.WriteString(prop.name);
+  writer.WriteU8(prop.type);
+  switch (prop.type) {
+    case PROP_INT: {
+      writer.WriteU64((unsigned long long)(long long)prop.number);
+      break;
+    }
+    case PROP_FLOAT: {
+      writer.WriteDouble(prop.number);
+      break;
+    }
+    case PROP_BOOL: {
+      writer.WriteU8(prop.number != 0.0);
+      break;
+    }
+    case PROP_STRING: {
+      writer.WriteString(prop.text);
+      break;
+    }
+  }
+}
+
+template<class Property> static void read_property_value(PacketReader &reader, Property &prop)
+{
+  switch (prop.type) {
+    case PROP_INT: {
+      prop.number = (double)(long long)reader.ReadU64();
+      break;
+    }
+    case PROP_FLOAT: {
+      prop.number = reader.ReadDouble();
+      break;
+    }
+    case PROP_BOOL: {
+      prop.number = (reader.ReadU8() != 0) ? 1.0 : 0.0;
+      break;
+    }
+    case PROP_STRING: {
+      prop.text = reader.ReadString();
+      break;
+    }
+    case PROP_REMOVED: {
+      break;
+    }
+    default: {
+      // Unknown type from a corrupted or hostile packet.
+      reader.Invalidate();
+      break;
+    }
+  }
+}
+
+void KX_NetworkReplication::SendSnapshots()
+{
+  const Snapshot &current = m_history.back();
+
+  for (auto &pair : m_clients) {
+    Client &client = pair.second;
+    // Without the baseline acknowledged by the client all the snapshot is sent.
+    const Snapshot *base = (client.ackedTick != 0) ? FindSnapshot(m_history, client.ackedTick) :
+                                                     nullptr;
+
+    std::vector<unsigned char> data;
+    PacketWriter writer(data);
+    writer.WriteU32(PACKET_MAGIC);
+    writer.WriteU8(PACKET_SNAPSHOT);
+    writer.WriteU32(current.tick);
+    writer.WriteU32(base ? base->tick : 0);
+    writer.WriteDouble(current.time);
+    writer.WriteU32(client.receivedSequence);
+    write_messages(data, writer, client.messages);
+
+    // The number of objects is known after the comparison with the baseline.
+    const unsigned int countOffset = data.size();
+    writer.WriteU32(0);
+    unsigned int count = 0;
+
+    static const std::vector<ObjectState> emptyObjects;
+    const std::vector<ObjectState> &baseObjects = base ? base->objects : emptyObjects;
+    std::vector<ObjectState>::const_iterator baseIt = baseObjects.begin();
+
+    for (const ObjectState &state : current.objects) {
+      // Objects of the baseline removed since.
+      for (; baseIt != baseObjects.end() && baseIt->id < state.id; ++baseIt) {
+        writer.WriteU32(baseIt->id);
+        writer.WriteU8(FIELD_REMOVED);
+        ++count;
+      }
+
+      const ObjectState *baseState = nullptr;
+      if (baseIt != baseObjects.end() && baseIt->id == state.id) {
+        baseState = &*(baseIt++);
+      }
+
+      unsigned char mask = 0;
+      if (!baseState || !floats_equal(state.position, baseState->position, 3)) {
+        mask |= FIELD_POSITION;
+      }
+      if (!baseState || !floats_equal(state.rotation, baseState->rotation, 4)) {
+        mask |= FIELD_ROTATION;
+      }
+      if (!baseState || !floats_equal(state.scale, baseState->scale, 3)) {
+        mask |= FIELD_SCALE;
+      }
+
+      // Properties added or changed and properties removed, both lists sorted by name.
+      std::vector<PropertyState> changedProps;
+      if (baseState) {
+        std::vector<PropertyState>::const_iterator basePropIt = baseState->properties.begin();
+        const std::vector<PropertyState>::const_iterator basePropEnd =
+            baseState->properties.end();
+        for (const PropertyState &prop : state.properties) {
+          for (; basePropIt != basePropEnd && basePropIt->name < prop.name; ++basePropIt) {
+            changedProps.push_back({basePropIt->name, PROP_REMOVED, 0.0, std::string()});
+          }
+          if (basePropIt != basePropEnd && basePropIt->name == prop.name) {
+            if (!(*basePropIt == prop)) {
+              changedProps.push_back(prop);
+            }
+            ++basePropIt;
+          }
+          else {
+            changedProps.push_back(prop);
+          }
+        }
+        for (; basePropIt != basePropEnd; ++basePropIt) {
+          changedProps.push_back({basePropIt->name, PROP_REMOVED, 0.0, std::string()});
+        }
+      }
+      else {
+        changedProps = state.properties;
+      }
+
+      if (!changedProps.empty()) {
+        mask |= FIELD_PROPERTIES;
+      }
+
+      if (mask == 0) {
+        continue;
+      }
+
+      writer.WriteU32(state.id);
+      writer.WriteU8(mask);
+      if (mask & FIELD_POSITION) {
+        for (unsigned short i = 0; i < 3; ++i) {
+          writer.WriteFloat(state.position[i]);
+        }
+      }
+      if (mask & FIELD_ROTATION) {
+        for (unsigned short i = 0; i < 4; ++i) {
+          writer.WriteFloat(state.rotation[i]);
+        }
+      }
+      if (mask & FIELD_SCALE) {
+        for (unsigned short i = 0; i < 3; ++i) {
+          writer.WriteFloat(state.scale[i]);
+        }
+      }
+      if (mask & FIELD_PROPERTIES) {
+        writer.WriteU32(changedProps.size());
+        for (const PropertyState &prop : changedProps) {
+          write_property(writer, prop);
+        }
+      }
+      ++count;
+    }
+
+    for (; baseIt != baseObjects.end(); ++baseIt) {
+      writer.WriteU32(baseIt->id);
+      writer.WriteU8(FIELD_REMOVED);
+      ++count;
+    }
+
+    for (unsigned short i = 0; i < 4; ++i) {
+      data[countOffset + i] = (count >> (i * 8)) & 0xFF;
+    }
+
+    SendPacket(data, pair.first);
+  }
+}
+
+unsigned long long KX_NetworkReplication::ChallengeToken(const Endpoint &endpoint) const
+{
+  unsigned char buffer[sizeof(m_secret) + sizeof(endpoint.address) + sizeof(endpoint.port)];
+  memcpy(buffer, m_secret, sizeof(m_secret));
+  memcpy(buffer + sizeof(m_secret), &endpoint.address, sizeof(endpoint.address));
+  memcpy(buffer + sizeof(m_secret) + sizeof(endpoint.address),
+         &endpoint.port,
+         sizeof(endpoint.port));
+
+  unsigned char digest[16];
+  BLI_hash_md5_buffer((const char *)buffer, sizeof(buffer), digest);
+
+  unsigned long long token;
+  memcpy(&token, digest, sizeof(token));
+  return token;
+}
+
+void KX_NetworkReplication::SendConnectRequest()
+{
+  std::vector<unsigned char> data;
+  PacketWriter writer(data);
+  writer.WriteU32(PACKET_MAGIC);
+  writer.WriteU8(PACKET_CONNECT);
+  // The padding makes the request bigger than the answer of the server.
+  data.resize(CONNECT_PACKET_SIZE, 0);
+
+  SendPacket(data, m_serverEndpoint);
+}
+
+void KX_NetworkReplication::SendChallenge(const Endpoint &to)
+{
+  std::vector<unsigned char> data;
+  PacketWriter writer(data);
+  writer.WriteU32(PACKET_MAGIC);
+  writer.WriteU8(PACKET_CHALLENGE);
+  writer.WriteU64(ChallengeToken(to));
+
+  SendPacket(data, to);
+}
+
+void KX_NetworkReplication::SendAcknowledgement()
+{
+  std::vector<unsigned char> data;
+  PacketWriter writer(data);
+  writer.WriteU32(PACKET_MAGIC);
+  writer.WriteU8(PACKET_ACKNOWLEDGEMENT);
+  // The token registers the client on the server.
+  writer.WriteU64(m_token);
+  writer.WriteU32(m_received.empty() ? 0 : m_received.back().tick);
+  writer.WriteU32(m_receivedSequence);
+  write_messages(data, writer, m_pendingMessages);
+
+  SendPacket(data, m_serverEndpoint);
+}
+
+void KX_NetworkReplication::ReceivePackets(double time, KX_NetworkMessageManager *manager)
+{
+  std::vector<unsigned char> buffer(65536);
+  std::vector<unsigned char> data;
+
+  while (true) {
+    sockaddr_in address = {};
+#ifdef WIN32
+    int addressSize = sizeof(address);
+    const int size = recvfrom((SOCKET)m_socket,
+                              (char *)buffer.data(),
+                              buffer.size(),
+                              0,
+                              (sockaddr *)&address,
+                              &addressSize);
+#else
+    socklen_t addressSize = sizeof(address);
+    const int size = recvfrom(
+        (int)m_socket, buffer.data(), buffer.size(), 0, (sockaddr *)&address, &addressSize);
+#endif
+
+    // No more packets, or an error reported by a previous send.
+    if (size < 0) {
+      break;
+    }
+
+    data.assign(buffer.begin(), buffer.begin() + size);
+    const Endpoint from = {(unsigned int)address.sin_addr.s_addr, address.sin_port};
+
+    if (m_settings.mode == MODE_SERVER) {
+      ReadClientPacket(data, from, time, manager);
+    }
+    // Ignore the packets not coming from the server.
+    else if (from.address == m_serverEndpoint.address && from.port == m_serverEndpoint.port) {
+      ReadServerPacket(data, time, manager);
+    }
+  }
+}
+
+void KX_NetworkReplication::ReadClientPacket(const std::vector<unsigned char> &data,
+                                             const Endpoint &from,
+                                             double time,
+                                             KX_NetworkMessageManager *manager)
+{
+  PacketReader reader(data);
+  if (reader.ReadU32() != PACKET_MAGIC) {
+    return;
+  }
+
+  const unsigned char type = reader.ReadU8();
+  // The challenge is answered without registering the sender, its address may be spoofed.
+  if (type == PACKET_CONNECT) {
+    if (data.size() >= CONNECT_PACKET_SIZE) {
+      SendChallenge(from);
+    }
+    return;
+  }
+  if (type != PACKET_ACKNOWLEDGEMENT) {
+    return;
+  }
+
+  const unsigned long long token = reader.ReadU64();
+  const unsigned int ackedTick = reader.ReadU32();
+  const unsigned int ackedSequence = reader.ReadU32();
+  if (!reader.IsValid()) {
+    return;
+  }
+
+  auto it = m_clients.find(from);
+  if (it == m_clients.end()) {
+    // Only the senders which received the challenge of their address are registered.
+    const unsigned long long expectedToken = ChallengeToken(from);
+    if (token != expectedToken) {
+      return;
+    }
+
+    char address[INET_ADDRSTRLEN];
+    in_addr inAddress;
+    inAddress.s_addr = from.address;
+    inet_ntop(AF_INET, &inAddress, address, sizeof(address));
+    CM_Message("replication: client " << address << ":" << ntohs(from.port) << " connected");
+
+    it = m_clients.emplace(from, Client{0, std::deque<Message>(), 0, time, expectedToken}).first;
+  }
+  else if (token != it->second.token) {
+    return;
+  }
+
+  Client &client = it->second;
+  client.lastReceiveTime = time;
+  // The packets can arrive in any order.
+  client.ackedTick = std::max(client.ackedTick, ackedTick);
+  while (!client.messages.empty() && client.messages.front().sequence <= ackedSequence) {
+    client.messages.pop_front();
+  }
+
+  const unsigned int messageCount = reader.ReadU32();
+  for (unsigned int i = 0; i < messageCount && reader.IsValid(); ++i) {
+    const unsigned int sequence = reader.ReadU32();
+    const std::string to = reader.ReadString();
+    const std::string subject = reader.ReadString();
+    const std::string body = reader.ReadString();
+    // The messages are resent until acknowledged, only the new ones are used.
+    if (reader.IsValid() && sequence > client.receivedSequence) {
+      manager->AddRemoteMessage(to, nullptr, subject, body);
+      client.receivedSequence = sequence;
+    }
+  }
+}
+
+void KX_NetworkReplication::ReadServerPacket(const std::vector<unsigned char> &data,
+                                             double time,
+                                             KX_NetworkMessageManager *manager)
+{
+  PacketReader reader(data);
+  if (reader.ReadU32() != PACKET_MAGIC) {
+    return;
+  }
+
+  const unsigned char type = reader.ReadU8();
+  if (type == PACKET_CHALLENGE) {
+    const unsigned long long token = reader.ReadU64();
+    if (reader.IsValid() && !m_connected) {
+      CM_Message("replication: connected to the server");
+      m_token = token;
+      m_connected = true;
+      m_lastReceiveTime = time;
+    }
+    return;
+  }
+  if (type != PACKET_SNAPSHOT || !m_connected) {
+    return;
+  }
+
+  m_lastReceiveTime = time;
+
+  Snapshot snapshot;
+  snapshot.tick = reader.ReadU32();
+  const unsigned int baseTick = reader.ReadU32();
+  snapshot.time = reader.ReadDouble();
+  const unsigned int ackedSequence = reader.ReadU32();
+  if (!reader.IsValid()) {
+    return;
+  }
+
+  while (!m_pendingMessages.empty() && m_pendingMessages.front().sequence <= ackedSequence) {
+    m_pendingMessages.pop_front();
+  }
+
+  const unsigned int messageCount = reader.ReadU32();
+  for (unsigned int i = 0; i < messageCount && reader.IsValid(); ++i) {
+    const unsigned int sequence = reader.ReadU32();
+    const std::string to = reader.ReadString();
+    const std::string subject = reader.ReadString();
+    const std::string body = reader.ReadString();
+    if (reader.IsValid() && sequence > m_receivedSequence) {
+      manager->AddRemoteMessage(to, nullptr, subject, body);
+      m_receivedSequence = sequence;
+    }
+  }
+
+  // Ignore the snapshots older than the last one, and the ones with a lost baseline.
+  if (!m_received.empty() && snapshot.tick <= m_received.back().tick) {
+    return;
+  }
+
+  if (baseTick != 0) {
+    const Snapshot *base = FindSnapshot(m_received, baseTick);
+    if (!base) {
+      return;
+    }
+    snapshot.objects = base->objects;
+  }
+
+  const unsigned int objectCount = reader.ReadU32();
+  for (unsigned int i = 0; i < objectCount && reader.IsValid(); ++i) {
+    const unsigned int id = reader.ReadU32();
+    const unsigned char mask = reader.ReadU8();
+
+    std::vector<ObjectState>::iterator it = std::lower_bound(
+        snapshot.objects.begin(),
+        snapshot.objects.end(),
+        id,
+        [](const ObjectState &state, unsigned int id) { return state.id < id; });
+
+    if (mask & FIELD_REMOVED) {
+      if (it != snapshot.objects.end() && it->id == id) {
+        snapshot.objects.erase(it);
+      }
+      continue;
+    }
+
+    if (it == snapshot.objects.end() || it->id != id) {
+      ObjectState state = {id, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+      it = snapshot.objects.insert(it, state);
+    }
+
+    ObjectState &state = *it;
+    if (mask & FIELD_POSITION) {
+      for (unsigned short j = 0; j < 3; ++j) {
+        state.position[j] = reader.ReadFloat();
+      }
+    }
+    if (mask & FIELD_ROTATION) {
+      for (unsigned short j = 0; j < 4; ++j) {
+        state.rotation[j] = reader.ReadFloat();
+      }
+    }
+    if (mask & FIELD_SCALE) {
+      for (unsigned short j = 0; j < 3; ++j) {
+        state.scale[j] = reader.ReadFloat();
+      }
+    }
+    if (mask & FIELD_PROPERTIES) {
+      const unsigned int propCount = reader.ReadU32();
+      for (unsigned int j = 0; j < propCount && reader.IsValid(); ++j) {
+        PropertyState prop = {reader.ReadString(), reader.ReadU8(), 0.0, std::string()};
+        read_property_value(reader, prop);
+
+        std::vector<PropertyState>::iterator propIt = std::lower_bound(
+            state.properties.begin(),
+            state.properties.end(),
+            prop.name,
+            [](const PropertyState &prop, const std::string &name) { return prop.name < name; });
+        const bool found = (propIt != state.properties.end() && propIt->name == prop.name);
+
+        if (prop.type == PROP_REMOVED) {
+          if (found) {
+            state.properties.erase(propIt);
+          }
+        }
+        else if (found) {
+          *propIt = std::move(prop);
+        }
+        else {
+          state.properties.insert(propIt, std::move(prop));
+        }
+      }
+    }
+  }
+
+  if (!reader.IsValid()) {
+    return;
+  }
+
+  // Smooth the estimation of the server clock, resynchronize after a big change.
+  const double offset = snapshot.time - time;
+  if (!m_clockInitialized || std::fabs(offset - m_clockOffset) > 1.0) {
+    m_clockOffset = offset;
+    m_clockInitialized = true;
+  }
+  else {
+    m_clockOffset += (offset - m_clockOffset) * 0.1;
+  }
+
+  m_received.push_back(std::move(snapshot));
+  if (m_received.size() > HISTORY_SIZE) {
+    m_received.pop_front();
+  }
+}
+
+void KX_NetworkReplication::ApplySnapshots(double time)
+{
+  if (m_received.empty()) {
+    return;
+  }
+
+  // Find the snapshots around the rendered time, without extrapolation.
+  const double renderTime = time + m_clockOffset - m_settings.interpolationDelay;
+  const Snapshot *from = &m_received.back();
+  const Snapshot *to = from;
+  for (unsigned int i = 0, size = m_received.size(); i < size; ++i) {
+    if (m_received[i].time > renderTime) {
+      to = &m_received[i];
+      from = (i > 0) ? &m_received[i - 1] : to;
+      break;
+    }
+  }
+
+  const float factor = (from != to) ? (renderTime - from->time) / (to->time - from->time) : 0.0f;
+
+  for (const ObjectState &state : to->objects) {
+    const auto objectIt = m_objects.find(state.id);
+    if (objectIt == m_objects.end()) {
+      continue;
+    }
+    KX_GameObject *gameobj = objectIt->second;
+
+    std::vector<ObjectState>::const_iterator fromIt = std::lower_bound(
+        from->objects.begin(),
+        from->objects.end(),
+        state.id,
+        [](const ObjectState &state, unsigned int id) { return state.id < id; });
+    const ObjectState &fromState = (fromIt != from->objects.end() && fromIt->id == state.id) ?
+                                       *fromIt :
+                                       state;
+
+    MT_Vector3 position;
+    MT_Vector3 scale;
+    for (unsigned short i = 0; i < 3; ++i) {
+      position[i] = fromState.position[i] + (state.position[i] - fromState.position[i]) * factor;
+      scale[i] = fromState.scale[i] + (state.scale[i] - fromState.scale[i]) * factor;
+    }
+
+    // Normalized linear interpolation on the shortest path.
+    float dot = 0.0f;
+    for (unsigned short i = 0; i < 4; ++i) {
+      dot += fromState.rotation[i] * state.rotation[i];
+    }
+    const float sign = (dot < 0.0f) ? -1.0f : 1.0f;
+    MT_Quaternion rotation;
+    for (unsigned short i = 0; i < 4; ++i) {
+      rotation[i] = fromState.rotation[i] +
+                    (state.rotation[i] * sign - fromState.rotation[i]) * factor;
+    }
+    rotation.normalize();
+
+    // The transform is driven by the server.
+    PHY_IPhysicsController *controller = gameobj->GetPhysicsController();
+    if (controller && !controller->IsDynamicsSuspended()) {
+      controller->SuspendDynamics();
+    }
+
+    gameobj->NodeSetWorldPosition(position);
+    gameobj->NodeSetGlobalOrientation(MT_Matrix3x3(rotation));
+    gameobj->NodeSetWorldScale(scale);
+    gameobj->NodeUpdateGS(0.0f);
+  }
+
+  // The properties are not interpolated, the ones of the last snapshot are used.
+  const Snapshot &last = m_received.back();
+  if (last.tick == m_appliedTick) {
+    return;
+  }
+  m_appliedTick = last.tick;
+
+  for (const ObjectState &state : last.objects) {
+    const auto objectIt = m_objects.find(state.id);
+    if (objectIt == m_objects.end()) {
+      continue;
+    }
+    KX_GameObject *gameobj = objectIt->second;
+
+    // Remove the replicable properties missing from the snapshot, the others are local.
+    for (const std::string &name : gameobj->GetPropertyNames()) {
+      PropertyState currentProp = {name, PROP_REMOVED, 0.0, std::string()};
+      if (!ReadProperty(gameobj->GetProperty(name), currentProp)) {
+        continue;
+      }
+
+      std::vector<PropertyState>::const_iterator propIt = std::lower_bound(
+          state.properties.begin(),
+          state.properties.end(),
+          name,
+          [](const PropertyState &prop, const std::string &name) { return prop.name < name; });
+      if (propIt == state.properties.end() || propIt->name != name) {
+        gameobj->RemoveProperty(name);
+      }
+    }
+
+    for (const PropertyState &prop : state.properties) {
+      EXP_Value *current = gameobj->GetProperty(prop.name);
+      PropertyState currentProp = {prop.name, PROP_REMOVED, 0.0, std::string()};
+      if (current && ReadProperty(current, currentProp) && currentProp == prop) {
+        continue;
+      }
+
+      EXP_Value *value = CreateProperty(prop);
+      if (!value) {
+        continue;
+      }
+      gameobj->SetProperty(prop.name, value);
+      value->Release();
+    }
+  }
+}
+
+void KX_NetworkReplication::Update(EXP_ListValue<KX_Scene> *scenes,
+                                   double time,
+                                   KX_NetworkMessageManager *manager)
+{
+  ReceivePackets(time, manager);
+  CollectObjects(scenes);
+
+  if (m_settings.mode == MODE_SERVER) {
+    for (auto it = m_clients.begin(); it != m_clients.end();) {
+      if ((time - it->second.lastReceiveTime) > CLIENT_TIMEOUT) {
+        CM_Warning("replication: client timed out");
+        it = m_clients.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+
+    if (m_history.empty() || (time - m_lastTickTime) >= (1.0 / m_settings.tickRate)) {
+      CaptureSnapshot(time);
+      m_lastTickTime = time;
+    }
+
+    if ((time - m_lastSendTime) >= (1.0 / m_settings.sendRate)) {
+      SendSnapshots();
+      m_lastSendTime = time;
+    }
+  }
+  else {
+    // Without packet from the server (e.g. restarted with a new key) the client reconnects.
+    if (m_connected && (time - m_lastReceiveTime) > CLIENT_TIMEOUT) {
+      CM_Warning("replication: server timed out, reconnecting");
+      m_connected = false;
+      // A restarted server counts its ticks and messages from the start.
+      m_received.clear();
+      m_appliedTick = 0;
+      m_receivedSequence = 0;
+      m_clockInitialized = false;
+    }
+
+    ApplySnapshots(time);
+
+    if ((time - m_lastSendTime) >= (1.0 / m_settings.sendRate)) {
+      if (m_connected) {
+        SendAcknowledgement();
+      }
+      else {
+        SendConnectRequest();
+      }
+      m_lastSendTime = time;
+    }
+  }
+}
@@ -0,0 +1,189 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file KX_NetworkReplication.h
+ *  \ingroup ketsji
+ *  \brief Ketsji Logic Extension: replication of objects and messages between engines over UDP.
+ */
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "KX_NetworkMessageManager.h"
+
+class EXP_Value;
+class KX_GameObject;
+class KX_Scene;
+template<class ItemType> class EXP_ListValue;
+
+/**
+ * Snapshot replication between a server engine and client engines.
+ *
+ * The server captures the transform and the properties of the objects having a true
+ * "replicate" property at the tick rate and sends them to the clients at the send rate.
+ * Each snapshot only contains the objects and properties changed since the last snapshot
+ * acknowledged by the client. The clients interpolate the transforms of the received
+ * snapshots with a delay to hide the jitter and the losses.
+ * The messages sent by the logic are sent reliably in both directions, the oldest ones first
+ * within a size budget per packet.
+ * The objects are identified by a hash of their scene and object names, only the first
+ * object with a given name is replicated.
+ *
+ * A client connects with a padded request, the server answers with a smaller challenge token
+ * derived from the client address and only registers the clients acknowledging with this token.
+ * A spoofed address never receives more than the size of its requests.
+ */
+class KX_NetworkReplication : public KX_NetworkMessageListener {
+ public:
+  enum Mode { MODE_SERVER = 0, MODE_CLIENT };
+
+  struct Settings {
+    Mode mode;
+    /// Server address, the address the server listens on or the client sends to.
+    std::string address;
+    unsigned short port;
+    /// Number of snapshots captured per second by the server.
+    float tickRate;
+    /// Number of packets sent per second.
+    float sendRate;
+    /// Delay of the interpolated transforms on the clients in seconds.
+    float interpolationDelay;
+  };
+
+ private:
+  struct PropertyState {
+    std::string name;
+    /// Type of the value, see PropertyType in the source file.
+    unsigned char type;
+    double number;
+    std::string text;
+
+    bool operator==(const PropertyState &other) const;
+  };
+
+  struct ObjectState {
+    unsigned int id;
+    float position[3];
+    float rotation[4];
+    float scale[3];
+    /// Properties sorted by name.
+    std::vector<PropertyState> properties;
+  };
+
+  struct Snapshot {
+    unsigned int tick;
+    /// Time of the server when captured.
+    double time;
+    /// Objects sorted by identifier.
+    std::vector<ObjectState> objects;
+  };
+
+  struct Message {
+    unsigned int sequence;
+    std::string to;
+    std::string subject;
+    std::string body;
+  };
+
+  /// Address of a peer, IPv4 address and port in network order.
+  struct Endpoint {
+    unsigned int address;
+    unsigned short port;
+
+    bool operator<(const Endpoint &other) const;
+  };
+
+  /// A client seen by the server.
+  struct Client {
+    /// Last snapshot tick reconstructed by the client, 0 if none.
+    unsigned int ackedTick;
+    /// Messages not yet acknowledged by the client.
+    std::deque<Message> messages;
+    /// Sequence of the last message received from the client.
+    unsigned int receivedSequence;
+    double lastReceiveTime;
+    /// Challenge token of the client address.
+    unsigned long long token;
+  };
+
+  Settings m_settings;
+  /// Socket handle, -1 when invalid.
+  long long m_socket;
+  Endpoint m_serverEndpoint;
+
+  double m_lastTickTime;
+  double m_lastSendTime;
+
+  /// Server: random key of the challenge tokens.
+  unsigned char m_secret[16];
+  /// Server: captured snapshots, the oldest first.
+  std::deque<Snapshot> m_history;
+  unsigned int m_nextTick;
+  std::map<Endpoint, Client> m_clients;
+  unsigned int m_nextSequence;
+
+  /// Client: challenge token received from the server, valid when connected.
+  unsigned long long m_token;
+  bool m_connected;
+  /// Client: time of the last packet received from the server.
+  double m_lastReceiveTime;
+  /// Client: reconstructed snapshots usable as baseline and for interpolation, oldest first.
+  std::deque<Snapshot> m_received;
+  /// Client: messages not yet acknowledged by the server.
+  std::deque<Message> m_pendingMessages;
+  /// Client: sequence of the last message received from the server.
+  unsigned int m_receivedSequence;
+  /// Client: estimated server time minus local time.
+  double m_clockOffset;
+  bool m_clockInitialized;
+  /// Client: tick of the snapshot whose properties were applied.
+  unsigned int m_appliedTick;
+
+  /// Objects of the scenes to replicate by identifier, rebuilt at each update.
+  std::map<unsigned int, KX_GameObject *> m_objects;
+
+  void CollectObjects(EXP_ListValue<KX_Scene> *scenes);
+  void CaptureSnapshot(double time);
+  void SendSnapshots();
+  void SendConnectRequest();
+  void SendChallenge(const Endpoint &to);
+  void SendAcknowledgement();
+  void ReceivePackets(double time, KX_NetworkMessageManager *manager);
+  void ReadServerPacket(const std::vector<unsigned char> &data,
+                        double time,
+                        KX_NetworkMessageManager *manager);
+  void ReadClientPacket(const std::vector<unsigned char> &data,
+                        const Endpoint &from,
+                        double time,
+                        KX_NetworkMessageManager *manager);
+  void ApplySnapshots(double time);
+
+  /// Read a game property, return false if the property type can't be replicated.
+  static bool ReadProperty(EXP_Value *prop, PropertyState &state);
+  static EXP_Value *CreateProperty(const PropertyState &state);
+
+  /// Return the challenge token of a client address, only known by the server and the client.
+  unsigned long long ChallengeToken(const Endpoint &endpoint) const;
+  const Snapshot *FindSnapshot(const std::deque<Snapshot> &snapshots, unsigned int tick) const;
+  bool SendPacket(const std::vector<unsigned char> &data, const Endpoint &to);
+
+ public:
+  KX_NetworkReplication(const Settings &settings);
+  ~KX_NetworkReplication();
+
+  /// Open the socket, return false and print an error if the socket can't be used.
+  bool Start();
+
+  /// Queue a message sent by the logic to send it to the other engines.
+  virtual void MessageAdded(const std::string &to,
+                            const std::string &subject,
+                            const std::string &body);
+
+  /** Receive the packets, capture or apply the snapshots and send the packets.
+   * The received messages are added to the manager.
+   */
+  void Update(EXP_ListValue<KX_Scene> *scenes, double time, KX_NetworkMessageManager *manager);
+};
@@ -0,0 +1,209 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Ketsji/KX_ObjectPool.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ObjectPool.h"
+
+#include "BKE_collection.hh"
+#include "BKE_context.hh"
+#include "BKE_layer.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_modifier.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_Scene.h"
+
+KX_ObjectPool::KX_ObjectPool(KX_Scene *scene) : m_scene(scene), m_stats({0, 0, 0, 0})
+{
+}
+
+KX_ObjectPool::~KX_ObjectPool()
+{
+  Clear();
+}
+
+bool KX_ObjectPool::IsPoolable(Object *templateob)
+{
+  /* The viewport render mode doesn't use the game render loop which skips the pooled objects. */
+  if (KX_GetActiveEngine()->UseViewportRender()) {
+    return false;
+  }
+
+  /* Instance collections visibility is managed in DupliGroupRecurse, soft bodies add a
+   * modifier to their object and metaballs are evaluated by basis, don't reuse them. */
+  return !templateob->instance_collection && !(templateob->gameflag & OB_SOFT_BODY) &&
+         templateob->type != OB_MBALL;
+}
+
+Object *KX_ObjectPool::NewObject(Main *bmain, Object *templateob)
+{
+  Object *newob;
+  BKE_id_copy_ex(bmain, &templateob->id, (ID **)&newob, 0);
+  id_us_min(&newob->id);
+  Scene *scene = m_scene->GetBlenderScene();
+  ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+  BKE_collection_object_add_from(bmain,
+                                 scene,
+                                 BKE_view_layer_camera_find(scene, view_layer),
+                                 newob);  // add replica where is the active camera
+
+  newob->base_flag |= (BASE_ENABLED_AND_MAYBE_VISIBLE_IN_VIEWPORT |
+                       BASE_ENABLED_AND_VISIBLE_IN_DEFAULT_VIEWPORT);
+  newob->visibility_flag &= ~OB_HIDE_VIEWPORT;
+
+  return newob;
+}
+
+/// Reset the data of a pooled object which could have been modified by its previous replica.
+static void pool_object_reset(Object *ob, Object *templateob)
+{
+  ob->parent = templateob->parent;
+  ob->partype = templateob->partype;
+  copy_m4_m4(ob->parentinv, templateob->parentinv);
+  copy_v4_v4(ob->color, templateob->color);
+
+  /* Armature modifiers were remapped to the parent replica in remap_parents_recursive. */
+  ModifierData *tmd = (ModifierData *)templateob->modifiers.first;
+  for (ModifierData *md = (ModifierData *)ob->modifiers.first; md && tmd;
+       md = md->next, tmd = tmd->next)
+  {
+    if (md->type == eModifierType_Armature && tmd->type == eModifierType_Armature) {
+      ((ArmatureModifierData *)md)->object = ((ArmatureModifierData *)tmd)->object;
+    }
+  }
+}
+
+Object *KX_ObjectPool::Acquire(Object *templateob)
+{
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  Main *bmain = CTX_data_main(C);
+
+  std::vector<Object *> &pool = m_objects[templateob];
+  if (pool.empty()) {
+    ++m_stats.m_misses;
+
+    Object *newob = NewObject(bmain, templateob);
+    /* This will call BKE_main_collection_sync_remap at frame end. */
+    m_scene->TagForCollectionRemap();
+    DEG_relations_tag_update(bmain);
+    return newob;
+  }
+
+  ++m_stats.m_hits;
+  --m_stats.m_available;
+
+  Object *ob = pool.back();
+  pool.pop_back();
+
+  pool_object_reset(ob, templateob);
+  ob->gameflag &= ~OB_POOLED_REPLICA;
+
+  /* The previous replica was made invisible, the base visibility must be synced again. */
+  if (ob->visibility_flag & OB_HIDE_VIEWPORT) {
+    ob->visibility_flag &= ~OB_HIDE_VIEWPORT;
+    m_scene->TagForCollectionRemap();
+    DEG_relations_tag_update(bmain);
+  }
+
+  DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM | ID_RECALC_SHADING);
+
+  return ob;
+}
+
+void KX_ObjectPool::Release(Object *templateob, Object *ob)
+{
+  ob->gameflag |= OB_POOLED_REPLICA;
+  ob->gameflag &= ~OB_OVERLAY_COLLECTION;
+  DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM);
+
+  m_objects[templateob].push_back(ob);
+  ++m_stats.m_released;
+  ++m_stats.m_available;
+}
+
+void KX_ObjectPool::Prewarm(Object *templateob, unsigned int count)
+{
+  if (!IsPoolable(templateob)) {
+    return;
+  }
+
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  Main *bmain = CTX_data_main(C);
+
+  std::vector<Object *> &pool = m_objects[templateob];
+  if (pool.size() >= count) {
+    return;
+  }
+
+  pool.reserve(count);
+  while (pool.size() < count) {
+    Object *ob = NewObject(bmain, templateob);
+    ob->gameflag |= OB_POOLED_REPLICA;
+    pool.push_back(ob);
+    ++m_stats.m_available;
+  }
+
+  /* Only one relations update for all the new objects. */
+  m_scene->TagForCollectionRemap();
+  DEG_relations_tag_update(bmain);
+}
+
+void KX_ObjectPool::Clear()
+{
+  if (m_objects.empty()) {
+    return;
+  }
+
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  Main *bmain = CTX_data_main(C);
+
+  for (const auto &pair : m_objects) {
+    for (Object *ob : pair.second) {
+      BKE_id_delete(bmain, ob);
+    }
+  }
+  m_objects.clear();
+  m_stats.m_available = 0;
+
+  DEG_relations_tag_update(bmain);
+}
+
+void KX_ObjectPool::ClearTagged()
+{
+  bContext *C = KX_GetActiveEngine()->GetContext();
+  Main *bmain = CTX_data_main(C);
+
+  bool removed = false;
+  for (auto it = m_objects.begin(); it != m_objects.end();) {
+    if (!IS_TAGGED(it->first)) {
+      ++it;
+      continue;
+    }
+
+    for (Object *ob : it->second) {
+      BKE_id_delete(bmain, ob);
+    }
+    m_stats.m_available -= it->second.size();
+    it = m_objects.erase(it);
+    removed = true;
+  }
+
+  if (removed) {
+    DEG_relations_tag_update(bmain);
+  }
+}
+
+const KX_ObjectPool::Stats &KX_ObjectPool::GetStats() const
+{
+  return m_stats;
+}
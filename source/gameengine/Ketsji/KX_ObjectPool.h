@@ -0,0 +1,65 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file KX_ObjectPool.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+struct Main;
+struct Object;
+class KX_Scene;
+
+/**
+ * Pool of hidden Blender objects used by replicas (addObject).
+ *
+ * Copying a Blender object for each replica means a BKE_id_copy_ex, a link in a collection,
+ * a collection remap and a depsgraph relations rebuild. The pool keeps the copies of removed
+ * replicas linked in the scene but flagged OB_POOLED_REPLICA (skipped by the game render loop)
+ * so that the next replica of the same template only has to clear this flag.
+ */
+class KX_ObjectPool {
+ public:
+  struct Stats {
+    /// Number of replicas which got their object from the pool.
+    unsigned int m_hits;
+    /// Number of replicas which had to copy their object.
+    unsigned int m_misses;
+    /// Number of objects given back to the pool.
+    unsigned int m_released;
+    /// Number of objects currently waiting in the pool.
+    unsigned int m_available;
+  };
+
+ private:
+  KX_Scene *m_scene;
+  /// Hidden copies per template object.
+  std::map<Object *, std::vector<Object *>> m_objects;
+  Stats m_stats;
+
+  /// Copy a template object and link it in the scene.
+  Object *NewObject(Main *bmain, Object *templateob);
+
+ public:
+  KX_ObjectPool(KX_Scene *scene);
+  ~KX_ObjectPool();
+
+  /// Return true if replicas of this object can use the pool.
+  static bool IsPoolable(Object *templateob);
+
+  /// Return a visible copy of the template object, taken from the pool if possible.
+  Object *Acquire(Object *templateob);
+  /// Hide an object copied from templateob and keep it for the next replica.
+  void Release(Object *templateob, Object *ob);
+  /// Create hidden copies until the pool of templateob contains count objects.
+  void Prewarm(Object *templateob, unsigned int count);
+  /// Delete all pooled objects.
+  void Clear();
+  /// Delete the pooled objects of the templates tagged ID_TAG_DOIT, e.g. of a freed library.
+  void ClearTagged();
+
+  const Stats &GetStats() const;
+};
@@ -28,10 +28,21 @@
 
 #include "KX_ObstacleSimulation.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "BLI_math_geom.h"
+#include "BLI_task.h"
 
+#include "CM_Profiler.h"
 #include "KX_Globals.h"
 #include "KX_NavMeshObject.h"
+#include "SCA_SteeringActuator.h"
+
+/// Maximum number of paths searched per frame, the other requests wait for the next frames.
+static const unsigned int MAX_PATH_REQUESTS = 32;
+/// Maximum number of cells of an obstacle in the grid.
+static const int MAX_OBSTACLE_CELLS = 64;
 
 namespace {
 inline float perp(const MT_Vector2 &a, const MT_Vector2 &b)
@@ -56,6 +67,10 @@ inline void vset(float v[2], float x, float y)
   v[0] = x;
   v[1] = y;
 }
+inline uint64_t gridCell(int x, int y)
+{
+  return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
 }  // namespace
 
 static int sweepCircleCircle(const MT_Vector2 &pos0,
@@ -189,7 +204,7 @@ static float interpolateToi(float a, const float *dir, const float *toi, const i
 }
 
 KX_ObstacleSimulation::KX_ObstacleSimulation(MT_Scalar levelHeight, bool enableVisualization)
-    : m_levelHeight(levelHeight), m_enableVisualization(enableVisualization)
+    : m_levelHeight(levelHeight), m_enableVisualization(enableVisualization), m_gridCellSize(1.0f)
 {
 }
 
@@ -229,31 +244,33 @@ void KX_ObstacleSimulation::AddObstacleForObj(KX_GameObject *gameobj)
 
 void KX_ObstacleSimulation::AddObstaclesForNavMesh(KX_NavMeshObject *navmeshobj)
 {
-  dtStatNavMesh *navmesh = navmeshobj->GetNavMesh();
-  if (navmesh) {
-    int npoly = navmesh->getPolyCount();
-    for (int pi = 0; pi < npoly; pi++) {
-      const dtStatPoly *poly = navmesh->getPoly(pi);
-
-      for (int i = 0, j = (int)poly->nv - 1; i < (int)poly->nv; j = i++) {
-        if (poly->n[j])
-          continue;
-        const float *vj = navmesh->getVertex(poly->v[j]);
-        const float *vi = navmesh->getVertex(poly->v[i]);
-
-        KX_Obstacle *obstacle = CreateObstacle(navmeshobj);
-        obstacle->m_type = KX_OBSTACLE_NAV_MESH;
-        obstacle->m_shape = KX_OBSTACLE_SEGMENT;
-        obstacle->m_pos = MT_Vector3(vj[0], vj[2], vj[1]);
-        obstacle->m_pos2 = MT_Vector3(vi[0], vi[2], vi[1]);
-        obstacle->m_rad = 0;
-      }
-    }
+  std::vector<MT_Vector3> walls;
+  navmeshobj->GetWalls(walls);
+  for (unsigned int i = 0, size = walls.size(); i < size; i += 2) {
+    KX_Obstacle *obstacle = CreateObstacle(navmeshobj);
+    obstacle->m_type = KX_OBSTACLE_NAV_MESH;
+    obstacle->m_shape = KX_OBSTACLE_SEGMENT;
+    obstacle->m_localPos = walls[i];
+    obstacle->m_localPos2 = walls[i + 1];
+    obstacle->m_pos = navmeshobj->TransformToWorldCoords(walls[i]);
+    obstacle->m_pos2 = navmeshobj->TransformToWorldCoords(walls[i + 1]);
+    obstacle->m_rad = 0;
   }
 }
 
 void KX_ObstacleSimulation::DestroyObstacleForObj(KX_GameObject *gameobj)
 {
+  const auto isDestroyed = [gameobj](KX_Obstacle *obstacle) {
+    return obstacle->m_gameObj == gameobj;
+  };
+  m_agents.erase(std::remove_if(m_agents.begin(), m_agents.end(), isDestroyed), m_agents.end());
+  // The actuators of the object are destructed with it.
+  const auto isOwned = [gameobj](SCA_SteeringActuator *steering) {
+    return steering->GetParent() == gameobj;
+  };
+  m_pathQueue.erase(std::remove_if(m_pathQueue.begin(), m_pathQueue.end(), isOwned),
+                    m_pathQueue.end());
+
   for (size_t i = 0; i < m_obstacles.size();) {
     if (m_obstacles[i]->m_gameObj == gameobj) {
       KX_Obstacle *obstacle = m_obstacles[i];
@@ -268,12 +285,26 @@ void KX_ObstacleSimulation::DestroyObstacleForObj(KX_GameObject *gameobj)
 
 void KX_ObstacleSimulation::UpdateObstacles()
 {
+  KX_NavMeshObject *navmeshobj = nullptr;
+  MT_Transform worldtr;
   for (size_t i = 0; i < m_obstacles.size(); i++) {
-    if (m_obstacles[i]->m_type == KX_OBSTACLE_NAV_MESH ||
-        m_obstacles[i]->m_shape == KX_OBSTACLE_SEGMENT)
+    KX_Obstacle *obs = m_obstacles[i];
+    if (obs->m_type == KX_OBSTACLE_NAV_MESH) {
+      // The segments of a nav mesh follow each other, compute its transform once.
+      if (obs->m_gameObj != navmeshobj) {
+        navmeshobj = static_cast<KX_NavMeshObject *>(obs->m_gameObj);
+        MT_Matrix3x3 orientation = navmeshobj->NodeGetWorldOrientation();
+        const MT_Vector3 &scaling = navmeshobj->NodeGetWorldScaling();
+        orientation.scale(scaling[0], scaling[1], scaling[2]);
+        worldtr = MT_Transform(navmeshobj->NodeGetWorldPosition(), orientation);
+      }
+      obs->m_pos = worldtr(obs->m_localPos);
+      obs->m_pos2 = worldtr(obs->m_localPos2);
+      continue;
+    }
+    if (obs->m_shape == KX_OBSTACLE_SEGMENT)
       continue;
 
-    KX_Obstacle *obs = m_obstacles[i];
     obs->m_pos = obs->m_gameObj->NodeGetWorldPosition();
     obs->vel[0] = obs->m_gameObj->GetLinearVelocity().x();
     obs->vel[1] = obs->m_gameObj->GetLinearVelocity().y();
@@ -298,12 +329,194 @@ KX_Obstacle *KX_ObstacleSimulation::GetObstacle(KX_GameObject *gameobj)
   return nullptr;
 }
 
-void KX_ObstacleSimulation::AdjustObstacleVelocity(KX_Obstacle *activeObst,
-                                                   KX_NavMeshObject *activeNavMeshObj,
-                                                   MT_Vector3 &velocity,
-                                                   MT_Scalar maxDeltaSpeed,
-                                                   MT_Scalar maxDeltaAngle)
+float KX_ObstacleSimulation::GetAvoidanceTime() const
+{
+  return 0.0f;
+}
+
+void KX_ObstacleSimulation::AdjustVelocity(KX_Obstacle *activeObst,
+                                           KX_NavMeshObject *activeNavMeshObj,
+                                           const KX_Obstacles &obstacles,
+                                           MT_Vector3 &velocity,
+                                           MT_Scalar maxDeltaSpeed,
+                                           MT_Scalar maxDeltaAngle)
+{
+}
+
+void KX_ObstacleSimulation::RequestVelocity(KX_Obstacle *activeObst,
+                                            KX_NavMeshObject *activeNavMeshObj,
+                                            SCA_SteeringActuator *steering,
+                                            const MT_Vector3 &velocity,
+                                            MT_Scalar maxDeltaSpeed,
+                                            MT_Scalar maxDeltaAngle)
+{
+  /* Set now as the other agents read it while adjusting their velocity, the requests of the
+   * agent itself are adjusted from their own velocity. */
+  vset(activeObst->dvel, velocity.x(), velocity.y());
+
+  std::vector<KX_SteeringRequest> &requests = activeObst->m_steeringRequests;
+  if (requests.empty()) {
+    m_agents.push_back(activeObst);
+  }
+
+  const KX_SteeringRequest request = {
+      steering, activeNavMeshObj, velocity, maxDeltaSpeed, maxDeltaAngle};
+  // An actuator running several times in a frame replaces its request.
+  for (KX_SteeringRequest &other : requests) {
+    if (other.m_steering == steering) {
+      other = request;
+      return;
+    }
+  }
+  requests.push_back(request);
+}
+
+void KX_ObstacleSimulation::RequestPath(SCA_SteeringActuator *steering)
+{
+  m_pathQueue.push_back(steering);
+}
+
+void KX_ObstacleSimulation::BuildGrid(float cellSize)
+{
+  m_gridCellSize = cellSize;
+  m_grid.clear();
+  m_largeObstacles.clear();
+
+  const float invCellSize = 1.0f / cellSize;
+  for (KX_Obstacle *obs : m_obstacles) {
+    float min[2] = {(float)obs->m_pos.x(), (float)obs->m_pos.y()};
+    float max[2] = {min[0], min[1]};
+    if (obs->m_shape == KX_OBSTACLE_SEGMENT) {
+      min[0] = std::min(min[0], (float)obs->m_pos2.x());
+      min[1] = std::min(min[1], (float)obs->m_pos2.y());
+      max[0] = std::max(max[0], (float)obs->m_pos2.x());
+      max[1] = std::max(max[1], (float)obs->m_pos2.y());
+    }
+
+    const int x0 = (int)floorf((min[0] - obs->m_rad) * invCellSize);
+    const int y0 = (int)floorf((min[1] - obs->m_rad) * invCellSize);
+    const int x1 = (int)floorf((max[0] + obs->m_rad) * invCellSize);
+    const int y1 = (int)floorf((max[1] + obs->m_rad) * invCellSize);
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > MAX_OBSTACLE_CELLS) {
+      m_largeObstacles.push_back(obs);
+      continue;
+    }
+
+    for (int y = y0; y <= y1; ++y) {
+      for (int x = x0; x <= x1; ++x) {
+        m_grid.push_back({gridCell(x, y), obs});
+      }
+    }
+  }
+
+  std::sort(m_grid.begin(), m_grid.end(), [](const GridEntry &a, const GridEntry &b) {
+    return a.m_cell < b.m_cell;
+  });
+}
+
+void KX_ObstacleSimulation::GetNeighbours(const MT_Vector3 &pos,
+                                          float range,
+                                          KX_Obstacles &neighbours) const
+{
+  const float invCellSize = 1.0f / m_gridCellSize;
+  const int x0 = (int)floorf((pos.x() - range) * invCellSize);
+  const int y0 = (int)floorf((pos.y() - range) * invCellSize);
+  const int x1 = (int)floorf((pos.x() + range) * invCellSize);
+  const int y1 = (int)floorf((pos.y() + range) * invCellSize);
+
+  neighbours = m_largeObstacles;
+  for (int y = y0; y <= y1; ++y) {
+    for (int x = x0; x <= x1; ++x) {
+      const uint64_t cell = gridCell(x, y);
+      std::vector<GridEntry>::const_iterator it = std::lower_bound(
+          m_grid.begin(), m_grid.end(), cell, [](const GridEntry &entry, uint64_t cell) {
+            return entry.m_cell < cell;
+          });
+      for (; it != m_grid.end() && it->m_cell == cell; ++it) {
+        neighbours.push_back(it->m_obstacle);
+      }
+    }
+  }
+
+  // The obstacles overlapping several cells are found several times.
+  std::sort(neighbours.begin(), neighbours.end());
+  neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+}
+
+void KX_ObstacleSimulation::SimulateAgentTask(void *__restrict userdata,
+                                              const int iter,
+                                              const TaskParallelTLS *__restrict /*tls*/)
+{
+  KX_ObstacleSimulation *simulation = static_cast<KX_ObstacleSimulation *>(userdata);
+  KX_Obstacle *agent = simulation->m_agents[iter];
+
+  // Reach of the agent and of the obstacles moving towards it during the avoidance time.
+  const float range = agent->m_rad + simulation->m_gridCellSize;
+
+  KX_Obstacles neighbours;
+  simulation->GetNeighbours(agent->m_pos, range, neighbours);
+  // The requests of an agent change its velocity history, they are adjusted in the same task.
+  for (KX_SteeringRequest &request : agent->m_steeringRequests) {
+    simulation->AdjustVelocity(agent,
+                               request.m_navMesh,
+                               neighbours,
+                               request.m_velocity,
+                               request.m_maxDeltaSpeed,
+                               request.m_maxDeltaAngle);
+  }
+}
+
+void KX_ObstacleSimulation::Simulate()
 {
+  CM_PROFILE_ZONE("ObstacleSimulation");
+
+  for (unsigned int i = 0; i < MAX_PATH_REQUESTS && !m_pathQueue.empty(); ++i) {
+    SCA_SteeringActuator *steering = m_pathQueue.front();
+    m_pathQueue.pop_front();
+    steering->UpdatePath();
+  }
+
+  if (m_agents.empty())
+    return;
+
+  /* The grid cells are as large as the reach of the fastest agent and obstacle during the
+   * avoidance time so that the neighbours of an agent are in the cells around it. */
+  const float avoidanceTime = GetAvoidanceTime();
+  if (avoidanceTime > 0.0f) {
+    float maxRadius = 0.0f;
+    float maxSpeed = 0.0f;
+    for (KX_Obstacle *obs : m_obstacles) {
+      if (obs->m_shape == KX_OBSTACLE_CIRCLE) {
+        maxRadius = std::max(maxRadius, (float)obs->m_rad);
+        maxSpeed = std::max(maxSpeed, len_v2(obs->vel));
+      }
+    }
+    float maxAgentSpeed = 0.0f;
+    for (KX_Obstacle *agent : m_agents) {
+      for (const KX_SteeringRequest &request : agent->m_steeringRequests) {
+        const float speed = sqrtf(request.m_velocity.x() * request.m_velocity.x() +
+                                  request.m_velocity.y() * request.m_velocity.y());
+        maxAgentSpeed = std::max(maxAgentSpeed, 2.0f * speed + len_v2(agent->vel));
+      }
+    }
+    BuildGrid(std::max(maxRadius + (maxAgentSpeed + maxSpeed) * avoidanceTime, 1.0f));
+
+    /* The agents only write their own velocity, the obstacles and the grid are only read
+     * during the adjustment. */
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (m_agents.size() > 1);
+    BLI_task_parallel_range(0, m_agents.size(), this, SimulateAgentTask, &settings);
+  }
+
+  // The velocities are applied to the objects on the main thread.
+  for (KX_Obstacle *agent : m_agents) {
+    for (const KX_SteeringRequest &request : agent->m_steeringRequests) {
+      request.m_steering->ApplyVelocity(request.m_velocity);
+    }
+    agent->m_steeringRequests.clear();
+  }
+  m_agents.clear();
 }
 
 void KX_ObstacleSimulation::DrawObstacles()
@@ -315,16 +528,7 @@ void KX_ObstacleSimulation::DrawObstacles()
   static const int SECTORS_NUM = 32;
   for (size_t i = 0; i < m_obstacles.size(); i++) {
     if (m_obstacles[i]->m_shape == KX_OBSTACLE_SEGMENT) {
-      MT_Vector3 p1 = m_obstacles[i]->m_pos;
-      MT_Vector3 p2 = m_obstacles[i]->m_pos2;
-      // apply world transform
-      if (m_obstacles[i]->m_type == KX_OBSTACLE_NAV_MESH) {
-        KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(m_obstacles[i]->m_gameObj);
-        p1 = navmeshobj->TransformToWorldCoords(p1);
-        p2 = navmeshobj->TransformToWorldCoords(p2);
-      }
-
-      KX_RasterizerDrawDebugLine(p1, p2, bluecolor);
+      KX_RasterizerDrawDebugLine(m_obstacles[i]->m_pos, m_obstacles[i]->m_pos2, bluecolor);
     }
     else if (m_obstacles[i]->m_shape == KX_OBSTACLE_CIRCLE) {
       KX_RasterizerDrawDebugCircle(
@@ -386,22 +590,21 @@ KX_ObstacleSimulationTOI::KX_ObstacleSimulationTOI(MT_Scalar levelHeight, bool e
 {
 }
 
-void KX_ObstacleSimulationTOI::AdjustObstacleVelocity(KX_Obstacle *activeObst,
-                                                      KX_NavMeshObject *activeNavMeshObj,
-                                                      MT_Vector3 &velocity,
-                                                      MT_Scalar maxDeltaSpeed,
-                                                      MT_Scalar maxDeltaAngle)
+float KX_ObstacleSimulationTOI::GetAvoidanceTime() const
 {
-  int nobs = m_obstacles.size();
-  int obstidx = std::find(m_obstacles.begin(), m_obstacles.end(), activeObst) -
-                m_obstacles.begin();
-  if (obstidx == nobs)
-    return;
-
-  vset(activeObst->dvel, velocity.x(), velocity.y());
+  return m_maxToi;
+}
 
+void KX_ObstacleSimulationTOI::AdjustVelocity(KX_Obstacle *activeObst,
+                                              KX_NavMeshObject *activeNavMeshObj,
+                                              const KX_Obstacles &obstacles,
+                                              MT_Vector3 &velocity,
+                                              MT_Scalar maxDeltaSpeed,
+                                              MT_Scalar maxDeltaAngle)
+{
   // apply RVO
-  sampleRVO(activeObst, activeNavMeshObj, maxDeltaAngle);
+  const float desiredVel[2] = {(float)velocity.x(), (float)velocity.y()};
+  sampleRVO(activeObst, activeNavMeshObj, obstacles, desiredVel, maxDeltaAngle);
 
   // Fake dynamic constraint.
   float dv[2];
@@ -443,9 +646,11 @@ KX_ObstacleSimulationTOI_rays::KX_ObstacleSimulationTOI_rays(MT_Scalar levelHeig
 
 void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
                                               KX_NavMeshObject *activeNavMeshObj,
+                                              const KX_Obstacles &obstacles,
+                                              const float desiredVel[2],
                                               const float maxDeltaAngle)
 {
-  MT_Vector2 vel(activeObst->dvel[0], activeObst->dvel[1]);
+  MT_Vector2 vel(desiredVel[0], desiredVel[1]);
   float vmax = (float)vel.length();
   float odir = (float)atan2(vel.y(), vel.x());
 
@@ -464,7 +669,7 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
   const int iforw = m_maxSamples / 2;
   const float aoff = (float)iforw / (float)m_maxSamples;
 
-  size_t nobs = m_obstacles.size();
+  size_t nobs = obstacles.size();
   for (int iter = 0; iter < m_maxSamples; ++iter) {
     // Calculate sample velocity
     const float ndir = ((float)iter / (float)m_maxSamples) - aoff;
@@ -477,7 +682,7 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
     float tmin = m_maxToi;
     float tmine = 0.0f;
     for (int i = 0; i < nobs; ++i) {
-      KX_Obstacle *ob = m_obstacles[i];
+      KX_Obstacle *ob = obstacles[i];
       bool res = filterObstacle(activeObst, activeNavMeshObj, ob, m_levelHeight);
       if (!res)
         continue;
@@ -506,20 +711,11 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
         }
       }
       else if (ob->m_shape == KX_OBSTACLE_SEGMENT) {
-        MT_Vector3 p1 = ob->m_pos;
-        MT_Vector3 p2 = ob->m_pos2;
-        // apply world transform
-        if (ob->m_type == KX_OBSTACLE_NAV_MESH) {
-          KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(ob->m_gameObj);
-          p1 = navmeshobj->TransformToWorldCoords(p1);
-          p2 = navmeshobj->TransformToWorldCoords(p2);
-        }
-
         if (!sweepCircleSegment(activeObst->m_pos.to2d(),
                                 activeObst->m_rad,
                                 svel,
-                                p1.to2d(),
-                                p2.to2d(),
+                                ob->m_pos.to2d(),
+                                ob->m_pos2.to2d(),
                                 ob->m_rad,
                                 htmin,
                                 htmax)) {
@@ -591,7 +787,8 @@ void KX_ObstacleSimulationTOI_rays::sampleRVO(KX_Obstacle *activeObst,
 
 static void processSamples(KX_Obstacle *activeObst,
                            KX_NavMeshObject *activeNavMeshObj,
-                           KX_Obstacles &obstacles,
+                           const KX_Obstacles &obstacles,
+                           const float *desiredVel,
                            float levelHeight,
                            const float vmax,
                            const float *spos,
@@ -648,7 +845,7 @@ static void processSamples(KX_Obstacle *activeObst,
         float dp[2], dv[2], np[2];
         sub_v2_v2v2(dp, pb, pa);
         normalize_v2(dp);
-        sub_v2_v2v2(dv, ob->dvel, activeObst->dvel);
+        sub_v2_v2v2(dv, ob->dvel, desiredVel);
 
         /* TODO: use line_point_side_v2 */
         if (area_tri_signed_v2(orig, dp, dv) < 0.01f) {
@@ -680,17 +877,9 @@ static void processSamples(KX_Obstacle *activeObst,
         }
       }
       else if (ob->m_shape == KX_OBSTACLE_SEGMENT) {
-        MT_Vector3 p1 = ob->m_pos;
-        MT_Vector3 p2 = ob->m_pos2;
-        // apply world transform
-        if (ob->m_type == KX_OBSTACLE_NAV_MESH) {
-          KX_NavMeshObject *navmeshobj = static_cast<KX_NavMeshObject *>(ob->m_gameObj);
-          p1 = navmeshobj->TransformToWorldCoords(p1);
-          p2 = navmeshobj->TransformToWorldCoords(p2);
-        }
         float p[2], q[2];
-        vset(p, p1.x(), p1.y());
-        vset(q, p2.x(), p2.y());
+        vset(p, ob->m_pos.x(), ob->m_pos.y());
+        vset(q, ob->m_pos2.x(), ob->m_pos2.y());
 
         // NOTE: the segments are assumed to come from a navmesh which is shrunken by
         // the agent radius, hence the use of really small radius.
@@ -739,7 +928,7 @@ static void processSamples(KX_Obstacle *activeObst,
     if (nside)
       side /= nside;
 
-    const float vpen = velWeight * (len_v2v2(vcand, activeObst->dvel) * ivmax);
+    const float vpen = velWeight * (len_v2v2(vcand, desiredVel) * ivmax);
     const float vcpen = curVelWeight * (len_v2v2(vcand, activeObst->vel) * ivmax);
     const float spen = sideWeight * side;
     const float tpen = toiWeight * (1.0f / (0.1f + tmin / maxToi));
@@ -755,17 +944,19 @@ static void processSamples(KX_Obstacle *activeObst,
 
 void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
                                                KX_NavMeshObject *activeNavMeshObj,
+                                               const KX_Obstacles &obstacles,
+                                               const float desiredVel[2],
                                                const float maxDeltaAngle)
 {
   vset(activeObst->nvel, 0.f, 0.f);
-  float vmax = len_v2(activeObst->dvel);
+  float vmax = len_v2(desiredVel);
 
   float *spos = new float[2 * m_maxSamples];
   int nspos = 0;
 
   if (!m_adaptive) {
-    const float cvx = activeObst->dvel[0] * m_bias;
-    const float cvy = activeObst->dvel[1] * m_bias;
+    const float cvx = desiredVel[0] * m_bias;
+    const float cvy = desiredVel[1] * m_bias;
     const float vrange = vmax * (1 - m_bias);
     const float cs = 1.0f / (float)m_sampleRadius * vrange;
 
@@ -784,7 +975,8 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
     }
     processSamples(activeObst,
                    activeNavMeshObj,
-                   m_obstacles,
+                   obstacles,
+                   desiredVel,
                    m_levelHeight,
                    vmax,
                    spos,
@@ -803,8 +995,8 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
     float cs;
     // First sample location.
     rad = 4;
-    res[0] = activeObst->dvel[0] * m_bias;
-    res[1] = activeObst->dvel[1] * m_bias;
+    res[0] = desiredVel[0] * m_bias;
+    res[1] = desiredVel[1] * m_bias;
     cs = vmax * (2 - m_bias * 2) / (float)(rad - 1);
 
     for (int k = 0; k < 5; ++k) {
@@ -825,7 +1017,8 @@ void KX_ObstacleSimulationTOI_cells::sampleRVO(KX_Obstacle *activeObst,
 
       processSamples(activeObst,
                      activeNavMeshObj,
-                     m_obstacles,
+                     obstacles,
+                     desiredVel,
                      m_levelHeight,
                      vmax,
                      spos,
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <deque>
 #include <vector>
 
 #include "MT_Vector2.h"
@@ -32,6 +34,8 @@
 
 class KX_GameObject;
 class KX_NavMeshObject;
+class SCA_SteeringActuator;
+struct TaskParallelTLS;
 
 enum KX_OBSTACLE_TYPE {
   KX_OBSTACLE_OBJ,
@@ -44,11 +48,25 @@ enum KX_OBSTACLE_SHAPE {
 };
 
 #define VEL_HIST_SIZE 6
+/// Velocity requested by a steering actuator, see KX_ObstacleSimulation::Simulate.
+struct KX_SteeringRequest {
+  SCA_SteeringActuator *m_steering;
+  KX_NavMeshObject *m_navMesh;
+  /// Requested velocity, adjusted by the simulation.
+  MT_Vector3 m_velocity;
+  MT_Scalar m_maxDeltaSpeed;
+  MT_Scalar m_maxDeltaAngle;
+};
+
 struct KX_Obstacle {
   KX_OBSTACLE_TYPE m_type;
   KX_OBSTACLE_SHAPE m_shape;
+  /// Position in world space, updated each frame.
   MT_Vector3 m_pos;
   MT_Vector3 m_pos2;
+  /// Nav mesh segment in the local space of its nav mesh.
+  MT_Vector3 m_localPos;
+  MT_Vector3 m_localPos2;
   MT_Scalar m_rad;
 
   float vel[2];
@@ -59,18 +77,70 @@ struct KX_Obstacle {
   int hhead;
 
   KX_GameObject *m_gameObj;
+
+  /// Velocities requested by the steering actuators of the object this frame.
+  std::vector<KX_SteeringRequest> m_steeringRequests;
 };
 typedef std::vector<KX_Obstacle *> KX_Obstacles;
 
+/**
+ * Obstacles of a scene and the agents steered around them.
+ *
+ * The steering actuators request the velocity of their agent and the replanning of their path
+ * during the logic frame, Simulate then resolves all the requests of the frame together: the
+ * paths are searched within a budget per frame and the velocities are adjusted in parallel,
+ * each agent only testing the obstacles found around it in a uniform grid.
+ */
 class KX_ObstacleSimulation {
  protected:
+  /// Obstacle stored in a cell of the grid.
+  struct GridEntry {
+    uint64_t m_cell;
+    KX_Obstacle *m_obstacle;
+  };
+
   KX_Obstacles m_obstacles;
 
   MT_Scalar m_levelHeight;
   bool m_enableVisualization;
 
+  /// Agents which requested a velocity this frame.
+  KX_Obstacles m_agents;
+  /// Steering actuators waiting for a path.
+  std::deque<SCA_SteeringActuator *> m_pathQueue;
+
+  /// Obstacles sorted by cell, rebuilt by each simulation.
+  std::vector<GridEntry> m_grid;
+  /// Obstacles overlapping too many cells, tested by all the agents.
+  KX_Obstacles m_largeObstacles;
+  float m_gridCellSize;
+
   KX_Obstacle *CreateObstacle(KX_GameObject *gameobj);
 
+  /// Fill the grid with the obstacles.
+  void BuildGrid(float cellSize);
+  /// Get the obstacles of the grid around a position.
+  void GetNeighbours(const MT_Vector3 &pos, float range, KX_Obstacles &neighbours) const;
+  static void SimulateAgentTask(void *__restrict userdata,
+                                const int iter,
+                                const TaskParallelTLS *__restrict tls);
+
+  /** Get the time ahead within which the agents avoid the obstacles, the obstacles out of
+   * reach in this time are not tested.
+   */
+  virtual float GetAvoidanceTime() const;
+  /** Adjust the velocity requested for an agent to avoid the obstacles.
+   * Can be called from several threads for different agents.
+   * \param obstacles The obstacles to avoid.
+   * \param velocity The requested velocity, adjusted in X and Y.
+   */
+  virtual void AdjustVelocity(KX_Obstacle *activeObst,
+                              KX_NavMeshObject *activeNavMeshObj,
+                              const KX_Obstacles &obstacles,
+                              MT_Vector3 &velocity,
+                              MT_Scalar maxDeltaSpeed,
+                              MT_Scalar maxDeltaAngle);
+
  public:
   KX_ObstacleSimulation(MT_Scalar levelHeight, bool enableVisualization);
   virtual ~KX_ObstacleSimulation();
@@ -83,11 +153,21 @@ class KX_ObstacleSimulation {
   void AddObstaclesForNavMesh(KX_NavMeshObject *navmesh);
   KX_Obstacle *GetObstacle(KX_GameObject *gameobj);
   void UpdateObstacles();
-  virtual void AdjustObstacleVelocity(KX_Obstacle *activeObst,
-                                      KX_NavMeshObject *activeNavMeshObj,
-                                      MT_Vector3 &velocity,
-                                      MT_Scalar maxDeltaSpeed,
-                                      MT_Scalar maxDeltaAngle);
+
+  /** Request the velocity of an agent for this frame, the adjusted velocity is given back to
+   * the actuator by Simulate with SCA_SteeringActuator::ApplyVelocity. Each actuator of the
+   * agent has its own request, adjusted one after the other.
+   */
+  void RequestVelocity(KX_Obstacle *activeObst,
+                       KX_NavMeshObject *activeNavMeshObj,
+                       SCA_SteeringActuator *steering,
+                       const MT_Vector3 &velocity,
+                       MT_Scalar maxDeltaSpeed,
+                       MT_Scalar maxDeltaAngle);
+  /// Request a new path for an actuator, searched by Simulate with UpdatePath of the actuator.
+  void RequestPath(SCA_SteeringActuator *steering);
+  /// Resolve the path and velocity requests of the frame.
+  void Simulate();
 };
 class KX_ObstacleSimulationTOI : public KX_ObstacleSimulation {
  protected:
@@ -99,23 +179,31 @@ class KX_ObstacleSimulationTOI : public KX_ObstacleSimulation {
   float m_toiWeight;        // Sample selection TOI weight
   float m_collisionWeight;  // Sample selection collision weight
 
+  /// Sample the velocities around the desired velocity of a request, the best is set in nvel.
   virtual void sampleRVO(KX_Obstacle *activeObst,
                          KX_NavMeshObject *activeNavMeshObj,
+                         const KX_Obstacles &obstacles,
+                         const float desiredVel[2],
                          const float maxDeltaAngle) = 0;
 
+  virtual float GetAvoidanceTime() const;
+  virtual void AdjustVelocity(KX_Obstacle *activeObst,
+                              KX_NavMeshObject *activeNavMeshObj,
+                              const KX_Obstacles &obstacles,
+                              MT_Vector3 &velocity,
+                              MT_Scalar maxDeltaSpeed,
+                              MT_Scalar maxDeltaAngle);
+
  public:
   KX_ObstacleSimulationTOI(MT_Scalar levelHeight, bool enableVisualization);
-  virtual void AdjustObstacleVelocity(KX_Obstacle *activeObst,
-                                      KX_NavMeshObject *activeNavMeshObj,
-                                      MT_Vector3 &velocity,
-                                      MT_Scalar maxDeltaSpeed,
-                                      MT_Scalar maxDeltaAngle);
 };
 
 class KX_ObstacleSimulationTOI_rays : public KX_ObstacleSimulationTOI {
  protected:
   virtual void sampleRVO(KX_Obstacle *activeObst,
                          KX_NavMeshObject *activeNavMeshObj,
+                         const KX_Obstacles &obstacles,
+                         const float desiredVel[2],
                          const float maxDeltaAngle);
 
  public:
@@ -129,6 +217,8 @@ class KX_ObstacleSimulationTOI_cells : public KX_ObstacleSimulationTOI {
   int m_sampleRadius;
   virtual void sampleRVO(KX_Obstacle *activeObst,
                          KX_NavMeshObject *activeNavMeshObj,
+                         const KX_Obstacles &obstacles,
+                         const float desiredVel[2],
                          const float maxDeltaAngle);
 
  public:
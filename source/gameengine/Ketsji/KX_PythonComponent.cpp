@@ -25,6 +25,9 @@
 #  include "KX_PythonComponent.h"
 #  include "KX_PythonProxy.h"
 
+#  include <cfloat>
+#  include <climits>
+
 #  include "BKE_python_proxy.hh"
 #  include "DNA_python_proxy_types.h"
 
@@ -127,6 +130,14 @@ PyAttributeDef KX_PythonComponent::Attributes[] = {
     EXP_PYATTRIBUTE_RO_FUNCTION("logger", KX_PythonComponent, KX_PythonProxy::pyattr_get_logger),
     EXP_PYATTRIBUTE_RO_FUNCTION(
         "loggerName", KX_PythonComponent, KX_PythonProxy::pyattr_get_logger_name),
+    EXP_PYATTRIBUTE_INT_RW_CHECK(
+        "updateTicks", 1, INT_MAX, true, KX_PythonComponent, m_updateTicks, pyattr_check_schedule),
+    EXP_PYATTRIBUTE_FLOAT_RW_CHECK("updateInterval",
+                                   0.0f,
+                                   FLT_MAX,
+                                   KX_PythonComponent,
+                                   m_updateInterval,
+                                   pyattr_check_schedule),
     EXP_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -143,4 +154,12 @@ PyObject *KX_PythonComponent::pyattr_get_object(EXP_PyObjectPlus *self_v,
     Py_RETURN_NONE;
   }
 }
+
+int KX_PythonComponent::pyattr_check_schedule(EXP_PyObjectPlus *self_v,
+                                              const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_PythonComponent *self = static_cast<KX_PythonComponent *>(self_v);
+  self->ResetUpdateSchedule();
+  return 0;
+}
 #endif
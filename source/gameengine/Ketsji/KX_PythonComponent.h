@@ -52,6 +52,7 @@ class KX_PythonComponent : public KX_PythonProxy {
 
   // Attributes
   static PyObject *pyattr_get_object(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_check_schedule(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
 };
 
 #endif  // WITH_PYTHON
@@ -102,11 +102,13 @@
 #include "BL_Converter.h"
 #include "BL_Shader.h"
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 #include "KX_Globals.h"
 #include "KX_LibLoadStatus.h"
 #include "KX_MeshProxy.h" /* for creating a new library of mesh objects */
 #include "KX_NavMeshObject.h"
 #include "KX_NetworkMessageScene.h"  //Needed for sendMessage()
+#include "KX_NetworkReplication.h"
 #include "KX_PyConstraintBinding.h"
 #include "KX_PyMath.h"
 #include "KX_PythonInitTypes.h"
@@ -281,6 +283,42 @@ static PyObject *gPyGetProfileInfo(PyObject *)
   return KX_GetActiveEngine()->GetPyProfileDict();
 }
 
+PyDoc_STRVAR(gPyStartProfileTrace_doc,
+             "startProfileTrace()\n"
+             "clears the recorded profiling zones and starts recording");
+static PyObject *gPyStartProfileTrace(PyObject *)
+{
+  CM_Profiler::Clear();
+  CM_Profiler::Start();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyStopProfileTrace_doc,
+             "stopProfileTrace()\n"
+             "stops recording the profiling zones");
+static PyObject *gPyStopProfileTrace(PyObject *)
+{
+  CM_Profiler::Stop();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPySaveProfileTrace_doc,
+             "saveProfileTrace(filepath)\n"
+             "writes the recorded profiling zones in a Chrome trace event file");
+static PyObject *gPySaveProfileTrace(PyObject *, PyObject *args)
+{
+  char *path;
+  if (!PyArg_ParseTuple(args, "s:saveProfileTrace", &path)) {
+    return nullptr;
+  }
+
+  if (!CM_Profiler::WriteChromeTrace(path)) {
+    PyErr_Format(PyExc_OSError, "saveProfileTrace(filepath): can't write \"%s\"", path);
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR(gPySendMessage_doc,
              "sendMessage(subject, [body, to, from])\n"
              "sends a message in same manner as a message actuator"
@@ -313,6 +351,77 @@ static PyObject *gPySendMessage(PyObject *, PyObject *args)
   Py_RETURN_NONE;
 }
 
+PyDoc_STRVAR(gPyStartReplication_doc,
+             "startReplication(mode, address, port, tickRate, sendRate, interpolationDelay)\n"
+             "starts the replication of the objects and messages with other engines\n"
+             " mode = KX_REPLICATION_SERVER or KX_REPLICATION_CLIENT\n"
+             " address = IPv4 address the server listens on or the client sends to\n"
+             " port = UDP port of the server\n"
+             " tickRate = snapshots captured per second by the server\n"
+             " sendRate = packets sent per second\n"
+             " interpolationDelay = delay of the interpolated transforms on the clients in "
+             "seconds\n");
+static PyObject *gPyStartReplication(PyObject *, PyObject *args, PyObject *kwds)
+{
+  int mode;
+  const char *address = "127.0.0.1";
+  int port = 7777;
+  float tickRate = 60.0f;
+  float sendRate = 20.0f;
+  float interpolationDelay = 0.1f;
+
+  static const char *kwlist[] = {
+      "mode", "address", "port", "tickRate", "sendRate", "interpolationDelay", nullptr};
+
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "i|sifff:startReplication",
+                                   const_cast<char **>(kwlist),
+                                   &mode,
+                                   &address,
+                                   &port,
+                                   &tickRate,
+                                   &sendRate,
+                                   &interpolationDelay))
+    return nullptr;
+
+  if (mode != KX_NetworkReplication::MODE_SERVER && mode != KX_NetworkReplication::MODE_CLIENT) {
+    PyErr_SetString(PyExc_ValueError,
+                    "startReplication(mode, ...): expected KX_REPLICATION_SERVER or "
+                    "KX_REPLICATION_CLIENT");
+    return nullptr;
+  }
+  if (port < 1 || port > 65535) {
+    PyErr_SetString(PyExc_ValueError, "startReplication(mode, ...): port out of range");
+    return nullptr;
+  }
+
+  const KX_NetworkReplication::Settings settings = {(KX_NetworkReplication::Mode)mode,
+                                                    address,
+                                                    (unsigned short)port,
+                                                    tickRate,
+                                                    sendRate,
+                                                    interpolationDelay};
+
+  if (!KX_GetActiveEngine()->StartReplication(settings)) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "startReplication(mode, ...): the replication can't be started, see the "
+                    "console");
+    return nullptr;
+  }
+
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyStopReplication_doc,
+             "stopReplication()\n"
+             "stops the replication started by startReplication");
+static PyObject *gPyStopReplication(PyObject *)
+{
+  KX_GetActiveEngine()->StopReplication();
+  Py_RETURN_NONE;
+}
+
 // this gets a pointer to an array filled with floats
 static PyObject *gPyGetSpectrum(PyObject *)
 {
@@ -756,6 +865,22 @@ static PyObject *gLibList(PyObject *, PyObject *args)
   return list;
 }
 
+static PyObject *gLibSetMergeTime(PyObject *, PyObject *args)
+{
+  float time;
+
+  if (!PyArg_ParseTuple(args, "f:LibSetMergeTime", &time))
+    return nullptr;
+
+  KX_GetActiveEngine()->GetConverter()->SetMergeBudget(time / 1000.0);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gLibGetMergeTime(PyObject *)
+{
+  return PyFloat_FromDouble(KX_GetActiveEngine()->GetConverter()->GetMergeBudget() * 1000.0);
+}
+
 struct PyNextFrameState pynextframestate;
 static PyObject *gPyNextFrame(PyObject *)
 {
@@ -788,6 +913,14 @@ static struct PyMethodDef game_methods[] = {
      METH_NOARGS,
      (const char *)gPyLoadGlobalDict_doc},
     {"sendMessage", (PyCFunction)gPySendMessage, METH_VARARGS, (const char *)gPySendMessage_doc},
+    {"startReplication",
+     (PyCFunction)gPyStartReplication,
+     METH_VARARGS | METH_KEYWORDS,
+     (const char *)gPyStartReplication_doc},
+    {"stopReplication",
+     (PyCFunction)gPyStopReplication,
+     METH_NOARGS,
+     (const char *)gPyStopReplication_doc},
     {"getCurrentController",
      (PyCFunction)SCA_PythonController::sPyGetCurrentController,
      METH_NOARGS,
@@ -916,11 +1049,22 @@ static struct PyMethodDef game_methods[] = {
      METH_NOARGS,
      (const char *)"Render next frame (if Python has control)"},
     {"getProfileInfo", (PyCFunction)gPyGetProfileInfo, METH_NOARGS, gPyGetProfileInfo_doc},
+    {"startProfileTrace",
+     (PyCFunction)gPyStartProfileTrace,
+     METH_NOARGS,
+     gPyStartProfileTrace_doc},
+    {"stopProfileTrace", (PyCFunction)gPyStopProfileTrace, METH_NOARGS, gPyStopProfileTrace_doc},
+    {"saveProfileTrace",
+     (PyCFunction)gPySaveProfileTrace,
+     METH_VARARGS,
+     gPySaveProfileTrace_doc},
     /* library functions */
     {"LibLoad", (PyCFunction)gLibLoad, METH_VARARGS | METH_KEYWORDS, (const char *)""},
     {"LibNew", (PyCFunction)gLibNew, METH_VARARGS, (const char *)""},
     {"LibFree", (PyCFunction)gLibFree, METH_VARARGS, (const char *)""},
     {"LibList", (PyCFunction)gLibList, METH_VARARGS, (const char *)""},
+    {"LibSetMergeTime", (PyCFunction)gLibSetMergeTime, METH_VARARGS, (const char *)""},
+    {"LibGetMergeTime", (PyCFunction)gLibGetMergeTime, METH_NOARGS, (const char *)""},
 
     {nullptr, (PyCFunction) nullptr, 0, nullptr}};
 
@@ -1602,6 +1746,10 @@ PyMODINIT_FUNC initGameLogicPythonBinding()
       d, KX_DYN_DISABLE_RIGID_BODY, SCA_DynamicActuator::KX_DYN_DISABLE_RIGID_BODY);
   KX_MACRO_addTypesToDict(d, KX_DYN_SET_MASS, SCA_DynamicActuator::KX_DYN_SET_MASS);
 
+  /* Replication */
+  KX_MACRO_addTypesToDict(d, KX_REPLICATION_SERVER, KX_NetworkReplication::MODE_SERVER);
+  KX_MACRO_addTypesToDict(d, KX_REPLICATION_CLIENT, KX_NetworkReplication::MODE_CLIENT);
+
   /* Input & Mouse Sensor */
   KX_MACRO_addTypesToDict(d, KX_INPUT_NONE, SCA_InputEvent::NONE);
   KX_MACRO_addTypesToDict(d, KX_INPUT_JUST_ACTIVATED, SCA_InputEvent::JUSTACTIVATED);
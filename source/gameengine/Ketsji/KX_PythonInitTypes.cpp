@@ -59,6 +59,7 @@
 #  include "KX_NavMeshObject.h"
 #  include "KX_PolyProxy.h"
 #  include "KX_PythonComponent.h"
+#  include "KX_TransformStore.h"
 #  include "KX_VehicleWrapper.h"
 #  include "KX_VertexProxy.h"
 #  include "SCA_2DFilterActuator.h"
@@ -267,6 +268,7 @@ PyMODINIT_FUNC initGameTypesPythonBinding(void)
     PyType_Ready_Attr(dict, SCA_VisibilityActuator, init_getset);
     PyType_Ready_Attr(dict, SCA_MouseActuator, init_getset);
     PyType_Ready_Attr(dict, KX_CollisionContactPoint, init_getset);
+    PyType_Ready_Attr(dict, KX_TransformStore, init_getset);
     PyType_Ready_Attr(dict, EXP_PyObjectPlus, init_getset);
     PyType_Ready_Attr(dict, SCA_2DFilterActuator, init_getset);
     PyType_Ready_Attr(dict, SCA_ANDController, init_getset);
@@ -22,21 +22,30 @@
 
 #include "KX_PythonProxy.h"
 
+#include <cmath>
+
 #include <fmt/format.h>
 
 #include "BKE_python_proxy.hh"
 #include "CM_Message.h"
 #include "DNA_python_proxy_types.h"
 
+/// Counter giving a different update phase to each proxy.
+static unsigned int update_phase_counter = 0;
+
 KX_PythonProxy::KX_PythonProxy()
     : EXP_Value(),
       m_init(false),
       m_pp(nullptr),
+      m_updatePhase(update_phase_counter++),
+      m_nextUpdateTime(-1.0),
 #ifdef WITH_PYTHON
       m_update(nullptr),
       m_dispose(nullptr),
-      m_logger(nullptr)
+      m_logger(nullptr),
 #endif
+      m_updateTicks(1),
+      m_updateInterval(0.0f)
 {
 }
 
@@ -109,6 +118,43 @@ void KX_PythonProxy::Update()
   }
 }
 
+bool KX_PythonProxy::NeedUpdate(unsigned int tick, double time)
+{
+  if (!m_init) {
+    return true;
+  }
+
+  if (m_updateInterval > 0.0f) {
+    if (m_nextUpdateTime < 0.0) {
+      // Start at a fraction of the interval given by the golden ratio of the phase.
+      const double fraction = std::fmod(m_updatePhase * 0.6180339887, 1.0);
+      m_nextUpdateTime = time + m_updateInterval * fraction;
+    }
+
+    if (time < m_nextUpdateTime) {
+      return false;
+    }
+
+    m_nextUpdateTime += m_updateInterval;
+    // Don't try to catch up the updates missed during a long frame.
+    if (m_nextUpdateTime <= time) {
+      m_nextUpdateTime = time + m_updateInterval;
+    }
+    return true;
+  }
+
+  if (m_updateTicks > 1) {
+    return ((tick + m_updatePhase) % m_updateTicks) == 0;
+  }
+
+  return true;
+}
+
+void KX_PythonProxy::ResetUpdateSchedule()
+{
+  m_nextUpdateTime = -1.0;
+}
+
 KX_PythonProxy *KX_PythonProxy::GetReplica()
 {
   KX_PythonProxy *replica = NewInstance();
@@ -132,6 +178,8 @@ void KX_PythonProxy::ProcessReplica()
   EXP_Value::ProcessReplica();
 
   m_init = false;
+  m_updatePhase = update_phase_counter++;
+  m_nextUpdateTime = -1.0;
 #ifdef WITH_PYTHON
   m_update = nullptr;
   m_dispose = nullptr;
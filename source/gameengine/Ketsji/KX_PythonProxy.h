@@ -33,6 +33,11 @@ class KX_PythonProxy : public EXP_Value {
 
   PythonProxy *m_pp;
 
+  /// Phase of the update schedule, spread the proxies with the same interval over the frames.
+  unsigned int m_updatePhase;
+  /// Time of the next update when updated every few seconds, negative when not scheduled.
+  double m_nextUpdateTime;
+
   #ifdef WITH_PYTHON
   PyObject *m_update;
 
@@ -41,6 +46,12 @@ class KX_PythonProxy : public EXP_Value {
   PyObject *m_logger;
   #endif
 
+ protected:
+  /// Number of logic ticks between two updates.
+  int m_updateTicks;
+  /// Time in seconds between two updates, used instead of the ticks when not zero.
+  float m_updateInterval;
+
  public:
   KX_PythonProxy();
 
@@ -56,6 +67,13 @@ class KX_PythonProxy : public EXP_Value {
 
   virtual void Update();
 
+  /** Return true if the proxy must be updated in this logic tick according to its update
+   * ticks or interval, a proxy not yet started is always updated.
+   */
+  bool NeedUpdate(unsigned int tick, double time);
+  /// Reset the schedule after a change of the update interval.
+  void ResetUpdateSchedule();
+
   virtual void Dispose();
 
   virtual KX_PythonProxy *NewInstance() = 0;
@@ -22,7 +22,9 @@
 
 #include "KX_PythonProxyManager.h"
 
-#include "CM_List.h"
+#include <algorithm>
+
+#include "CM_Profiler.h"
 #include "KX_GameObject.h"
 
 static bool compareObjectDepth(KX_GameObject *o1, KX_GameObject *o2)
@@ -47,24 +49,35 @@ void KX_PythonProxyManager::Register(KX_GameObject *gameobj)
 
 void KX_PythonProxyManager::Unregister(KX_GameObject *gameobj)
 {
-  CM_ListRemoveIfFound(m_objects, gameobj);
-  m_objects_changed = true;
+  /* Only clear the entry as the objects can be removed during the update,
+   * the list is compacted in the next update. */
+  std::vector<KX_GameObject *>::iterator it = std::find(
+      m_objects.begin(), m_objects.end(), gameobj);
+  if (it != m_objects.end()) {
+    *it = nullptr;
+    m_objects_changed = true;
+  }
 }
 
-void KX_PythonProxyManager::Update()
+void KX_PythonProxyManager::Update(double curtime)
 {
+  CM_PROFILE_ZONE("Components");
+
   if (m_objects_changed) {
-    std::sort(m_objects.begin(), m_objects.end(), compareObjectDepth);
+    m_objects.erase(std::remove(m_objects.begin(), m_objects.end(), nullptr), m_objects.end());
+    std::stable_sort(m_objects.begin(), m_objects.end(), compareObjectDepth);
 
     m_objects_changed = false;
   }
 
-  /* Update object components, we copy the object pointer in a second list to make
-   * sure that we iterate on a list which will not be modified, indeed components
-   * can add objects in theirs update.
-   */
-  const std::vector<KX_GameObject *> objects = m_objects;
-  for (KX_GameObject *gameobj : objects) {
-    gameobj->Update();
+  /* Update object components by index, the components can add objects in their update
+   * which are appended to the list and updated from the next frame, and remove objects
+   * which are only cleared in the list. */
+  const unsigned int tick = m_tick++;
+  for (unsigned int i = 0, size = m_objects.size(); i < size; ++i) {
+    KX_GameObject *gameobj = m_objects[i];
+    if (gameobj) {
+      gameobj->UpdateComponents(tick, curtime);
+    }
   }
 }
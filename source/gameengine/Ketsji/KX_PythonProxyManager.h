@@ -6,8 +6,11 @@ class KX_GameObject;
 
 class KX_PythonProxyManager {
  private:
+  /// Registered objects sorted by depth, the unregistered objects are null until the next update.
   std::vector<KX_GameObject *> m_objects;
   bool m_objects_changed = false;
+  /// Logic tick counter used to schedule the updates of the proxies.
+  unsigned int m_tick = 0;
 
  public:
   KX_PythonProxyManager();
@@ -16,5 +19,5 @@ class KX_PythonProxyManager {
   void Register(KX_GameObject *gameobj);
   void Unregister(KX_GameObject *gameobj);
 
-  void Update();
+  void Update(double curtime);
 };
@@ -32,7 +32,15 @@
 
 #include "KX_RayCast.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "DNA_object_types.h"
+
 #include "CM_Message.h"
+#include "KX_ClientObjectInfo.h"
+#include "KX_GameObject.h"
 
 KX_RayCast::KX_RayCast(PHY_IPhysicsController *ignoreController, bool faceNormal, bool faceUV)
     : PHY_IRayCastFilterCallback(ignoreController, faceNormal, faceUV)
@@ -117,3 +125,236 @@ bool KX_RayCast::RayTest(PHY_IPhysicsEnvironment *physics_environment,
   }
   return false;
 }
+
+/// Filter of the batch rays, only reads the objects as it is called by several threads.
+class KX_RayCastBatchFilter : public PHY_IRayCastFilterCallback {
+ public:
+  KX_RayCastBatchFilter(PHY_IPhysicsController *ignoreController)
+      : PHY_IRayCastFilterCallback(ignoreController)
+  {
+  }
+
+  /* All the objects are tested, like rayCast without x-ray the collision mask is only checked on
+   * the front object. */
+  virtual bool needBroadphaseRayCast(PHY_IPhysicsController *controller)
+  {
+    KX_ClientObjectInfo *info = static_cast<KX_ClientObjectInfo *>(controller->GetNewClientInfo());
+    return (info && info->m_gameobject);
+  }
+
+  virtual void reportHit(PHY_RayCastResult *result)
+  {
+  }
+};
+
+void KX_RayCast::RayTestBatch(PHY_IPhysicsEnvironment *physics_environment,
+                              PHY_IPhysicsController *ignoreController,
+                              unsigned int mask,
+                              const float *from,
+                              const float *to,
+                              unsigned int count,
+                              KX_GameObject **hitObjects,
+                              float *hitPoints,
+                              float *hitNormals)
+{
+  std::vector<PHY_IPhysicsController *> hitControllers(count);
+  KX_RayCastBatchFilter filter(ignoreController);
+  physics_environment->RayTestBatch(
+      filter, from, to, count, hitControllers.data(), hitPoints, hitNormals);
+
+  const bool allGroups = (mask == ((1u << OB_MAX_COL_MASKS) - 1));
+  for (unsigned int i = 0; i < count; ++i) {
+    KX_ClientObjectInfo *info = hitControllers[i] ? static_cast<KX_ClientObjectInfo *>(
+                                                        hitControllers[i]->GetNewClientInfo()) :
+                                                    nullptr;
+    KX_GameObject *gameobj = info ? info->m_gameobject : nullptr;
+    // The ray stopped on an object out of the collision mask, it is a miss.
+    if (gameobj && !allGroups && !(gameobj->GetCollisionGroup() & mask)) {
+      gameobj = nullptr;
+      std::fill_n(&hitPoints[i * 3], 3, 0.0f);
+      std::fill_n(&hitNormals[i * 3], 3, 0.0f);
+    }
+    hitObjects[i] = gameobj;
+  }
+}
+
+#ifdef WITH_PYTHON
+
+/// Copy a C contiguous buffer of float or double triplets.
+static bool ray_batch_points(PyObject *value, const char *name, std::vector<float> &points)
+{
+  Py_buffer view;
+  if (PyObject_GetBuffer(value, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1) {
+    PyErr_Format(PyExc_TypeError,
+                 "rayCastBatch(origins, targets, mask): %s must be a contiguous float array",
+                 name);
+    return false;
+  }
+
+  const char *format = view.format ? view.format : "B";
+  if (*format == '@' || *format == '=') {
+    ++format;
+  }
+  const bool isFloat = STREQ(format, "f");
+  const bool isDouble = STREQ(format, "d");
+  const Py_ssize_t size = view.len / view.itemsize;
+
+  if ((!isFloat && !isDouble) || (size % 3) != 0) {
+    PyErr_Format(PyExc_ValueError,
+                 "rayCastBatch(origins, targets, mask): %s must be an array of float or double "
+                 "triplets",
+                 name);
+    PyBuffer_Release(&view);
+    return false;
+  }
+
+  points.resize(size);
+  if (isFloat) {
+    const float *data = static_cast<const float *>(view.buf);
+    std::copy(data, data + size, points.begin());
+  }
+  else {
+    const double *data = static_cast<const double *>(view.buf);
+    std::copy(data, data + size, points.begin());
+  }
+
+  PyBuffer_Release(&view);
+  return true;
+}
+
+/// Return a writable memoryview of a copy of data, shaped (size, width) if width > 1.
+static PyObject *ray_batch_view(const void *data,
+                                unsigned int size,
+                                unsigned int width,
+                                unsigned int itemsize,
+                                const char *format)
+{
+  PyObject *bytes = PyByteArray_FromStringAndSize(static_cast<const char *>(data),
+                                                  size * width * itemsize);
+  if (!bytes) {
+    return nullptr;
+  }
+
+  PyObject *view = PyMemoryView_FromObject(bytes);
+  Py_DECREF(bytes);
+  if (!view) {
+    return nullptr;
+  }
+
+  // A memoryview can't be cast to a shape containing zero.
+  PyObject *result = (width == 1 || size == 0) ?
+                         PyObject_CallMethod(view, "cast", "s", format) :
+                         PyObject_CallMethod(view, "cast", "s(II)", format, size, width);
+  Py_DECREF(view);
+
+  return result;
+}
+
+PyObject *KX_RayCast::PyRayTestBatch(PHY_IPhysicsEnvironment *physics_environment,
+                                     PHY_IPhysicsController *ignoreController,
+                                     PyObject *args,
+                                     PyObject *kwds)
+{
+  PyObject *pyorigins;
+  PyObject *pytargets;
+  int mask = (1 << OB_MAX_COL_MASKS) - 1;
+
+  static const char *kwlist[] = {"origins", "targets", "mask", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "OO|i:rayCastBatch",
+                                   const_cast<char **>(kwlist),
+                                   &pyorigins,
+                                   &pytargets,
+                                   &mask)) {
+    return nullptr;
+  }
+
+  if (mask == 0 || mask & ~((1 << OB_MAX_COL_MASKS) - 1)) {
+    PyErr_Format(PyExc_TypeError,
+                 "rayCastBatch(origins, targets, mask): mask argument must be a int bitfield, "
+                 "0 < mask < %i",
+                 (1 << OB_MAX_COL_MASKS));
+    return nullptr;
+  }
+
+  std::vector<float> origins;
+  std::vector<float> targets;
+  if (!ray_batch_points(pyorigins, "origins", origins) ||
+      !ray_batch_points(pytargets, "targets", targets)) {
+    return nullptr;
+  }
+
+  // A single origin is shared by all the rays.
+  if (origins.size() == 3 && targets.size() > 3) {
+    origins.resize(targets.size());
+    for (unsigned int i = 3, size = origins.size(); i < size; ++i) {
+      origins[i] = origins[i % 3];
+    }
+  }
+
+  if (origins.size() != targets.size()) {
+    PyErr_SetString(PyExc_ValueError,
+                    "rayCastBatch(origins, targets, mask): origins and targets must have the "
+                    "same length or origins must contain a single point");
+    return nullptr;
+  }
+
+  const unsigned int count = targets.size() / 3;
+  std::vector<KX_GameObject *> hitObjects(count, nullptr);
+  std::vector<float> hitPoints(count * 3, 0.0f);
+  std::vector<float> hitNormals(count * 3, 0.0f);
+
+  if (physics_environment && count > 0) {
+    RayTestBatch(physics_environment,
+                 ignoreController,
+                 mask,
+                 origins.data(),
+                 targets.data(),
+                 count,
+                 hitObjects.data(),
+                 hitPoints.data(),
+                 hitNormals.data());
+  }
+
+  // The objects are returned once, each ray stores the index of its object or -1.
+  std::vector<int> indices(count);
+  std::unordered_map<KX_GameObject *, int> objectIndices;
+  PyObject *objects = PyList_New(0);
+  for (unsigned int i = 0; i < count; ++i) {
+    KX_GameObject *gameobj = hitObjects[i];
+    if (!gameobj) {
+      indices[i] = -1;
+      continue;
+    }
+
+    const auto it = objectIndices.emplace(gameobj, objectIndices.size());
+    if (it.second) {
+      PyObject *proxy = gameobj->GetProxy();
+      PyList_Append(objects, proxy);
+      Py_DECREF(proxy);
+    }
+    indices[i] = it.first->second;
+  }
+
+  PyObject *pyindices = ray_batch_view(indices.data(), count, 1, sizeof(int), "i");
+  PyObject *pypoints = ray_batch_view(hitPoints.data(), count, 3, sizeof(float), "f");
+  PyObject *pynormals = ray_batch_view(hitNormals.data(), count, 3, sizeof(float), "f");
+  if (!pyindices || !pypoints || !pynormals) {
+    Py_DECREF(objects);
+    Py_XDECREF(pyindices);
+    Py_XDECREF(pypoints);
+    Py_XDECREF(pynormals);
+    return nullptr;
+  }
+
+  PyObject *ret = PyTuple_New(4);
+  PyTuple_SET_ITEM(ret, 0, objects);
+  PyTuple_SET_ITEM(ret, 1, pyindices);
+  PyTuple_SET_ITEM(ret, 2, pypoints);
+  PyTuple_SET_ITEM(ret, 3, pynormals);
+
+  return ret;
+}
+
+#endif  // WITH_PYTHON
@@ -33,12 +33,15 @@
 
 #include "BLI_utildefines.h"
 
+#include "EXP_Python.h"
+
 #include "MT_Vector2.h"
 #include "MT_Vector3.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IPhysicsEnvironment.h"
 
 class RAS_MeshObject;
+class KX_GameObject;
 struct KX_ClientObjectInfo;
 
 /**
@@ -97,6 +100,30 @@ class KX_RayCast : public PHY_IRayCastFilterCallback {
                       const MT_Vector3 &frompoint,
                       const MT_Vector3 &topoint,
                       KX_RayCast &callback);
+
+  /**
+   * Cast count rays in parallel and write for each ray the closest object, the hit point and the
+   * hit normal. Like rayCast without x-ray the closest object is dropped (nullptr, zero point
+   * and normal) if it doesn't match the collision mask.
+   * Unlike RayTest no callback is called, the rays can't be filtered by property.
+   */
+  static void RayTestBatch(PHY_IPhysicsEnvironment *physics_environment,
+                           PHY_IPhysicsController *ignoreController,
+                           unsigned int mask,
+                           const float *from,
+                           const float *to,
+                           unsigned int count,
+                           KX_GameObject **hitObjects,
+                           float *hitPoints,
+                           float *hitNormals);
+
+#ifdef WITH_PYTHON
+  /// Parse the arguments of rayCastBatch(origins, targets, mask) and return its result tuple.
+  static PyObject *PyRayTestBatch(PHY_IPhysicsEnvironment *physics_environment,
+                                  PHY_IPhysicsController *ignoreController,
+                                  PyObject *args,
+                                  PyObject *kwds);
+#endif  // WITH_PYTHON
 };
 
 template<class T, class dataT> class KX_RayCast::Callback : public KX_RayCast {
@@ -36,6 +36,10 @@
 
 #include "KX_Scene.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <unordered_map>
+
 #include "BKE_layer.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_mball.hh"
@@ -46,6 +50,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_task.h"
+#include "BLI_time.h"
 #include "DEG_depsgraph_query.hh"
 #include "DNA_camera_types.h"
 #include "DNA_collection_types.h"
@@ -66,6 +71,7 @@
 #include "BL_DataConversion.h"
 #include "BL_SceneConverter.h"
 #include "CM_List.h"
+#include "CM_Profiler.h"
 #include "EXP_FloatValue.h"
 #include "KX_2DFilterManager.h"
 #include "KX_BlenderCanvas.h"
@@ -74,12 +80,18 @@
 #include "KX_FontObject.h"
 #include "KX_Globals.h"
 #include "KX_Light.h"
+#include "KX_NavMeshObject.h"
+#include "KX_LodLevel.h"
 #include "KX_LodManager.h"
 #include "KX_MotionState.h"
 #include "KX_NetworkMessageScene.h"
 #include "KX_NodeRelationships.h"
+#include "KX_ObjectPool.h"
 #include "KX_ObstacleSimulation.h"
 #include "KX_PyMath.h"
+#include "KX_RayCast.h"
+#include "KX_TransformStore.h"
+#include "PHY_IGraphicController.h"
 #include "PHY_IPhysicsController.h"
 #include "PHY_IPhysicsEnvironment.h"
 #include "RAS_BucketManager.h"
@@ -98,6 +110,10 @@
 #  include "bpy_rna.hh"
 #endif
 
+/// Names of the life time property of the added objects and of the timer sub property.
+static const EXP_PropertyName timebombPropName("::timebomb");
+static const EXP_PropertyName timerPropName("timer");
+
 static void *KX_SceneReplicationFunc(SG_Node *node, void *gameobj, void *scene)
 {
   KX_GameObject *replica =
@@ -118,7 +134,15 @@ static void *KX_SceneDestructionFunc(SG_Node *node, void *gameobj, void *scene)
 
 bool KX_Scene::KX_ScenegraphUpdateFunc(SG_Node *node, void *gameobj, void *scene)
 {
-  return node->Schedule(((KX_Scene *)scene)->m_sghead);
+  KX_Scene *kxscene = (KX_Scene *)scene;
+  // The lists of the trees are owned by their task, the node is updated after them.
+  if (kxscene->m_isParallelSceneGraphUpdate) {
+    kxscene->m_deferredScheduledNodesLock.Lock();
+    const bool scheduled = CM_ListAddIfNotFound(kxscene->m_deferredScheduledNodes, node);
+    kxscene->m_deferredScheduledNodesLock.Unlock();
+    return scheduled;
+  }
+  return node->Schedule(kxscene->m_sghead);
 }
 
 bool KX_Scene::KX_ScenegraphRescheduleFunc(SG_Node *node, void *gameobj, void *scene)
@@ -126,11 +150,19 @@ bool KX_Scene::KX_ScenegraphRescheduleFunc(SG_Node *node, void *gameobj, void *s
   return node->Reschedule(((KX_Scene *)scene)->m_sghead);
 }
 
+void KX_Scene::KX_ScenegraphDirtyRenderFunc(SG_Node *node, void *gameobj, void *scene)
+{
+  if (gameobj) {
+    ((KX_Scene *)scene)->AddDirtyObject((KX_GameObject *)gameobj);
+  }
+}
+
 SG_Callbacks KX_Scene::m_callbacks = SG_Callbacks(KX_SceneReplicationFunc,
                                                   KX_SceneDestructionFunc,
                                                   KX_GameObject::UpdateTransformFunc,
                                                   KX_Scene::KX_ScenegraphUpdateFunc,
-                                                  KX_Scene::KX_ScenegraphRescheduleFunc);
+                                                  KX_Scene::KX_ScenegraphRescheduleFunc,
+                                                  KX_Scene::KX_ScenegraphDirtyRenderFunc);
 
 KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
                    const std::string &sceneName,
@@ -155,12 +187,20 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
       m_blenderScene(scene),
       m_isActivedHysteresis(false),
       m_lodHysteresisValue(0),
+      m_lodScreenSize(false),
+      m_lodMaxSwaps(0),
       m_isRuntime(true)  // eevee
 {
 
   m_dbvt_culling = false;
   m_dbvt_occlusion_res = 0;
   m_activityCulling = false;
+  m_activityCullingTravel = 0.0;
+  m_activityCullingGeneration = 0;
+  m_parallelSceneGraph = (scene->gm.flag & GAME_USE_PARALLEL_SCENEGRAPH) != 0;
+  m_isParallelSceneGraphUpdate = false;
+  m_parallelAnimations = (scene->gm.flag & GAME_USE_PARALLEL_ANIMATION) != 0;
+  m_isParallelAnimationUpdate = false;
   m_objectlist = new EXP_ListValue<KX_GameObject>();
   m_parentlist = new EXP_ListValue<KX_GameObject>();
   m_lightlist = new EXP_ListValue<KX_LightObject>();
@@ -207,6 +247,9 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
       m_obstacleSimulation = nullptr;
   }
 
+  m_objectPool = new KX_ObjectPool(this);
+  m_transformStore = nullptr;
+
   m_animationPool = BLI_task_pool_create(&m_animationPoolData, TASK_PRIORITY_LOW);
 
 #ifdef WITH_PYTHON
@@ -377,6 +420,13 @@ KX_Scene::~KX_Scene()
   if (m_obstacleSimulation)
     delete m_obstacleSimulation;
 
+  // The removed replicas gave their Blender objects back to the pool.
+  delete m_objectPool;
+
+  if (m_transformStore) {
+    m_transformStore->Release();
+  }
+
   if (m_animationPool) {
     BLI_task_pool_free(m_animationPool);
   }
@@ -693,6 +743,8 @@ void KX_Scene::UpdateDepsgraph(Main *bmain,
                                bool is_last_render_pass,
                                KX_Camera *cam)
 {
+  CM_PROFILE_ZONE("UpdateDepsgraph");
+
   if (m_collectionRemap) {
     /* check 68589a31ebfb79165f99a979357d237e5413e904 for potential issue or improvement? */
     /* If problem with ReplicateBlenderObject, see other occurences of
@@ -701,13 +753,25 @@ void KX_Scene::UpdateDepsgraph(Main *bmain,
     m_collectionRemap = false;
   }
 
+  /* Blender physics simulations must be checked on all objects at each pass. */
+  const bool useBlenderPhysics = scene->gm.flag &
+                                 (GAME_USE_INTERACTIVE_DYNAPAINT | GAME_USE_INTERACTIVE_RIGIDBODY);
+
   /* Notify the depsgraph if object transform changed in the scene
-   * for next drawing loop. */
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    /* Update compatibles blender physics simulations */
-    Object *ob = gameobj->GetBlenderObject();
-    TagBlenderPhysicsObject(scene, ob);
-    gameobj->TagForTransformUpdate(is_overlay_pass, is_last_render_pass);
+   * for next drawing loop. Only the objects of the dirty list
+   * (moved since the last render) are processed. */
+  if (useBlenderPhysics) {
+    for (KX_GameObject *gameobj : GetObjectList()) {
+      /* Update compatibles blender physics simulations */
+      Object *ob = gameobj->GetBlenderObject();
+      TagBlenderPhysicsObject(scene, ob);
+      gameobj->TagForTransformUpdate(is_overlay_pass, is_last_render_pass);
+    }
+  }
+  else {
+    for (KX_GameObject *gameobj : m_dirtyObjects) {
+      gameobj->TagForTransformUpdate(is_overlay_pass, is_last_render_pass);
+    }
   }
 
   /* Notify depsgraph for other changes */
@@ -722,8 +786,20 @@ void KX_Scene::UpdateDepsgraph(Main *bmain,
   BKE_scene_graph_update_tagged(depsgraph, bmain);
 
   /* Update evaluated object object_to_world according to SceneGraph. */
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForTransformUpdateEvaluated();
+  if (useBlenderPhysics) {
+    for (KX_GameObject *gameobj : GetObjectList()) {
+      gameobj->TagForTransformUpdateEvaluated();
+    }
+  }
+  else {
+    for (KX_GameObject *gameobj : m_dirtyObjects) {
+      gameobj->TagForTransformUpdateEvaluated();
+    }
+  }
+
+  /* Objects are kept in the dirty list for all the render passes of the frame. */
+  if (is_last_render_pass) {
+    ClearDirtyObjects();
   }
 }
 
@@ -796,6 +872,8 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam,
                                       bool is_overlay_pass,
                                       bool is_last_render_pass)
 {
+  CM_PROFILE_ZONE_DETAIL("RenderScene", cam->GetName().c_str());
+
   KX_KetsjiEngine *engine = KX_GetActiveEngine();
   RAS_Rasterizer *rasty = engine->GetRasterizer();
   RAS_ICanvas *canvas = engine->GetCanvas();
@@ -1341,8 +1419,34 @@ bool KX_Scene::SomethingIsMoving()
   return false;
 }
 
+void KX_Scene::AppendToForces(KX_GameObject *gameobj, const MT_Vector3 &vec, bool torque)
+{
+  // The physics world is shared by all the trees of the parallel scene graph update.
+  if (m_isParallelSceneGraphUpdate) {
+    m_deferredForcesLock.Lock();
+    m_deferredForces.emplace_back(gameobj, vec, torque);
+    m_deferredForcesLock.Unlock();
+    return;
+  }
+
+  if (torque) {
+    gameobj->ApplyTorque(vec, false);
+  }
+  else {
+    gameobj->ApplyForce(vec, false);
+  }
+}
+
 void KX_Scene::AppendToIdsToUpdate(ID *id, IDRecalcFlag flag, bool in_overlay_collection_only)
 {
+  // Called from the animation pool or the scene graph update, see UpdateAnimationsParallel.
+  if (m_isParallelAnimationUpdate || m_isParallelSceneGraphUpdate) {
+    m_deferredIdsToUpdateLock.Lock();
+    m_deferredIdsToUpdate.emplace_back(id, flag, in_overlay_collection_only);
+    m_deferredIdsToUpdateLock.Unlock();
+    return;
+  }
+
   std::pair<ID *, IDRecalcFlag> it = {id, flag};
   if (in_overlay_collection_only) {
     if (std::find(m_idsToUpdateInOverlayPass.begin(), m_idsToUpdateInOverlayPass.end(), it) ==
@@ -1410,6 +1514,42 @@ void KX_Scene::TagBlenderPhysicsObject(Scene *scene, Object *ob)
   }
 }
 
+void KX_Scene::AddDirtyObject(KX_GameObject *gameobj)
+{
+  m_dirtyObjectsLock.Lock();
+  if (gameobj->GetDirtyListState() == KX_GameObject::DIRTY_LIST_NONE) {
+    gameobj->SetDirtyListState(KX_GameObject::DIRTY_LIST_ADDED);
+    m_dirtyObjects.push_back(gameobj);
+  }
+  m_dirtyObjectsLock.Unlock();
+}
+
+void KX_Scene::ActivateDirtyObject(KX_GameObject *gameobj)
+{
+  gameobj->SetDirtyListState(KX_GameObject::DIRTY_LIST_NONE);
+  // The object is synchronized at least once.
+  AddDirtyObject(gameobj);
+}
+
+void KX_Scene::ClearDirtyObjects()
+{
+  unsigned int count = 0;
+  for (KX_GameObject *gameobj : m_dirtyObjects) {
+    Object *ob = gameobj->GetBlenderObject();
+    /* Objects driven by the depsgraph and objects with an original object which can't follow the
+     * scene graph need a synchronization at each render pass, even when static. */
+    if (ob && ((ob->transflag & OB_TRANSFLAG_OVERRIDE_GAME_PRIORITY) ||
+               !OrigObCanBeTransformedInRealtime(ob)))
+    {
+      m_dirtyObjects[count++] = gameobj;
+    }
+    else {
+      gameobj->SetDirtyListState(KX_GameObject::DIRTY_LIST_NONE);
+    }
+  }
+  m_dirtyObjects.resize(count);
+}
+
 KX_GameObject *KX_Scene::AddDuplicaObject(KX_GameObject *gameobj,
                                           KX_GameObject *reference,
                                           float lifespan)
@@ -1454,7 +1594,7 @@ KX_GameObject *KX_Scene::AddDuplicaObject(KX_GameObject *gameobj,
         // have 50 frames per second if you change this value, make sure you change it in
         // KX_GameObject::pyattr_get_life property too
         EXP_Value *fval = new EXP_FloatValue(lifespan * 0.02f);
-        replica->SetProperty("::timebomb", fval);
+        replica->SetProperty(timebombPropName, fval);
         fval->Release();
       }
 
@@ -1623,7 +1763,7 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
   for (int i = 0; i < numprops; i++) {
     EXP_Value *prop = newobj->GetProperty(i);
 
-    if (prop->GetProperty("timer"))
+    if (prop->GetProperty(timerPropName))
       this->m_timemgr->AddTimeProperty(prop);
   }
 
@@ -1663,6 +1803,10 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
 
   // this is the list of object that are send to the graphics pipeline
   m_objectlist->Add(CM_AddRef(newobj));
+  ActivateDirtyObject(newobj);
+  if (m_transformStore) {
+    m_transformStore->Register(newobj);
+  }
   switch (newobj->GetGameObjectType()) {
     case SCA_IObject::OBJ_LIGHT: {
       m_lightlist->Add(CM_AddRef(static_cast<KX_LightObject *>(newobj)));
@@ -1716,6 +1860,14 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
       newctrl->SuspendDynamics();
   }
 
+  // replicate graphic controller, activated once the replica is placed
+  if (gameobj->GetGraphicController()) {
+    PHY_IMotionState *motionstate = new KX_MotionState(newobj->GetSGNode());
+    PHY_IGraphicController *newctrl = gameobj->GetGraphicController()->GetReplica(motionstate);
+    newctrl->SetNewClientInfo(newobj->getClientInfo());
+    newobj->SetGraphicController(newctrl);
+  }
+
   return newobj;
 }
 
@@ -1930,6 +2082,8 @@ void KX_Scene::DupliGroupRecurse(KX_GameObject *groupobj, int level)
     replica->NodeSetLocalOrientation(newori);
     // update scenegraph for entire tree of children
     replica->GetSGNode()->UpdateWorldData(0);
+    // we can now add the graphic controller to the physic engine
+    replica->ActivateGraphicController(true, true);
 
     remap_parents_recursive(replica);
 
@@ -2016,7 +2170,7 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
     // 60 frames per second if you change this value, make sure you change it in
     // KX_GameObject::pyattr_get_life property too
     EXP_Value *fval = new EXP_FloatValue(lifespan * 0.016666667f);
-    replica->SetProperty("::timebomb", fval);
+    replica->SetProperty(timebombPropName, fval);
     fval->Release();
   }
 
@@ -2050,6 +2204,8 @@ KX_GameObject *KX_Scene::AddReplicaObject(KX_GameObject *originalobject,
   }
 
   replica->GetSGNode()->UpdateWorldData(0);
+  // we can now add the graphic controller to the physic engine
+  replica->ActivateGraphicController(true, true);
 
   // now replicate logic
   for (KX_GameObject *gameobj : m_logicHierarchicalGameObjects) {
@@ -2175,7 +2331,7 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 
   for (int i = 0; i < numprops; i++) {
     EXP_Value *propval = gameobj->GetProperty(i);
-    if (propval->GetProperty("timer")) {
+    if (propval->GetProperty(timerPropName)) {
       m_timemgr->RemoveTimeProperty(propval);
     }
   }
@@ -2197,8 +2353,21 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
     m_obstacleSimulation->DestroyObstacleForObj(gameobj);
   }
 
+  CM_ListRemoveIfFound(m_tiledNavMeshes, gameobj);
+  for (KX_NavMeshObject *navmesh : m_tiledNavMeshes) {
+    navmesh->RemoveBlocker(gameobj);
+  }
+
   m_proxyManager.Unregister(gameobj);
 
+  if (gameobj->GetDirtyListState() == KX_GameObject::DIRTY_LIST_ADDED) {
+    CM_ListRemoveIfFound(m_dirtyObjects, gameobj);
+  }
+
+  if (m_transformStore) {
+    m_transformStore->Unregister(gameobj);
+  }
+
   gameobj->RemoveMeshes();
 
   bool ret = true;
@@ -2316,6 +2485,63 @@ void KX_Scene::PhysicsCullingCallback(KX_ClientObjectInfo *objectInfo, void *cul
     // ideally, invisible objects should be removed from the culling tree temporarily
     return;
   }
+
+  // This object was not culled by the tree.
+  gameobj->GetCullingNode().SetCulled(false);
+}
+
+void KX_Scene::CalculateVisibleMeshes(KX_Camera *cam, const RAS_Rect &viewport)
+{
+  if (!m_dbvt_culling) {
+    return;
+  }
+
+  CM_PROFILE_ZONE("Culling");
+
+  // Cull all the objects by default, the culling test uncull the visible ones.
+  for (KX_GameObject *gameobj : m_objectlist) {
+    const bool useCulling = gameobj->UseCulling();
+    gameobj->GetCullingNode().SetCulled(useCulling);
+
+    // Deformed objects can go out of their rest bounding box.
+    Object *ob = gameobj->GetBlenderObject();
+    if (useCulling && ob && ob->modifiers.first) {
+      gameobj->UpdateBounds();
+    }
+  }
+
+  const SG_Frustum &frustum = cam->GetFrustum();
+  const int area[4] = {
+      viewport.GetLeft(), viewport.GetBottom(), viewport.GetWidth() + 1, viewport.GetHeight() + 1};
+  const bool dbvt = m_physicsEnvironment->CullingTest(PhysicsCullingCallback,
+                                                      nullptr,
+                                                      frustum.GetPlanes(),
+                                                      m_dbvt_occlusion_res,
+                                                      area,
+                                                      frustum.GetMatrix());
+
+  for (KX_GameObject *gameobj : m_objectlist) {
+    SG_CullingNode &node = gameobj->GetCullingNode();
+    Object *ob = gameobj->GetBlenderObject();
+    // Without culling tree test the bounding box of the objects against the frustum.
+    if (!dbvt && node.GetCulled() && gameobj->GetVisible()) {
+      const SG_BBox &aabb = node.GetAabb();
+      node.SetCulled(frustum.AabbInsideFrustum(aabb.GetMin(),
+                                               aabb.GetMax(),
+                                               gameobj->NodeGetWorldTransform().toMatrix()) ==
+                     SG_Frustum::OUTSIDE);
+    }
+
+    // Tell the game render loop to skip the culled objects.
+    if (ob) {
+      if (node.GetCulled()) {
+        ob->gameflag |= OB_CULLED;
+      }
+      else {
+        ob->gameflag &= ~OB_CULLED;
+      }
+    }
+  }
 }
 
 void KX_Scene::RenderDebugProperties(RAS_DebugDraw &debugDraw,
@@ -2372,9 +2598,16 @@ void KX_Scene::RenderDebugProperties(RAS_DebugDraw &debugDraw,
 // logic stuff
 void KX_Scene::LogicBeginFrame(double curtime, double framestep)
 {
+  CM_PROFILE_ZONE("LogicBeginFrame");
+
+  // Give the current transforms to the scripts.
+  if (m_transformStore) {
+    m_transformStore->Gather();
+  }
+
   // have a look at temp objects ...
   for (KX_GameObject *gameobj : m_tempObjectList) {
-    EXP_FloatValue *propval = (EXP_FloatValue *)gameobj->GetProperty("::timebomb");
+    EXP_FloatValue *propval = (EXP_FloatValue *)gameobj->GetProperty(timebombPropName);
 
     if (propval) {
       const float timeleft = propval->GetNumber() - framestep;
@@ -2395,84 +2628,138 @@ void KX_Scene::LogicBeginFrame(double curtime, double framestep)
   m_logicmgr->BeginFrame(curtime, framestep);
 }
 
+KX_TransformStore *KX_Scene::GetTransformStore()
+{
+  if (!m_transformStore) {
+    m_transformStore = new KX_TransformStore();
+    for (KX_GameObject *gameobj : m_objectlist) {
+      m_transformStore->Register(gameobj);
+    }
+  }
+
+  return m_transformStore;
+}
+
 void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
 {
   CM_ListAddIfNotFound(m_animatedlist, gameobj);
 }
 
-// static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
-//{
-//  KX_GameObject *gameobj, *parent;
-//  bool needs_update;
-//  KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData
-//  *)BLI_task_pool_user_data(pool); double curtime = data->curtime;
-
-//  gameobj = (KX_GameObject *)taskdata;
-
-//  // Non-armature updates are fast enough, so just update them
-//  needs_update = gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE;
-
-//  if (!needs_update) {
-//    // If we got here, we're looking to update an armature, so check its children meshes
-//    // to see if we need to bother with a more expensive pose update
-//    const std::vector<KX_GameObject *> children = gameobj->GetChildren();
-
-//    bool has_mesh = false, has_non_mesh = false;
-
-//    // Check for meshes that haven't been culled
-//    for (KX_GameObject *child : children) {
-//      // if (!child->GetCulled()) { // eevee disable armature animation culling
-//      needs_update = true;
-//      break;
-//      //}
+/** Return true if the actions of an object must be applied to it, a culled armature only
+ * manages the time and end of its actions. */
+static bool animation_needs_update(KX_GameObject *gameobj)
+{
+  // Non-armature updates are fast enough, so just update them
+  if (gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE) {
+    return true;
+  }
 
-//      if (child->GetMeshCount() == 0)
-//        has_non_mesh = true;
-//      else
-//        has_mesh = true;
-//    }
+  // If we got here, we're looking to update an armature, so check its children meshes
+  // to see if we need to bother with a more expensive pose update
+  bool has_mesh = false;
+  for (KX_GameObject *child : gameobj->GetChildren()) {
+    if (child->GetMeshCount() == 0) {
+      continue;
+    }
+    has_mesh = true;
+    // Check for meshes that haven't been culled
+    if (child->GetVisible() && !child->GetCullingNode().GetCulled()) {
+      return true;
+    }
+  }
 
-//    // If we didn't find a non-culled mesh, check to see
-//    // if we even have any meshes, and update if this
-//    // armature has only non-mesh children.
-//    if (!needs_update && !has_mesh && has_non_mesh)
-//      needs_update = true;
-//  }
+  // If we didn't find a non-culled mesh, update only if this armature has no mesh children,
+  // its pose could deform a mesh which is not its child or be used by other objects.
+  return !has_mesh;
+}
 
-//  // If the object is a culled armature, then we manage only the animation time and end of its
-//  // animations.
-//  gameobj->UpdateActionManager(curtime, needs_update);
+static void update_anim_thread_func(TaskPool *__restrict pool, void *taskdata)
+{
+  KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_user_data(
+      pool);
+  KX_GameObject *gameobj = (KX_GameObject *)taskdata;
 
-//  if (needs_update) {
-//    const std::vector<KX_GameObject *> children = gameobj->GetChildren();
-//    parent = gameobj->GetParent();
-//  }
-//}
+  // If the object is a culled armature, then we manage only the animation time and end of its
+  // animations.
+  gameobj->UpdateActions(data->curtime, animation_needs_update(gameobj));
+}
 
 void KX_Scene::UpdateAnimations(double curtime)
 {
-  // m_animationPoolData.curtime = curtime;
+  CM_PROFILE_ZONE("UpdateAnimations");
+
+  if (m_parallelAnimations) {
+    UpdateAnimationsParallel(curtime);
+    return;
+  }
 
   for (KX_GameObject *gameobj : m_animatedlist) {
-    // BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false,
-    // TASK_PRIORITY_LOW);
     if (!gameobj->IsActionsSuspended()) {
+      gameobj->UpdateActionManager(curtime, animation_needs_update(gameobj));
+    }
+  }
+}
+
+void KX_Scene::UpdateAnimationsParallel(double curtime)
+{
+  /* Only the armature actions are evaluated in the pool, they write to the pose of their own
+   * object. The other actions can write to shared data (node trees, shape keys) and are updated
+   * serially. */
+  for (KX_GameObject *gameobj : m_animatedlist) {
+    if (gameobj->IsActionsSuspended()) {
+      continue;
+    }
+    if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+      m_parallelAnimatedObjects.push_back(gameobj);
+    }
+    else {
       gameobj->UpdateActionManager(curtime, true);
     }
   }
 
-  // BLI_task_pool_work_and_wait(m_animationPool);
+  if (m_parallelAnimatedObjects.empty()) {
+    return;
+  }
+
+  m_animationPoolData.curtime = curtime;
+  m_isParallelAnimationUpdate = true;
+
+  for (KX_GameObject *gameobj : m_parallelAnimatedObjects) {
+    BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false, nullptr);
+  }
+  BLI_task_pool_work_and_wait(m_animationPool);
+
+  m_isParallelAnimationUpdate = false;
+
+  // Merge the ids tagged by the actions.
+  for (const std::tuple<ID *, IDRecalcFlag, bool> &item : m_deferredIdsToUpdate) {
+    AppendToIdsToUpdate(std::get<0>(item), std::get<1>(item), std::get<2>(item));
+  }
+  m_deferredIdsToUpdate.clear();
+
+  // The scene graph isn't thread safe, apply the transform actions now.
+  for (KX_GameObject *gameobj : m_parallelAnimatedObjects) {
+    gameobj->UpdateActionIPOs();
+  }
+  m_parallelAnimatedObjects.clear();
 }
 
 void KX_Scene::LogicUpdateFrame(double curtime)
 {
-  m_proxyManager.Update();
+  CM_PROFILE_ZONE("LogicUpdateFrame");
+
+  m_proxyManager.Update(curtime);
 
   m_logicmgr->UpdateFrame(curtime);
 }
 
 void KX_Scene::LogicEndFrame()
 {
+  // Apply the transforms modified by the scripts.
+  if (m_transformStore) {
+    m_transformStore->Apply();
+  }
+
   m_logicmgr->EndFrame();
 
   /* Don't remove the objects from the euthanasy list here as the child objects of a deleted
@@ -2485,9 +2772,17 @@ void KX_Scene::LogicEndFrame()
     RemoveObject(m_euthanasyobjects.front());
   }
 
+  // Rebuild the navigation mesh tiles under the moved blockers before the obstacles use them.
+  for (KX_NavMeshObject *navmesh : m_tiledNavMeshes) {
+    navmesh->UpdateTiles();
+  }
+
   // prepare obstacle simulation for new frame
-  if (m_obstacleSimulation)
+  if (m_obstacleSimulation) {
     m_obstacleSimulation->UpdateObstacles();
+    // Steer the agents of the steering actuators run this frame, before the physics.
+    m_obstacleSimulation->Simulate();
+  }
 
   for (KX_FontObject *font : m_fontlist) {
     font->UpdateTextFromProperty();
@@ -2497,14 +2792,108 @@ void KX_Scene::LogicEndFrame()
 /**
  * UpdateParents: SceneGraph transformation update.
  */
-void KX_Scene::UpdateParents(double curtime)
+struct SceneGraphUpdateData {
+  std::deque<SG_DList> *groups;
+  std::vector<std::vector<SG_Node *>> *updatedNodes;
+  double curtime;
+};
+
+static void update_scenegraph_group_func(void *__restrict userdata,
+                                         const int iter,
+                                         const TaskParallelTLS *__restrict /*tls*/)
 {
-  // we use the SG dynamic list
+  SceneGraphUpdateData *data = static_cast<SceneGraphUpdateData *>(userdata);
+  SG_DList &head = (*data->groups)[iter];
+  std::vector<SG_Node *> &updatedNodes = (*data->updatedNodes)[iter];
+
+  /* Same order as the serial update, the children updated with their
+   * parent are unlinked from the list of the group. */
+  SG_DList *item;
+  while ((item = head.Remove()) != nullptr) {
+    static_cast<SG_Node *>(item)->UpdateWorldDataParallel(data->curtime, updatedNodes);
+  }
+}
+
+void KX_Scene::UpdateParentsParallel(double curtime)
+{
+  /* A node update only reads its ancestors and writes its descendants,
+   * the scheduled nodes are grouped per root node to update each tree
+   * in its own task without locking the nodes. The updates touching the
+   * rest of the scene (physics and culling transforms, depsgraph tags,
+   * scheduling of other nodes) are deferred after the tasks. */
+  std::unordered_map<const SG_Node *, unsigned int> groupIndices;
+  unsigned int numGroups = 0;
+
   SG_Node *node;
+  while ((node = SG_Node::GetNextScheduled(m_sghead)) != nullptr) {
+    const auto it = groupIndices.emplace(node->GetRootSGParent(), numGroups);
+    if (it.second) {
+      if (numGroups == m_sceneGraphGroups.size()) {
+        m_sceneGraphGroups.emplace_back();
+        m_sceneGraphUpdatedNodes.emplace_back();
+      }
+      ++numGroups;
+    }
+    m_sceneGraphGroups[it.first->second].AddBack(node);
+  }
+
+  if (numGroups == 0) {
+    return;
+  }
+
+  SceneGraphUpdateData data = {&m_sceneGraphGroups, &m_sceneGraphUpdatedNodes, curtime};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numGroups > 1);
+
+  m_isParallelSceneGraphUpdate = true;
+  BLI_task_parallel_range(0, numGroups, &data, update_scenegraph_group_func, &settings);
+  m_isParallelSceneGraphUpdate = false;
+
+  for (unsigned int i = 0; i < numGroups; ++i) {
+    for (SG_Node *updatedNode : m_sceneGraphUpdatedNodes[i]) {
+      updatedNode->ActivateUpdateTransformCallback();
+    }
+    m_sceneGraphUpdatedNodes[i].clear();
+  }
+
+  for (const std::tuple<ID *, IDRecalcFlag, bool> &item : m_deferredIdsToUpdate) {
+    AppendToIdsToUpdate(std::get<0>(item), std::get<1>(item), std::get<2>(item));
+  }
+  m_deferredIdsToUpdate.clear();
+
+  for (const std::tuple<KX_GameObject *, MT_Vector3, bool> &item : m_deferredForces) {
+    AppendToForces(std::get<0>(item), std::get<1>(item), std::get<2>(item));
+  }
+  m_deferredForces.clear();
+
+  // The nodes scheduled by other trees are updated now as the serial update would.
+  for (SG_Node *scheduledNode : m_deferredScheduledNodes) {
+    scheduledNode->Schedule(m_sghead);
+  }
+  m_deferredScheduledNodes.clear();
 
   while ((node = SG_Node::GetNextScheduled(m_sghead)) != nullptr) {
     node->UpdateWorldData(curtime);
   }
+}
+
+void KX_Scene::UpdateParents(double curtime)
+{
+  CM_PROFILE_ZONE("UpdateParents");
+
+  // we use the SG dynamic list
+  SG_Node *node;
+
+  if (m_parallelSceneGraph) {
+    UpdateParentsParallel(curtime);
+  }
+  else {
+    while ((node = SG_Node::GetNextScheduled(m_sghead)) != nullptr) {
+      node->UpdateWorldData(curtime);
+    }
+  }
 
   // the list must be empty here
   BLI_assert(m_sghead.Empty());
@@ -2519,13 +2908,121 @@ RAS_MaterialBucket *KX_Scene::FindBucket(class RAS_IPolyMaterial *polymat, bool
   return m_bucketmanager->FindBucket(polymat, bucketCreated);
 }
 
+/// Horizontal projection scale of a 50 mm lens on a 36 mm sensor, the zoom of the screen size lod.
+static const float lod_reference_projection = 2.0f * 50.0f / 36.0f;
+
+/** Compute the squared lod distances of the objects to the camera.
+ * The positions are packed per axis for the loops to be vectorized. For an orthographic camera
+ * the distance doesn't change the size on screen and only the scale is used.
+ */
+static void lod_distances(const std::vector<float> (&positions)[3],
+                          const std::vector<float> &scales,
+                          const MT_Vector3 &campos,
+                          bool orthographic,
+                          std::vector<float> &r_distances)
+{
+  const unsigned int size = positions[0].size();
+  const float *x = positions[0].data();
+  const float *y = positions[1].data();
+  const float *z = positions[2].data();
+  const float *scale = scales.data();
+
+  r_distances.resize(size);
+  float *dist = r_distances.data();
+
+  if (orthographic) {
+    std::copy(scale, scale + size, dist);
+    return;
+  }
+
+  const float cx = campos[0];
+  const float cy = campos[1];
+  const float cz = campos[2];
+  for (unsigned int i = 0; i < size; ++i) {
+    const float dx = x[i] - cx;
+    const float dy = y[i] - cy;
+    const float dz = z[i] - cz;
+    dist[i] = (dx * dx + dy * dy + dz * dz) * scale[i];
+  }
+}
+
 void KX_Scene::UpdateObjectLods(KX_Camera *cam)
 {
-  const MT_Vector3 &cam_pos = cam->NodeGetWorldPosition();
-  const float lodfactor = cam->GetLodDistanceFactor();
+  CM_PROFILE_ZONE("UpdateObjectLods");
+
+  float lodfactor = cam->GetLodDistanceFactor();
+  bool orthographic = false;
+  /* With the screen size metric the level distances are the ones of the object at its original
+   * scale seen through a 50 mm lens, the distances are scaled by the camera zoom and the object
+   * scale to switch at the same size on screen. */
+  if (m_lodScreenSize) {
+    const MT_Matrix4x4 &projmat = cam->GetProjectionMatrix();
+    const float projection = std::min(MT_abs(projmat[0][0]), MT_abs(projmat[1][1]));
+    lodfactor *= lod_reference_projection / std::max(projection, FLT_EPSILON);
+    orthographic = !cam->GetCameraData()->m_perspective;
+  }
+
+  // Gather the visible objects with lod.
+  m_lodObjects.clear();
+  for (std::vector<float> &positions : m_lodPositions) {
+    positions.clear();
+  }
+  m_lodScales.clear();
 
   for (KX_GameObject *gameobj : m_kxobWithLod) {
-    gameobj->UpdateLod(cam_pos, lodfactor);
+    // Culled objects are not rendered, their LOD is updated when they become visible again.
+    if (!gameobj->GetLodManager() || gameobj->GetCullingNode().GetCulled()) {
+      continue;
+    }
+
+    m_lodObjects.push_back(gameobj);
+    const MT_Vector3 &obpos = gameobj->NodeGetWorldPosition();
+    for (unsigned short axis = 0; axis < 3; ++axis) {
+      m_lodPositions[axis].push_back(obpos[axis]);
+    }
+
+    float scale = lodfactor;
+    if (m_lodScreenSize) {
+      const MT_Vector3 &obscale = gameobj->NodeGetWorldScaling();
+      scale /= std::max(MT_abs(obscale[obscale.closestAxis()]), MT_Scalar(FLT_EPSILON));
+    }
+    m_lodScales.push_back(scale * scale);
+  }
+
+  lod_distances(
+      m_lodPositions, m_lodScales, cam->NodeGetWorldPosition(), orthographic, m_lodDistances);
+
+  m_lodSwaps.clear();
+  for (unsigned int i = 0, size = m_lodObjects.size(); i < size; ++i) {
+    KX_GameObject *gameobj = m_lodObjects[i];
+    KX_LodLevel *lodLevel = gameobj->GetLodManager()->GetLevel(
+        this, gameobj->GetCurrentLodLevel(), m_lodDistances[i]);
+
+    if (lodLevel && lodLevel->GetLevel() != gameobj->GetCurrentLodLevel()) {
+      m_lodSwaps.emplace_back(m_lodDistances[i], gameobj, lodLevel);
+    }
+    else {
+      gameobj->UpdateLod(nullptr);
+    }
+  }
+
+  /* Limit the number of mesh replacements per render, after a camera cut the nearest objects
+   * change level first and the others in the next renders. */
+  unsigned int numSwaps = m_lodSwaps.size();
+  if (m_lodMaxSwaps > 0 && numSwaps > (unsigned int)m_lodMaxSwaps) {
+    numSwaps = m_lodMaxSwaps;
+    std::nth_element(m_lodSwaps.begin(),
+                     m_lodSwaps.begin() + numSwaps,
+                     m_lodSwaps.end(),
+                     [](const std::tuple<float, KX_GameObject *, KX_LodLevel *> &swap1,
+                        const std::tuple<float, KX_GameObject *, KX_LodLevel *> &swap2) {
+                       return std::get<0>(swap1) < std::get<0>(swap2);
+                     });
+  }
+
+  for (unsigned int i = 0, size = m_lodSwaps.size(); i < size; ++i) {
+    KX_GameObject *gameobj = std::get<1>(m_lodSwaps[i]);
+    gameobj->UpdateLod((i < numSwaps) ? std::get<2>(m_lodSwaps[i]) : nullptr);
   }
 }
 
@@ -2549,40 +3046,148 @@ int KX_Scene::GetLodHysteresisValue(void)
   return m_lodHysteresisValue;
 }
 
+void KX_Scene::SetLodScreenSize(bool screenSize)
+{
+  m_lodScreenSize = screenSize;
+}
+
+bool KX_Scene::GetLodScreenSize() const
+{
+  return m_lodScreenSize;
+}
+
+void KX_Scene::SetLodMaxSwaps(int maxSwaps)
+{
+  m_lodMaxSwaps = maxSwaps;
+}
+
+int KX_Scene::GetLodMaxSwaps() const
+{
+  return m_lodMaxSwaps;
+}
+
+void KX_Scene::AddTiledNavMesh(KX_NavMeshObject *navmesh)
+{
+  CM_ListAddIfNotFound(m_tiledNavMeshes, navmesh);
+}
+
+void KX_Scene::RemoveTiledNavMesh(KX_NavMeshObject *navmesh)
+{
+  CM_ListRemoveIfFound(m_tiledNavMeshes, navmesh);
+}
+
+/** Compute the minimum squared distance from the positions to the cameras.
+ * The positions are packed per axis for the loops to be vectorized. */
+static void activity_culling_distances(
+    const std::vector<float> (&positions)[3],
+    const std::vector<std::pair<KX_Camera *, MT_Vector3>> &cameras,
+    std::vector<float> &r_distances)
+{
+  const unsigned int size = positions[0].size();
+  const float *x = positions[0].data();
+  const float *y = positions[1].data();
+  const float *z = positions[2].data();
+
+  r_distances.assign(size, FLT_MAX);
+  float *dist = r_distances.data();
+
+  for (const std::pair<KX_Camera *, MT_Vector3> &cam : cameras) {
+    const float cx = cam.second[0];
+    const float cy = cam.second[1];
+    const float cz = cam.second[2];
+    for (unsigned int i = 0; i < size; ++i) {
+      const float dx = x[i] - cx;
+      const float dy = y[i] - cy;
+      const float dz = z[i] - cz;
+      // Keep the minimum distance.
+      dist[i] = std::min(dist[i], dx * dx + dy * dy + dz * dz);
+    }
+  }
+}
+
 void KX_Scene::UpdateObjectActivity(void)
 {
+  CM_PROFILE_ZONE("UpdateObjectActivity");
+
   if (!m_activityCulling) {
+    m_activityCullingCameras.clear();
     return;
   }
 
-  std::vector<MT_Vector3> camPositions;
+  std::vector<std::pair<KX_Camera *, MT_Vector3>> cameras;
 
   for (KX_Camera *cam : m_cameralist) {
     if (cam->GetActivityCulling()) {
-      camPositions.push_back(cam->NodeGetWorldPosition());
+      cameras.emplace_back(cam, cam->NodeGetWorldPosition());
     }
   }
 
   // None cameras are using object activity culling?
-  if (camPositions.size() == 0) {
+  if (cameras.size() == 0) {
+    m_activityCullingCameras.clear();
     return;
   }
 
+  /* The distance of an object to its nearest camera can't change more than the maximum
+   * displacement of the cameras plus the displacement of the object. */
+  bool sameCameras = (cameras.size() == m_activityCullingCameras.size());
+  float camTravel = 0.0f;
+  for (unsigned int i = 0; sameCameras && i < cameras.size(); ++i) {
+    if (cameras[i].first != m_activityCullingCameras[i].first) {
+      sameCameras = false;
+      break;
+    }
+    camTravel = std::max(camTravel,
+                         (cameras[i].second - m_activityCullingCameras[i].second).length());
+  }
+
+  if (sameCameras) {
+    m_activityCullingTravel += camTravel;
+  }
+  else {
+    ++m_activityCullingGeneration;
+  }
+  m_activityCullingCameras.swap(cameras);
+
+  // Gather the objects which could have changed of side of their radius since their last check.
+  m_activityCullingObjects.clear();
+  for (std::vector<float> &positions : m_activityCullingPositions) {
+    positions.clear();
+  }
+
   for (KX_GameObject *gameobj : m_objectlist) {
+    KX_GameObject::ActivityCullingInfo &info = gameobj->GetActivityCullingInfo();
     // If the object doesn't manage activity culling we don't compute distance.
-    if (gameobj->GetActivityCullingInfo().m_flags ==
-        KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE) {
+    if (info.m_flags == KX_GameObject::ActivityCullingInfo::ACTIVITY_NONE) {
       continue;
     }
 
-    // For each camera compute the distance to objects and keep the minimum distance.
     const MT_Vector3 &obpos = gameobj->NodeGetWorldPosition();
-    float dist = FLT_MAX;
-    for (const MT_Vector3 &campos : camPositions) {
-      // Keep the minimum distance.
-      dist = min_ff((obpos - campos).length2(), dist);
+    if (info.m_checkGeneration == m_activityCullingGeneration) {
+      const float margin = info.m_checkMargin - (float)(m_activityCullingTravel -
+                                                        info.m_checkTravel);
+      if (margin > 0.0f && (obpos - info.m_checkPosition).length2() < margin * margin) {
+        continue;
+      }
+    }
+
+    m_activityCullingObjects.push_back(gameobj);
+    for (unsigned short axis = 0; axis < 3; ++axis) {
+      m_activityCullingPositions[axis].push_back(obpos[axis]);
     }
+  }
+
+  activity_culling_distances(
+      m_activityCullingPositions, m_activityCullingCameras, m_activityCullingDistances);
+
+  for (unsigned int i = 0, size = m_activityCullingObjects.size(); i < size; ++i) {
+    KX_GameObject *gameobj = m_activityCullingObjects[i];
+    const float dist = m_activityCullingDistances[i];
     gameobj->UpdateActivity(dist);
+    gameobj->GetActivityCullingInfo().SetChecked(dist,
+                                                 gameobj->NodeGetWorldPosition(),
+                                                 m_activityCullingTravel,
+                                                 m_activityCullingGeneration);
   }
 }
 
@@ -2648,6 +3253,9 @@ static void MergeScene_LogicBrick(SCA_ILogicBrick *brick, KX_Scene *from, KX_Sce
 
 static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene *from)
 {
+  // The activity culling state is relative to the cameras of the scene.
+  gameobj->GetActivityCullingInfo().InvalidateCheck();
+
   SCA_ActuatorList &actuators = gameobj->GetActuators();
   for (SCA_IActuator *actuator : actuators) {
     MergeScene_LogicBrick(actuator, from, to);
@@ -2663,11 +3271,15 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
     MergeScene_LogicBrick(controller, from, to);
   }
 
-  /* graphics controller */
+  /* physics and graphics controllers */
   PHY_IController *ctrl = gameobj->GetPhysicsController();
   if (ctrl) {
     ctrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
   }
+  ctrl = gameobj->GetGraphicController();
+  if (ctrl) {
+    ctrl->SetPhysicsEnvironment(to->GetPhysicsEnvironment());
+  }
 
   /* SG_Node can hold a scene reference */
   SG_Node *sg = gameobj->GetSGNode();
@@ -2701,107 +3313,182 @@ static void MergeScene_GameObject(KX_GameObject *gameobj, KX_Scene *to, KX_Scene
 
 bool KX_Scene::MergeScene(KX_Scene *other)
 {
+  MergeState state;
+  MergeSceneStep(other, state, DBL_MAX);
+  return (state.stage == MergeState::MERGE_FINISHED);
+}
+
+bool KX_Scene::MergeSceneStep(KX_Scene *other, MergeState &state, double endtime)
+{
+  CM_PROFILE_ZONE_DETAIL("MergeScene", other->GetName().c_str());
+
   PHY_IPhysicsEnvironment *env = this->GetPhysicsEnvironment();
   PHY_IPhysicsEnvironment *env_other = other->GetPhysicsEnvironment();
 
-  if ((env == nullptr) !=
-      (env_other == nullptr)) /* TODO - even when both scenes have NONE physics, the other is
-                                 loaded with bullet enabled, ??? */
-  {
-    CM_FunctionError("physics scenes type differ, aborting\n\tsource "
-                     << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
-    return false;
-  }
+  while (!state.IsDone()) {
+    switch (state.stage) {
+      case MergeState::MERGE_BEGIN: {
+        if ((env == nullptr) !=
+            (env_other == nullptr)) /* TODO - even when both scenes have NONE physics, the other
+                                       is loaded with bullet enabled, ??? */
+        {
+          CM_FunctionError("physics scenes type differ, aborting\n\tsource "
+                           << (int)(env != nullptr) << ", target " << (int)(env_other != nullptr));
+          state.stage = MergeState::MERGE_FAILED;
+          return true;
+        }
 
-  GetBucketManager()->MergeBucketManager(other->GetBucketManager());
+        GetBucketManager()->MergeBucketManager(other->GetBucketManager());
 
-  /* active + inactive == all ??? - lets hope so */
-  for (KX_GameObject *gameobj : *other->GetObjectList()) {
-    MergeScene_GameObject(gameobj, this, other);
+        /* move materials across, assume they both use the same scene-converters.
+         * Do this with the buckets so the materials of the merged objects use this scene.
+         */
+        KX_GetActiveEngine()->GetConverter()->MergeScene(this, other);
 
-    /* add properties to debug list for LibLoad objects */
-    if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
-      AddObjectDebugProperties(gameobj);
-    }
-  }
+        state.stage = MergeState::MERGE_OBJECTS;
+        break;
+      }
+      case MergeState::MERGE_OBJECTS: {
+        EXP_ListValue<KX_GameObject> *objects = other->GetObjectList();
+        if (state.index == objects->GetCount()) {
+          // The root parents not in the object list.
+          m_parentlist->MergeList(other->m_parentlist);
+          other->m_parentlist->ReleaseAndRemoveAll();
+
+          state.stage = MergeState::MERGE_INACTIVE_OBJECTS;
+          state.index = 0;
+          break;
+        }
 
-  for (KX_GameObject *gameobj : *other->GetInactiveList()) {
-    MergeScene_GameObject(gameobj, this, other);
-  }
+        /* active + inactive == all ??? - lets hope so */
+        KX_GameObject *gameobj = objects->GetValue(state.index++);
+        MergeScene_GameObject(gameobj, this, other);
+
+        /* A root parent is updated by this scene from now, with its client info pointing to this
+         * scene. The reference of the other list is moved. */
+        if (other->m_parentlist->RemoveValue(gameobj)) {
+          m_parentlist->Add(gameobj);
+        }
+
+        if (other->m_transformStore) {
+          other->m_transformStore->Unregister(gameobj);
+        }
+        if (m_transformStore) {
+          m_transformStore->Register(gameobj);
+        }
 
-  if (env) {
-    env->MergeEnvironment(env_other);
-    EXP_ListValue<KX_GameObject> *otherObjects = other->GetObjectList();
+        /* add properties to debug list for LibLoad objects */
+        if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
+          AddObjectDebugProperties(gameobj);
+        }
 
-    // List of all physics objects to merge (needed by ReplicateConstraints).
-    std::vector<KX_GameObject *> physicsObjects;
-    for (KX_GameObject *gameobj : *otherObjects) {
-      if (gameobj->GetPhysicsController()) {
-        physicsObjects.push_back(gameobj);
+        // The object is alive in this scene, the list of the other scene is released later.
+        GetObjectList()->Add(CM_AddRef(gameobj));
+        break;
       }
-    }
+      case MergeState::MERGE_INACTIVE_OBJECTS: {
+        EXP_ListValue<KX_GameObject> *objects = other->GetInactiveList();
+        if (state.index == objects->GetCount()) {
+          state.stage = MergeState::MERGE_PHYSICS;
+          state.index = 0;
+          break;
+        }
 
-    for (unsigned int i = 0; i < physicsObjects.size(); ++i) {
-      KX_GameObject *gameobj = physicsObjects[i];
-      // Replicate all constraints in the right physics environment.
-      gameobj->GetPhysicsController()->ReplicateConstraints(gameobj, physicsObjects);
-      gameobj->ClearConstraints();
-    }
-  }
+        MergeScene_GameObject(objects->GetValue(state.index++), this, other);
+        break;
+      }
+      case MergeState::MERGE_PHYSICS: {
+        if (env) {
+          env->MergeEnvironment(env_other);
+          EXP_ListValue<KX_GameObject> *otherObjects = other->GetObjectList();
+
+          // List of all physics objects to merge (needed by ReplicateConstraints).
+          std::vector<KX_GameObject *> physicsObjects;
+          for (KX_GameObject *gameobj : *otherObjects) {
+            if (gameobj->GetPhysicsController()) {
+              physicsObjects.push_back(gameobj);
+            }
+          }
+
+          for (unsigned int i = 0; i < physicsObjects.size(); ++i) {
+            KX_GameObject *gameobj = physicsObjects[i];
+            // Replicate all constraints in the right physics environment.
+            gameobj->GetPhysicsController()->ReplicateConstraints(gameobj, physicsObjects);
+            gameobj->ClearConstraints();
+          }
+        }
 
-  GetObjectList()->MergeList(other->GetObjectList());
-  other->GetObjectList()->ReleaseAndRemoveAll();
+        state.stage = MergeState::MERGE_LISTS;
+        break;
+      }
+      case MergeState::MERGE_LISTS: {
+        other->GetObjectList()->ReleaseAndRemoveAll();
 
-  GetInactiveList()->MergeList(other->GetInactiveList());
-  other->GetInactiveList()->ReleaseAndRemoveAll();
+        m_dirtyObjects.insert(
+            m_dirtyObjects.end(), other->m_dirtyObjects.begin(), other->m_dirtyObjects.end());
+        other->m_dirtyObjects.clear();
 
-  GetRootParentList()->MergeList(other->GetRootParentList());
-  other->GetRootParentList()->ReleaseAndRemoveAll();
+        m_tiledNavMeshes.insert(m_tiledNavMeshes.end(),
+                                other->m_tiledNavMeshes.begin(),
+                                other->m_tiledNavMeshes.end());
+        other->m_tiledNavMeshes.clear();
 
-  GetLightList()->MergeList(other->GetLightList());
-  other->GetLightList()->ReleaseAndRemoveAll();
+        GetInactiveList()->MergeList(other->GetInactiveList());
+        other->GetInactiveList()->ReleaseAndRemoveAll();
 
-  GetCameraList()->MergeList(other->GetCameraList());
-  other->GetCameraList()->ReleaseAndRemoveAll();
+        GetLightList()->MergeList(other->GetLightList());
+        other->GetLightList()->ReleaseAndRemoveAll();
 
-  GetFontList()->MergeList(other->GetFontList());
-  other->GetFontList()->ReleaseAndRemoveAll();
+        GetCameraList()->MergeList(other->GetCameraList());
+        other->GetCameraList()->ReleaseAndRemoveAll();
 
-  /* move materials across, assume they both use the same scene-converters
-   * Do this after lights are merged so materials can use the lights in shaders
-   */
-  KX_GetActiveEngine()->GetConverter()->MergeScene(this, other);
+        GetFontList()->MergeList(other->GetFontList());
+        other->GetFontList()->ReleaseAndRemoveAll();
 
-  /* merge logic */
-  {
-    SCA_LogicManager *logicmgr = GetLogicManager();
-    SCA_LogicManager *logicmgr_other = other->GetLogicManager();
+        state.stage = MergeState::MERGE_LOGIC;
+        break;
+      }
+      case MergeState::MERGE_LOGIC: {
+        SCA_LogicManager *logicmgr = GetLogicManager();
+        SCA_LogicManager *logicmgr_other = other->GetLogicManager();
 
-    std::vector<class SCA_EventManager *> evtmgrs = logicmgr->GetEventManagers();
-    // vector<class SCA_EventManager*>evtmgrs_others= logicmgr_other->GetEventManagers();
+        std::vector<class SCA_EventManager *> evtmgrs = logicmgr->GetEventManagers();
+        // vector<class SCA_EventManager*>evtmgrs_others= logicmgr_other->GetEventManagers();
 
-    // SCA_EventManager *evtmgr;
-    SCA_EventManager *evtmgr_other;
+        // SCA_EventManager *evtmgr;
+        SCA_EventManager *evtmgr_other;
 
-    for (unsigned int i = 0; i < evtmgrs.size(); i++) {
-      evtmgr_other = logicmgr_other->FindEventManager(evtmgrs[i]->GetType());
+        for (unsigned int i = 0; i < evtmgrs.size(); i++) {
+          evtmgr_other = logicmgr_other->FindEventManager(evtmgrs[i]->GetType());
 
-      if (evtmgr_other) /* unlikely but possible one scene has a joystick and not the other */
-        evtmgr_other->Replace_LogicManager(logicmgr);
+          if (evtmgr_other) /* unlikely but possible one scene has a joystick and not the other */
+            evtmgr_other->Replace_LogicManager(logicmgr);
 
-      /* when merging objects sensors are moved across into the new manager, don't need to do this
-       * here */
-    }
+          /* when merging objects sensors are moved across into the new manager, don't need to do
+           * this here */
+        }
 
-    /* grab any timer properties from the other scene */
-    SCA_TimeEventManager *timemgr = GetTimeEventManager();
-    SCA_TimeEventManager *timemgr_other = other->GetTimeEventManager();
-    std::vector<EXP_Value *> times = timemgr_other->GetTimeValues();
+        /* grab any timer properties from the other scene */
+        SCA_TimeEventManager *timemgr = GetTimeEventManager();
+        SCA_TimeEventManager *timemgr_other = other->GetTimeEventManager();
+        std::vector<EXP_Value *> times = timemgr_other->GetTimeValues();
+
+        for (unsigned int i = 0; i < times.size(); i++) {
+          timemgr->AddTimeProperty(times[i]);
+        }
+
+        state.stage = MergeState::MERGE_FINISHED;
+        break;
+      }
+      default:
+        break;
+    }
 
-    for (unsigned int i = 0; i < times.size(); i++) {
-      timemgr->AddTimeProperty(times[i]);
+    if (!state.IsDone() && BLI_time_now_seconds() >= endtime) {
+      return false;
     }
   }
+
   return true;
 }
 
@@ -2909,6 +3596,8 @@ PyMethodDef KX_Scene::Methods[] = {
     EXP_PYMETHODTABLE(KX_Scene, addOverlayCollection),
     EXP_PYMETHODTABLE(KX_Scene, removeOverlayCollection),
     EXP_PYMETHODTABLE(KX_Scene, getGameObjectFromObject),
+    EXP_PYMETHODTABLE(KX_Scene, prewarmObjectPool),
+    EXP_PYMETHODTABLE_KEYWORDS(KX_Scene, rayCastBatch),
 
     /* dict style access */
     EXP_PYMETHODTABLE(KX_Scene, get),
@@ -3227,6 +3916,34 @@ int KX_Scene::pyattr_set_gravity(EXP_PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_Scene::pyattr_get_transforms(EXP_PyObjectPlus *self_v,
+                                          const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+  return self->GetTransformStore()->GetProxy();
+}
+
+PyObject *KX_Scene::pyattr_get_object_pool_stats(EXP_PyObjectPlus *self_v,
+                                                 const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+  const KX_ObjectPool::Stats &stats = self->GetObjectPool()->GetStats();
+
+  const std::pair<const char *, unsigned long> values[] = {{"hits", stats.m_hits},
+                                                           {"misses", stats.m_misses},
+                                                           {"released", stats.m_released},
+                                                           {"available", stats.m_available}};
+
+  PyObject *dict = PyDict_New();
+  for (const std::pair<const char *, unsigned long> &value : values) {
+    PyObject *item = PyLong_FromUnsignedLong(value.second);
+    PyDict_SetItemString(dict, value.first, item);
+    Py_DECREF(item);
+  }
+
+  return dict;
+}
+
 PyAttributeDef KX_Scene::Attributes[] = {
     EXP_PYATTRIBUTE_RO_FUNCTION("name", KX_Scene, pyattr_get_name),
     EXP_PYATTRIBUTE_RO_FUNCTION("objects", KX_Scene, pyattr_get_objects),
@@ -3250,7 +3967,11 @@ PyAttributeDef KX_Scene::Attributes[] = {
     EXP_PYATTRIBUTE_RW_FUNCTION(
         "pre_draw_setup", KX_Scene, pyattr_get_drawing_callback, pyattr_set_drawing_callback),
     EXP_PYATTRIBUTE_RW_FUNCTION("gravity", KX_Scene, pyattr_get_gravity, pyattr_set_gravity),
+    EXP_PYATTRIBUTE_RO_FUNCTION("objectPoolStats", KX_Scene, pyattr_get_object_pool_stats),
+    EXP_PYATTRIBUTE_RO_FUNCTION("transforms", KX_Scene, pyattr_get_transforms),
     EXP_PYATTRIBUTE_BOOL_RO("activityCulling", KX_Scene, m_activityCulling),
+    EXP_PYATTRIBUTE_BOOL_RW("parallelSceneGraph", KX_Scene, m_parallelSceneGraph),
+    EXP_PYATTRIBUTE_BOOL_RW("parallelAnimations", KX_Scene, m_parallelAnimations),
     EXP_PYATTRIBUTE_BOOL_RO("dbvt_culling", KX_Scene, m_dbvt_culling),
     EXP_PYATTRIBUTE_RO_FUNCTION("logger", KX_Scene, KX_PythonProxy::pyattr_get_logger),
     EXP_PYATTRIBUTE_RO_FUNCTION("loggerName", KX_Scene, KX_PythonProxy::pyattr_get_logger_name),
@@ -3603,6 +4324,72 @@ EXP_PYMETHODDEF_DOC(KX_Scene,
   Py_RETURN_NONE;
 }
 
+static void prewarm_object_pool_recursive(KX_ObjectPool *pool, SG_Node *node, unsigned int count)
+{
+  KX_GameObject *gameobj = static_cast<KX_GameObject *>(node->GetSGClientObject());
+  if (gameobj && gameobj->GetBlenderObject()) {
+    pool->Prewarm(gameobj->GetBlenderObject(), count);
+  }
+
+  // Children are replicated with their parent, they need their own pooled objects.
+  for (SG_Node *child : node->GetSGChildren()) {
+    prewarm_object_pool_recursive(pool, child, count);
+  }
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    prewarmObjectPool,
+                    "prewarmObjectPool(object, count)\n"
+                    "Create hidden Blender objects used by the next count replicas of object.\n")
+{
+  PyObject *pyob;
+  KX_GameObject *ob;
+  int count;
+
+  if (!PyArg_ParseTuple(args, "Oi:prewarmObjectPool", &pyob, &count)) {
+    return nullptr;
+  }
+
+  if (!ConvertPythonToGameObject(
+          m_logicmgr, pyob, &ob, false, "scene.prewarmObjectPool(object, count): KX_Scene")) {
+    return nullptr;
+  }
+
+  if (!m_inactivelist->SearchValue(ob)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "scene.prewarmObjectPool(object, count): KX_Scene, object must be in an "
+                    "inactive layer");
+    return nullptr;
+  }
+
+  if (count < 0) {
+    PyErr_SetString(PyExc_ValueError,
+                    "scene.prewarmObjectPool(object, count): KX_Scene, count must be positive");
+    return nullptr;
+  }
+
+  prewarm_object_pool_recursive(m_objectPool, ob->GetSGNode(), count);
+
+  Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC(KX_Scene,
+                    rayCastBatch,
+                    "rayCastBatch(origins, targets, mask)\n"
+                    "Cast a ray from each origin to each target in parallel and return a 4-tuple "
+                    "(objects, hits, positions, normals).\n"
+                    " origins = float array of points shaped (n, 3), or a single point for all the "
+                    "rays\n"
+                    " targets = float array of points shaped (n, 3)\n"
+                    " mask    = collision mask: the collision mask that the rays can hit, "
+                    "0 < mask < 65536\n"
+                    " objects is the list of the hit objects, hits the memoryview of the index "
+                    "in objects of the object hit by each ray or -1, positions and normals the "
+                    "memoryviews of the hit points and normals shaped (n, 3).\n")
+{
+  return KX_RayCast::PyRayTestBatch(m_physicsEnvironment, nullptr, args, kwds);
+}
+
 bool ConvertPythonToScene(PyObject *value,
                           KX_Scene **scene,
                           bool py_none_ok,
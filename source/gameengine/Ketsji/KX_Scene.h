@@ -31,12 +31,16 @@
 
 #pragma once
 
+#include <deque>
 #include <list>
+#include <memory>
 #include <set>
+#include <tuple>
 #include <vector>
 
 #include "DNA_ID.h"  // For IDRecalcFlag
 
+#include "CM_Thread.h"
 #include "EXP_PyObjectPlus.h"
 #include "EXP_Value.h"
 #include "KX_PhysicsEngineEnums.h"
@@ -70,6 +74,7 @@ class SG_Node;
 class KX_Camera;
 class KX_FontObject;
 class KX_GameObject;
+class KX_LodLevel;
 class KX_LightObject;
 class RAS_MeshObject;
 class RAS_BucketManager;
@@ -82,7 +87,10 @@ class RAS_2DFilterManager;
 class KX_2DFilterManager;
 class BL_SceneConverter;
 struct KX_ClientObjectInfo;
+class KX_NavMeshObject;
 class KX_ObstacleSimulation;
+class KX_ObjectPool;
+class KX_TransformStore;
 struct TaskPool;
 
 /*********EEVEE INTEGRATION************/
@@ -108,6 +116,33 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
     double curtime;
   };
 
+  /// Progress of a scene merged incrementally with MergeSceneStep.
+  struct MergeState {
+    enum Stage {
+      MERGE_BEGIN = 0,
+      MERGE_OBJECTS,
+      MERGE_INACTIVE_OBJECTS,
+      MERGE_PHYSICS,
+      MERGE_LISTS,
+      MERGE_LOGIC,
+      MERGE_FINISHED,
+      MERGE_FAILED
+    };
+
+    Stage stage;
+    /// Index of the next item to merge in the current stage.
+    unsigned int index;
+
+    MergeState() : stage(MERGE_BEGIN), index(0)
+    {
+    }
+
+    bool IsDone() const
+    {
+      return stage >= MERGE_FINISHED;
+    }
+  };
+
  private:
   Py_Header
 
@@ -166,6 +201,13 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   EXP_ListValue<KX_GameObject> *m_inactivelist;  // all objects that are not in the active layer
   /// All animated objects, no need of EXP_ListValue because the list isn't exposed in python.
   std::vector<KX_GameObject *> m_animatedlist;
+  /**
+   * Active objects to synchronize with the depsgraph in the next render passes,
+   * filled by the scene graph when a node becomes dirty for render.
+   * See KX_GameObject::DirtyListState.
+   */
+  std::vector<KX_GameObject *> m_dirtyObjects;
+  CM_ThreadSpinLock m_dirtyObjectsLock;
 
   /// The set of cameras for this scene
   EXP_ListValue<KX_Camera> *m_cameralist;
@@ -177,6 +219,22 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
                       // the Qlist is for objects that needs to be rescheduled
                       // for updates after udpate is over (slow parent, bone parent)
 
+  /// Update the independent node trees in parallel in UpdateParents.
+  bool m_parallelSceneGraph;
+  /// True while the node trees are updated in parallel.
+  bool m_isParallelSceneGraphUpdate;
+  /// Scheduled nodes of each node tree, used by the parallel scene graph update.
+  /// A deque to not move the lists, copying a list gives an empty list.
+  std::deque<SG_DList> m_sceneGraphGroups;
+  /// Nodes of each tree to call the update transform callback on after the parallel update.
+  std::vector<std::vector<SG_Node *>> m_sceneGraphUpdatedNodes;
+  /// Nodes scheduled during the parallel update, updated after it.
+  std::vector<SG_Node *> m_deferredScheduledNodes;
+  CM_ThreadSpinLock m_deferredScheduledNodesLock;
+  /// Forces and torques of the ipo controllers applied after the parallel update.
+  std::vector<std::tuple<KX_GameObject *, MT_Vector3, bool>> m_deferredForces;
+  CM_ThreadSpinLock m_deferredForcesLock;
+
   /**
    * Various SCA managers used by the scene
    */
@@ -263,6 +321,16 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
    * Toggle to enable or disable activity culling.
    */
   bool m_activityCulling;
+  /// Activity culling cameras and their positions from the last activity culling pass.
+  std::vector<std::pair<KX_Camera *, MT_Vector3>> m_activityCullingCameras;
+  /// Sum of the maximum camera displacement of each activity culling pass.
+  double m_activityCullingTravel;
+  /// Incremented when the activity culling cameras change, all objects are checked again.
+  unsigned int m_activityCullingGeneration;
+  /// Objects to check in the activity culling pass and their positions packed per axis.
+  std::vector<KX_GameObject *> m_activityCullingObjects;
+  std::vector<float> m_activityCullingPositions[3];
+  std::vector<float> m_activityCullingDistances;
 
   /**
    * Toggle to enable or disable culling via DBVT broadphase of Bullet.
@@ -296,15 +364,43 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   KX_2DFilterManager *m_filterManager;
 
   KX_ObstacleSimulation *m_obstacleSimulation;
+  /// Navigation meshes with tiles rebuilt under their blockers.
+  std::vector<KX_NavMeshObject *> m_tiledNavMeshes;
+
+  /// Hidden Blender objects reused by replicas.
+  KX_ObjectPool *m_objectPool;
+  /// Packed world transforms exposed to python, created on demand.
+  KX_TransformStore *m_transformStore;
 
   AnimationPoolData m_animationPoolData;
   TaskPool *m_animationPool;
+  /// Evaluate the armature actions in parallel in UpdateAnimations.
+  bool m_parallelAnimations;
+  /// True while the armature actions are evaluated in parallel.
+  bool m_isParallelAnimationUpdate;
+  /// Armatures evaluated in the animation pool, their scene graph is synced afterward.
+  std::vector<KX_GameObject *> m_parallelAnimatedObjects;
+  /// Ids to update appended by the animation pool or the parallel scene graph update, merged in
+  /// the ids to update after them.
+  std::vector<std::tuple<ID *, IDRecalcFlag, bool>> m_deferredIdsToUpdate;
+  CM_ThreadSpinLock m_deferredIdsToUpdateLock;
 
   /**
    * LOD Hysteresis settings
    */
   bool m_isActivedHysteresis;
   int m_lodHysteresisValue;
+  /// Scale the lod distances by the camera zoom and the object scale.
+  bool m_lodScreenSize;
+  /// Maximum number of objects changing of lod level per render, 0 for no limit.
+  int m_lodMaxSwaps;
+  /// Visible objects with lod, their positions packed per axis and their squared distance scale.
+  std::vector<KX_GameObject *> m_lodObjects;
+  std::vector<float> m_lodPositions[3];
+  std::vector<float> m_lodScales;
+  std::vector<float> m_lodDistances;
+  /// Objects changing of lod level with their squared distance and new level.
+  std::vector<std::tuple<float, KX_GameObject *, KX_LodLevel *>> m_lodSwaps;
 
   // Convert objects list & collection helpers
   void convert_blender_objects_list_synchronous(std::vector<Object *> objectslist);
@@ -373,8 +469,16 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
                          std::vector<Object *> children);
   bool SomethingIsMoving();
   void AppendToIdsToUpdate(ID *id, IDRecalcFlag flag, bool in_overlay_collection_only);
+  /// Apply a force or a torque to an object, deferred after the parallel scene graph update.
+  void AppendToForces(KX_GameObject *gameobj, const MT_Vector3 &vec, bool torque);
   void TagForExtraIdsUpdate(Main *bmain, KX_Camera *cam);
   void TagBlenderPhysicsObject(Scene *scene, Object *ob);
+  /// Add an active object in the list of objects to synchronize with the depsgraph.
+  void AddDirtyObject(KX_GameObject *gameobj);
+  /// Allow an object newly added in the object list to be synchronized with the depsgraph.
+  void ActivateDirtyObject(KX_GameObject *gameobj);
+  /// Remove the objects not needing a synchronization at each render pass from the dirty list.
+  void ClearDirtyObjects();
   KX_GameObject *AddDuplicaObject(KX_GameObject *gameobj,
                                   KX_GameObject *reference,
                                   float lifespan);
@@ -391,7 +495,9 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
    */
   static bool KX_ScenegraphUpdateFunc(SG_Node *node, void *gameobj, void *scene);
   static bool KX_ScenegraphRescheduleFunc(SG_Node *node, void *gameobj, void *scene);
+  static void KX_ScenegraphDirtyRenderFunc(SG_Node *node, void *gameobj, void *scene);
   void UpdateParents(double curtime);
+  void UpdateParentsParallel(double curtime);
   void DupliGroupRecurse(KX_GameObject *groupobj, int level);
   bool IsObjectInGroup(KX_GameObject *gameobj)
   {
@@ -420,6 +526,7 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   void LogicBeginFrame(double curtime, double framestep);
   void LogicUpdateFrame(double curtime);
   void UpdateAnimations(double curtime);
+  void UpdateAnimationsParallel(double curtime);
 
   void LogicEndFrame();
 
@@ -493,6 +600,12 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   void ReplicateLogic(class KX_GameObject *newobj);
   static SG_Callbacks m_callbacks;
 
+  /** Compute the culling state of the objects for a camera and flag the culled blender
+   * objects to be skipped by the game render loop. Culled objects don't cast shadows,
+   * so it does nothing when the DBVT culling is disabled.
+   */
+  void CalculateVisibleMeshes(KX_Camera *cam, const RAS_Rect &viewport);
+
   /// Update the mesh for objects based on level of detail settings
   void UpdateObjectLods(KX_Camera *cam);
 
@@ -501,6 +614,10 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   bool IsActivedLodHysteresis();
   void SetLodHysteresisValue(int hysteresisvalue);
   int GetLodHysteresisValue();
+  void SetLodScreenSize(bool screenSize);
+  bool GetLodScreenSize() const;
+  void SetLodMaxSwaps(int maxSwaps);
+  int GetLodMaxSwaps() const;
 
   // Update the activity box settings for objects in this scene, if needed.
   void UpdateObjectActivity(void);
@@ -555,6 +672,17 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
     return m_obstacleSimulation;
   }
 
+  void AddTiledNavMesh(KX_NavMeshObject *navmesh);
+  void RemoveTiledNavMesh(KX_NavMeshObject *navmesh);
+
+  KX_ObjectPool *GetObjectPool()
+  {
+    return m_objectPool;
+  }
+
+  /// Return the transform store, create it and register the active objects if needed.
+  KX_TransformStore *GetTransformStore();
+
   /**  Inherited from EXP_Value -- returns the name of this object. */
   virtual std::string GetName();
 
@@ -582,6 +710,8 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   EXP_PYMETHOD_DOC(KX_Scene, addOverlayCollection);
   EXP_PYMETHOD_DOC(KX_Scene, removeOverlayCollection);
   EXP_PYMETHOD_DOC(KX_Scene, getGameObjectFromObject);
+  EXP_PYMETHOD_DOC(KX_Scene, prewarmObjectPool);
+  EXP_PYMETHOD_DOC(KX_Scene, rayCastBatch);
 
   /* attributes */
   static PyObject *pyattr_get_name(EXP_PyObjectPlus *self_v, const EXP_PYATTRIBUTE_DEF *attrdef);
@@ -620,6 +750,10 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   static int pyattr_set_gravity(EXP_PyObjectPlus *self_v,
                                 const EXP_PYATTRIBUTE_DEF *attrdef,
                                 PyObject *value);
+  static PyObject *pyattr_get_transforms(EXP_PyObjectPlus *self_v,
+                                        const EXP_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_object_pool_stats(EXP_PyObjectPlus *self_v,
+                                                const EXP_PYATTRIBUTE_DEF *attrdef);
 
   /* getitem/setitem */
   static PyMappingMethods Mapping;
@@ -641,6 +775,11 @@ class KX_Scene : public KX_PythonProxy, public SCA_IScene {
   }
 
   bool MergeScene(KX_Scene *other);
+  /** Merge a part of the other scene until the time endtime (BLI_time_now_seconds) is reached.
+   * The objects are merged one by one and are alive in this scene as soon as they are merged.
+   * \return True when the merge is done or failed.
+   */
+  bool MergeSceneStep(KX_Scene *other, MergeState &state, double endtime);
 
   // void PrintStats(int verbose_level) {
   //	m_bucketmanager->PrintStats(verbose_level)
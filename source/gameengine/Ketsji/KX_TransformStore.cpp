@@ -0,0 +1,477 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Ketsji/KX_TransformStore.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_TransformStore.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "KX_GameObject.h"
+
+#include "CM_Message.h"
+
+/// Number of floats used by the transform of an object.
+static const unsigned int TRANSFORM_SIZE = 3 + 9 + 3;
+
+KX_TransformStore::KX_TransformStore()
+    : m_capacity(0), m_data(std::make_shared<std::vector<float>>())
+{
+}
+
+KX_TransformStore::~KX_TransformStore()
+{
+}
+
+std::string KX_TransformStore::GetName()
+{
+  return "TransformStore";
+}
+
+void KX_TransformStore::Reserve(unsigned int capacity)
+{
+  if (capacity <= m_capacity) {
+    return;
+  }
+
+  capacity = std::max(capacity, m_capacity * 2);
+
+  /* Copy each component at its new offset, in the current transforms and in the snapshot used
+   * by Apply which follows them. */
+  std::shared_ptr<std::vector<float>> newData = std::make_shared<std::vector<float>>(
+      capacity * TRANSFORM_SIZE * 2);
+  const std::vector<float> &oldData = *m_data;
+  std::vector<float> &data = *newData;
+  const unsigned int size = m_objects.size();
+  const unsigned int widths[] = {3, 9, 3};
+  unsigned int oldOffset = 0;
+  unsigned int newOffset = 0;
+  for (unsigned int width : widths) {
+    for (unsigned int block = 0; block < 2; ++block) {
+      const unsigned int oldBlock = block * m_capacity * TRANSFORM_SIZE;
+      const unsigned int newBlock = block * capacity * TRANSFORM_SIZE;
+      std::copy_n(oldData.begin() + oldBlock + oldOffset,
+                  size * width,
+                  data.begin() + newBlock + newOffset);
+    }
+    oldOffset += m_capacity * width;
+    newOffset += capacity * width;
+  }
+
+  /* Python buffers still own the previous block, its snapshot is replaced by its current
+   * transforms to detect the writes made in the detached buffers. */
+  if (m_data.use_count() > 1) {
+    std::vector<float> &retired = *m_data;
+    const unsigned int half = m_capacity * TRANSFORM_SIZE;
+    std::copy_n(retired.begin(), half, retired.begin() + half);
+    m_retiredData.push_back(m_data);
+  }
+
+  m_data = newData;
+  m_capacity = capacity;
+}
+
+void KX_TransformStore::CheckRetiredData()
+{
+  for (std::shared_ptr<std::vector<float>> &retired : m_retiredData) {
+    std::vector<float> &data = *retired;
+    const unsigned int half = data.size() / 2;
+    if (!std::equal(data.begin(), data.begin() + half, data.begin() + half)) {
+      CM_Warning("scene.transforms: buffer obtained before the store grew was modified, "
+                 "the modifications are ignored, get the buffers again after adding objects");
+      std::copy_n(data.begin(), half, data.begin() + half);
+    }
+  }
+
+  m_retiredData.erase(std::remove_if(m_retiredData.begin(),
+                                     m_retiredData.end(),
+                                     [](const std::shared_ptr<std::vector<float>> &retired) {
+                                       return retired.use_count() == 1;
+                                     }),
+                      m_retiredData.end());
+}
+
+static void transform_store_write(float *data,
+                                  unsigned int capacity,
+                                  unsigned int index,
+                                  SG_Node *node)
+{
+  float *position = data + index * 3;
+  float *orientation = data + capacity * 3 + index * 9;
+  float *scale = data + capacity * 12 + index * 3;
+
+  node->GetWorldPosition().getValue(position);
+  const MT_Matrix3x3 &rot = node->GetWorldOrientation();
+  for (unsigned short row = 0; row < 3; ++row) {
+    for (unsigned short col = 0; col < 3; ++col) {
+      orientation[row * 3 + col] = rot[row][col];
+    }
+  }
+  node->GetWorldScaling().getValue(scale);
+}
+
+static bool transform_store_changed(const float *data,
+                                    const float *snapshot,
+                                    unsigned int capacity,
+                                    unsigned int index)
+{
+  return memcmp(data + index * 3, snapshot + index * 3, sizeof(float) * 3) != 0 ||
+         memcmp(data + capacity * 3 + index * 9,
+                snapshot + capacity * 3 + index * 9,
+                sizeof(float) * 9) != 0 ||
+         memcmp(data + capacity * 12 + index * 3,
+                snapshot + capacity * 12 + index * 3,
+                sizeof(float) * 3) != 0;
+}
+
+void KX_TransformStore::Register(KX_GameObject *gameobj)
+{
+  SG_Node *node = gameobj->GetSGNode();
+  if (node->GetTransformIndex() != -1) {
+    return;
+  }
+
+  const unsigned int index = m_objects.size();
+  Reserve(index + 1);
+
+  m_objects.push_back(gameobj);
+  node->SetTransformIndex(index);
+
+  float *data = m_data->data();
+  transform_store_write(data, m_capacity, index, node);
+  transform_store_write(data + m_capacity * TRANSFORM_SIZE, m_capacity, index, node);
+}
+
+void KX_TransformStore::Unregister(KX_GameObject *gameobj)
+{
+  SG_Node *node = gameobj->GetSGNode();
+  const int index = node->GetTransformIndex();
+  if (index == -1) {
+    return;
+  }
+
+  node->SetTransformIndex(-1);
+
+  // Move the last object at the index of the removed one.
+  const unsigned int last = m_objects.size() - 1;
+  if ((unsigned int)index != last) {
+    KX_GameObject *lastobj = m_objects[last];
+    m_objects[index] = lastobj;
+    lastobj->GetSGNode()->SetTransformIndex(index);
+
+    for (unsigned int block = 0; block < 2; ++block) {
+      float *data = m_data->data() + block * m_capacity * TRANSFORM_SIZE;
+      std::copy_n(data + last * 3, 3, data + index * 3);
+      std::copy_n(data + m_capacity * 3 + last * 9, 9, data + m_capacity * 3 + index * 9);
+      std::copy_n(data + m_capacity * 12 + last * 3, 3, data + m_capacity * 12 + index * 3);
+    }
+  }
+
+  m_objects.pop_back();
+}
+
+void KX_TransformStore::Gather()
+{
+  float *data = m_data->data();
+  float *snapshot = data + m_capacity * TRANSFORM_SIZE;
+  for (unsigned int i = 0, size = m_objects.size(); i < size; ++i) {
+    transform_store_write(data, m_capacity, i, m_objects[i]->GetSGNode());
+  }
+
+  std::copy_n(data, m_capacity * TRANSFORM_SIZE, snapshot);
+}
+
+void KX_TransformStore::Apply()
+{
+  if (!m_retiredData.empty()) {
+    CheckRetiredData();
+  }
+
+  const float *data = m_data->data();
+  const float *snapshot = data + m_capacity * TRANSFORM_SIZE;
+
+  // Only the transforms modified since the last gather are applied, parents before children.
+  std::vector<std::pair<unsigned int, unsigned int>> changed;
+  for (unsigned int i = 0, size = m_objects.size(); i < size; ++i) {
+    if (transform_store_changed(data, snapshot, m_capacity, i)) {
+      unsigned int depth = 0;
+      for (SG_Node *parent = m_objects[i]->GetSGNode()->GetSGParent(); parent;
+           parent = parent->GetSGParent())
+      {
+        ++depth;
+      }
+      changed.emplace_back(depth, i);
+    }
+  }
+
+  if (changed.empty()) {
+    return;
+  }
+
+  std::sort(changed.begin(), changed.end());
+
+  for (const std::pair<unsigned int, unsigned int> &item : changed) {
+    const unsigned int index = item.second;
+    KX_GameObject *gameobj = m_objects[index];
+    const float *orientation = data + m_capacity * 3 + index * 9;
+
+    gameobj->NodeSetWorldPosition(MT_Vector3(data + index * 3));
+    gameobj->NodeSetGlobalOrientation(MT_Matrix3x3(orientation[0],
+                                                   orientation[1],
+                                                   orientation[2],
+                                                   orientation[3],
+                                                   orientation[4],
+                                                   orientation[5],
+                                                   orientation[6],
+                                                   orientation[7],
+                                                   orientation[8]));
+    gameobj->NodeSetWorldScale(MT_Vector3(data + m_capacity * 12 + index * 3));
+    gameobj->NodeUpdateGS(0.0f);
+  }
+
+  // The children of the modified objects moved too.
+  Gather();
+}
+
+unsigned int KX_TransformStore::GetSize() const
+{
+  return m_objects.size();
+}
+
+const std::vector<KX_GameObject *> &KX_TransformStore::GetObjects() const
+{
+  return m_objects;
+}
+
+unsigned int KX_TransformStore::GetOffset(Component component) const
+{
+  switch (component) {
+    case POSITION:
+      return 0;
+    case ORIENTATION:
+      return m_capacity * 3;
+    case SCALING:
+      return m_capacity * 12;
+  }
+
+  return 0;
+}
+
+float *KX_TransformStore::GetPositions()
+{
+  return m_data->data() + GetOffset(POSITION);
+}
+
+float *KX_TransformStore::GetOrientations()
+{
+  return m_data->data() + GetOffset(ORIENTATION);
+}
+
+float *KX_TransformStore::GetScalings()
+{
+  return m_data->data() + GetOffset(SCALING);
+}
+
+#ifdef WITH_PYTHON
+
+/// Internal data of an exported buffer, owning the exported block.
+struct KX_TransformBuffer {
+  Py_ssize_t shape;
+  std::shared_ptr<std::vector<float>> data;
+};
+
+int KX_TransformStore::py_get_buffer(PyObject *self, Py_buffer *view, int flags)
+{
+  KX_TransformStore *store = static_cast<KX_TransformStore *>(EXP_PROXY_REF(self));
+  if (!store) {
+    PyErr_SetString(PyExc_BufferError, "KX_TransformStore, " EXP_PROXY_ERROR_MSG);
+    view->obj = nullptr;
+    return -1;
+  }
+
+  // Only the current transforms are exported, not the snapshot.
+  KX_TransformBuffer *buffer = new KX_TransformBuffer{store->m_capacity * TRANSFORM_SIZE,
+                                                      store->m_data};
+
+  view->obj = self;
+  Py_INCREF(self);
+  view->buf = buffer->data->data();
+  view->len = buffer->shape * sizeof(float);
+  view->readonly = 0;
+  view->itemsize = sizeof(float);
+  view->format = (flags & PyBUF_FORMAT) ? (char *)"f" : nullptr;
+  view->ndim = 1;
+  view->shape = (flags & PyBUF_ND) ? &buffer->shape : nullptr;
+  view->strides = (flags & PyBUF_STRIDES) ? &view->itemsize : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = buffer;
+
+  return 0;
+}
+
+void KX_TransformStore::py_release_buffer(PyObject *self, Py_buffer *view)
+{
+  // The block is freed with its last owner, the store or a buffer.
+  delete (KX_TransformBuffer *)view->internal;
+}
+
+PyBufferProcs KX_TransformStore::BufferProcs = {(getbufferproc)py_get_buffer,
+                                                (releasebufferproc)py_release_buffer};
+
+PyTypeObject KX_TransformStore::Type = {
+    PyVarObject_HEAD_INIT(nullptr, 0) "KX_TransformStore",
+    sizeof(EXP_PyObjectPlus_Proxy),
+    0,
+    py_base_dealloc,
+    0,
+    0,
+    0,
+    0,
+    py_base_repr,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    &BufferProcs,
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    Methods,
+    0,
+    0,
+    &EXP_Value::Type,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    py_base_new};
+
+PyMethodDef KX_TransformStore::Methods[] = {
+    EXP_PYMETHODTABLE_NOARGS(KX_TransformStore, gather),
+    EXP_PYMETHODTABLE_NOARGS(KX_TransformStore, apply),
+    {nullptr, nullptr}  // Sentinel
+};
+
+PyAttributeDef KX_TransformStore::Attributes[] = {
+    EXP_PYATTRIBUTE_RO_FUNCTION("objects", KX_TransformStore, pyattr_get_objects),
+    EXP_PYATTRIBUTE_RO_FUNCTION("positions", KX_TransformStore, pyattr_get_positions),
+    EXP_PYATTRIBUTE_RO_FUNCTION("orientations", KX_TransformStore, pyattr_get_orientations),
+    EXP_PYATTRIBUTE_RO_FUNCTION("scales", KX_TransformStore, pyattr_get_scales),
+    EXP_PYATTRIBUTE_NULL  // Sentinel
+};
+
+EXP_PYMETHODDEF_DOC_NOARGS(KX_TransformStore,
+                           gather,
+                           "gather()\n"
+                           "Copy the world transforms of the objects into the store, discarding "
+                           "the modifications not applied.\n")
+{
+  Gather();
+  Py_RETURN_NONE;
+}
+
+EXP_PYMETHODDEF_DOC_NOARGS(KX_TransformStore,
+                           apply,
+                           "apply()\n"
+                           "Set the world transforms of the objects modified in the store.\n")
+{
+  Apply();
+  Py_RETURN_NONE;
+}
+
+PyObject *KX_TransformStore::pyattr_get_objects(EXP_PyObjectPlus *self_v,
+                                                const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_TransformStore *self = static_cast<KX_TransformStore *>(self_v);
+  const std::vector<KX_GameObject *> &objects = self->GetObjects();
+
+  PyObject *list = PyList_New(objects.size());
+  for (unsigned int i = 0, size = objects.size(); i < size; ++i) {
+    PyList_SET_ITEM(list, i, objects[i]->GetProxy());
+  }
+
+  return list;
+}
+
+/// Return a memoryview of a component shaped (objects, width) or (objects, 3, 3).
+static PyObject *transform_store_component_view(KX_TransformStore *self,
+                                                KX_TransformStore::Component component,
+                                                PyObject *shape)
+{
+  const unsigned int size = self->GetSize();
+  const unsigned int width = (component == KX_TransformStore::ORIENTATION) ? 9 : 3;
+  const unsigned int start = self->GetOffset(component);
+
+  PyObject *proxy = self->GetProxy();
+  PyObject *block = PyMemoryView_FromObject(proxy);
+  Py_DECREF(proxy);
+  if (!block) {
+    Py_DECREF(shape);
+    return nullptr;
+  }
+
+  PyObject *pystart = PyLong_FromUnsignedLong(start);
+  PyObject *pystop = PyLong_FromUnsignedLong(start + size * width);
+  PyObject *slice = PySlice_New(pystart, pystop, nullptr);
+  Py_DECREF(pystart);
+  Py_DECREF(pystop);
+  PyObject *view = PyObject_GetItem(block, slice);
+  Py_DECREF(slice);
+  Py_DECREF(block);
+
+  // A memoryview can't be cast to a shape containing zero.
+  if (!view || size == 0) {
+    Py_DECREF(shape);
+    return view;
+  }
+
+  PyObject *bytes = PyObject_CallMethod(view, "cast", "s", "B");
+  Py_DECREF(view);
+  if (!bytes) {
+    Py_DECREF(shape);
+    return nullptr;
+  }
+
+  PyObject *result = PyObject_CallMethod(bytes, "cast", "sO", "f", shape);
+  Py_DECREF(bytes);
+  Py_DECREF(shape);
+
+  return result;
+}
+
+PyObject *KX_TransformStore::pyattr_get_positions(EXP_PyObjectPlus *self_v,
+                                                  const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_TransformStore *self = static_cast<KX_TransformStore *>(self_v);
+  return transform_store_component_view(self, POSITION, Py_BuildValue("(II)", self->GetSize(), 3));
+}
+
+PyObject *KX_TransformStore::pyattr_get_orientations(EXP_PyObjectPlus *self_v,
+                                                     const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_TransformStore *self = static_cast<KX_TransformStore *>(self_v);
+  return transform_store_component_view(
+      self, ORIENTATION, Py_BuildValue("(III)", self->GetSize(), 3, 3));
+}
+
+PyObject *KX_TransformStore::pyattr_get_scales(EXP_PyObjectPlus *self_v,
+                                               const EXP_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_TransformStore *self = static_cast<KX_TransformStore *>(self_v);
+  return transform_store_component_view(self, SCALING, Py_BuildValue("(II)", self->GetSize(), 3));
+}
+
+#endif  // WITH_PYTHON
@@ -0,0 +1,95 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file KX_TransformStore.h
+ *  \ingroup ketsji
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "EXP_Value.h"
+
+class KX_GameObject;
+
+/**
+ * Packed world transforms of the objects of a scene, exposed to python through the buffer
+ * protocol (scene.transforms).
+ *
+ * The store is created on the first access from python, from then all the active objects of the
+ * scene are registered and their scene graph node holds their index in the store. The positions,
+ * orientations (row major) and scales are stored per component in a single float block:
+ * [capacity * 3 positions][capacity * 9 orientations][capacity * 3 scales], followed by a
+ * snapshot of the same layout taken at the last gather.
+ *
+ * The scene graph nodes stay the reference of the transforms, Gather copies the world transforms
+ * of the nodes in the store and Apply copies back the store in the nodes.
+ *
+ * The python buffers share the ownership of the data block, they stay valid after the store is
+ * freed or the block is replaced to grow, but are then detached from the objects.
+ */
+class KX_TransformStore : public EXP_Value {
+  Py_Header
+
+ public:
+  enum Component { POSITION = 0, ORIENTATION, SCALING };
+
+ private:
+  /// Stored objects, the index of an object is its index in the data arrays.
+  std::vector<KX_GameObject *> m_objects;
+  /// Number of objects the data block can hold.
+  unsigned int m_capacity;
+  /// Current transforms followed by the snapshot of the last gather, shared with python buffers.
+  std::shared_ptr<std::vector<float>> m_data;
+  /// Data blocks replaced while exported, checked for writes lost in detached buffers.
+  std::vector<std::shared_ptr<std::vector<float>>> m_retiredData;
+
+  /// Warn about the writes in the detached blocks and forget the blocks not exported anymore.
+  void CheckRetiredData();
+
+  /// Grow the data block to hold at least capacity objects.
+  void Reserve(unsigned int capacity);
+
+ public:
+  KX_TransformStore();
+  virtual ~KX_TransformStore();
+
+  virtual std::string GetName();
+
+  /// Add an object at the end of the store.
+  void Register(KX_GameObject *gameobj);
+  /// Remove an object, the last object takes its index.
+  void Unregister(KX_GameObject *gameobj);
+
+  /// Copy the world transforms of the objects into the store.
+  void Gather();
+  /// Set the world transforms of the objects from the store.
+  void Apply();
+
+  unsigned int GetSize() const;
+  const std::vector<KX_GameObject *> &GetObjects() const;
+  /// Return the offset of a component in the data block, in floats.
+  unsigned int GetOffset(Component component) const;
+  float *GetPositions();
+  float *GetOrientations();
+  float *GetScalings();
+
+#ifdef WITH_PYTHON
+  static int py_get_buffer(PyObject *self, Py_buffer *view, int flags);
+  static void py_release_buffer(PyObject *self, Py_buffer *view);
+  static PyBufferProcs BufferProcs;
+
+  EXP_PYMETHOD_DOC_NOARGS(KX_TransformStore, gather);
+  EXP_PYMETHOD_DOC_NOARGS(KX_TransformStore, apply);
+
+  static PyObject *pyattr_get_objects(EXP_PyObjectPlus *self_v,
+                                      const EXP_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_positions(EXP_PyObjectPlus *self_v,
+                                        const EXP_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_orientations(EXP_PyObjectPlus *self_v,
+                                           const EXP_PYATTRIBUTE_DEF *attrdef);
+  static PyObject *pyattr_get_scales(EXP_PyObjectPlus *self_v,
+                                     const EXP_PYATTRIBUTE_DEF *attrdef);
+#endif  // WITH_PYTHON
+};
@@ -30,14 +30,19 @@
 
 #include "LA_Launcher.h"
 
+#include <algorithm>
+#include <sstream>
+
 #include "BKE_main.hh"
 #include "BKE_sound.h"
+#include "BLI_time.h"
 #include "DNA_scene_types.h"
 #include "wm_event_types.hh"
 
 #include "BL_Converter.h"
 #include "BL_DataConversion.h"
 #include "CM_Message.h"
+#include "CM_Profiler.h"
 #include "DEV_EventConsumer.h"
 #include "DEV_InputDevice.h"
 #include "DEV_Joystick.h"
@@ -73,6 +78,7 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system,
       m_kxStartScene(nullptr),
       m_useViewportRender(useViewportRender),
       m_shadingTypeRuntime(shadingTypeRuntime),
+      m_benchmarkFrames(0),
       m_exitRequested(KX_ExitRequest::NO_REQUEST),
       m_globalSettings(gs),
       m_system(system),
@@ -139,6 +145,8 @@ void LA_Launcher::InitEngine()
                               syshandle, "fixedtime", (gm.flag & GAME_ENABLE_ALL_FRAMES)) == 0);
   bool frameRate = (SYS_GetCommandLineInt(syshandle, "show_framerate", 0) != 0);
   bool nodepwarnings = (SYS_GetCommandLineInt(syshandle, "ignore_deprecation_warnings", 1) != 0);
+  m_profileTracePath = SYS_GetCommandLineString(syshandle, "profile_trace", "");
+  m_benchmarkFrames = std::max(SYS_GetCommandLineInt(syshandle, "benchmark_frames", 0), 0);
   bool restrictAnimFPS = (gm.flag & GAME_RESTRICT_ANIM_UPDATES) != 0;
 
   // Setup python console keys used as shortcut.
@@ -154,7 +162,10 @@ void LA_Launcher::InitEngine()
                                   (frameRate ? KX_KetsjiEngine::SHOW_FRAMERATE : 0) |
                                   (restrictAnimFPS ? KX_KetsjiEngine::RESTRICT_ANIMATION : 0) |
                                   (properties ? KX_KetsjiEngine::SHOW_DEBUG_PROPERTIES : 0) |
-                                  (profile ? KX_KetsjiEngine::SHOW_PROFILE : 0));
+                                  (profile ? KX_KetsjiEngine::SHOW_PROFILE : 0) |
+                                  (m_benchmarkFrames ? (KX_KetsjiEngine::FIXED_FRAMERATE |
+                                                        KX_KetsjiEngine::USE_EXTERNAL_CLOCK) :
+                                                       0));
 
   m_rasterizer = new RAS_Rasterizer();
 
@@ -217,7 +228,8 @@ void LA_Launcher::InitEngine()
 #endif
 
   m_ketsjiEngine->SetFlag(flags, true);
-  m_ketsjiEngine->SetRender(true);
+  // The benchmark only measures the logic, physics and scene graph.
+  m_ketsjiEngine->SetRender(m_benchmarkFrames == 0);
 
   m_ketsjiEngine->SetTicRate(gm.ticrate);
   m_ketsjiEngine->SetMaxLogicFrame(gm.maxlogicstep);
@@ -242,6 +254,12 @@ void LA_Launcher::InitEngine()
                   &m_audioDeviceIsInitialized);
 #endif  // WITH_PYTHON
 
+  // Record the profiling zones from the conversion of the starting scene.
+  if (!m_profileTracePath.empty()) {
+    CM_Profiler::Clear();
+    CM_Profiler::Start();
+  }
+
   // Create a scene converter, create and convert the stratingscene.
   m_converter = new BL_Converter(m_maggie, m_ketsjiEngine);
   m_ketsjiEngine->SetConverter(m_converter);
@@ -291,6 +309,13 @@ void LA_Launcher::ExitEngine()
   DEV_Joystick::Close();
   m_ketsjiEngine->StopEngine();
 
+  if (!m_profileTracePath.empty()) {
+    CM_Profiler::Stop();
+    if (!CM_Profiler::WriteChromeTrace(m_profileTracePath)) {
+      CM_Error("can't write profile trace \"" << m_profileTracePath << "\"");
+    }
+  }
+
 #ifdef WITH_PYTHON
 
   /* Clears the dictionary by hand:
@@ -500,8 +525,52 @@ bool LA_Launcher::EngineNextFrame()
   return (m_exitRequested == KX_ExitRequest::NO_REQUEST);
 }
 
+void LA_Launcher::EngineBenchmarkLoop()
+{
+  m_ketsjiEngine->SetProfileMeasurementCount(m_benchmarkFrames);
+
+  const double timestep = 1.0 / m_ketsjiEngine->GetTicRate();
+  const double starttime = BLI_time_now_seconds();
+
+  /* The first call only initializes the engine clock. The clock is advanced by one frame and a
+   * half to not lose a frame to the rounding of the elapsed time, exactly one frame of timestep
+   * is proceeded as the elapsed time is reset at each frame.
+   */
+  int frames = -1;
+  bool run = true;
+  while (run && frames < m_benchmarkFrames) {
+    m_ketsjiEngine->SetClockTime(m_ketsjiEngine->GetClockTime() + timestep * 1.5);
+    run = EngineNextFrame();
+    ++frames;
+  }
+
+  const double totaltime = BLI_time_now_seconds() - starttime;
+
+  std::vector<std::string> labels;
+  std::vector<double> times;
+  m_ketsjiEngine->GetProfileAverages(labels, times);
+
+  // Single line of JSON read by the performance tests, times are in milliseconds.
+  std::stringstream json;
+  json << "BENCHMARK: {\"frames\": " << frames << ", \"total\": " << totaltime * 1000.0
+       << ", \"categories\": {";
+  for (unsigned short i = 0, size = labels.size(); i < size; ++i) {
+    // Remove the trailing colon of the label.
+    const std::string name = labels[i].substr(0, labels[i].size() - 1);
+    json << ((i == 0) ? "" : ", ") << "\"" << name << "\": " << times[i] * 1000.0;
+  }
+  json << "}}";
+
+  CM_Message(json.str());
+}
+
 void LA_Launcher::EngineMainLoop()
 {
+  if (m_benchmarkFrames > 0) {
+    EngineBenchmarkLoop();
+    return;
+  }
+
 #ifdef WITH_PYTHON
   std::string pythonCode;
   std::string pythonFileName;
@@ -54,6 +54,10 @@ class LA_Launcher {
   KX_Scene *m_kxStartScene;
   bool m_useViewportRender;
   int m_shadingTypeRuntime;
+  /// File written with the profiling zones recorded during the game, empty if not profiled.
+  std::string m_profileTracePath;
+  /// Number of logic frames run without rendering by the benchmark, 0 if not benchmarking.
+  int m_benchmarkFrames;
 
   /// \section Exit state.
   KX_ExitRequest m_exitRequested;
@@ -114,6 +118,11 @@ class LA_Launcher {
   /// Execute engine render, overrided to render background.
   virtual void RenderEngine();
 
+  /** Run m_benchmarkFrames logic frames at fixed timestep as fast as possible and print the
+   * average time per frame of each profiling category.
+   */
+  void EngineBenchmarkLoop();
+
 #ifdef WITH_PYTHON
   /** Return true if the user use a valid python script for main loop and copy the python code
    * to pythonCode and file name to pythonFileName. Else return false.
@@ -0,0 +1,305 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Physics/Bullet/CcdDynamicsWorldMt.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdDynamicsWorldMt.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "BulletCollision/BroadphaseCollision/btOverlappingPairCache.h"
+#include "BulletDynamics/Dynamics/btSimulationIslandManagerMt.h"
+#include "LinearMath/btQuickprof.h"
+
+#include "BLI_task.h"
+
+#include "CM_Message.h"
+
+struct ParallelForData {
+  const btIParallelForBody *body;
+  int begin;
+  int end;
+  int grainSize;
+};
+
+static void parallel_for_func(void *__restrict userdata,
+                              const int iter,
+                              const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ParallelForData *data = static_cast<ParallelForData *>(userdata);
+  const int begin = data->begin + iter * data->grainSize;
+  data->body->forLoop(begin, std::min(begin + data->grainSize, data->end));
+}
+
+struct ParallelSumData {
+  const btIParallelSumBody *body;
+  int begin;
+  int end;
+  int grainSize;
+  /// Sum per chunk, added in order to not depend on the threads.
+  std::vector<btScalar> sums;
+};
+
+static void parallel_sum_func(void *__restrict userdata,
+                              const int iter,
+                              const TaskParallelTLS *__restrict /*tls*/)
+{
+  ParallelSumData *data = static_cast<ParallelSumData *>(userdata);
+  const int begin = data->begin + iter * data->grainSize;
+  data->sums[iter] = data->body->sumLoop(begin, std::min(begin + data->grainSize, data->end));
+}
+
+CcdTaskScheduler::CcdTaskScheduler() : btITaskScheduler("Blender")
+{
+}
+
+int CcdTaskScheduler::getMaxNumThreads() const
+{
+  return BT_MAX_THREAD_COUNT;
+}
+
+int CcdTaskScheduler::getNumThreads() const
+{
+  /* Bullet gives an index to each thread calling it, including the threads which are not
+   * part of the task scheduler (e.g python threads), the arrays indexed by thread are sized
+   * for the maximum index. */
+  return BT_MAX_THREAD_COUNT;
+}
+
+void CcdTaskScheduler::setNumThreads(int /*numThreads*/)
+{
+  // The number of threads is the one of the Blender task scheduler.
+}
+
+void CcdTaskScheduler::parallelFor(int iBegin,
+                                   int iEnd,
+                                   int grainSize,
+                                   const btIParallelForBody &body)
+{
+  if (iEnd <= iBegin) {
+    return;
+  }
+
+  grainSize = std::max(grainSize, 1);
+  ParallelForData data = {&body, iBegin, iEnd, grainSize};
+  const int numChunks = (iEnd - iBegin + grainSize - 1) / grainSize;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numChunks > 1);
+
+  BLI_task_parallel_range(0, numChunks, &data, parallel_for_func, &settings);
+}
+
+btScalar CcdTaskScheduler::parallelSum(int iBegin,
+                                       int iEnd,
+                                       int grainSize,
+                                       const btIParallelSumBody &body)
+{
+  if (iEnd <= iBegin) {
+    return 0.0f;
+  }
+
+  grainSize = std::max(grainSize, 1);
+  const int numChunks = (iEnd - iBegin + grainSize - 1) / grainSize;
+  ParallelSumData data = {&body, iBegin, iEnd, grainSize, std::vector<btScalar>(numChunks)};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numChunks > 1);
+
+  BLI_task_parallel_range(0, numChunks, &data, parallel_sum_func, &settings);
+
+  btScalar sum = 0.0f;
+  for (const btScalar value : data.sums) {
+    sum += value;
+  }
+  return sum;
+}
+
+bool CcdTaskScheduler::Activate()
+{
+  static CcdTaskScheduler scheduler;
+
+  if (btGetTaskScheduler() == &scheduler) {
+    return true;
+  }
+
+  // Keep a thread index for the threads not in the task scheduler.
+  if (BLI_task_scheduler_num_threads() >= int(BT_MAX_THREAD_COUNT) / 2) {
+    CM_Warning("too many threads for the multithreaded physics, using a single thread");
+    return false;
+  }
+
+  // Fails if Bullet was first used by another thread than the main thread.
+  btSetTaskScheduler(&scheduler);
+  if (btGetTaskScheduler() != &scheduler) {
+    CM_Warning("the multithreaded physics must be started from the main thread");
+    return false;
+  }
+
+  return true;
+}
+
+CcdCollisionDispatcherMt::CcdCollisionDispatcherMt(btCollisionConfiguration *config)
+    : btCollisionDispatcherMt(config, 40)
+{
+}
+
+static bool manifold_less(const btPersistentManifold *manifold1,
+                          const btPersistentManifold *manifold2)
+{
+  const int index1 = manifold1->getBody0()->getWorldArrayIndex();
+  const int index2 = manifold2->getBody0()->getWorldArrayIndex();
+  if (index1 != index2) {
+    return index1 < index2;
+  }
+  return manifold1->getBody1()->getWorldArrayIndex() <
+         manifold2->getBody1()->getWorldArrayIndex();
+}
+
+struct CollisionPairsUpdater : public btIParallelForBody {
+  btBroadphasePair **pairs;
+  btNearCallback callback;
+  btCollisionDispatcher *dispatcher;
+  const btDispatcherInfo *info;
+
+  void forLoop(int iBegin, int iEnd) const
+  {
+    for (int i = iBegin; i < iEnd; ++i) {
+      callback(*pairs[i], *dispatcher, *info);
+    }
+  }
+};
+
+void CcdCollisionDispatcherMt::dispatchAllCollisionPairs(btOverlappingPairCache *pairCache,
+                                                         const btDispatcherInfo &info,
+                                                         btDispatcher *dispatcher)
+{
+  const int pairCount = pairCache->getNumOverlappingPairs();
+  if (pairCount == 0) {
+    return;
+  }
+
+  btBroadphasePair *pairArray = pairCache->getOverlappingPairArrayPtr();
+  m_parallelPairs.resize(0);
+  m_serialPairs.resize(0);
+  for (int i = 0; i < pairCount; ++i) {
+    btBroadphasePair &pair = pairArray[i];
+    const btCollisionObject *object0 = (btCollisionObject *)pair.m_pProxy0->m_clientObject;
+    const btCollisionObject *object1 = (btCollisionObject *)pair.m_pProxy1->m_clientObject;
+    if ((object0->getInternalType() | object1->getInternalType()) &
+        btCollisionObject::CO_SOFT_BODY)
+    {
+      m_serialPairs.push_back(&pair);
+    }
+    else {
+      m_parallelPairs.push_back(&pair);
+    }
+  }
+
+  CollisionPairsUpdater updater;
+  updater.callback = getNearCallback();
+  updater.dispatcher = this;
+  updater.info = &info;
+
+  if (m_parallelPairs.size() > 0) {
+    const int firstNewManifold = m_manifoldsPtr.size();
+
+    updater.pairs = &m_parallelPairs[0];
+    m_batchUpdating = true;
+    btParallelFor(0, m_parallelPairs.size(), m_grainSize, updater);
+    m_batchUpdating = false;
+
+    for (int i = 0; i < m_batchManifoldsPtr.size(); ++i) {
+      btAlignedObjectArray<btPersistentManifold *> &batchManifoldsPtr = m_batchManifoldsPtr[i];
+      for (int j = 0; j < batchManifoldsPtr.size(); ++j) {
+        m_manifoldsPtr.push_back(batchManifoldsPtr[j]);
+      }
+      batchManifoldsPtr.resizeNoInitialize(0);
+    }
+
+    /* The order of the manifolds is the order of the contacts in the solver, the manifolds
+     * of a pair are created by the same thread so a stable sort is enough. */
+    if (m_manifoldsPtr.size() > firstNewManifold) {
+      btPersistentManifold **manifolds = &m_manifoldsPtr[0];
+      std::stable_sort(
+          manifolds + firstNewManifold, manifolds + m_manifoldsPtr.size(), manifold_less);
+    }
+
+    for (int i = firstNewManifold; i < m_manifoldsPtr.size(); ++i) {
+      m_manifoldsPtr[i]->m_index1a = i;
+    }
+  }
+
+  if (m_serialPairs.size() > 0) {
+    updater.pairs = &m_serialPairs[0];
+    updater.forLoop(0, m_serialPairs.size());
+  }
+}
+
+CcdDynamicsWorldMt::CcdDynamicsWorldMt(btDispatcher *dispatcher,
+                                       btBroadphaseInterface *pairCache,
+                                       btConstraintSolverPoolMt *solverPool,
+                                       btCollisionConfiguration *collisionConfiguration)
+    : btSoftRigidDynamicsWorld(dispatcher, pairCache, solverPool, collisionConfiguration)
+{
+  if (m_ownsIslandManager) {
+    m_islandManager->~btSimulationIslandManager();
+    btAlignedFree(m_islandManager);
+  }
+
+  void *mem = btAlignedAlloc(sizeof(btSimulationIslandManagerMt), 16);
+  btSimulationIslandManagerMt *islandManager = new (mem) btSimulationIslandManagerMt();
+  islandManager->setMinimumSolverBatchSize(m_solverInfo.m_minimumSolverBatchSize);
+  m_islandManager = islandManager;
+  m_ownsIslandManager = true;
+}
+
+CcdDynamicsWorldMt::~CcdDynamicsWorldMt()
+{
+}
+
+void CcdDynamicsWorldMt::solveConstraints(btContactSolverInfo &solverInfo)
+{
+  BT_PROFILE("solveConstraints");
+
+  m_constraintSolver->prepareSolve(getNumCollisionObjects(), getDispatcher()->getNumManifolds());
+
+  // Each island is solved by a solver of the pool.
+  btSimulationIslandManagerMt *islandManager = static_cast<btSimulationIslandManagerMt *>(
+      m_islandManager);
+  btSimulationIslandManagerMt::SolverParams solverParams;
+  solverParams.m_solverPool = m_constraintSolver;
+  solverParams.m_solverMt = nullptr;
+  solverParams.m_solverInfo = &solverInfo;
+  solverParams.m_debugDrawer = m_debugDrawer;
+  solverParams.m_dispatcher = getDispatcher();
+  islandManager->buildAndProcessIslands(getDispatcher(), this, m_constraints, solverParams);
+
+  m_constraintSolver->allSolved(solverInfo, m_debugDrawer);
+}
+
+void CcdDynamicsWorldMt::IntegrateTransformsUpdater::forLoop(int iBegin, int iEnd) const
+{
+  m_world->integrateTransformsInternal(&m_bodies[iBegin], iEnd - iBegin, m_timeStep);
+}
+
+void CcdDynamicsWorldMt::integrateTransforms(btScalar timeStep)
+{
+  // The speculative restitution is only done by the serial version.
+  if (m_applySpeculativeContactRestitution || m_nonStaticRigidBodies.size() == 0) {
+    btSoftRigidDynamicsWorld::integrateTransforms(timeStep);
+    return;
+  }
+
+  BT_PROFILE("integrateTransforms");
+
+  IntegrateTransformsUpdater updater;
+  updater.m_world = this;
+  updater.m_bodies = &m_nonStaticRigidBodies[0];
+  updater.m_timeStep = timeStep;
+  btParallelFor(0, m_nonStaticRigidBodies.size(), 50, updater);
+}
@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file CcdDynamicsWorldMt.h
+ *  \ingroup physbullet
+ */
+
+#pragma once
+
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+#include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
+#include "LinearMath/btThreads.h"
+
+/**
+ * Bullet task scheduler running the parallel loops of the "Mt" classes with the Blender task
+ * scheduler (TBB) instead of Bullet's own thread pool.
+ */
+class CcdTaskScheduler : public btITaskScheduler {
+ public:
+  CcdTaskScheduler();
+
+  virtual int getMaxNumThreads() const;
+  virtual int getNumThreads() const;
+  virtual void setNumThreads(int numThreads);
+  virtual void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody &body);
+  virtual btScalar parallelSum(int iBegin,
+                               int iEnd,
+                               int grainSize,
+                               const btIParallelSumBody &body);
+
+  /** Install the scheduler used by all the multithreaded worlds,
+   * return false if the threads can't be used by Bullet.
+   */
+  static bool Activate();
+};
+
+/**
+ * Collision dispatcher computing the contacts of the pairs in parallel.
+ * The new manifolds are sorted by objects to keep a solving order independent of the threads,
+ * the pairs using a soft body are processed serially after the others as a soft body stores
+ * its contacts in itself.
+ */
+class CcdCollisionDispatcherMt : public btCollisionDispatcherMt {
+ private:
+  btAlignedObjectArray<btBroadphasePair *> m_parallelPairs;
+  btAlignedObjectArray<btBroadphasePair *> m_serialPairs;
+
+ public:
+  CcdCollisionDispatcherMt(btCollisionConfiguration *config);
+
+  virtual void dispatchAllCollisionPairs(btOverlappingPairCache *pairCache,
+                                         const btDispatcherInfo &info,
+                                         btDispatcher *dispatcher);
+};
+
+/**
+ * Soft rigid world solving the simulation islands and integrating the rigid bodies in parallel,
+ * same as btDiscreteDynamicsWorldMt which can't contain soft bodies.
+ * The constraint solver must be a btConstraintSolverPoolMt.
+ */
+class CcdDynamicsWorldMt : public btSoftRigidDynamicsWorld {
+ protected:
+  struct IntegrateTransformsUpdater : public btIParallelForBody {
+    CcdDynamicsWorldMt *m_world;
+    btRigidBody **m_bodies;
+    btScalar m_timeStep;
+
+    virtual void forLoop(int iBegin, int iEnd) const;
+  };
+
+  virtual void solveConstraints(btContactSolverInfo &solverInfo);
+  virtual void integrateTransforms(btScalar timeStep);
+
+ public:
+  CcdDynamicsWorldMt(btDispatcher *dispatcher,
+                     btBroadphaseInterface *pairCache,
+                     btConstraintSolverPoolMt *solverPool,
+                     btCollisionConfiguration *collisionConfiguration);
+  virtual ~CcdDynamicsWorldMt();
+};
@@ -0,0 +1,499 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Physics/Bullet/CcdOcclusionBuffer.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdOcclusionBuffer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "BLI_assert.h"
+#include "BLI_simd.hh"
+#include "BLI_task.h"
+
+#include "CM_Profiler.h"
+
+namespace {
+
+/// Vertex in clip coordinates, then in pixel coordinates with z = 1/w.
+struct ClipVertex {
+  float x;
+  float y;
+  float z;
+  float w;
+};
+
+/// Multiplication of column major matrices: m = m1 * m2.
+void mul_m4(float m[16], const float m1[16], const float m2[16])
+{
+  for (int c = 0; c < 4; ++c) {
+    for (int r = 0; r < 4; ++r) {
+      m[c * 4 + r] = m1[r] * m2[c * 4] + m1[4 + r] * m2[c * 4 + 1] + m1[8 + r] * m2[c * 4 + 2] +
+                     m1[12 + r] * m2[c * 4 + 3];
+    }
+  }
+}
+
+inline ClipVertex transform(const float m[16], const float x, const float y, const float z)
+{
+  return {x * m[0] + y * m[4] + z * m[8] + m[12],
+          x * m[1] + y * m[5] + z * m[9] + m[13],
+          x * m[2] + y * m[6] + z * m[10] + m[14],
+          x * m[3] + y * m[7] + z * m[11] + m[15]};
+}
+
+inline ClipVertex interpolate(const ClipVertex &a, const ClipVertex &b, const float t)
+{
+  return {a.x + (b.x - a.x) * t,
+          a.y + (b.y - a.y) * t,
+          a.z + (b.z - a.z) * t,
+          a.w + (b.w - a.w) * t};
+}
+
+/** Clip a polygon against the near and far planes.
+ * \param pi The polygon of np vertices, np <= 4.
+ * \param po The clipped polygon, at most np + 2 vertices.
+ * \return The number of vertices of the clipped polygon.
+ */
+int clip_polygon(const ClipVertex *pi, const int np, ClipVertex *po)
+{
+  ClipVertex pn[8];
+  float s[8];
+  int i, j, m, n;
+
+  // Deal with near clipping.
+  for (i = 0, m = 0; i < np; ++i) {
+    s[i] = pi[i].z + pi[i].w;
+    if (s[i] < 0.0f) {
+      m += 1 << i;
+    }
+  }
+  if (m == ((1 << np) - 1)) {
+    return 0;
+  }
+
+  int ni = np;
+  if (m != 0) {
+    for (i = np - 1, j = 0, n = 0; j < np; i = j++) {
+      const ClipVertex &a = pi[i];
+      const ClipVertex &b = pi[j];
+      const float t = s[i] / (a.w + a.z - b.w - b.z);
+      if (t > 0.0f && t < 1.0f) {
+        pn[n++] = interpolate(a, b, t);
+      }
+      if (s[j] > 0.0f) {
+        pn[n++] = b;
+      }
+    }
+    // Ready to test far clipping, start from the modified polygon.
+    pi = pn;
+    ni = n;
+  }
+
+  // Now deal with far clipping.
+  for (i = 0, m = 0; i < ni; ++i) {
+    s[i] = pi[i].z - pi[i].w;
+    if (s[i] > 0.0f) {
+      m += 1 << i;
+    }
+  }
+  if (m == ((1 << ni) - 1)) {
+    return 0;
+  }
+  if (m != 0) {
+    for (i = ni - 1, j = 0, n = 0; j < ni; i = j++) {
+      const ClipVertex &a = pi[i];
+      const ClipVertex &b = pi[j];
+      const float t = s[i] / (a.z - a.w - b.z + b.w);
+      if (t > 0.0f && t < 1.0f) {
+        po[n++] = interpolate(a, b, t);
+      }
+      if (s[j] < 0.0f) {
+        po[n++] = b;
+      }
+    }
+    return n;
+  }
+
+  std::copy(pi, pi + ni, po);
+  return ni;
+}
+
+/// Clamp a pixel coordinate before its conversion to an integer.
+inline int clamp_pixel(const float value, const int size)
+{
+  return (int)std::min(std::max(value, 0.0f), float(size - 1));
+}
+
+}  // namespace
+
+CcdOcclusionBuffer::CcdOcclusionBuffer()
+    : m_sizes{0, 0},
+      m_tiles{0, 0},
+      m_scales{0.0f, 0.0f},
+      m_occlusion(false),
+      m_prevSizes{0, 0},
+      m_prevValid(false)
+{
+}
+
+void CcdOcclusionBuffer::Setup(int size, const int *viewport, const float worldToClip[16])
+{
+  // Compute the size of the buffer, the buffer size depends on the aspect ratio.
+  const int maxsize = std::max(viewport[2], viewport[3]);
+  BLI_assert(maxsize > 0);
+  const double ratio = 1.0 / (2 * maxsize);
+  // Ensure even number.
+  m_sizes[0] = std::max(2, 2 * ((int)(size * viewport[2] * ratio + 0.5)));
+  m_sizes[1] = std::max(2, 2 * ((int)(size * viewport[3] * ratio + 0.5)));
+  m_scales[0] = float(m_sizes[0] / 2);
+  m_scales[1] = float(m_sizes[1] / 2);
+
+  m_tiles[0] = (m_sizes[0] + TILE_WIDTH - 1) / TILE_WIDTH;
+  m_tiles[1] = (m_sizes[1] + TILE_HEIGHT - 1) / TILE_HEIGHT;
+  const unsigned int numTiles = m_tiles[0] * m_tiles[1];
+  m_buffer.resize(numTiles * TILE_WIDTH * TILE_HEIGHT);
+  m_tileDepths.resize(numTiles);
+  m_bins.resize(numTiles);
+
+  memcpy(m_wtc, worldToClip, sizeof(m_wtc));
+
+  // Keep the occluders of the last frame to compare them with the new ones.
+  std::swap(m_occluders, m_prevOccluders);
+}
+
+void CcdOcclusionBuffer::SetNumOccluders(unsigned int count)
+{
+  m_occluders.resize(count);
+}
+
+CcdOcclusionBuffer::Occluder &CcdOcclusionBuffer::GetOccluder(unsigned int index)
+{
+  return m_occluders[index];
+}
+
+bool CcdOcclusionBuffer::SameAsPrevious() const
+{
+  if (!m_prevValid || m_sizes[0] != m_prevSizes[0] || m_sizes[1] != m_prevSizes[1] ||
+      memcmp(m_wtc, m_prevWtc, sizeof(m_wtc)) != 0 ||
+      m_occluders.size() != m_prevOccluders.size())
+  {
+    return false;
+  }
+
+  for (unsigned int i = 0, size = m_occluders.size(); i < size; ++i) {
+    const Occluder &occluder = m_occluders[i];
+    const Occluder &prevOccluder = m_prevOccluders[i];
+    if (memcmp(occluder.matrix, prevOccluder.matrix, sizeof(occluder.matrix)) != 0 ||
+        occluder.faces != prevOccluder.faces || occluder.triangles != prevOccluder.triangles)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void CcdOcclusionBuffer::SetupOccluder(unsigned int index)
+{
+  const Occluder &occluder = m_occluders[index];
+  std::vector<Triangle> &triangles = m_occluderTriangles[index];
+  triangles.clear();
+
+  float mtc[16];
+  mul_m4(mtc, m_wtc, occluder.matrix);
+
+  for (unsigned int i = 0, size = occluder.faces.size(); i < size; ++i) {
+    const float *v = &occluder.triangles[i * 9];
+    const ClipVertex pi[3] = {transform(mtc, v[0], v[1], v[2]),
+                              transform(mtc, v[3], v[4], v[5]),
+                              transform(mtc, v[6], v[7], v[8])};
+    ClipVertex p[8];
+    const int n = clip_polygon(pi, 3, p);
+
+    // Convert to pixel coordinates with the pixel centers at integer coordinates.
+    for (int j = 0; j < n; ++j) {
+      const float iw = 1.0f / p[j].w;
+      p[j].x = (p[j].x * iw + 1.0f) * m_scales[0];
+      p[j].y = (p[j].y * iw + 1.0f) * m_scales[1];
+      p[j].z = iw;
+    }
+
+    for (int j = 2; j < n; ++j) {
+      const ClipVertex &a = p[0];
+      const float area = (p[j - 1].x - a.x) * (p[j].y - a.y) -
+                         (p[j - 1].y - a.y) * (p[j].x - a.x);
+      if ((occluder.faces[i] * area) < 0.0f || area == 0.0f) {
+        continue;
+      }
+      // Double sided faces can be clockwise, the edge functions expect counter clockwise.
+      const ClipVertex &b = (area > 0.0f) ? p[j - 1] : p[j];
+      const ClipVertex &c = (area > 0.0f) ? p[j] : p[j - 1];
+
+      // Pixel centers covered by the triangle bounds.
+      const float minx = std::max(std::ceil(std::min({a.x, b.x, c.x})), 0.0f);
+      const float miny = std::max(std::ceil(std::min({a.y, b.y, c.y})), 0.0f);
+      const float maxx = std::min(std::floor(std::max({a.x, b.x, c.x})),
+                                  float(m_sizes[0] - 1));
+      const float maxy = std::min(std::floor(std::max({a.y, b.y, c.y})),
+                                  float(m_sizes[1] - 1));
+      if (minx > maxx || miny > maxy) {
+        continue;
+      }
+
+      Triangle tri;
+      tri.minx = (int)minx;
+      tri.maxx = (int)maxx;
+      tri.miny = (int)miny;
+      tri.maxy = (int)maxy;
+
+      const ClipVertex *verts[3] = {&a, &b, &c};
+      for (int e = 0; e < 3; ++e) {
+        const ClipVertex &v0 = *verts[e];
+        const ClipVertex &v1 = *verts[(e + 1) % 3];
+        tri.edges[e][0] = v0.y - v1.y;
+        tri.edges[e][1] = v1.x - v0.x;
+        tri.edges[e][2] = -tri.edges[e][0] * v0.x - tri.edges[e][1] * v0.y;
+      }
+
+      const float iarea = 1.0f / std::fabs(area);
+      const float dzdx = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) * iarea;
+      const float dzdy = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) * iarea;
+      tri.depth[0] = dzdx;
+      tri.depth[1] = dzdy;
+      tri.depth[2] = a.z - dzdx * a.x - dzdy * a.y;
+
+      triangles.push_back(tri);
+    }
+  }
+}
+
+void CcdOcclusionBuffer::RasterizeTile(unsigned int tile)
+{
+  const int x0 = (tile % m_tiles[0]) * TILE_WIDTH;
+  const int y0 = (tile / m_tiles[0]) * TILE_HEIGHT;
+  float *pixels = &m_buffer[tile * TILE_WIDTH * TILE_HEIGHT];
+  std::fill(pixels, pixels + TILE_WIDTH * TILE_HEIGHT, 0.0f);
+
+  for (const unsigned int index : m_bins[tile]) {
+    const Triangle &tri = m_triangles[index];
+    // Bounds of the triangle in the tile.
+    const int minx = std::max(tri.minx, x0) - x0;
+    const int maxx = std::min(tri.maxx, x0 + TILE_WIDTH - 1) - x0;
+    const int miny = std::max(tri.miny, y0) - y0;
+    const int maxy = std::min(tri.maxy, y0 + TILE_HEIGHT - 1) - y0;
+
+    for (int y = miny; y <= maxy; ++y) {
+      float *row = pixels + y * TILE_WIDTH;
+      const float py = float(y0 + y);
+
+#if BLI_HAVE_SSE2
+      // Process groups of 4 pixels, the pixels outside of the triangle fail the edge tests.
+      const int startx = minx & ~3;
+      const float px = float(x0 + startx);
+      const __m128 offsets = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+      const __m128 zero = _mm_setzero_ps();
+
+      __m128 edges[3];
+      __m128 edgeSteps[3];
+      for (int e = 0; e < 3; ++e) {
+        const float *edge = tri.edges[e];
+        edges[e] = _mm_add_ps(_mm_set1_ps(edge[0] * px + edge[1] * py + edge[2]),
+                              _mm_mul_ps(_mm_set1_ps(edge[0]), offsets));
+        edgeSteps[e] = _mm_set1_ps(edge[0] * 4.0f);
+      }
+      __m128 depth = _mm_add_ps(_mm_set1_ps(tri.depth[0] * px + tri.depth[1] * py + tri.depth[2]),
+                                _mm_mul_ps(_mm_set1_ps(tri.depth[0]), offsets));
+      const __m128 depthStep = _mm_set1_ps(tri.depth[0] * 4.0f);
+
+      for (int x = startx; x <= maxx; x += 4) {
+        const __m128 inside = _mm_and_ps(
+            _mm_and_ps(_mm_cmpge_ps(edges[0], zero), _mm_cmpge_ps(edges[1], zero)),
+            _mm_cmpge_ps(edges[2], zero));
+        const __m128 old = _mm_loadu_ps(row + x);
+        const __m128 nearest = _mm_max_ps(old, depth);
+        _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+
+        edges[0] = _mm_add_ps(edges[0], edgeSteps[0]);
+        edges[1] = _mm_add_ps(edges[1], edgeSteps[1]);
+        edges[2] = _mm_add_ps(edges[2], edgeSteps[2]);
+        depth = _mm_add_ps(depth, depthStep);
+      }
+#else
+      for (int x = minx; x <= maxx; ++x) {
+        const float px = float(x0 + x);
+        bool inside = true;
+        for (int e = 0; e < 3; ++e) {
+          inside &= (tri.edges[e][0] * px + tri.edges[e][1] * py + tri.edges[e][2]) >= 0.0f;
+        }
+        if (inside) {
+          row[x] = std::max(row[x], tri.depth[0] * px + tri.depth[1] * py + tri.depth[2]);
+        }
+      }
+#endif
+    }
+  }
+
+  // Farthest depth of the tile pixels inside of the buffer.
+  const int width = std::min(TILE_WIDTH, m_sizes[0] - x0);
+  const int height = std::min(TILE_HEIGHT, m_sizes[1] - y0);
+  float farthest = FLT_MAX;
+  for (int y = 0; y < height; ++y) {
+    const float *row = pixels + y * TILE_WIDTH;
+    for (int x = 0; x < width; ++x) {
+      farthest = std::min(farthest, row[x]);
+    }
+  }
+  m_tileDepths[tile] = farthest;
+}
+
+void CcdOcclusionBuffer::Rasterize()
+{
+  CM_PROFILE_ZONE("OcclusionRasterize");
+
+  // Nothing moved since the last rasterization, the depth is still valid.
+  if (SameAsPrevious()) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  // Transform and clip the triangles of each occluder.
+  const unsigned int numOccluders = m_occluders.size();
+  m_occluderTriangles.resize(numOccluders);
+  settings.use_threading = (numOccluders > 1);
+  BLI_task_parallel_range(
+      0,
+      numOccluders,
+      this,
+      [](void *__restrict userdata, const int iter, const TaskParallelTLS *__restrict) {
+        static_cast<CcdOcclusionBuffer *>(userdata)->SetupOccluder(iter);
+      },
+      &settings);
+
+  // Bin the triangles to the tiles they overlap.
+  m_triangles.clear();
+  for (const std::vector<Triangle> &triangles : m_occluderTriangles) {
+    m_triangles.insert(m_triangles.end(), triangles.begin(), triangles.end());
+  }
+  for (std::vector<unsigned int> &bin : m_bins) {
+    bin.clear();
+  }
+  for (unsigned int i = 0, size = m_triangles.size(); i < size; ++i) {
+    const Triangle &tri = m_triangles[i];
+    for (int ty = tri.miny / TILE_HEIGHT, maxty = tri.maxy / TILE_HEIGHT; ty <= maxty; ++ty) {
+      for (int tx = tri.minx / TILE_WIDTH, maxtx = tri.maxx / TILE_WIDTH; tx <= maxtx; ++tx) {
+        m_bins[ty * m_tiles[0] + tx].push_back(i);
+      }
+    }
+  }
+
+  m_occlusion = !m_triangles.empty();
+
+  // The queries don't read the buffer without occlusion.
+  if (m_occlusion) {
+    settings.use_threading = true;
+    settings.min_iter_per_thread = 8;
+    BLI_task_parallel_range(
+        0,
+        (int)m_bins.size(),
+        this,
+        [](void *__restrict userdata, const int iter, const TaskParallelTLS *__restrict) {
+          static_cast<CcdOcclusionBuffer *>(userdata)->RasterizeTile(iter);
+        },
+        &settings);
+  }
+
+  memcpy(m_prevWtc, m_wtc, sizeof(m_wtc));
+  m_prevSizes[0] = m_sizes[0];
+  m_prevSizes[1] = m_sizes[1];
+  m_prevValid = true;
+}
+
+bool CcdOcclusionBuffer::QueryAabb(const float center[3], const float extents[3]) const
+{
+  if (!m_occlusion) {
+    // No occlusion, no need to check.
+    return true;
+  }
+
+  // Screen bounds and nearest depth of the box.
+  float minx = FLT_MAX;
+  float miny = FLT_MAX;
+  float maxx = -FLT_MAX;
+  float maxy = -FLT_MAX;
+  float nearest = 0.0f;
+  for (int i = 0; i < 8; ++i) {
+    const ClipVertex p = transform(m_wtc,
+                                   center[0] + ((i & 1) ? extents[0] : -extents[0]),
+                                   center[1] + ((i & 2) ? extents[1] : -extents[1]),
+                                   center[2] + ((i & 4) ? extents[2] : -extents[2]));
+    // The box is clipped, it's probably a large box, don't waste our time to check.
+    if ((p.z + p.w) <= 0.0f || p.w <= 0.0f) {
+      return true;
+    }
+    const float iw = 1.0f / p.w;
+    const float x = (p.x * iw + 1.0f) * m_scales[0];
+    const float y = (p.y * iw + 1.0f) * m_scales[1];
+    minx = std::min(minx, x);
+    maxx = std::max(maxx, x);
+    miny = std::min(miny, y);
+    maxy = std::max(maxy, y);
+    nearest = std::max(nearest, iw);
+  }
+
+  // Pixels overlapping the box bounds.
+  if (maxx < -0.5f || maxy < -0.5f || minx > m_sizes[0] - 0.5f || miny > m_sizes[1] - 0.5f) {
+    return true;
+  }
+  const int x0 = clamp_pixel(std::floor(minx), m_sizes[0]);
+  const int x1 = clamp_pixel(std::ceil(maxx), m_sizes[0]);
+  const int y0 = clamp_pixel(std::floor(miny), m_sizes[1]);
+  const int y1 = clamp_pixel(std::ceil(maxy), m_sizes[1]);
+
+#if BLI_HAVE_SSE2
+  const __m128 nearest4 = _mm_set1_ps(nearest);
+#endif
+
+  for (int ty = y0 / TILE_HEIGHT, maxty = y1 / TILE_HEIGHT; ty <= maxty; ++ty) {
+    for (int tx = x0 / TILE_WIDTH, maxtx = x1 / TILE_WIDTH; tx <= maxtx; ++tx) {
+      const unsigned int tile = ty * m_tiles[0] + tx;
+      // All the pixels of the tile are in front of the box.
+      if (m_tileDepths[tile] > nearest) {
+        continue;
+      }
+
+      const int tilex = tx * TILE_WIDTH;
+      const int tiley = ty * TILE_HEIGHT;
+      const int minx = std::max(x0, tilex) - tilex;
+      const int maxx = std::min(x1, tilex + TILE_WIDTH - 1) - tilex;
+      const int miny = std::max(y0, tiley) - tiley;
+      const int maxy = std::min(y1, tiley + TILE_HEIGHT - 1) - tiley;
+      const float *pixels = &m_buffer[tile * TILE_WIDTH * TILE_HEIGHT];
+
+      for (int y = miny; y <= maxy; ++y) {
+        const float *row = pixels + y * TILE_WIDTH;
+        int x = minx;
+#if BLI_HAVE_SSE2
+        for (; x + 3 <= maxx; x += 4) {
+          if (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(row + x), nearest4)) != 0) {
+            return true;
+          }
+        }
+#endif
+        for (; x <= maxx; ++x) {
+          if (row[x] <= nearest) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file CcdOcclusionBuffer.h
+ *  \ingroup physbullet
+ */
+
+#pragma once
+
+#include <vector>
+
+/**
+ * Software depth buffer of the occluder objects, used to cull the objects hidden behind them.
+ *
+ * The buffer is split in tiles of TILE_WIDTH x TILE_HEIGHT pixels stored contiguously. The
+ * occluder triangles are transformed and clipped in parallel per occluder, binned to the tiles
+ * they overlap and then rasterized in parallel per tile, four pixels at a time with SSE2. Each
+ * tile keeps the farthest depth of its pixels so that a box behind it is rejected without
+ * reading the pixels.
+ *
+ * The depth stored is 1/w: 0 where no occluder is drawn and larger is nearer.
+ *
+ * When the camera and the occluders didn't change since the last rasterization the depth is
+ * reused as is.
+ */
+class CcdOcclusionBuffer {
+ public:
+  static const int TILE_WIDTH = 32;
+  static const int TILE_HEIGHT = 8;
+
+  struct Occluder {
+    /// Model to world transform, column major.
+    float matrix[16];
+    /// Model space triangles, 9 floats per triangle.
+    std::vector<float> triangles;
+    /** Face of each triangle: 0 for a double sided face, 1 for a single sided face of an object
+     * with a positive scale and -1 with a negative scale.
+     */
+    std::vector<float> faces;
+  };
+
+ private:
+  /// Triangle in pixel coordinates, the pixel centers are at integer coordinates.
+  struct Triangle {
+    /// Edge functions a * x + b * y + c, positive inside the triangle.
+    float edges[3][3];
+    /// Depth plane a * x + b * y + c.
+    float depth[3];
+    /// Pixel bounds, inclusive.
+    int minx;
+    int miny;
+    int maxx;
+    int maxy;
+  };
+
+  /// Size of the buffer in pixels.
+  int m_sizes[2];
+  /// Number of tiles per row and column.
+  int m_tiles[2];
+  /// Scale from device coordinates to pixel coordinates.
+  float m_scales[2];
+  /// World to clip transform, column major.
+  float m_wtc[16];
+  /// True when some occluder triangles were drawn.
+  bool m_occlusion;
+
+  /// Pixels depth, tile by tile.
+  std::vector<float> m_buffer;
+  /// Farthest depth of each tile.
+  std::vector<float> m_tileDepths;
+  /// Index of the triangles overlapping each tile.
+  std::vector<std::vector<unsigned int>> m_bins;
+  std::vector<Triangle> m_triangles;
+  /// Triangles of each occluder, filled in parallel.
+  std::vector<std::vector<Triangle>> m_occluderTriangles;
+
+  std::vector<Occluder> m_occluders;
+  /// Occluders and transform of the last rasterization, to reuse its depth.
+  std::vector<Occluder> m_prevOccluders;
+  float m_prevWtc[16];
+  int m_prevSizes[2];
+  bool m_prevValid;
+
+  void SetupOccluder(unsigned int index);
+  void RasterizeTile(unsigned int tile);
+  /// Return true when the depth of the last rasterization can be reused.
+  bool SameAsPrevious() const;
+
+ public:
+  CcdOcclusionBuffer();
+  ~CcdOcclusionBuffer() = default;
+
+  /** Begin a new frame.
+   * \param size The largest dimension of the buffer, the other follows the viewport aspect.
+   * \param viewport The viewport {x, y, width, height}.
+   * \param worldToClip The world to clip transform, column major.
+   */
+  void Setup(int size, const int *viewport, const float worldToClip[16]);
+
+  /// Set the number of occluders of the frame, filled with GetOccluder before Rasterize.
+  void SetNumOccluders(unsigned int count);
+  Occluder &GetOccluder(unsigned int index);
+
+  /// Draw the occluders of the frame in the depth buffer.
+  void Rasterize();
+
+  /** Test a world space box (center and half extents) against the depth buffer.
+   * \return False if the box is hidden by the occluders. Can be called from several threads.
+   */
+  bool QueryAabb(const float center[3], const float extents[3]) const;
+};
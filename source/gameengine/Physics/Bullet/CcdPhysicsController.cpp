@@ -41,6 +41,7 @@
 #include "LinearMath/btConvexHull.h"
 
 #include "CcdPhysicsEnvironment.h"
+#include "CcdShapeCache.h"
 #include "CM_Message.h"
 #include "KX_GameObject.h"
 #include "RAS_DisplayArray.h"
@@ -2026,6 +2027,7 @@ void CcdShapeConstructionInfo::ProcessReplica()
   m_triangleIndexVertexArray = nullptr;
   m_forceReInstance = false;
   m_shapeProxy = nullptr;
+  m_shapeCache = nullptr;
   m_vertexArray.clear();
   m_polygonIndexArray.clear();
   m_triFaceArray.clear();
@@ -2665,6 +2667,12 @@ bool CcdShapeConstructionInfo::UpdateMesh(class KX_GameObject *from_gameobj,
     m_forceReInstance = true;
   }
 
+  // Don't fill the cache with the meshes modified at runtime.
+  if (m_shapeCache) {
+    m_shapeCache->Release();
+    m_shapeCache = nullptr;
+  }
+
   // Make sure to also replace the mesh in the shape map! Otherwise we leave dangling references
   // when we free. Note, this whole business could cause issues with shared meshes. If we update
   // one mesh, do we replace them all?
@@ -2691,15 +2699,17 @@ bool CcdShapeConstructionInfo::SetProxy(CcdShapeConstructionInfo *shapeInfo)
   return true;
 }
 
-btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
-                                                              bool useGimpact,
-                                                              bool useBvh)
+btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(
+    btScalar margin,
+    bool useGimpact,
+    bool useBvh,
+    std::vector<btBvhTriangleMeshShape *> *deferredBvhShapes)
 {
   btCollisionShape *collisionShape = nullptr;
   btCompoundShape *compoundShape = nullptr;
 
   if (m_shapeType == PHY_SHAPE_PROXY && m_shapeProxy != nullptr)
-    return m_shapeProxy->CreateBulletShape(margin, useGimpact, useBvh);
+    return m_shapeProxy->CreateBulletShape(margin, useGimpact, useBvh, deferredBvhShapes);
 
   switch (m_shapeType) {
     default:
@@ -2792,13 +2802,32 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
                                                                         m_vertexArray.size() / 3,
                                                                         &m_vertexArray[0],
                                                                         3 * sizeof(btScalar));
+            if (m_shapeCache) {
+              m_shapeCacheKey = CcdShapeCache::ComputeKey(&m_vertexArray[0],
+                                                          m_vertexArray.size() / 3,
+                                                          m_triFaceArray.data(),
+                                                          m_polygonIndexArray.size());
+            }
           }
 
           m_forceReInstance = false;
         }
 
-        btBvhTriangleMeshShape *unscaledShape = new btBvhTriangleMeshShape(
-            m_triangleIndexVertexArray, true, useBvh);
+        btBvhTriangleMeshShape *unscaledShape = nullptr;
+        if (m_shapeCache && useBvh && m_weldingThreshold1 == 0.0f) {
+          unscaledShape = m_shapeCache->LoadShape(m_shapeCacheKey, m_triangleIndexVertexArray);
+        }
+        if (!unscaledShape) {
+          const bool deferBvh = useBvh && deferredBvhShapes;
+          unscaledShape = new btBvhTriangleMeshShape(
+              m_triangleIndexVertexArray, true, useBvh && !deferBvh);
+          if (deferBvh) {
+            deferredBvhShapes->push_back(unscaledShape);
+          }
+          else if (useBvh) {
+            StoreBvh(unscaledShape);
+          }
+        }
         unscaledShape->setMargin(margin);
         collisionShape = new btScaledBvhTriangleMeshShape(unscaledShape,
                                                           btVector3(1.0f, 1.0f, 1.0f));
@@ -2815,7 +2844,8 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
       for (std::vector<CcdShapeConstructionInfo *>::iterator sit = m_shapeArray.begin();
            sit != m_shapeArray.end();
            sit++) {
-        collisionShape = (*sit)->CreateBulletShape(margin, useGimpact, useBvh);
+        collisionShape = (*sit)->CreateBulletShape(
+            margin, useGimpact, useBvh, deferredBvhShapes);
         if (collisionShape) {
           collisionShape->setLocalScaling((*sit)->m_childScale);
           compoundShape->addChildShape((*sit)->m_childTrans, collisionShape);
@@ -2831,6 +2861,29 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin,
   return collisionShape;
 }
 
+void CcdShapeConstructionInfo::BuildBvh(btBvhTriangleMeshShape *shape)
+{
+  shape->buildOptimizedBvh();
+  StoreBvh(shape);
+}
+
+void CcdShapeConstructionInfo::StoreBvh(btBvhTriangleMeshShape *shape)
+{
+  if (m_shapeCache && m_weldingThreshold1 == 0.0f) {
+    m_shapeCache->StoreShape(m_shapeCacheKey, shape);
+  }
+}
+
+void CcdShapeConstructionInfo::SetShapeCache(CcdShapeCache *cache)
+{
+  if (m_shapeCache) {
+    m_shapeCache->Release();
+  }
+  m_shapeCache = cache;
+  // Compute the key at the next creation of the triangle array.
+  m_forceReInstance = true;
+}
+
 void CcdShapeConstructionInfo::AddShape(CcdShapeConstructionInfo *shapeInfo)
 {
   m_shapeArray.push_back(shapeInfo);
@@ -2857,4 +2910,7 @@ CcdShapeConstructionInfo::~CcdShapeConstructionInfo()
   if (m_shapeType == PHY_SHAPE_PROXY && m_shapeProxy != nullptr) {
     m_shapeProxy->Release();
   }
+  if (m_shapeCache) {
+    m_shapeCache->Release();
+  }
 }
@@ -81,7 +81,9 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
         m_triangleIndexVertexArray(nullptr),
         m_forceReInstance(false),
         m_weldingThreshold1(0.0f),
-        m_shapeProxy(nullptr)
+        m_shapeProxy(nullptr),
+        m_shapeCache(nullptr),
+        m_shapeCacheKey(0)
   {
     m_childTrans.setIdentity();
   }
@@ -156,9 +158,21 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
     return m_shapeProxy;
   }
 
-  btCollisionShape *CreateBulletShape(btScalar margin,
-                                      bool useGimpact = false,
-                                      bool useBvh = true);
+  /** Create a new bullet shape, when deferredBvhShapes is not nullptr the BVH of the triangle
+   * mesh shapes are not built and the shapes are added to this list to build their BVH later
+   * with BuildBvh.
+   */
+  btCollisionShape *CreateBulletShape(
+      btScalar margin,
+      bool useGimpact = false,
+      bool useBvh = true,
+      std::vector<btBvhTriangleMeshShape *> *deferredBvhShapes = nullptr);
+
+  /// Build the BVH of a shape created with a deferred BVH, can be called from any thread.
+  void BuildBvh(btBvhTriangleMeshShape *shape);
+
+  /// Use a cache for the BVH of the triangle mesh shape, the cache is released by the shape.
+  void SetShapeCache(class CcdShapeCache *cache);
 
   // member variables
   PHY_ShapeType m_shapeType;
@@ -202,6 +216,14 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
   float m_weldingThreshold1;
   /// only used for PHY_SHAPE_PROXY, pointer to actual shape info
   CcdShapeConstructionInfo *m_shapeProxy;
+
+  /// Add the BVH of a triangle mesh shape to the shape cache if used.
+  void StoreBvh(btBvhTriangleMeshShape *shape);
+
+  /// Cache of the BVH for static triangle mesh, nullptr when not used.
+  class CcdShapeCache *m_shapeCache;
+  /// Key of m_triangleIndexVertexArray in the shape cache.
+  unsigned long long m_shapeCacheKey;
 };
 
 struct CcdConstructionInfo {
@@ -21,10 +21,15 @@
 
 #include "CcdPhysicsEnvironment.h"
 
+#include "BKE_library.hh"
+#include "BKE_main.hh"
 #include "BKE_object.hh"
 #include "BLI_bounds.hh"
+#include "BLI_task.h"
+#include "DNA_mesh_types.h"
 #include "DNA_object_force_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_world_types.h"
 
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
 #include "BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h"
@@ -32,11 +37,16 @@
 #include "BulletDynamics/ConstraintSolver/btNNCGConstraintSolver.h"
 #include "BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h"
 #include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
+#include "LinearMath/btQuickprof.h"
 
 #include "BL_SceneConverter.h"
 #include "CM_List.h"
+#include "CM_Profiler.h"
 #include "CcdConstraint.h"
+#include "CcdDynamicsWorldMt.h"
 #include "CcdGraphicController.h"
+#include "CcdOcclusionBuffer.h"
+#include "CcdShapeCache.h"
 #include "KX_GameObject.h"
 #include "MT_MinMax.h"
 #include "PHY_IVehicle.h"
@@ -365,9 +375,23 @@ void CcdPhysicsEnvironment::SetDebugDrawer(btIDebugDraw *debugDrawer)
   m_debugDrawer = debugDrawer;
 }
 
-CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling)
+/// Report the Bullet zones (BT_PROFILE) to the engine profiler.
+static void bullet_enter_profile_zone(const char *name)
+{
+  CM_Profiler::BeginZone(name);
+}
+
+static void bullet_leave_profile_zone()
+{
+  CM_Profiler::EndZone();
+}
+
+CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType,
+                                             bool useDbvtCulling,
+                                             bool useParallelPhysics)
     : m_cullingCache(nullptr),
       m_cullingTree(nullptr),
+      m_occlusionBuffer(nullptr),
       //m_numIterations(10),
       m_numTimeSubSteps(1),
       m_solverType(PHY_SOLVER_NONE),
@@ -375,6 +399,8 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
       m_linearDeactivationThreshold(0.8f),
       m_angularDeactivationThreshold(1.0f),
       m_contactBreakingThreshold(0.02f),
+      m_useParallelPhysics(false),
+      m_useShapeCache(false),
       m_solver(nullptr),
       m_filterCallback(nullptr),
       m_ghostPairCallback(nullptr),
@@ -384,9 +410,21 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
     m_triggerCallbacks[i] = nullptr;
   }
 
+  btSetCustomEnterProfileZoneFunc(bullet_enter_profile_zone);
+  btSetCustomLeaveProfileZoneFunc(bullet_leave_profile_zone);
+
   m_collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
 
-  btCollisionDispatcher *dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+  // The task scheduler must be installed before the creation of the multithreaded dispatcher.
+  m_useParallelPhysics = useParallelPhysics && CcdTaskScheduler::Activate();
+
+  btCollisionDispatcher *dispatcher;
+  if (m_useParallelPhysics) {
+    dispatcher = new CcdCollisionDispatcherMt(m_collisionConfiguration);
+  }
+  else {
+    dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+  }
   btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
   m_ownDispatcher = dispatcher;
 
@@ -405,8 +443,16 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(PHY_SolverType solverType, bool use
   SetSolverType(solverType);  // issues with quickstep and memory allocations
   //	m_dynamicsWorld = new
   // btDiscreteDynamicsWorld(dispatcher,m_broadphase,m_solver,m_collisionConfiguration);
-  m_dynamicsWorld = new btSoftRigidDynamicsWorld(
-      dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+  if (m_useParallelPhysics) {
+    m_dynamicsWorld = new CcdDynamicsWorldMt(dispatcher,
+                                             m_broadphase,
+                                             static_cast<btConstraintSolverPoolMt *>(m_solver),
+                                             m_collisionConfiguration);
+  }
+  else {
+    m_dynamicsWorld = new btSoftRigidDynamicsWorld(
+        dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+  }
   m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationSubtickCallback,
                                            this);
   // m_dynamicsWorld->getSolverInfo().m_linearSlop = 0.01f;
@@ -720,18 +766,61 @@ void CcdPhysicsEnvironment::SimulationSubtickCallback(btScalar timeStep)
   }
 }
 
+struct SynchronizeMotionStatesData {
+  CcdPhysicsController **controllers;
+  float timeStep;
+};
+
+static void synchronize_motion_states_func(void *__restrict userdata,
+                                           const int iter,
+                                           const TaskParallelTLS *__restrict /*tls*/)
+{
+  SynchronizeMotionStatesData *data = static_cast<SynchronizeMotionStatesData *>(userdata);
+  data->controllers[iter]->SynchronizeMotionStates(data->timeStep);
+}
+
+void CcdPhysicsEnvironment::SynchronizeMotionStates(float timeStep)
+{
+  if (!m_useParallelPhysics) {
+    for (CcdPhysicsController *ctrl : m_controllers) {
+      ctrl->SynchronizeMotionStates(timeStep);
+    }
+    return;
+  }
+
+  /* The rigid bodies only write in their own motion state and shape, the soft bodies update
+   * their pose and are kept serial. */
+  m_parallelControllers.clear();
+  for (CcdPhysicsController *ctrl : m_controllers) {
+    if (ctrl->GetSoftBody()) {
+      ctrl->SynchronizeMotionStates(timeStep);
+    }
+    else {
+      m_parallelControllers.push_back(ctrl);
+    }
+  }
+
+  SynchronizeMotionStatesData data = {m_parallelControllers.data(), timeStep};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+
+  BLI_task_parallel_range(
+      0, m_parallelControllers.size(), &data, synchronize_motion_states_func, &settings);
+}
+
 bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, float interval)
 {
-  std::set<CcdPhysicsController *>::iterator it;
+  CM_PROFILE_ZONE("ProceedDeltaTime");
+
   int i;
 
   // Update Bullet global variables.
   gDeactivationTime = m_deactivationTime;
   gContactBreakingThreshold = m_contactBreakingThreshold;
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    (*it)->SynchronizeMotionStates(timeStep);
-  }
+  SynchronizeMotionStates(timeStep);
 
   float subStep = timeStep / float(m_numTimeSubSteps);
   i = m_dynamicsWorld->stepSimulation(
@@ -741,9 +830,7 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
 
   ProcessFhSprings(curTime, i * subStep);
 
-  for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-    (*it)->SynchronizeMotionStates(timeStep);
-  }
+  SynchronizeMotionStates(timeStep);
 
   for (i = 0; i < m_wrapperVehicles.size(); i++) {
     WrapperVehicle *veh = m_wrapperVehicles[i];
@@ -757,6 +844,8 @@ bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, flo
 
 void CcdPhysicsEnvironment::UpdateSoftBodies()
 {
+  CM_PROFILE_ZONE("UpdateSoftBodies");
+
   std::set<CcdPhysicsController *>::iterator it;
 
   for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
@@ -1002,27 +1091,43 @@ void CcdPhysicsEnvironment::SetSolverDamping(float damping)
   m_dynamicsWorld->getSolverInfo().m_damping = damping;
 }
 
-void CcdPhysicsEnvironment::SetSolverType(PHY_SolverType solverType)
+static btConstraintSolver *ccd_new_constraint_solver(PHY_SolverType solverType)
 {
-
-  if (m_solverType == solverType) {
-    return;
-  }
-
   switch (solverType) {
     case PHY_SOLVER_SEQUENTIAL: {
-      m_solver = new btSequentialImpulseConstraintSolver();
-      break;
+      return new btSequentialImpulseConstraintSolver();
     }
 
     case PHY_SOLVER_NNCG: {
-      m_solver = new btNNCGConstraintSolver();
-      break;
+      return new btNNCGConstraintSolver();
     }
     default: {
       BLI_assert(false);
     }
   };
+
+  return nullptr;
+}
+
+void CcdPhysicsEnvironment::SetSolverType(PHY_SolverType solverType)
+{
+
+  if (m_solverType == solverType) {
+    return;
+  }
+
+  if (m_useParallelPhysics) {
+    // One solver per thread, each simulation island is solved by a single solver.
+    const int numSolvers = BLI_task_scheduler_num_threads();
+    std::vector<btConstraintSolver *> solvers(numSolvers);
+    for (btConstraintSolver *&solver : solvers) {
+      solver = ccd_new_constraint_solver(solverType);
+    }
+    m_solver = new btConstraintSolverPoolMt(solvers.data(), numSolvers);
+  }
+  else {
+    m_solver = ccd_new_constraint_solver(solverType);
+  }
   m_solverType = solverType;
 }
 
@@ -1317,531 +1422,182 @@ PHY_IPhysicsController *CcdPhysicsEnvironment::RayTest(PHY_IRayCastFilterCallbac
   return result.m_controller;
 }
 
-// Handles occlusion culling.
-// The implementation is based on the CDTestFramework
-struct OcclusionBuffer {
-  struct WriteOCL {
-    static inline bool Process(btScalar &q, btScalar v)
-    {
-      if (q < v) {
-        q = v;
-      }
-      return false;
-    }
-    static inline void Occlusion(bool &flag)
-    {
-      flag = true;
-    }
-  };
-
-  struct QueryOCL {
-    static inline bool Process(btScalar &q, btScalar v)
-    {
-      return (q <= v);
-    }
-    static inline void Occlusion(bool &flag)
-    {
-    }
-  };
+/** Broadphase ray callback of a batch ray, same as the one of btSoftRigidDynamicsWorld::rayTest
+ * except that it can be used by several threads at the same time.
+ */
+struct BatchRayCallback : public btBroadphaseRayCallback {
+  btTransform m_rayFromTrans;
+  btTransform m_rayToTrans;
+  btCollisionWorld::RayResultCallback &m_resultCallback;
 
-  btScalar *m_buffer;
-  size_t m_bufferSize;
-  bool m_initialized;
-  bool m_occlusion;
-  int m_sizes[2];
-  btScalar m_scales[2];
-  btScalar m_offsets[2];
-  btScalar m_wtc[16];  // world to clip transform
-  btScalar m_mtc[16];  // model to clip transform
-  // constructor: size=largest dimension of the buffer.
-  // Buffer size depends on aspect ratio
-  OcclusionBuffer()
-  {
-    m_initialized = false;
-    m_occlusion = false;
-    m_buffer = nullptr;
-    m_bufferSize = 0;
-  }
-  // multiplication of column major matrices: m = m1 * m2
-  template<typename T1, typename T2> void CMmat4mul(btScalar *m, const T1 *m1, const T2 *m2)
+  BatchRayCallback(const btVector3 &rayFrom,
+                   const btVector3 &rayTo,
+                   btCollisionWorld::RayResultCallback &resultCallback)
+      : m_resultCallback(resultCallback)
   {
-    m[0] = btScalar(m1[0] * m2[0] + m1[4] * m2[1] + m1[8] * m2[2] + m1[12] * m2[3]);
-    m[1] = btScalar(m1[1] * m2[0] + m1[5] * m2[1] + m1[9] * m2[2] + m1[13] * m2[3]);
-    m[2] = btScalar(m1[2] * m2[0] + m1[6] * m2[1] + m1[10] * m2[2] + m1[14] * m2[3]);
-    m[3] = btScalar(m1[3] * m2[0] + m1[7] * m2[1] + m1[11] * m2[2] + m1[15] * m2[3]);
+    m_rayFromTrans.setIdentity();
+    m_rayFromTrans.setOrigin(rayFrom);
+    m_rayToTrans.setIdentity();
+    m_rayToTrans.setOrigin(rayTo);
 
-    m[4] = btScalar(m1[0] * m2[4] + m1[4] * m2[5] + m1[8] * m2[6] + m1[12] * m2[7]);
-    m[5] = btScalar(m1[1] * m2[4] + m1[5] * m2[5] + m1[9] * m2[6] + m1[13] * m2[7]);
-    m[6] = btScalar(m1[2] * m2[4] + m1[6] * m2[5] + m1[10] * m2[6] + m1[14] * m2[7]);
-    m[7] = btScalar(m1[3] * m2[4] + m1[7] * m2[5] + m1[11] * m2[6] + m1[15] * m2[7]);
-
-    m[8] = btScalar(m1[0] * m2[8] + m1[4] * m2[9] + m1[8] * m2[10] + m1[12] * m2[11]);
-    m[9] = btScalar(m1[1] * m2[8] + m1[5] * m2[9] + m1[9] * m2[10] + m1[13] * m2[11]);
-    m[10] = btScalar(m1[2] * m2[8] + m1[6] * m2[9] + m1[10] * m2[10] + m1[14] * m2[11]);
-    m[11] = btScalar(m1[3] * m2[8] + m1[7] * m2[9] + m1[11] * m2[10] + m1[15] * m2[11]);
-
-    m[12] = btScalar(m1[0] * m2[12] + m1[4] * m2[13] + m1[8] * m2[14] + m1[12] * m2[15]);
-    m[13] = btScalar(m1[1] * m2[12] + m1[5] * m2[13] + m1[9] * m2[14] + m1[13] * m2[15]);
-    m[14] = btScalar(m1[2] * m2[12] + m1[6] * m2[13] + m1[10] * m2[14] + m1[14] * m2[15]);
-    m[15] = btScalar(m1[3] * m2[12] + m1[7] * m2[13] + m1[11] * m2[14] + m1[15] * m2[15]);
+    btVector3 rayDir = (rayTo - rayFrom);
+    rayDir.normalize();
+    for (unsigned short i = 0; i < 3; ++i) {
+      m_rayDirectionInverse[i] = (rayDir[i] == btScalar(0.0)) ? btScalar(1e30) :
+                                                                btScalar(1.0) / rayDir[i];
+      m_signs[i] = m_rayDirectionInverse[i] < 0.0;
+    }
+    m_lambda_max = rayDir.dot(rayTo - rayFrom);
   }
 
-  void setup(int size, const int *view, float mat[16])
+  virtual bool process(const btBroadphaseProxy *proxy)
   {
-    m_initialized = false;
-    m_occlusion = false;
-    // compute the size of the buffer
-    int maxsize = (view[2] > view[3]) ? view[2] : view[3];
-    BLI_assert(maxsize > 0);
-    double ratio = 1.0 / (2 * maxsize);
-    // ensure even number
-    m_sizes[0] = 2 * ((int)(size * view[2] * ratio + 0.5));
-    m_sizes[1] = 2 * ((int)(size * view[3] * ratio + 0.5));
-    m_scales[0] = btScalar(m_sizes[0] / 2);
-    m_scales[1] = btScalar(m_sizes[1] / 2);
-    m_offsets[0] = m_scales[0] + 0.5f;
-    m_offsets[1] = m_scales[1] + 0.5f;
-    // prepare matrix
-    // at this time of the rendering, the modelview matrix is the
-    // world to camera transformation and the projection matrix is
-    // camera to clip transformation. combine both so that
-    for (unsigned short i = 0; i < 16; i++) {
-      m_wtc[i] = btScalar(mat[i]);
-    }
-  }
-
-  void initialize()
-  {
-    size_t newsize = (m_sizes[0] * m_sizes[1]) * sizeof(btScalar);
-    if (m_buffer) {
-      // see if we can reuse
-      if (newsize > m_bufferSize) {
-        free(m_buffer);
-        m_buffer = nullptr;
-        m_bufferSize = 0;
-      }
-    }
-    if (!m_buffer) {
-      m_buffer = (btScalar *)calloc(1, newsize);
-      m_bufferSize = newsize;
-    }
-    else {
-      // buffer exists already, just clears it
-      memset(m_buffer, 0, newsize);
+    // terminate further ray tests, once the closestHitFraction reached zero
+    if (m_resultCallback.m_closestHitFraction == btScalar(0.0f)) {
+      return false;
     }
-    // memory allocate must succeed
-    BLI_assert(m_buffer != nullptr);
-    m_initialized = true;
-    m_occlusion = false;
-  }
 
-  void SetModelMatrix(float *fl)
-  {
-    CMmat4mul(m_mtc, m_wtc, fl);
-    if (!m_initialized) {
-      initialize();
+    btCollisionObject *collisionObject = (btCollisionObject *)proxy->m_clientObject;
+    if (m_resultCallback.needsCollision(collisionObject->getBroadphaseHandle())) {
+      btSoftRigidDynamicsWorld::rayTestSingle(m_rayFromTrans,
+                                              m_rayToTrans,
+                                              collisionObject,
+                                              collisionObject->getCollisionShape(),
+                                              collisionObject->getWorldTransform(),
+                                              m_resultCallback);
     }
+    return true;
   }
+};
+
+struct BatchRayTester : btDbvt::ICollide {
+  BatchRayCallback &m_rayCallback;
 
-  // transform a segment in world coordinate to clip coordinate
-  void transformW(const btVector3 &x, btVector4 &t)
+  BatchRayTester(BatchRayCallback &rayCallback) : m_rayCallback(rayCallback)
   {
-    t[0] = x[0] * m_wtc[0] + x[1] * m_wtc[4] + x[2] * m_wtc[8] + m_wtc[12];
-    t[1] = x[0] * m_wtc[1] + x[1] * m_wtc[5] + x[2] * m_wtc[9] + m_wtc[13];
-    t[2] = x[0] * m_wtc[2] + x[1] * m_wtc[6] + x[2] * m_wtc[10] + m_wtc[14];
-    t[3] = x[0] * m_wtc[3] + x[1] * m_wtc[7] + x[2] * m_wtc[11] + m_wtc[15];
   }
 
-  void transformM(const float *x, btVector4 &t)
+  void Process(const btDbvtNode *leaf)
   {
-    t[0] = x[0] * m_mtc[0] + x[1] * m_mtc[4] + x[2] * m_mtc[8] + m_mtc[12];
-    t[1] = x[0] * m_mtc[1] + x[1] * m_mtc[5] + x[2] * m_mtc[9] + m_mtc[13];
-    t[2] = x[0] * m_mtc[2] + x[1] * m_mtc[6] + x[2] * m_mtc[10] + m_mtc[14];
-    t[3] = x[0] * m_mtc[3] + x[1] * m_mtc[7] + x[2] * m_mtc[11] + m_mtc[15];
+    m_rayCallback.process((btDbvtProxy *)leaf->data);
   }
-  // convert polygon to device coordinates
-  static bool project(btVector4 *p, int n)
-  {
-    for (int i = 0; i < n; ++i) {
-      p[i][2] = 1 / p[i][3];
-      p[i][0] *= p[i][2];
-      p[i][1] *= p[i][2];
-    }
-    return true;
-  }
-  // pi: closed polygon in clip coordinate, NP = number of segments
-  // po: same polygon with clipped segments removed
-  template<const int NP> static int clip(const btVector4 *pi, btVector4 *po)
-  {
-    btScalar s[2 * NP];
-    btVector4 pn[2 * NP];
-    int i, j, m, n, ni;
-    // deal with near clipping
-    for (i = 0, m = 0; i < NP; ++i) {
-      s[i] = pi[i][2] + pi[i][3];
-      if (s[i] < 0) {
-        m += 1 << i;
-      }
-    }
-    if (m == ((1 << NP) - 1)) {
-      return 0;
-    }
-    if (m != 0) {
-      for (i = NP - 1, j = 0, n = 0; j < NP; i = j++) {
-        const btVector4 &a = pi[i];
-        const btVector4 &b = pi[j];
-        const btScalar t = s[i] / (a[3] + a[2] - b[3] - b[2]);
-        if ((t > 0) && (t < 1)) {
-          pn[n][0] = a[0] + (b[0] - a[0]) * t;
-          pn[n][1] = a[1] + (b[1] - a[1]) * t;
-          pn[n][2] = a[2] + (b[2] - a[2]) * t;
-          pn[n][3] = a[3] + (b[3] - a[3]) * t;
-          ++n;
-        }
-        if (s[j] > 0) {
-          pn[n++] = b;
-        }
-      }
-      // ready to test far clipping, start from the modified polygon
-      pi = pn;
-      ni = n;
-    }
-    else {
-      // no clipping on the near plane, keep same vector
-      ni = NP;
-    }
-    // now deal with far clipping
-    for (i = 0, m = 0; i < ni; ++i) {
-      s[i] = pi[i][2] - pi[i][3];
-      if (s[i] > 0) {
-        m += 1 << i;
-      }
-    }
-    if (m == ((1 << ni) - 1)) {
-      return 0;
-    }
-    if (m != 0) {
-      for (i = ni - 1, j = 0, n = 0; j < ni; i = j++) {
-        const btVector4 &a = pi[i];
-        const btVector4 &b = pi[j];
-        const btScalar t = s[i] / (a[2] - a[3] - b[2] + b[3]);
-        if ((t > 0) && (t < 1)) {
-          po[n][0] = a[0] + (b[0] - a[0]) * t;
-          po[n][1] = a[1] + (b[1] - a[1]) * t;
-          po[n][2] = a[2] + (b[2] - a[2]) * t;
-          po[n][3] = a[3] + (b[3] - a[3]) * t;
-          ++n;
-        }
-        if (s[j] < 0) {
-          po[n++] = b;
-        }
-      }
-      return n;
-    }
-    for (int i = 0; i < ni; ++i) {
-      po[i] = pi[i];
-    }
-    return ni;
-  }
-  // write or check a triangle to buffer. a,b,c in device coordinates (-1,+1)
-  template<typename POLICY>
-  inline bool draw(const btVector4 &a,
-                   const btVector4 &b,
-                   const btVector4 &c,
-                   const float face,
-                   const btScalar minarea)
-  {
-    const btScalar a2 = btCross(b - a, c - a)[2];
-    if ((face * a2) < 0.0f || btFabs(a2) < minarea) {
-      return false;
-    }
-    // further down we are normally going to write to the Zbuffer, mark it so
-    POLICY::Occlusion(m_occlusion);
-
-    int x[3], y[3], ib = 1, ic = 2;
-    btScalar z[3];
-    x[0] = (int)(a.x() * m_scales[0] + m_offsets[0]);
-    y[0] = (int)(a.y() * m_scales[1] + m_offsets[1]);
-    z[0] = a.z();
-    if (a2 < 0.f) {
-      // negative aire is possible with double face => must
-      // change the order of b and c otherwise the algorithm doesn't work
-      ib = 2;
-      ic = 1;
-    }
-    x[ib] = (int)(b.x() * m_scales[0] + m_offsets[0]);
-    x[ic] = (int)(c.x() * m_scales[0] + m_offsets[0]);
-    y[ib] = (int)(b.y() * m_scales[1] + m_offsets[1]);
-    y[ic] = (int)(c.y() * m_scales[1] + m_offsets[1]);
-    z[ib] = b.z();
-    z[ic] = c.z();
-    const int mix = btMax(0, btMin(x[0], btMin(x[1], x[2])));
-    const int mxx = btMin(m_sizes[0], 1 + btMax(x[0], btMax(x[1], x[2])));
-    const int miy = btMax(0, btMin(y[0], btMin(y[1], y[2])));
-    const int mxy = btMin(m_sizes[1], 1 + btMax(y[0], btMax(y[1], y[2])));
-    const int width = mxx - mix;
-    const int height = mxy - miy;
-    if ((width * height) <= 1) {
-      // degenerated in at most one single pixel
-      btScalar *scan = &m_buffer[miy * m_sizes[0] + mix];
-      // use for loop to detect the case where width or height == 0
-      for (int iy = miy; iy < mxy; ++iy) {
-        for (int ix = mix; ix < mxx; ++ix) {
-          if (POLICY::Process(*scan, z[0])) {
-            return true;
-          }
-          if (POLICY::Process(*scan, z[1])) {
-            return true;
-          }
-          if (POLICY::Process(*scan, z[2])) {
-            return true;
-          }
-        }
-      }
-    }
-    else if (width == 1) {
-      // Degenerated in at least 2 vertical lines
-      // The algorithm below doesn't work when face has a single pixel width
-      // We cannot use general formulas because the plane is degenerated.
-      // We have to interpolate along the 3 edges that overlaps and process each pixel.
-      // sort the y coord to make formula simpler
-      int ytmp;
-      btScalar ztmp;
-      if (y[0] > y[1]) {
-        ytmp = y[1];
-        y[1] = y[0];
-        y[0] = ytmp;
-        ztmp = z[1];
-        z[1] = z[0];
-        z[0] = ztmp;
-      }
-      if (y[0] > y[2]) {
-        ytmp = y[2];
-        y[2] = y[0];
-        y[0] = ytmp;
-        ztmp = z[2];
-        z[2] = z[0];
-        z[0] = ztmp;
-      }
-      if (y[1] > y[2]) {
-        ytmp = y[2];
-        y[2] = y[1];
-        y[1] = ytmp;
-        ztmp = z[2];
-        z[2] = z[1];
-        z[1] = ztmp;
-      }
-      int dy[] = {y[0] - y[1], y[1] - y[2], y[2] - y[0]};
-      btScalar dzy[3];
-      dzy[0] = (dy[0]) ? (z[0] - z[1]) / dy[0] : btScalar(0.0f);
-      dzy[1] = (dy[1]) ? (z[1] - z[2]) / dy[1] : btScalar(0.0f);
-      dzy[2] = (dy[2]) ? (z[2] - z[0]) / dy[2] : btScalar(0.0f);
-      btScalar v[3] = {dzy[0] * (miy - y[0]) + z[0],
-                       dzy[1] * (miy - y[1]) + z[1],
-                       dzy[2] * (miy - y[2]) + z[2]};
-      dy[0] = y[1] - y[0];
-      dy[1] = y[0] - y[1];
-      dy[2] = y[2] - y[0];
-      btScalar *scan = &m_buffer[miy * m_sizes[0] + mix];
-      for (int iy = miy; iy < mxy; ++iy) {
-        if (dy[0] >= 0 && POLICY::Process(*scan, v[0])) {
-          return true;
-        }
-        if (dy[1] >= 0 && POLICY::Process(*scan, v[1])) {
-          return true;
-        }
-        if (dy[2] >= 0 && POLICY::Process(*scan, v[2])) {
-          return true;
-        }
-        scan += m_sizes[0];
-        v[0] += dzy[0];
-        v[1] += dzy[1];
-        v[2] += dzy[2];
-        dy[0]--;
-        dy[1]++;
-        dy[2]--;
-      }
+};
+
+/// Number of rays tested by a task of a ray batch.
+static const unsigned int RAY_BATCH_CHUNK = 64;
+
+struct RayTestBatchData {
+  btDbvtBroadphase *broadphase;
+  PHY_IRayCastFilterCallback *filterCallback;
+  const float *from;
+  const float *to;
+  unsigned int count;
+  PHY_IPhysicsController **hitControllers;
+  float *hitPoints;
+  float *hitNormals;
+};
+
+static void ray_test_batch_func(void *__restrict userdata,
+                                const int iter,
+                                const TaskParallelTLS *__restrict /*tls*/)
+{
+  RayTestBatchData *data = static_cast<RayTestBatchData *>(userdata);
+  const unsigned int start = iter * RAY_BATCH_CHUNK;
+  const unsigned int end = MT_min(start + RAY_BATCH_CHUNK, data->count);
+
+  /* btDbvtBroadphase::rayTest uses a stack shared by all the rays, the trees are
+   * traversed directly with a stack owned by the task. */
+  btAlignedObjectArray<const btDbvtNode *> stack;
+
+  for (unsigned int i = start; i < end; ++i) {
+    const float *from = &data->from[i * 3];
+    const float *to = &data->to[i * 3];
+    const btVector3 rayFrom(from[0], from[1], from[2]);
+    const btVector3 rayTo(to[0], to[1], to[2]);
+
+    FilterClosestRayResultCallback rayCallback(*data->filterCallback, rayFrom, rayTo);
+    // same options as RayTest
+    rayCallback.m_collisionFilterMask = CcdConstructionInfo::AllFilter ^
+                                        CcdConstructionInfo::SensorFilter;
+    rayCallback.m_flags |= btTriangleRaycastCallback::kF_UseSubSimplexConvexCastRaytest;
+
+    BatchRayCallback broadphaseCallback(rayFrom, rayTo, rayCallback);
+    BatchRayTester tester(broadphaseCallback);
+    for (btDbvt &tree : data->broadphase->m_sets) {
+      tree.rayTestInternal(tree.m_root,
+                           rayFrom,
+                           rayTo,
+                           broadphaseCallback.m_rayDirectionInverse,
+                           broadphaseCallback.m_signs,
+                           broadphaseCallback.m_lambda_max,
+                           btVector3(0.0f, 0.0f, 0.0f),
+                           btVector3(0.0f, 0.0f, 0.0f),
+                           stack,
+                           tester);
+    }
+
+    float *hitPoint = &data->hitPoints[i * 3];
+    float *hitNormal = &data->hitNormals[i * 3];
+    if (!rayCallback.hasHit()) {
+      data->hitControllers[i] = nullptr;
+      hitPoint[0] = hitPoint[1] = hitPoint[2] = 0.0f;
+      hitNormal[0] = hitNormal[1] = hitNormal[2] = 0.0f;
+      continue;
     }
-    else if (height == 1) {
-      // Degenerated in at least 2 horizontal lines
-      // The algorithm below doesn't work when face has a single pixel width
-      // We cannot use general formulas because the plane is degenerated.
-      // We have to interpolate along the 3 edges that overlaps and process each pixel.
-      int xtmp;
-      btScalar ztmp;
-      if (x[0] > x[1]) {
-        xtmp = x[1];
-        x[1] = x[0];
-        x[0] = xtmp;
-        ztmp = z[1];
-        z[1] = z[0];
-        z[0] = ztmp;
-      }
-      if (x[0] > x[2]) {
-        xtmp = x[2];
-        x[2] = x[0];
-        x[0] = xtmp;
-        ztmp = z[2];
-        z[2] = z[0];
-        z[0] = ztmp;
-      }
-      if (x[1] > x[2]) {
-        xtmp = x[2];
-        x[2] = x[1];
-        x[1] = xtmp;
-        ztmp = z[2];
-        z[2] = z[1];
-        z[1] = ztmp;
-      }
-      int dx[] = {x[0] - x[1], x[1] - x[2], x[2] - x[0]};
-      btScalar dzx[3];
-      dzx[0] = (dx[0]) ? (z[0] - z[1]) / dx[0] : btScalar(0.0f);
-      dzx[1] = (dx[1]) ? (z[1] - z[2]) / dx[1] : btScalar(0.0f);
-      dzx[2] = (dx[2]) ? (z[2] - z[0]) / dx[2] : btScalar(0.0f);
-      btScalar v[3] = {dzx[0] * (mix - x[0]) + z[0],
-                       dzx[1] * (mix - x[1]) + z[1],
-                       dzx[2] * (mix - x[2]) + z[2]};
-      dx[0] = x[1] - x[0];
-      dx[1] = x[0] - x[1];
-      dx[2] = x[2] - x[0];
-      btScalar *scan = &m_buffer[miy * m_sizes[0] + mix];
-      for (int ix = mix; ix < mxx; ++ix) {
-        if (dx[0] >= 0 && POLICY::Process(*scan, v[0])) {
-          return true;
-        }
-        if (dx[1] >= 0 && POLICY::Process(*scan, v[1])) {
-          return true;
-        }
-        if (dx[2] >= 0 && POLICY::Process(*scan, v[2])) {
-          return true;
-        }
-        scan++;
-        v[0] += dzx[0];
-        v[1] += dzx[1];
-        v[2] += dzx[2];
-        dx[0]--;
-        dx[1]++;
-        dx[2]--;
-      }
+
+    data->hitControllers[i] = static_cast<CcdPhysicsController *>(
+        rayCallback.m_collisionObject->getUserPointer());
+
+    btVector3 &normal = rayCallback.m_hitNormalWorld;
+    if (normal.length2() > (SIMD_EPSILON * SIMD_EPSILON)) {
+      normal.normalize();
     }
     else {
-      // general case
-      const int dx[] = {y[0] - y[1], y[1] - y[2], y[2] - y[0]};
-      const int dy[] = {
-          x[1] - x[0] - dx[0] * width, x[2] - x[1] - dx[1] * width, x[0] - x[2] - dx[2] * width};
-      const int a = x[2] * y[0] + x[0] * y[1] - x[2] * y[1] - x[0] * y[2] + x[1] * y[2] -
-                    x[1] * y[0];
-      const btScalar ia = 1 / (btScalar)a;
-      const btScalar dzx = ia *
-                           (y[2] * (z[1] - z[0]) + y[1] * (z[0] - z[2]) + y[0] * (z[2] - z[1]));
-      const btScalar dzy = ia * (x[2] * (z[0] - z[1]) + x[0] * (z[1] - z[2]) +
-                                 x[1] * (z[2] - z[0])) -
-                           (dzx * width);
-      int c[] = {miy * x[1] + mix * y[0] - x[1] * y[0] - mix * y[1] + x[0] * y[1] - miy * x[0],
-                 miy * x[2] + mix * y[1] - x[2] * y[1] - mix * y[2] + x[1] * y[2] - miy * x[1],
-                 miy * x[0] + mix * y[2] - x[0] * y[2] - mix * y[0] + x[2] * y[0] - miy * x[2]};
-      btScalar v = ia * ((z[2] * c[0]) + (z[0] * c[1]) + (z[1] * c[2]));
-      btScalar *scan = &m_buffer[miy * m_sizes[0]];
-
-      for (int iy = miy; iy < mxy; ++iy) {
-        for (int ix = mix; ix < mxx; ++ix) {
-          if ((c[0] >= 0) && (c[1] >= 0) && (c[2] >= 0)) {
-            if (POLICY::Process(scan[ix], v)) {
-              return true;
-            }
-          }
-          c[0] += dx[0];
-          c[1] += dx[1];
-          c[2] += dx[2];
-          v += dzx;
-        }
-        c[0] += dy[0];
-        c[1] += dy[1];
-        c[2] += dy[2];
-        v += dzy;
-        scan += m_sizes[0];
-      }
+      normal.setValue(1.0f, 0.0f, 0.0f);
     }
-    return false;
-  }
-  // clip than write or check a polygon
-  template<const int NP, typename POLICY>
-  inline bool clipDraw(const btVector4 *p, const float face, btScalar minarea)
-  {
-    btVector4 o[NP * 2];
-    int n = clip<NP>(p, o);
-    bool earlyexit = false;
-    if (n) {
-      project(o, n);
-      for (int i = 2; i < n && !earlyexit; ++i) {
-        earlyexit |= draw<POLICY>(o[0], o[i - 1], o[i], face, minarea);
-      }
+    for (unsigned short j = 0; j < 3; ++j) {
+      hitPoint[j] = rayCallback.m_hitPointWorld[j];
+      hitNormal[j] = normal[j];
     }
-    return earlyexit;
   }
-  // add a triangle (in model coordinate)
-  // face =  0.f if face is double side,
-  //      =  1.f if face is single sided and scale is positive
-  //      = -1.f if face is single sided and scale is negative
-  void appendOccluderM(const float *a, const float *b, const float *c, const float face)
-  {
-    btVector4 p[3];
-    transformM(a, p[0]);
-    transformM(b, p[1]);
-    transformM(c, p[2]);
-    clipDraw<3, WriteOCL>(p, face, btScalar(0.0f));
-  }
-  // add a quad (in model coordinate)
-  void appendOccluderM(
-      const float *a, const float *b, const float *c, const float *d, const float face)
-  {
-    btVector4 p[4];
-    transformM(a, p[0]);
-    transformM(b, p[1]);
-    transformM(c, p[2]);
-    transformM(d, p[3]);
-    clipDraw<4, WriteOCL>(p, face, btScalar(0.0f));
-  }
-  // query occluder for a box (c=center, e=extend) in world coordinate
-  inline bool queryOccluderW(const btVector3 &c, const btVector3 &e)
-  {
-    if (!m_occlusion) {
-      // no occlusion yet, no need to check
-      return true;
-    }
-    btVector4 x[8];
-    transformW(btVector3(c[0] - e[0], c[1] - e[1], c[2] - e[2]), x[0]);
-    transformW(btVector3(c[0] + e[0], c[1] - e[1], c[2] - e[2]), x[1]);
-    transformW(btVector3(c[0] + e[0], c[1] + e[1], c[2] - e[2]), x[2]);
-    transformW(btVector3(c[0] - e[0], c[1] + e[1], c[2] - e[2]), x[3]);
-    transformW(btVector3(c[0] - e[0], c[1] - e[1], c[2] + e[2]), x[4]);
-    transformW(btVector3(c[0] + e[0], c[1] - e[1], c[2] + e[2]), x[5]);
-    transformW(btVector3(c[0] + e[0], c[1] + e[1], c[2] + e[2]), x[6]);
-    transformW(btVector3(c[0] - e[0], c[1] + e[1], c[2] + e[2]), x[7]);
-
-    for (int i = 0; i < 8; ++i) {
-      // the box is clipped, it's probably a large box, don't waste our time to check
-      if ((x[i][2] + x[i][3]) <= 0) {
-        return true;
-      }
-    }
-    static const int d[] = {1, 0, 3, 2, 4, 5, 6, 7, 4, 7, 3, 0,
-                            6, 5, 1, 2, 7, 6, 2, 3, 5, 4, 0, 1};
-    for (unsigned int i = 0; i < (sizeof(d) / sizeof(d[0]));) {
-      const btVector4 p[] = {x[d[i + 0]], x[d[i + 1]], x[d[i + 2]], x[d[i + 3]]};
-      i += 4;
-      if (clipDraw<4, QueryOCL>(p, 1.0f, 0.0f)) {
-        return true;
-      }
-    }
-    return false;
+}
+
+void CcdPhysicsEnvironment::RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                                         const float *from,
+                                         const float *to,
+                                         unsigned int count,
+                                         PHY_IPhysicsController **hitControllers,
+                                         float *hitPoints,
+                                         float *hitNormals)
+{
+  if (count == 0) {
+    return;
   }
-};
+
+  RayTestBatchData data = {static_cast<btDbvtBroadphase *>(m_broadphase),
+                           &filterCallback,
+                           from,
+                           to,
+                           count,
+                           hitControllers,
+                           hitPoints,
+                           hitNormals};
+
+  const unsigned int numChunks = (count + RAY_BATCH_CHUNK - 1) / RAY_BATCH_CHUNK;
+
+  /* The world is only read, the broadphase trees, the collision shapes and
+   * the transforms are not modified during a ray test. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numChunks > 1);
+
+  BLI_task_parallel_range(0, numChunks, &data, ray_test_batch_func, &settings);
+}
 
 struct DbvtCullingCallback : btDbvt::ICollide {
   PHY_CullingCallback m_clientCallback;
   void *m_userData;
-  OcclusionBuffer *m_ocb;
+  const CcdOcclusionBuffer *m_ocb;
 
   DbvtCullingCallback(PHY_CullingCallback clientCallback, void *userData)
   {
@@ -1851,7 +1607,11 @@ struct DbvtCullingCallback : btDbvt::ICollide {
   }
   bool Descent(const btDbvtNode *node)
   {
-    return (m_ocb->queryOccluderW(node->volume.Center(), node->volume.Extents()));
+    const btVector3 center = node->volume.Center();
+    const btVector3 extents = node->volume.Extents();
+    const float c[3] = {float(center.x()), float(center.y()), float(center.z())};
+    const float e[3] = {float(extents.x()), float(extents.y()), float(extents.z())};
+    return m_ocb->QueryAabb(c, e);
   }
   void Process(const btDbvtNode *node, btScalar depth)
   {
@@ -1863,50 +1623,72 @@ struct DbvtCullingCallback : btDbvt::ICollide {
     // the client object is a graphic controller
     CcdGraphicController *ctrl = static_cast<CcdGraphicController *>(proxy->m_clientObject);
     KX_ClientObjectInfo *info = (KX_ClientObjectInfo *)ctrl->GetNewClientInfo();
-    if (m_ocb) {
-      // means we are doing occlusion culling. Check if this object is an occluders
-      KX_GameObject *gameobj = KX_GameObject::GetClientObject(info);
-      if (gameobj && gameobj->GetOccluder()) {
-        const MT_Transform trans = gameobj->NodeGetWorldTransform();
-        float fl[16];
-        trans.getValue(fl);
-        // this will create the occlusion buffer if not already done
-        // and compute the transformation from model local space to clip space
-        m_ocb->SetModelMatrix(fl);
-        float face = (gameobj->IsNegativeScaling()) ? -1.0f : 1.0f;
-        // walk through the meshes and for each add to buffer
-        for (int i = 0; i < gameobj->GetMeshCount(); i++) {
-          RAS_MeshObject *meshobj = gameobj->GetMesh(i);
-          const float *v1, *v2, *v3, *v4;
-
-          int polycount = meshobj->NumPolygons();
-          for (int j = 0; j < polycount; j++) {
-            RAS_Polygon *poly = meshobj->GetPolygon(j);
-            switch (poly->VertexCount()) {
-              case 3:
-                v1 = poly->GetVertex(0)->getXYZ();
-                v2 = poly->GetVertex(1)->getXYZ();
-                v3 = poly->GetVertex(2)->getXYZ();
-                m_ocb->appendOccluderM(v1, v2, v3, ((poly->IsTwoside()) ? 0.f : face));
-                break;
-              case 4:
-                v1 = poly->GetVertex(0)->getXYZ();
-                v2 = poly->GetVertex(1)->getXYZ();
-                v3 = poly->GetVertex(2)->getXYZ();
-                v4 = poly->GetVertex(3)->getXYZ();
-                m_ocb->appendOccluderM(v1, v2, v3, v4, ((poly->IsTwoside()) ? 0.f : face));
-                break;
-            }
-          }
-        }
-      }
-    }
     if (info)
       (*m_clientCallback)(info, m_userData);
   }
 };
 
-static OcclusionBuffer gOcb;
+/// Collect the occluders inside the frustum.
+struct DbvtOccluderCallback : btDbvt::ICollide {
+  std::vector<KX_GameObject *> &m_occluders;
+
+  DbvtOccluderCallback(std::vector<KX_GameObject *> &occluders) : m_occluders(occluders)
+  {
+  }
+  void Process(const btDbvtNode *leaf)
+  {
+    btBroadphaseProxy *proxy = (btBroadphaseProxy *)leaf->data;
+    CcdGraphicController *ctrl = static_cast<CcdGraphicController *>(proxy->m_clientObject);
+    KX_ClientObjectInfo *info = (KX_ClientObjectInfo *)ctrl->GetNewClientInfo();
+    KX_GameObject *gameobj = KX_GameObject::GetClientObject(info);
+    if (gameobj && gameobj->GetOccluder()) {
+      m_occluders.push_back(gameobj);
+    }
+  }
+};
+
+struct OccluderFillData {
+  const std::vector<KX_GameObject *> *occluders;
+  CcdOcclusionBuffer *buffer;
+};
+
+/// Copy the mesh triangles of an occluder to the occlusion buffer.
+static void occluder_fill_func(void *__restrict userdata,
+                               const int iter,
+                               const TaskParallelTLS *__restrict /*tls*/)
+{
+  OccluderFillData *data = static_cast<OccluderFillData *>(userdata);
+  KX_GameObject *gameobj = (*data->occluders)[iter];
+  CcdOcclusionBuffer::Occluder &occluder = data->buffer->GetOccluder(iter);
+
+  gameobj->NodeGetWorldTransform().getValue(occluder.matrix);
+  occluder.triangles.clear();
+  occluder.faces.clear();
+
+  const float face = (gameobj->IsNegativeScaling()) ? -1.0f : 1.0f;
+  for (int i = 0; i < gameobj->GetMeshCount(); i++) {
+    RAS_MeshObject *meshobj = gameobj->GetMesh(i);
+    for (int j = 0, polycount = meshobj->NumPolygons(); j < polycount; j++) {
+      RAS_Polygon *poly = meshobj->GetPolygon(j);
+      const int numverts = poly->VertexCount();
+      if (numverts < 3) {
+        continue;
+      }
+      const float polyface = (poly->IsTwoside()) ? 0.0f : face;
+      const float *v0 = poly->GetVertex(0)->getXYZ();
+      // Split the quads in two triangles.
+      for (int k = 2; k < numverts && k < 4; ++k) {
+        const float *v1 = poly->GetVertex(k - 1)->getXYZ();
+        const float *v2 = poly->GetVertex(k)->getXYZ();
+        occluder.triangles.insert(occluder.triangles.end(), v0, v0 + 3);
+        occluder.triangles.insert(occluder.triangles.end(), v1, v1 + 3);
+        occluder.triangles.insert(occluder.triangles.end(), v2, v2 + 3);
+        occluder.faces.push_back(polyface);
+      }
+    }
+  }
+}
+
 bool CcdPhysicsEnvironment::CullingTest(PHY_CullingCallback callback,
                                         void *userData,
                                         const std::array<MT_Vector4, 6> &planes,
@@ -1916,6 +1698,8 @@ bool CcdPhysicsEnvironment::CullingTest(PHY_CullingCallback callback,
 {
   if (!m_cullingTree)
     return false;
+  // Move the proxies updated since the last test to the static set and rebalance the tree.
+  m_cullingTree->calculateOverlappingPairs(m_dynamicsWorld->getDispatcher());
   DbvtCullingCallback dispatcher(callback, userData);
   btVector3 planes_n[6];
   btScalar planes_o[6];
@@ -1925,10 +1709,32 @@ bool CcdPhysicsEnvironment::CullingTest(PHY_CullingCallback callback,
   }
   // if occlusionRes != 0 => occlusion culling
   if (occlusionRes) {
+    if (!m_occlusionBuffer) {
+      m_occlusionBuffer = new CcdOcclusionBuffer();
+    }
+
     float mat[16];
     matrix.getValue(mat);
-    gOcb.setup(occlusionRes, viewport, mat);
-    dispatcher.m_ocb = &gOcb;
+    m_occlusionBuffer->Setup(occlusionRes, viewport, mat);
+
+    // Draw first the occluders inside the frustum.
+    std::vector<KX_GameObject *> occluders;
+    DbvtOccluderCallback occluderCollector(occluders);
+    btDbvt::collideKDOP(
+        m_cullingTree->m_sets[1].m_root, planes_n, planes_o, 6, occluderCollector);
+    btDbvt::collideKDOP(
+        m_cullingTree->m_sets[0].m_root, planes_n, planes_o, 6, occluderCollector);
+
+    m_occlusionBuffer->SetNumOccluders(occluders.size());
+    OccluderFillData data = {&occluders, m_occlusionBuffer};
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (occluders.size() > 1);
+    BLI_task_parallel_range(0, occluders.size(), &data, occluder_fill_func, &settings);
+
+    m_occlusionBuffer->Rasterize();
+
+    dispatcher.m_ocb = m_occlusionBuffer;
     // occlusion culling, the direction of the view is taken from the first plan which MUST be the
     // near plane
     btDbvt::collideOCL(
@@ -1986,6 +1792,10 @@ CcdPhysicsEnvironment::~CcdPhysicsEnvironment()
 {
   m_wrapperVehicles.clear();
 
+  for (DeferredBvhShape &deferred : m_deferredBvhShapes) {
+    deferred.shapeInfo->Release();
+  }
+
   // m_broadphase->DestroyScene();
   // delete broadphase ? release reference on broadphase ?
 
@@ -2019,6 +1829,9 @@ CcdPhysicsEnvironment::~CcdPhysicsEnvironment()
 
   if (nullptr != m_cullingCache)
     delete m_cullingCache;
+
+  if (nullptr != m_occlusionBuffer)
+    delete m_occlusionBuffer;
 }
 
 btTypedConstraint *CcdPhysicsEnvironment::GetConstraintById(int constraintId)
@@ -2070,10 +1883,16 @@ bool CcdPhysicsEnvironment::RequestCollisionCallback(PHY_IPhysicsController *ctr
 
 void CcdPhysicsEnvironment::CallbackTriggers()
 {
+  CM_PROFILE_ZONE("CallbackTriggers");
+
   if (!m_triggerCallbacks[PHY_OBJECT_RESPONSE]) {
     return;
   }
 
+  /* The collision data of the previous step were consumed by the logic, they are reused without
+   * reallocation. */
+  m_triggerContacts.clear();
+
   // Walk over all overlapping pairs, and if one of the involved bodies is registered for trigger
   // callback, perform callback
   btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
@@ -2111,8 +1930,16 @@ void CcdPhysicsEnvironment::CallbackTriggers()
       manifold->clearManifold();  // refreshContactPoints(rb0->getCenterOfMassTransform(),rb1->getCenterOfMassTransform());
     }
 
-    const CcdCollData *coll_data = new CcdCollData(manifold);
-    m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE], ctrl0, ctrl1, coll_data, first);
+    m_triggerContacts.push_back({ctrl0, ctrl1, first, CcdCollData(manifold)});
+  }
+
+  // The contacts are reported once collected, the array is not reallocated anymore.
+  for (const TriggerContact &contact : m_triggerContacts) {
+    m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE],
+                                            contact.ctrl0,
+                                            contact.ctrl1,
+                                            &contact.collData,
+                                            contact.first);
   }
 }
 
@@ -2749,7 +2576,9 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
       PHY_SOLVER_NNCG,        // GAME_SOLVER_NNGC
   };
   CcdPhysicsEnvironment *ccdPhysEnv = new CcdPhysicsEnvironment(
-      solverTypeTable[blenderscene->gm.solverType], false);
+      solverTypeTable[blenderscene->gm.solverType],
+      (blenderscene->gm.mode & WO_DBVT_CULLING) != 0,
+      (blenderscene->gm.flag & GAME_USE_PARALLEL_PHYSICS) != 0);
   ccdPhysEnv->SetDebugDrawer(new BlenderDebugDraw());
   ccdPhysEnv->SetDeactivationLinearTreshold(blenderscene->gm.lineardeactthreshold);
   ccdPhysEnv->SetDeactivationAngularTreshold(blenderscene->gm.angulardeactthreshold);
@@ -2757,6 +2586,7 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
   ccdPhysEnv->SetERPNonContact(blenderscene->gm.erp);
   ccdPhysEnv->SetERPContact(blenderscene->gm.erp2);
   ccdPhysEnv->SetCFM(blenderscene->gm.cfm);
+  ccdPhysEnv->m_useShapeCache = (blenderscene->gm.flag & GAME_USE_SHAPE_CACHE) != 0;
 
   if (visualizePhysics)
     ccdPhysEnv->SetDebugMode(btIDebugDraw::DBG_DrawWireframe | btIDebugDraw::DBG_DrawAabb |
@@ -2767,6 +2597,44 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
   return ccdPhysEnv;
 }
 
+static void build_bvh_func(void *__restrict userdata,
+                           const int iter,
+                           const TaskParallelTLS *__restrict /*tls*/)
+{
+  CcdPhysicsEnvironment::DeferredBvhShape &deferred =
+      (*static_cast<std::vector<CcdPhysicsEnvironment::DeferredBvhShape> *>(userdata))[iter];
+  CM_PROFILE_ZONE("BuildBvh");
+  deferred.shapeInfo->BuildBvh(deferred.shape);
+}
+
+void CcdPhysicsEnvironment::EndConversion()
+{
+  if (m_deferredBvhShapes.empty()) {
+    return;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (m_deferredBvhShapes.size() > 1);
+  BLI_task_parallel_range(
+      0, m_deferredBvhShapes.size(), &m_deferredBvhShapes, build_bvh_func, &settings);
+
+  for (DeferredBvhShape &deferred : m_deferredBvhShapes) {
+    deferred.shapeInfo->Release();
+  }
+  m_deferredBvhShapes.clear();
+}
+
+PHY_IGraphicController *CcdPhysicsEnvironment::CreateGraphicController(
+    PHY_IMotionState *motionState)
+{
+  if (!m_cullingTree) {
+    return nullptr;
+  }
+
+  return new CcdGraphicController(this, motionState);
+}
+
 void CcdPhysicsEnvironment::ConvertObject(BL_SceneConverter *converter,
                                           KX_GameObject *gameobj,
                                           RAS_MeshObject *meshobj,
@@ -3055,6 +2923,10 @@ void CcdPhysicsEnvironment::ConvertObject(BL_SceneConverter *converter,
       }
       else {
         shapeInfo->SetMesh(kxscene, meshobj, false);
+        if (m_useShapeCache && !isbulletsoftbody && meshobj->GetOrigMesh()) {
+          shapeInfo->SetShapeCache(
+              CcdShapeCache::Acquire(ID_BLEND_PATH_FROM_GLOBAL(&meshobj->GetOrigMesh()->id)));
+        }
       }
 
       // Soft bodies can benefit from welding, don't do it on non-soft bodies
@@ -3066,7 +2938,13 @@ void CcdPhysicsEnvironment::ConvertObject(BL_SceneConverter *converter,
         shapeInfo->setVertexWeldingThreshold1(0.0f);  // todo: expose this to the UI
       }
 
-      bm = shapeInfo->CreateBulletShape(ci.m_margin, useGimpact, !isbulletsoftbody);
+      std::vector<btBvhTriangleMeshShape *> deferredBvhShapes;
+      bm = shapeInfo->CreateBulletShape(
+          ci.m_margin, useGimpact, !isbulletsoftbody, &deferredBvhShapes);
+      for (btBvhTriangleMeshShape *deferredShape : deferredBvhShapes) {
+        shapeInfo->AddRef();
+        m_deferredBvhShapes.push_back({shapeInfo, deferredShape});
+      }
       // should we compute inertia for dynamic shape?
       // bm->calculateLocalInertia(ci.m_mass,ci.m_localInertiaTensor);
 
@@ -47,9 +47,28 @@ class btIDebugDraw;
 class btDynamicsWorld;
 class PHY_IVehicle;
 class CcdGraphicController;
+class CcdOcclusionBuffer;
 class CcdOverlapFilterCallBack;
 class CcdShapeConstructionInfo;
 
+class CcdCollData : public PHY_ICollData {
+  const btPersistentManifold *m_manifoldPoint;
+
+ public:
+  CcdCollData(const btPersistentManifold *manifoldPoint);
+  virtual ~CcdCollData();
+
+  virtual unsigned int GetNumContacts() const;
+  virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
+  virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
+  virtual MT_Vector3 GetWorldPoint(unsigned int index, bool first) const;
+  virtual MT_Vector3 GetNormal(unsigned int index, bool first) const;
+  virtual float GetCombinedFriction(unsigned int index, bool first) const;
+  virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
+  virtual float GetCombinedRestitution(unsigned int index, bool first) const;
+  virtual float GetAppliedImpulse(unsigned int index, bool first) const;
+};
+
 /** CcdPhysicsEnvironment is an experimental mainloop for physics simulation using optional
  * continuous collision detection. Physics Environment takes care of stepping the simulation and is
  * a container for physics entities. It stores rigidbodies,constraints, materials etc. A derived
@@ -78,6 +97,8 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   btOverlappingPairCache *m_cullingCache;
   /// broadphase for culling
   struct btDbvtBroadphase *m_cullingTree;
+  /// depth buffer of the occluders, created at the first occlusion culling test
+  CcdOcclusionBuffer *m_occlusionBuffer;
 
   /// solver iterations
   //int m_numIterations;
@@ -92,10 +113,32 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
   float m_angularDeactivationThreshold;
   float m_contactBreakingThreshold;
 
+  /// True when the world, the dispatcher and the solver are the multithreaded ones.
+  bool m_useParallelPhysics;
+  /// True when the BVH of the static triangle meshes are cached next to the .blend.
+  bool m_useShapeCache;
+  /// Controllers synchronized in parallel, rebuilt at each step.
+  std::vector<CcdPhysicsController *> m_parallelControllers;
+
+  /// A manifold reported to the collision callbacks.
+  struct TriggerContact {
+    CcdPhysicsController *ctrl0;
+    CcdPhysicsController *ctrl1;
+    bool first;
+    CcdCollData collData;
+  };
+  /** The contacts of the last step, the collision data given to the callbacks stay valid until
+   * the next step. */
+  std::vector<TriggerContact> m_triggerContacts;
+
   void ProcessFhSprings(double curTime, float timeStep);
+  /// Synchronize the motion states of all the controllers.
+  void SynchronizeMotionStates(float timeStep);
 
  public:
-  CcdPhysicsEnvironment(PHY_SolverType solverType, bool useDbvtCulling);
+  CcdPhysicsEnvironment(PHY_SolverType solverType,
+                        bool useDbvtCulling,
+                        bool useParallelPhysics);
 
   virtual ~CcdPhysicsEnvironment();
 
@@ -200,6 +243,13 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
                                           float toX,
                                           float toY,
                                           float toZ);
+  virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                            const float *from,
+                            const float *to,
+                            unsigned int count,
+                            PHY_IPhysicsController **hitControllers,
+                            float *hitPoints,
+                            float *hitNormals);
   virtual bool CullingTest(PHY_CullingCallback callback,
                            void *userData,
                            const std::array<MT_Vector4, 6> &planes,
@@ -292,6 +342,17 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
                              bool isCompoundChild,
                              bool hasCompoundChildren);
 
+  /// A triangle mesh shape created by the conversion, its BVH is built at the end of conversion.
+  struct DeferredBvhShape {
+    CcdShapeConstructionInfo *shapeInfo;
+    btBvhTriangleMeshShape *shape;
+  };
+
+  /// Build in parallel the BVH of the triangle mesh shapes created by ConvertObject.
+  virtual void EndConversion();
+
+  virtual PHY_IGraphicController *CreateGraphicController(PHY_IMotionState *motionState);
+
   /* Set the rigid body joints constraints values for converted objects and replicated group
    * instances. */
   virtual void SetupObjectConstraints(KX_GameObject *obj_src,
@@ -302,6 +363,9 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
  protected:
   std::set<CcdPhysicsController *> m_controllers;
 
+  /// Shapes created by ConvertObject waiting for EndConversion.
+  std::vector<DeferredBvhShape> m_deferredBvhShapes;
+
   PHY_ResponseCallback m_triggerCallbacks[PHY_NUM_RESPONSE];
   void *m_triggerCallbacksUserPtrs[PHY_NUM_RESPONSE];
 
@@ -326,21 +390,3 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
 
   virtual void ExportFile(const std::string &filename);
 };
-
-class CcdCollData : public PHY_ICollData {
-  const btPersistentManifold *m_manifoldPoint;
-
- public:
-  CcdCollData(const btPersistentManifold *manifoldPoint);
-  virtual ~CcdCollData();
-
-  virtual unsigned int GetNumContacts() const;
-  virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
-  virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
-  virtual MT_Vector3 GetWorldPoint(unsigned int index, bool first) const;
-  virtual MT_Vector3 GetNormal(unsigned int index, bool first) const;
-  virtual float GetCombinedFriction(unsigned int index, bool first) const;
-  virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
-  virtual float GetCombinedRestitution(unsigned int index, bool first) const;
-  virtual float GetAppliedImpulse(unsigned int index, bool first) const;
-};
@@ -0,0 +1,387 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file gameengine/Physics/Bullet/CcdShapeCache.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdShapeCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h> /* for open flags (O_BINARY, O_RDONLY). */
+
+#ifndef WIN32
+#  include <unistd.h> /* for close */
+#else
+#  include <io.h> /* for close */
+#endif
+
+#include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
+
+#include "BLI_fileops.h"
+#include "BLI_mmap.h"
+
+#include "CM_Message.h"
+
+/** File layout: a header, the table of the entries and the serialized BVHs aligned on 16 bytes.
+ * The values are in the native byte order, a file of another byte order has an invalid
+ * version and is rebuilt.
+ */
+static const char cache_magic[8] = {'B', 'G', 'E', 'S', 'H', 'A', 'P', 'E'};
+static const unsigned int cache_version = 2;
+static const unsigned long long cache_alignment = 16;
+/// Build setting of the cached BVHs, part of the keys with the Bullet version.
+static const bool cache_quantized_aabb_compression = true;
+
+struct CacheHeader {
+  char magic[8];
+  unsigned int version;
+  unsigned int scalarSize;
+  unsigned long long numEntries;
+};
+
+struct CacheEntry {
+  unsigned long long key;
+  unsigned long long offset;
+  unsigned long long size;
+  /// Hash of the serialized BVH, to detect a corrupted file.
+  unsigned long long checksum;
+};
+
+static unsigned long long cache_align(unsigned long long size)
+{
+  return (size + cache_alignment - 1) & ~(cache_alignment - 1);
+}
+
+static const unsigned long long hash_init = 14695981039346656037ULL;
+
+static unsigned long long hash_data(unsigned long long hash, const void *data, size_t size)
+{
+  // FNV-1a
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/// Access to the header of a serialized BVH, to check it before its deserialization.
+class CcdSerializedBvh : public btOptimizedBvh {
+ public:
+  /// Return true if the header matches the Bullet version, the build settings and the size.
+  static bool IsValid(const void *buffer, unsigned int size)
+  {
+    if (size < sizeof(btQuantizedBvh)) {
+      return false;
+    }
+
+    const CcdSerializedBvh *bvh = static_cast<const CcdSerializedBvh *>(buffer);
+    const unsigned char useQuantization = *reinterpret_cast<const unsigned char *>(
+        &bvh->m_useQuantization);
+    if (bvh->m_bulletVersion != BT_BULLET_VERSION ||
+        useQuantization != (unsigned char)cache_quantized_aabb_compression ||
+        bvh->m_curNodeIndex < 0 || bvh->m_subtreeHeaderCount < 0 ||
+        (unsigned int)bvh->m_traversalMode > TRAVERSAL_RECURSIVE)
+    {
+      return false;
+    }
+
+    // Computed without overflow, unlike calculateSerializeBufferSize.
+    const unsigned long long expectedSize =
+        sizeof(btQuantizedBvh) + getAlignmentSerializationPadding() +
+        sizeof(btBvhSubtreeInfo) * (unsigned long long)bvh->m_subtreeHeaderCount +
+        sizeof(btQuantizedBvhNode) * (unsigned long long)bvh->m_curNodeIndex;
+    return expectedSize == size;
+  }
+};
+
+/// Triangle mesh shape owning the buffer of its deserialized BVH.
+class CcdCachedBvhTriangleMeshShape : public btBvhTriangleMeshShape {
+ private:
+  void *m_bvhBuffer;
+  btOptimizedBvh *m_cachedBvh;
+
+ public:
+  CcdCachedBvhTriangleMeshShape(btStridingMeshInterface *mesh,
+                                void *bvhBuffer,
+                                btOptimizedBvh *cachedBvh)
+      : btBvhTriangleMeshShape(mesh, cache_quantized_aabb_compression, false),
+        m_bvhBuffer(bvhBuffer),
+        m_cachedBvh(cachedBvh)
+  {
+    setOptimizedBvh(m_cachedBvh);
+  }
+
+  virtual ~CcdCachedBvhTriangleMeshShape()
+  {
+    // The BVH can be rebuilt by a scaling, the base class then owns the new one.
+    m_cachedBvh->~btOptimizedBvh();
+    btAlignedFree(m_bvhBuffer);
+  }
+};
+
+static std::mutex cache_registry_mutex;
+static std::map<std::string, CcdShapeCache *> cache_registry;
+
+CcdShapeCache::CcdShapeCache(const std::string &path) : m_path(path), m_users(0), m_file(nullptr)
+{
+  Open();
+}
+
+CcdShapeCache::~CcdShapeCache()
+{
+  Save();
+
+  if (m_file) {
+    BLI_mmap_free(m_file);
+  }
+}
+
+CcdShapeCache *CcdShapeCache::Acquire(const std::string &blendPath)
+{
+  if (blendPath.empty()) {
+    return nullptr;
+  }
+
+  const std::string path = blendPath + ".bvhcache";
+
+  std::lock_guard<std::mutex> lock(cache_registry_mutex);
+  CcdShapeCache *&cache = cache_registry[path];
+  if (!cache) {
+    cache = new CcdShapeCache(path);
+  }
+  ++cache->m_users;
+  return cache;
+}
+
+void CcdShapeCache::Release()
+{
+  std::lock_guard<std::mutex> lock(cache_registry_mutex);
+  if (--m_users > 0) {
+    return;
+  }
+
+  cache_registry.erase(m_path);
+  delete this;
+}
+
+void CcdShapeCache::Open()
+{
+  const int fd = BLI_open(m_path.c_str(), O_BINARY | O_RDONLY, 0);
+  if (fd == -1) {
+    return;
+  }
+
+  m_file = BLI_mmap_open(fd);
+  close(fd);
+  if (!m_file) {
+    return;
+  }
+
+  const size_t length = BLI_mmap_get_length(m_file);
+  CacheHeader header;
+  if (!BLI_mmap_read(m_file, &header, 0, sizeof(CacheHeader)) ||
+      memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 ||
+      header.version != cache_version || header.scalarSize != sizeof(btScalar) ||
+      header.numEntries > (length - sizeof(CacheHeader)) / sizeof(CacheEntry))
+  {
+    CM_Warning("invalid shape cache \"" << m_path << "\", the shapes will be rebuilt");
+    BLI_mmap_free(m_file);
+    m_file = nullptr;
+    return;
+  }
+
+  std::vector<CacheEntry> entries(header.numEntries);
+  if (!entries.empty() && !BLI_mmap_read(m_file,
+                                         entries.data(),
+                                         sizeof(CacheHeader),
+                                         entries.size() * sizeof(CacheEntry)))
+  {
+    BLI_mmap_free(m_file);
+    m_file = nullptr;
+    return;
+  }
+
+  for (const CacheEntry &entry : entries) {
+    if ((entry.offset % cache_alignment) != 0 || entry.offset > length ||
+        entry.size > length - entry.offset)
+    {
+      continue;
+    }
+    m_entries[entry.key] = {entry.key, entry.offset, entry.size, entry.checksum};
+  }
+}
+
+void CcdShapeCache::Save()
+{
+  if (m_newEntries.empty()) {
+    return;
+  }
+
+  // Keep the entries of the mapped file unless rebuilt.
+  std::vector<CacheEntry> entries;
+  for (const auto &pair : m_entries) {
+    if (m_newEntries.find(pair.first) == m_newEntries.end()) {
+      entries.push_back({pair.first, 0, pair.second.size, pair.second.checksum});
+    }
+  }
+  for (const auto &pair : m_newEntries) {
+    const std::vector<char> &data = pair.second;
+    const unsigned long long checksum = hash_data(hash_init, data.data(), data.size());
+    entries.push_back({pair.first, 0, data.size(), checksum});
+  }
+
+  unsigned long long offset = cache_align(sizeof(CacheHeader) +
+                                          entries.size() * sizeof(CacheEntry));
+  for (CacheEntry &entry : entries) {
+    entry.offset = offset;
+    offset = cache_align(offset + entry.size);
+  }
+
+  const std::string tmpPath = m_path + "@";
+  FILE *file = BLI_fopen(tmpPath.c_str(), "wb");
+  if (!file) {
+    CM_Warning("can't write shape cache \"" << m_path << "\"");
+    return;
+  }
+
+  CacheHeader header;
+  memcpy(header.magic, cache_magic, sizeof(cache_magic));
+  header.version = cache_version;
+  header.scalarSize = sizeof(btScalar);
+  header.numEntries = entries.size();
+
+  bool written = (fwrite(&header, sizeof(CacheHeader), 1, file) == 1) &&
+                 (fwrite(entries.data(), sizeof(CacheEntry), entries.size(), file) ==
+                  entries.size());
+
+  std::vector<char> data;
+  for (const CacheEntry &entry : entries) {
+    if (!written) {
+      break;
+    }
+
+    const auto it = m_newEntries.find(entry.key);
+    if (it != m_newEntries.end()) {
+      data = it->second;
+    }
+    else {
+      data.resize(entry.size);
+      if (!BLI_mmap_read(m_file, data.data(), m_entries[entry.key].offset, entry.size)) {
+        written = false;
+        break;
+      }
+    }
+
+    written = (fseek(file, entry.offset, SEEK_SET) == 0) &&
+              (fwrite(data.data(), 1, data.size(), file) == data.size());
+  }
+
+  written = (fclose(file) == 0) && written;
+
+  // The mapped file can't be replaced on some systems.
+  if (m_file) {
+    BLI_mmap_free(m_file);
+    m_file = nullptr;
+    m_entries.clear();
+  }
+
+  if (!written || BLI_rename_overwrite(tmpPath.c_str(), m_path.c_str()) != 0) {
+    CM_Warning("can't write shape cache \"" << m_path << "\"");
+    BLI_delete(tmpPath.c_str(), false, false);
+  }
+
+  m_newEntries.clear();
+}
+
+unsigned long long CcdShapeCache::ComputeKey(const btScalar *vertices,
+                                             int numVertices,
+                                             const int *indices,
+                                             int numTriangles)
+{
+  // The BVH also depends on the Bullet version and the build settings.
+  static const int buildSettings[] = {BT_BULLET_VERSION,
+                                      (int)sizeof(btScalar),
+                                      cache_quantized_aabb_compression,
+                                      MAX_SUBTREE_SIZE_IN_BYTES,
+                                      MAX_NUM_PARTS_IN_BITS};
+
+  unsigned long long hash = hash_init;
+  hash = hash_data(hash, &cache_version, sizeof(cache_version));
+  hash = hash_data(hash, buildSettings, sizeof(buildSettings));
+  hash = hash_data(hash, &numVertices, sizeof(numVertices));
+  hash = hash_data(hash, &numTriangles, sizeof(numTriangles));
+  hash = hash_data(hash, vertices, sizeof(btScalar) * 3 * numVertices);
+  hash = hash_data(hash, indices, sizeof(int) * 3 * numTriangles);
+  return hash;
+}
+
+btBvhTriangleMeshShape *CcdShapeCache::LoadShape(unsigned long long key,
+                                                 btStridingMeshInterface *mesh)
+{
+  void *buffer = nullptr;
+  unsigned int size = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto newIt = m_newEntries.find(key);
+    const auto it = m_entries.find(key);
+    if (newIt != m_newEntries.end()) {
+      size = newIt->second.size();
+      buffer = btAlignedAlloc(size, cache_alignment);
+      memcpy(buffer, newIt->second.data(), size);
+    }
+    else if (it != m_entries.end()) {
+      size = it->second.size;
+      buffer = btAlignedAlloc(size, cache_alignment);
+      // The file can be corrupted, the shape is then rebuilt and stored again.
+      if (!BLI_mmap_read(m_file, buffer, it->second.offset, size) ||
+          hash_data(hash_init, buffer, size) != it->second.checksum ||
+          !CcdSerializedBvh::IsValid(buffer, size))
+      {
+        CM_Warning("corrupted shape in cache \"" << m_path << "\", the shape will be rebuilt");
+        btAlignedFree(buffer);
+        buffer = nullptr;
+        m_entries.erase(it);
+      }
+    }
+  }
+
+  if (!buffer) {
+    return nullptr;
+  }
+
+  btOptimizedBvh *bvh = btOptimizedBvh::deSerializeInPlace(buffer, size, false);
+  if (!bvh) {
+    btAlignedFree(buffer);
+    return nullptr;
+  }
+
+  return new CcdCachedBvhTriangleMeshShape(mesh, buffer, bvh);
+}
+
+void CcdShapeCache::StoreShape(unsigned long long key, btBvhTriangleMeshShape *shape)
+{
+  btOptimizedBvh *bvh = shape->getOptimizedBvh();
+  // The key assumes the build settings of the cache.
+  if (!bvh || bvh->isQuantized() != cache_quantized_aabb_compression) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_newEntries.find(key) != m_newEntries.end()) {
+      return;
+    }
+  }
+
+  const unsigned int size = bvh->calculateSerializeBufferSize();
+  void *buffer = btAlignedAlloc(size, cache_alignment);
+  if (bvh->serializeInPlace(buffer, size, false)) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const char *data = static_cast<const char *>(buffer);
+    m_newEntries.emplace(key, std::vector<char>(data, data + size));
+  }
+  btAlignedFree(buffer);
+}
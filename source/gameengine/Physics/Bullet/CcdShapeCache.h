@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file CcdShapeCache.h
+ *  \ingroup physbullet
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h"
+
+struct BLI_mmap_file;
+
+/**
+ * Cache of the BVHs of the static triangle mesh shapes, stored in a file next to the .blend
+ * to not rebuild them at each launch.
+ *
+ * The BVHs are identified by a hash of the triangle arrays they were built from, the Bullet
+ * version and the build settings, a modified mesh then gets a new entry. The BVHs read from
+ * the file are checked before use, a corrupted BVH is rebuilt.
+ * The file is memory mapped at the first use and the new BVHs are added to the file when the
+ * last user releases the cache.
+ */
+class CcdShapeCache {
+ private:
+  struct Entry {
+    unsigned long long key;
+    unsigned long long offset;
+    unsigned long long size;
+    unsigned long long checksum;
+  };
+
+  std::string m_path;
+  int m_users;
+
+  /// Protect the entries as the shapes can be created in several threads.
+  std::mutex m_mutex;
+  /// The mapped file, nullptr if the file doesn't exist or is invalid.
+  BLI_mmap_file *m_file;
+  /// Entries of the mapped file by key.
+  std::map<unsigned long long, Entry> m_entries;
+  /// Serialized BVHs built since the file was mapped, by key.
+  std::map<unsigned long long, std::vector<char>> m_newEntries;
+
+  CcdShapeCache(const std::string &path);
+  ~CcdShapeCache();
+
+  void Open();
+  /// Write the entries of the mapped file and the new entries in a new file.
+  void Save();
+
+ public:
+  /// Return the cache of a .blend file, nullptr for an unsaved file.
+  static CcdShapeCache *Acquire(const std::string &blendPath);
+  /// Release a cache returned by Acquire, the new entries are saved by the last user.
+  void Release();
+
+  /// Hash the triangle arrays a BVH is built from, with the Bullet version and build settings.
+  static unsigned long long ComputeKey(const btScalar *vertices,
+                                       int numVertices,
+                                       const int *indices,
+                                       int numTriangles);
+
+  /** Create a shape using the cached BVH of this key, nullptr if the key is not cached.
+   * The shape owns a copy of the BVH.
+   */
+  btBvhTriangleMeshShape *LoadShape(unsigned long long key, btStridingMeshInterface *mesh);
+  /// Add the built BVH of a shape to the cache, can be called from any thread.
+  void StoreShape(unsigned long long key, btBvhTriangleMeshShape *shape);
+};
@@ -44,6 +44,7 @@ class PHY_IVehicle;
 class PHY_ICharacter;
 class RAS_MeshObject;
 class PHY_IPhysicsController;
+class PHY_IGraphicController;
 
 class RAS_MeshObject;
 class KX_GameObject;
@@ -240,6 +241,19 @@ class PHY_IPhysicsEnvironment {
                                           float toX,
                                           float toY,
                                           float toZ) = 0;
+  /**
+   * Cast count rays from the packed points from to the packed points to and write for each ray
+   * the closest hit controller (nullptr if missed), the hit point and the hit normal.
+   * The rays can be tested in parallel: the needBroadphaseRayCast function of the filter must be
+   * thread safe and reportHit is not called. The face normal and UV options are ignored.
+   */
+  virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                            const float *from,
+                            const float *to,
+                            unsigned int count,
+                            PHY_IPhysicsController **hitControllers,
+                            float *hitPoints,
+                            float *hitNormals) = 0;
 
   // culling based on physical broad phase
   // the plane number must be set as follow: near, far, left, right, top, botton
@@ -280,6 +294,19 @@ class PHY_IPhysicsEnvironment {
                              bool isCompoundChild,
                              bool hasCompoundChildren) = 0;
 
+  /// Finish the work deferred by ConvertObject, called once all the objects are converted.
+  virtual void EndConversion()
+  {
+  }
+
+  /** Create a controller registering the bounding box of an object in the culling tree.
+   * \return nullptr if the environment doesn't support culling.
+   */
+  virtual PHY_IGraphicController *CreateGraphicController(PHY_IMotionState *motionState)
+  {
+    return nullptr;
+  }
+
   /* Set the rigid body joints constraints values for converted objects and replicated group
    * instances. */
   virtual void SetupObjectConstraints(KX_GameObject *obj_src,
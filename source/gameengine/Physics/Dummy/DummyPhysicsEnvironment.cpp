@@ -31,6 +31,8 @@
 
 #include "DummyPhysicsEnvironment.h"
 
+#include <algorithm>
+
 DummyPhysicsEnvironment::DummyPhysicsEnvironment()
 {
   // create physicsengine data
@@ -122,3 +124,19 @@ PHY_IPhysicsController *DummyPhysicsEnvironment::RayTest(
   // collision detection / raytesting
   return nullptr;
 }
+
+void DummyPhysicsEnvironment::RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                                           const float *from,
+                                           const float *to,
+                                           unsigned int count,
+                                           PHY_IPhysicsController **hitControllers,
+                                           float *hitPoints,
+                                           float *hitNormals)
+{
+  // no collision, all the rays miss
+  for (unsigned int i = 0; i < count; ++i) {
+    hitControllers[i] = nullptr;
+  }
+  std::fill(hitPoints, hitPoints + count * 3, 0.0f);
+  std::fill(hitNormals, hitNormals + count * 3, 0.0f);
+}
@@ -98,6 +98,13 @@ class DummyPhysicsEnvironment : public PHY_IPhysicsEnvironment {
                                           float toX,
                                           float toY,
                                           float toZ);
+  virtual void RayTestBatch(PHY_IRayCastFilterCallback &filterCallback,
+                            const float *from,
+                            const float *to,
+                            unsigned int count,
+                            PHY_IPhysicsController **hitControllers,
+                            float *hitPoints,
+                            float *hitNormals);
   virtual bool CullingTest(PHY_CullingCallback callback,
                            void *userData,
                            const std::array<MT_Vector4, 6> &planes,
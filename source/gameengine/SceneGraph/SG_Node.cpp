@@ -13,6 +13,9 @@
 
 static CM_ThreadMutex scheduleMutex;
 static CM_ThreadMutex transformMutex;
+/* Node whose spatial data is updated by this thread, it is unlinked from the update list once
+ * updated so the schedule requests of its own controllers are dropped. */
+static thread_local const SG_Node *updatingNode = nullptr;
 
 SG_Node::SG_Node(void *clientobj, void *clientinfo, SG_Callbacks &callbacks)
     : SG_QList(),
@@ -28,6 +31,7 @@ SG_Node::SG_Node(void *clientobj, void *clientinfo, SG_Callbacks &callbacks)
       m_worldScaling(1.0f, 1.0f, 1.0f),
       m_parent_relation(nullptr),
       m_familly(new SG_Familly()),
+      m_transformIndex(-1),
       m_modified(true),
       m_dirty(DIRTY_NONE)
 {
@@ -48,6 +52,7 @@ SG_Node::SG_Node(const SG_Node &other)
       m_worldScaling(other.m_worldScaling),
       m_parent_relation(other.m_parent_relation->NewCopy()),
       m_familly(new SG_Familly()),
+      m_transformIndex(-1),
       m_dirty(DIRTY_NONE)
 {
 }
@@ -206,7 +211,11 @@ void SG_Node::RemoveChild(SG_Node *child)
 
 void SG_Node::UpdateWorldData(double time, bool parentUpdated)
 {
-  if (UpdateSpatialData(GetSGParent(), time, parentUpdated)) {
+  updatingNode = this;
+  const bool updated = UpdateSpatialData(GetSGParent(), time, parentUpdated);
+  updatingNode = nullptr;
+
+  if (updated) {
     // to update the
     ActivateUpdateTransformCallback();
   }
@@ -220,6 +229,24 @@ void SG_Node::UpdateWorldData(double time, bool parentUpdated)
   }
 }
 
+void SG_Node::UpdateWorldDataParallel(double time,
+                                      std::vector<SG_Node *> &updatedNodes,
+                                      bool parentUpdated)
+{
+  updatingNode = this;
+  if (UpdateSpatialData(GetSGParent(), time, parentUpdated)) {
+    updatedNodes.push_back(this);
+  }
+  updatingNode = nullptr;
+
+  // The node is updated, remove it from the update list of its tree.
+  Delink();
+
+  for (SG_Node *childnode : m_children) {
+    childnode->UpdateWorldDataParallel(time, updatedNodes, parentUpdated);
+  }
+}
+
 void SG_Node::UpdateWorldDataThread(double time, bool parentUpdated)
 {
   CM_ThreadSpinLock &famillyMutex = m_familly->GetMutex();
@@ -232,7 +259,11 @@ void SG_Node::UpdateWorldDataThread(double time, bool parentUpdated)
 
 void SG_Node::UpdateWorldDataThreadSchedule(double time, bool parentUpdated)
 {
-  if (UpdateSpatialData(GetSGParent(), time, parentUpdated)) {
+  updatingNode = this;
+  const bool updated = UpdateSpatialData(GetSGParent(), time, parentUpdated);
+  updatingNode = nullptr;
+
+  if (updated) {
     // to update the
     ActivateUpdateTransformCallback();
   }
@@ -323,9 +354,8 @@ void SG_Node::AddSGController(SG_Controller *cont)
 
 void SG_Node::RemoveSGController(SG_Controller *cont)
 {
-  m_mutex.Lock();
+  // The controllers are only modified by the owner of the node tree.
   CM_ListRemoveIfFound(m_SGcontrollers, cont);
-  m_mutex.Unlock();
 }
 
 void SG_Node::RemoveAllControllers()
@@ -362,6 +392,16 @@ void SG_Node::SetSGClientInfo(void *clientInfo)
   m_SGclientInfo = clientInfo;
 }
 
+int SG_Node::GetTransformIndex() const
+{
+  return m_transformIndex;
+}
+
+void SG_Node::SetTransformIndex(int index)
+{
+  m_transformIndex = index;
+}
+
 void SG_Node::SetControllerTime(double time)
 {
   for (SG_Controller *cont : m_SGcontrollers) {
@@ -372,7 +412,12 @@ void SG_Node::SetControllerTime(double time)
 void SG_Node::ClearModified()
 {
   m_modified = false;
+  // Notify only once until the render clears the flag.
+  const bool dirtyRender = (m_dirty & DIRTY_RENDER);
   m_dirty = DIRTY_ALL;
+  if (!dirtyRender) {
+    ActivateDirtyRenderCallback();
+  }
 }
 
 void SG_Node::SetModified()
@@ -406,6 +451,7 @@ bool SG_Node::UpdateSpatialData(const SG_Node *parent, double time, bool &parent
   bool bComputesWorldTransform = false;
 
   // update spatial controllers
+  // The controllers only modify their node and object, the trees can be updated in parallel.
   for (SG_Controller *cont : m_SGcontrollers) {
     if (cont->Update(time)) {
       bComputesWorldTransform = true;
@@ -620,6 +666,11 @@ void SG_Node::ActivateUpdateTransformCallback()
 
 bool SG_Node::ActivateScheduleUpdateCallback()
 {
+  // Unlinked just after its update, see UpdateWorldData.
+  if (this == updatingNode) {
+    return false;
+  }
+
   // HACK, this check assumes that the scheduled nodes are put on a DList (see SG_Node.h)
   // The early check on Empty() allows up to avoid calling the callback function
   // when the node is already scheduled for update.
@@ -641,3 +692,11 @@ void SG_Node::ActivateRecheduleUpdateCallback()
     m_callbacks.m_reschedulefunc(this, m_SGclientObject, m_SGclientInfo);
   }
 }
+
+void SG_Node::ActivateDirtyRenderCallback()
+{
+  if (m_callbacks.m_dirtyrenderfunc) {
+    // Call client provided dirty func, it can be called from several threads.
+    m_callbacks.m_dirtyrenderfunc(this, m_SGclientObject, m_SGclientInfo);
+  }
+}
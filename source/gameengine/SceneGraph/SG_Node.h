@@ -26,6 +26,7 @@ typedef void *(*SG_DestructionNewCallback)(SG_Node *sgnode, void *clientobj, voi
 typedef void (*SG_UpdateTransformCallback)(SG_Node *sgnode, void *clientobj, void *clientinfo);
 typedef bool (*SG_ScheduleUpdateCallback)(SG_Node *sgnode, void *clientobj, void *clientinfo);
 typedef bool (*SG_RescheduleUpdateCallback)(SG_Node *sgnode, void *clientobj, void *clientinfo);
+typedef void (*SG_DirtyRenderCallback)(SG_Node *sgnode, void *clientobj, void *clientinfo);
 
 /**
  * SG_Callbacks hold 2 call backs to the outside world.
@@ -48,7 +49,8 @@ struct SG_Callbacks {
         m_destructionfunc(nullptr),
         m_updatefunc(nullptr),
         m_schedulefunc(nullptr),
-        m_reschedulefunc(nullptr)
+        m_reschedulefunc(nullptr),
+        m_dirtyrenderfunc(nullptr)
   {
   }
 
@@ -56,12 +58,14 @@ struct SG_Callbacks {
                SG_DestructionNewCallback destructfunc,
                SG_UpdateTransformCallback updatefunc,
                SG_ScheduleUpdateCallback schedulefunc,
-               SG_RescheduleUpdateCallback reschedulefunc)
+               SG_RescheduleUpdateCallback reschedulefunc,
+               SG_DirtyRenderCallback dirtyrenderfunc)
       : m_replicafunc(repfunc),
         m_destructionfunc(destructfunc),
         m_updatefunc(updatefunc),
         m_schedulefunc(schedulefunc),
-        m_reschedulefunc(reschedulefunc)
+        m_reschedulefunc(reschedulefunc),
+        m_dirtyrenderfunc(dirtyrenderfunc)
   {
   }
 
@@ -70,6 +74,8 @@ struct SG_Callbacks {
   SG_UpdateTransformCallback m_updatefunc;
   SG_ScheduleUpdateCallback m_schedulefunc;
   SG_RescheduleUpdateCallback m_reschedulefunc;
+  /// Called when the node becomes dirty for render (DIRTY_RENDER was not set).
+  SG_DirtyRenderCallback m_dirtyrenderfunc;
 };
 
 typedef std::vector<SG_Node *> NodeList;
@@ -164,6 +170,15 @@ class SG_Node : public SG_QList {
    */
   void UpdateWorldData(double time, bool parentUpdated = false);
   void UpdateWorldDataThread(double time, bool parentUpdated = false);
+  /**
+   * Update the world data as UpdateWorldData but without calling the update transform
+   * callback, which isn't thread safe. The updated nodes are appended to updatedNodes
+   * to call ActivateUpdateTransformCallback on them afterward.
+   */
+  void UpdateWorldDataParallel(double time,
+                               std::vector<SG_Node *> &updatedNodes,
+                               bool parentUpdated = false);
+  void ActivateUpdateTransformCallback();
 
   /**
    * Update the simulation time of this node. Iterate through
@@ -257,6 +272,10 @@ class SG_Node : public SG_QList {
   void *GetSGClientInfo() const;
   void SetSGClientInfo(void *clientInfo);
 
+  /// Return the index of the node in the scene transform store, -1 if not stored.
+  int GetTransformIndex() const;
+  void SetTransformIndex(int index);
+
   /**
    * Set the current simulation time for this node.
    * The implementation of this function runs through
@@ -332,9 +351,9 @@ class SG_Node : public SG_QList {
 
   bool ActivateReplicationCallback(SG_Node *replica);
   void ActivateDestructionCallback();
-  void ActivateUpdateTransformCallback();
   bool ActivateScheduleUpdateCallback();
   void ActivateRecheduleUpdateCallback();
+  void ActivateDirtyRenderCallback();
 
   /**
    * Update the world coordinates of this spatial node. This also informs
@@ -373,7 +392,9 @@ class SG_Node : public SG_QList {
   std::unique_ptr<SG_ParentRelation> m_parent_relation;
 
   std::shared_ptr<SG_Familly> m_familly;
-  CM_ThreadMutex m_mutex;
+
+  /// Index in the scene transform store, -1 if the node isn't stored.
+  int m_transformIndex;
 
   bool m_modified;
   unsigned short m_dirty;
@@ -357,6 +357,9 @@ bool ImageRender::Render()
   RunPreDrawCallbacks();
 #endif
 
+  m_scene->CalculateVisibleMeshes(m_camera,
+                                  RAS_Rect(viewport[0], viewport[1], viewport[2], viewport[3]));
+
   int num_passes = max_ii(1, m_samples);
   num_passes = min_ii(num_passes, m_scene->GetBlenderScene()->eevee.taa_samples);
 
@@ -0,0 +1,332 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import math
+import pathlib
+import platform
+import tempfile
+
+# Logic frames run by the player, at the tic rate of the scene.
+NUM_FRAMES = 600
+LOG_KEY = "BENCHMARK: "
+
+
+def _add_logic(obj, actuator_type):
+    # Link an always sensor pulsing every frame to a new actuator.
+    import bpy
+
+    bpy.context.view_layer.objects.active = obj
+    bpy.ops.logic.sensor_add(type='ALWAYS', object=obj.name)
+    bpy.ops.logic.controller_add(type='LOGIC_AND', object=obj.name)
+    bpy.ops.logic.actuator_add(type=actuator_type, object=obj.name)
+
+    sensor = obj.game.sensors[-1]
+    sensor.use_pulse_true_level = True
+    sensor.tick_skip = 0
+    controller = obj.game.controllers[-1]
+    actuator = obj.game.actuators[-1]
+    controller.link(sensor=sensor, actuator=actuator)
+
+    return actuator
+
+
+def _add_cube(collection, name, location, size=1.0, physics_type='STATIC'):
+    import bpy
+
+    bpy.ops.mesh.primitive_cube_add(size=size, location=location)
+    obj = bpy.context.active_object
+    obj.name = name
+    obj.game.physics_type = physics_type
+    if collection:
+        for users_collection in obj.users_collection:
+            users_collection.objects.unlink(obj)
+        collection.objects.link(obj)
+
+    return obj
+
+
+def _generate_spawn_storm():
+    # Spawners adding short lived rigid bodies every frame.
+    import bpy
+
+    templates = bpy.data.collections.new("Templates")
+    bpy.context.scene.collection.children.link(templates)
+
+    projectile = _add_cube(templates, "Projectile", (0.0, 0.0, 0.0), size=0.2, physics_type='RIGID_BODY')
+    templates.hide_viewport = True
+
+    _add_cube(None, "Ground", (0.0, 0.0, -1.0), size=200.0)
+
+    for i in range(32):
+        angle = i / 32 * 2.0 * math.pi
+        bpy.ops.object.empty_add(location=(math.cos(angle) * 20.0, math.sin(angle) * 20.0, 5.0))
+        spawner = bpy.context.active_object
+        spawner.name = f"Spawner.{i:03d}"
+
+        actuator = _add_logic(spawner, 'EDIT_OBJECT')
+        actuator.mode = 'ADDOBJECT'
+        actuator.object = projectile
+        actuator.time = 120
+        actuator.linear_velocity = (-math.cos(angle) * 10.0, -math.sin(angle) * 10.0, 5.0)
+
+
+def _generate_rigid_body_pile():
+    # Rigid bodies dropped on each other.
+    _add_cube(None, "Ground", (0.0, 0.0, -1.0), size=200.0)
+
+    size = 12
+    for x in range(size):
+        for y in range(size):
+            for z in range(size):
+                location = (x * 1.1 - size * 0.55, y * 1.1 - size * 0.55, z * 1.2 + 1.0)
+                _add_cube(None, f"Body.{x}.{y}.{z}", location, physics_type='RIGID_BODY')
+
+
+def _generate_logic_brick_farm():
+    # Objects without physics running logic bricks every frame.
+    import bpy
+
+    size = 40
+    for x in range(size):
+        for y in range(size):
+            obj = _add_cube(None, f"Brick.{x}.{y}", (x * 2.0, y * 2.0, 0.0), physics_type='NO_COLLISION')
+
+            actuator = _add_logic(obj, 'MOTION')
+            actuator.offset_rotation = (0.0, 0.0, 0.01)
+
+            actuator = _add_logic(obj, 'PROPERTY')
+            bpy.ops.object.game_property_new(type='INT', name="counter")
+            actuator.mode = 'ADD'
+            actuator.property = "counter"
+            actuator.value = "1"
+
+
+def _generate_armature_crowd():
+    # Skinned meshes deformed by looping actions.
+    import bpy
+
+    bpy.ops.object.armature_add(location=(0.0, 0.0, 0.0))
+    armature = bpy.context.active_object
+    armature.name = "Armature"
+
+    # Chain of bones along Z.
+    num_bones = 4
+    bpy.ops.object.mode_set(mode='EDIT')
+    edit_bones = armature.data.edit_bones
+    parent = edit_bones[0]
+    parent.head = (0.0, 0.0, 0.0)
+    parent.tail = (0.0, 0.0, 0.5)
+    for i in range(1, num_bones):
+        bone = edit_bones.new(f"Bone.{i}")
+        bone.head = (0.0, 0.0, i * 0.5)
+        bone.tail = (0.0, 0.0, (i + 1) * 0.5)
+        bone.parent = parent
+        bone.use_connect = True
+        parent = bone
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    # Swing all the bones in a loop.
+    bpy.ops.object.mode_set(mode='POSE')
+    for frame, angle in ((1, -0.5), (20, 0.5), (40, -0.5)):
+        for pose_bone in armature.pose.bones:
+            pose_bone.rotation_mode = 'XYZ'
+            pose_bone.rotation_euler = (angle, 0.0, 0.0)
+            pose_bone.keyframe_insert("rotation_euler", frame=frame)
+    bpy.ops.object.mode_set(mode='OBJECT')
+    action = armature.animation_data.action
+    armature.animation_data_clear()
+
+    # Mesh skinned to the bones by height.
+    bpy.ops.mesh.primitive_cylinder_add(radius=0.2, depth=num_bones * 0.5,
+                                        location=(0.0, 0.0, num_bones * 0.25))
+    body = bpy.context.active_object
+    body.name = "Body"
+    bpy.ops.object.transform_apply(location=True)
+    bones = armature.data.bones
+    for bone in bones:
+        group = body.vertex_groups.new(name=bone.name)
+        for vertex in body.data.vertices:
+            if bone.head_local.z <= vertex.co.z <= bone.tail_local.z:
+                group.add([vertex.index], 1.0, 'REPLACE')
+    modifier = body.modifiers.new("Armature", 'ARMATURE')
+    modifier.object = armature
+    body.parent = armature
+
+    actuator = _add_logic(armature, 'ACTION')
+    actuator.action = action
+    actuator.play_mode = 'LOOPEND'
+    actuator.frame_start = 1
+    actuator.frame_end = 40
+
+    # Duplicate the armature with its child mesh.
+    size = 16
+    for x in range(size):
+        for y in range(size):
+            if x == 0 and y == 0:
+                continue
+            bpy.ops.object.select_all(action='DESELECT')
+            armature.select_set(True)
+            body.select_set(True)
+            bpy.context.view_layer.objects.active = armature
+            bpy.ops.object.duplicate(linked=True)
+            bpy.context.active_object.location = (x * 1.5, y * 1.5, 0.0)
+
+
+def _generate_scene_graph_forest(parallel=False):
+    # Rotating hierarchies of empties, the scene graph updates all of them every frame.
+    import bpy
+
+    bpy.context.scene.game_settings.use_parallel_scenegraph = parallel
+
+    size = 32
+    depth = 16
+    for x in range(size):
+        for y in range(size):
+            bpy.ops.object.empty_add(location=(x * 3.0, y * 3.0, 0.0))
+            root = bpy.context.active_object
+            root.name = f"Root.{x}.{y}"
+
+            actuator = _add_logic(root, 'MOTION')
+            actuator.offset_rotation = (0.0, 0.0, 0.01)
+
+            parent = root
+            for i in range(depth):
+                bpy.ops.object.empty_add(location=(x * 3.0 + 0.1 * (i + 1), y * 3.0, 0.0))
+                child = bpy.context.active_object
+                child.parent = parent
+                parent = child
+
+
+def _generate_steering_crowd():
+    # Agents following paths on a navigation mesh and avoiding each other.
+    import bpy
+
+    bpy.context.scene.game_settings.obstacle_simulation = 'RVO_CELLS'
+
+    bpy.ops.mesh.primitive_plane_add(size=120.0, location=(0.0, 0.0, 0.0))
+    ground = bpy.context.active_object
+    ground.name = "Ground"
+    bpy.ops.object.select_all(action='DESELECT')
+    ground.select_set(True)
+    bpy.context.view_layer.objects.active = ground
+    bpy.ops.mesh.navmesh_make()
+    navmesh = next(obj for obj in bpy.data.objects if obj.game.physics_type == 'NAVMESH')
+
+    # Two groups crossing each other towards the opposite side.
+    targets = []
+    for x in (-50.0, 50.0):
+        bpy.ops.object.empty_add(location=(x, 0.0, 0.0))
+        targets.append(bpy.context.active_object)
+
+    size_x = 40
+    size_y = 25
+    for x in range(size_x):
+        for y in range(size_y):
+            side = x % 2
+            location = ((side * 2 - 1) * (20.0 + x * 0.5), (y - size_y * 0.5) * 1.5, 0.0)
+            bpy.ops.object.empty_add(location=location)
+            agent = bpy.context.active_object
+            agent.name = f"Agent.{x}.{y}"
+            agent.game.use_obstacle_create = True
+            agent.game.obstacle_radius = 0.4
+
+            actuator = _add_logic(agent, 'STEERING')
+            actuator.mode = 'PATHFOLLOWING'
+            actuator.navmesh = navmesh
+            actuator.target = targets[1 - side]
+            actuator.velocity = 3.0
+            actuator.distance = 1.0
+            actuator.update_period = 500
+
+
+SCENES = {
+    'spawn_storm': _generate_spawn_storm,
+    'rigid_body_pile': _generate_rigid_body_pile,
+    'logic_brick_farm': _generate_logic_brick_farm,
+    'armature_crowd': _generate_armature_crowd,
+    'scene_graph_forest': _generate_scene_graph_forest,
+    'scene_graph_forest_parallel': lambda: _generate_scene_graph_forest(parallel=True),
+    'steering_crowd': _generate_steering_crowd,
+}
+
+
+def _generate(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    scene = bpy.context.scene
+
+    SCENES[args['scene']]()
+
+    bpy.ops.object.camera_add(location=(0.0, -60.0, 30.0), rotation=(1.1, 0.0, 0.0))
+    scene.camera = bpy.context.active_object
+
+    bpy.ops.wm.save_as_mainfile(filepath=args['filepath'])
+    return {}
+
+
+if __name__ != '__main__':
+    import api
+
+    def _player_executable(env):
+        # The player is installed next to Blender.
+        blender = pathlib.Path(env.blender_executable)
+        if platform.system() == "Windows":
+            return blender.parent / 'blenderplayer.exe'
+        elif platform.system() == "Darwin":
+            return blender.parents[3] / 'Blenderplayer.app' / 'Contents' / 'MacOS' / 'Blenderplayer'
+        return blender.parent / 'blenderplayer'
+
+    class GameEngineTest(api.Test):
+        def __init__(self, name, filepath=None):
+            self._name = name
+            self.filepath = filepath
+
+        def name(self):
+            return self._name
+
+        def category(self):
+            return "gameengine"
+
+        def use_background(self):
+            # The player needs a window for its GPU context, even without rendering.
+            return False
+
+        def _run_player(self, env, filepath):
+            args = [
+                _player_executable(env),
+                '-w', '64', '64', '0', '0',
+                '-g', 'benchmark_frames', '=', str(NUM_FRAMES),
+                filepath,
+            ]
+            log = env.call(args, cwd=env.base_dir, environment=env.blender_executable_environment)
+
+            for line in log:
+                if line.startswith(LOG_KEY):
+                    output = eval(line[len(LOG_KEY):])
+                    # The game can end before its first logic frame, e.g. on a startup error.
+                    if output['frames'] == 0:
+                        raise Exception("No logic frame run by the game engine benchmark.")
+                    # Times in seconds per logic frame, like the other tests.
+                    result = {'time': output['total'] / 1000.0 / output['frames']}
+                    for category, time in output['categories'].items():
+                        result[category.lower().replace(' ', '_')] = time / 1000.0
+                    return result
+
+            raise Exception("No game engine benchmark result found in log.")
+
+        def run(self, env, device_id):
+            if self.filepath:
+                return self._run_player(env, str(self.filepath))
+
+            with tempfile.TemporaryDirectory() as tempdir:
+                filepath = str(pathlib.Path(tempdir) / f"{self._name}.blend")
+                env.run_in_blender(_generate, {'scene': self._name, 'filepath': filepath})
+                return self._run_player(env, filepath)
+
+    def generate(env):
+        tests = [GameEngineTest(name) for name in SCENES.keys()]
+        filepaths = env.find_blend_files('gameengine/*')
+        tests += [GameEngineTest(filepath.stem, filepath) for filepath in filepaths]
+        return tests
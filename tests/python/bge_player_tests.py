@@ -0,0 +1,300 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Game engine tests, running generated scenes in the player.
+
+./bge_player_tests.py --blender /path/to/blender --player /path/to/blenderplayer
+"""
+
+import argparse
+import ast
+import pathlib
+import socket
+import subprocess
+import sys
+import tempfile
+import unittest
+
+from modules.test_utils import AbstractBlenderRunnerTest
+
+# Line printed by the scene checks, followed by a Python literal of the results.
+RESULT_KEY = "BGE_TEST: "
+# Upper bound of logic frames run by the player, the checks end the game before.
+MAX_FRAMES = 600
+
+
+# ------------------------------------------------------------------------------
+# Scene generation, run inside Blender.
+
+def _add_logic(obj, controller_type='LOGIC_AND', pulse=False):
+    # Link an always sensor to a new controller.
+    import bpy
+
+    bpy.context.view_layer.objects.active = obj
+    bpy.ops.logic.sensor_add(type='ALWAYS', object=obj.name)
+    bpy.ops.logic.controller_add(type=controller_type, object=obj.name)
+
+    sensor = obj.game.sensors[-1]
+    sensor.use_pulse_true_level = pulse
+    sensor.tick_skip = 0
+    controller = obj.game.controllers[-1]
+    controller.link(sensor=sensor)
+
+    return sensor, controller
+
+
+def _add_check(obj, script):
+    # Run a script every logic frame, it prints the results and ends the game.
+    import bpy
+
+    text = bpy.data.texts.new(obj.name + "_check.py")
+    text.write(script)
+    sensor, controller = _add_logic(obj, 'PYTHON', pulse=True)
+    controller.mode = 'SCRIPT'
+    controller.text = text
+
+
+def generate_action_play_end(filepath):
+    # An empty moving from 0 to 10 on X with a PLAY action, checked once the action ended.
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+
+    bpy.ops.object.empty_add(location=(0.0, 0.0, 0.0))
+    obj = bpy.context.active_object
+    obj.name = "Animated"
+    obj.keyframe_insert("location", index=0, frame=1)
+    obj.location.x = 10.0
+    obj.keyframe_insert("location", index=0, frame=10)
+    action = obj.animation_data.action
+    action.use_fake_user = True
+    obj.animation_data_clear()
+    obj.location.x = 0.0
+
+    sensor, controller = _add_logic(obj)
+    bpy.ops.logic.actuator_add(type='ACTION', object=obj.name)
+    actuator = obj.game.actuators[-1]
+    actuator.action = action
+    actuator.play_mode = 'PLAY'
+    actuator.frame_start = 1.0
+    actuator.frame_end = 10.0
+    controller.link(actuator=actuator)
+
+    _add_check(obj, (
+        "import bge\n"
+        "owner = bge.logic.getCurrentController().owner\n"
+        "owner['frames'] = owner.get('frames', 0) + 1\n"
+        "if owner['frames'] == 60:\n"
+        "    print('" + RESULT_KEY + "' + repr({'x': owner.worldPosition.x}))\n"
+        "    bge.logic.endGame()\n"
+    ))
+
+    bpy.ops.wm.save_as_mainfile(filepath=filepath)
+
+
+def generate_action_armatures(filepath):
+    # Two armatures moving their bone to different locations with PLAY actions evaluated in
+    # parallel in the same frames, checked once the actions ended.
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    bpy.context.scene.game_settings.use_parallel_animation = True
+
+    armatures = []
+    for name, location_x, end_y in (("Armature1", -2.0, 4.0), ("Armature2", 2.0, -6.0)):
+        bpy.ops.object.armature_add(location=(location_x, 0.0, 0.0))
+        obj = bpy.context.active_object
+        obj.name = name
+        bone = obj.pose.bones["Bone"]
+        bone.keyframe_insert("location", index=1, frame=1)
+        bone.location.y = end_y
+        bone.keyframe_insert("location", index=1, frame=10)
+        action = obj.animation_data.action
+        action.use_fake_user = True
+        obj.animation_data_clear()
+        bone.location.y = 0.0
+
+        sensor, controller = _add_logic(obj)
+        bpy.ops.logic.actuator_add(type='ACTION', object=obj.name)
+        actuator = obj.game.actuators[-1]
+        actuator.action = action
+        actuator.play_mode = 'PLAY'
+        actuator.frame_start = 1.0
+        actuator.frame_end = 10.0
+        controller.link(actuator=actuator)
+        armatures.append(obj)
+
+    _add_check(armatures[0], (
+        "import bge\n"
+        "owner = bge.logic.getCurrentController().owner\n"
+        "owner['frames'] = owner.get('frames', 0) + 1\n"
+        "if owner['frames'] == 60:\n"
+        "    objects = bge.logic.getCurrentScene().objects\n"
+        "    locations = {name: tuple(objects[name].channels['Bone'].location)\n"
+        "                 for name in ('Armature1', 'Armature2')}\n"
+        "    print('" + RESULT_KEY + "' + repr(locations))\n"
+        "    bge.logic.endGame()\n"
+    ))
+
+    bpy.ops.wm.save_as_mainfile(filepath=filepath)
+
+
+def _generate_replication(filepath, script):
+    # A replicated empty and a logic empty running the script of the server or the client.
+    import bpy
+
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+
+    bpy.ops.object.empty_add(location=(0.0, 0.0, 0.0))
+    mover = bpy.context.active_object
+    mover.name = "Mover"
+    for name, prop_type, value in (("replicate", 'BOOL', True), ("score", 'INT', 0), ("temp", 'INT', 1)):
+        bpy.context.view_layer.objects.active = mover
+        bpy.ops.object.game_property_new(type=prop_type, name=name)
+        mover.game.properties[name].value = value
+
+    bpy.ops.object.empty_add(location=(0.0, 0.0, 0.0))
+    logic = bpy.context.active_object
+    logic.name = "Logic"
+    _add_check(logic, script)
+
+    bpy.ops.wm.save_as_mainfile(filepath=filepath)
+
+
+def generate_replication_server(filepath, port):
+    # Move the replicated object then change its properties and keep the state until killed.
+    _generate_replication(filepath, (
+        "import bge\n"
+        "owner = bge.logic.getCurrentController().owner\n"
+        "owner['frames'] = owner.get('frames', 0) + 1\n"
+        "mover = bge.logic.getCurrentScene().objects['Mover']\n"
+        "if owner['frames'] == 1:\n"
+        "    bge.logic.startReplication(bge.logic.KX_REPLICATION_SERVER, '127.0.0.1', {})\n"
+        "elif owner['frames'] <= 60:\n"
+        "    mover.worldPosition = (owner['frames'] * 0.1, 0.0, 0.0)\n"
+        "if owner['frames'] == 60:\n"
+        "    mover['score'] = 42\n"
+        "    del mover['temp']\n"
+        "if owner['frames'] == 3600:\n"
+        "    bge.logic.endGame()\n"
+    ).format(port))
+
+
+def generate_replication_client(filepath, port):
+    # Print the replicated state after the server reached its final state.
+    _generate_replication(filepath, (
+        "import bge\n"
+        "owner = bge.logic.getCurrentController().owner\n"
+        "owner['frames'] = owner.get('frames', 0) + 1\n"
+        "mover = bge.logic.getCurrentScene().objects['Mover']\n"
+        "if owner['frames'] == 1:\n"
+        "    bge.logic.startReplication(bge.logic.KX_REPLICATION_CLIENT, '127.0.0.1', {})\n"
+        "if owner['frames'] == 300:\n"
+        "    print('" + RESULT_KEY + "' + repr({{\n"
+        "        'x': mover.worldPosition.x, 'score': mover.get('score'), 'temp': 'temp' in mover}}))\n"
+        "    bge.logic.endGame()\n"
+    ).format(port))
+
+
+# ------------------------------------------------------------------------------
+# Tests, run outside Blender.
+
+class AbstractPlayerTest(AbstractBlenderRunnerTest):
+    @classmethod
+    def setUpClass(cls):
+        cls.blender = args.blender
+        cls.player = args.player
+        cls.testdir = pathlib.Path(__file__).parent
+        cls.tempdir = tempfile.TemporaryDirectory()
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.tempdir.cleanup()
+
+    def generate(self, name: str, *args) -> str:
+        # Save the scene generated by `generate_<name>` to a temporary file.
+        filepath = str(pathlib.Path(self.tempdir.name) / (name + ".blend"))
+        self.run_blender('', (
+            "import sys; "
+            "sys.path.insert(0, {!r}); "
+            "import bge_player_tests; "
+            "bge_player_tests.generate_{}({})"
+        ).format(str(self.testdir), name, ", ".join(repr(arg) for arg in (filepath,) + args)))
+        return filepath
+
+    def player_command(self, filepath: str, benchmark: bool = True) -> list:
+        # The benchmark mode runs at a fixed timestep and ends after MAX_FRAMES.
+        command = [self.player, '-w', '64', '64', '0', '0']
+        if benchmark:
+            command += ['-g', 'benchmark_frames', '=', str(MAX_FRAMES)]
+        return command + [filepath]
+
+    def parse_results(self, output: str) -> dict:
+        for line in output.splitlines():
+            if line.startswith(RESULT_KEY):
+                return ast.literal_eval(line[len(RESULT_KEY):])
+        self.fail("No game engine test result found in output:\n" + output)
+
+    def run_player(self, filepath: str, timeout: int = 300) -> dict:
+        proc = subprocess.run(self.player_command(filepath), stdout=subprocess.PIPE,
+                              stderr=subprocess.STDOUT, timeout=timeout)
+        output = proc.stdout.decode('utf-8', errors='replace')
+        self.assertEqual(proc.returncode, 0, "Player exited with an error:\n" + output)
+        return self.parse_results(output)
+
+
+class ActionTest(AbstractPlayerTest):
+    def test_play_end_pose(self):
+        # The last frame of a PLAY action must be applied before the action is removed.
+        results = self.run_player(self.generate('action_play_end'))
+        self.assertAlmostEqual(results['x'], 10.0, places=4)
+
+    def test_parallel_armatures(self):
+        # Each armature evaluated in the animation pool must get the pose of its own action.
+        results = self.run_player(self.generate('action_armatures'))
+        for name, end_y in (('Armature1', 4.0), ('Armature2', -6.0)):
+            location = results[name]
+            self.assertAlmostEqual(location[0], 0.0, places=4)
+            self.assertAlmostEqual(location[1], end_y, places=4)
+            self.assertAlmostEqual(location[2], 0.0, places=4)
+
+
+class ReplicationTest(AbstractPlayerTest):
+    def test_server_client(self):
+        # Two players exchanging packets in real time, the client ends the test.
+        # A free UDP port, so that parallel test runs don't share the server.
+        with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as sock:
+            sock.bind(('127.0.0.1', 0))
+            port = sock.getsockname()[1]
+
+        server_filepath = self.generate('replication_server', port)
+        client_filepath = self.generate('replication_client', port)
+
+        server = subprocess.Popen(self.player_command(server_filepath, benchmark=False),
+                                  stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        try:
+            proc = subprocess.run(self.player_command(client_filepath, benchmark=False),
+                                  stdout=subprocess.PIPE, stderr=subprocess.STDOUT, timeout=300)
+        finally:
+            server.kill()
+            server.wait()
+
+        output = proc.stdout.decode('utf-8', errors='replace')
+        self.assertEqual(proc.returncode, 0, "Player exited with an error:\n" + output)
+        results = self.parse_results(output)
+        self.assertAlmostEqual(results['x'], 6.0, places=4)
+        self.assertEqual(results['score'], 42)
+        # The property removed on the server is removed on the client.
+        self.assertFalse(results['temp'])
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--blender', required=True)
+    parser.add_argument('--player', required=True)
+    args, remaining = parser.parse_known_args()
+
+    unittest.main(argv=sys.argv[0:1] + remaining)